@@ -22,6 +22,7 @@
 
 #include "program_options.hpp"
 
+#include "gemm_bench_log.hpp"
 #include "rocblas.hpp"
 #include "rocblas_data.hpp"
 #include "rocblas_datatype2string.hpp"
@@ -33,6 +34,7 @@
 #include <cctype>
 #include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <stdexcept>
@@ -42,6 +44,8 @@
 // aux
 #include "testing_set_get_matrix.hpp"
 #include "testing_set_get_matrix_async.hpp"
+#include "testing_set_get_matrix_batched.hpp"
+#include "testing_set_get_matrix_strided_batched.hpp"
 #include "testing_set_get_vector.hpp"
 #include "testing_set_get_vector_async.hpp"
 // blas1
@@ -313,6 +317,8 @@ struct perf_blas<T, U, std::enable_if_t<std::is_same_v<T, float> || std::is_same
                 {"set_get_vector_async", testing_set_get_vector_async<T>},
                 {"set_get_matrix", testing_set_get_matrix<T>},
                 {"set_get_matrix_async", testing_set_get_matrix_async<T>},
+                {"set_get_matrix_batched", testing_set_get_matrix_batched<T>},
+                {"set_get_matrix_strided_batched", testing_set_get_matrix_strided_batched<T>},
                 // L1
                 {"asum", testing_asum<T>},
                 {"asum_batched", testing_asum_batched<T>},
@@ -518,6 +524,8 @@ struct perf_blas<
                 {"set_get_vector_async", testing_set_get_vector_async<T>},
                 {"set_get_matrix", testing_set_get_matrix<T>},
                 {"set_get_matrix_async", testing_set_get_matrix_async<T>},
+                {"set_get_matrix_batched", testing_set_get_matrix_batched<T>},
+                {"set_get_matrix_strided_batched", testing_set_get_matrix_strided_batched<T>},
                 // L1
                 {"asum", testing_asum<T>},
                 {"asum_batched", testing_asum_batched<T>},
@@ -1044,6 +1052,15 @@ int run_bench_test(bool               init,
             return 0;
     }
 
+    // rotg and rotmg time host computations, and set_get_* time synchronous transfers, so
+    // their hot calls are not timed on a stream by rocblas_time_hot_calls
+    if((ArgumentModel_get_timing_options().enabled || rocblas_get_rotating_bytes())
+       && (!strcmp(function, "rotg") || !strcmp(function, "rotmg")
+           || !strncmp(function, "set_get_", 8)))
+        rocblas_cerr << "rocblas-bench WARNING: --timing_stats, --rotating and --flush are not "
+                        "supported by "
+                     << function << " and are ignored" << std::endl;
+
 #if BUILD_WITH_TENSILE
     if(!strcmp(function, "gemm") || !strcmp(function, "gemm_batched"))
     {
@@ -1298,6 +1315,169 @@ int run_bench_gpu_test(int                parallel_devices,
     return 0;
 }
 
+// Set a scalar of a GEMM compute type from its real and imaginary parts
+void set_gemm_scalar(rocblas_union_t& scalar, rocblas_datatype type, double real, double imag)
+{
+    switch(type)
+    {
+    case rocblas_datatype_f16_r:
+        scalar.h = rocblas_half(float(real));
+        break;
+    case rocblas_datatype_f32_r:
+        scalar.s = float(real);
+        break;
+    case rocblas_datatype_f64_r:
+        scalar.d = real;
+        break;
+    case rocblas_datatype_i32_r:
+        scalar.i = int32_t(real);
+        break;
+    case rocblas_datatype_f32_c:
+        scalar.c = rocblas_float_complex(float(real), float(imag));
+        break;
+    case rocblas_datatype_f64_c:
+        scalar.z = rocblas_double_complex(real, imag);
+        break;
+    default:
+        break;
+    }
+}
+
+// Report how the GEMM calls of a bench log capture, and their time, are covered by tuned logic
+int rocblas_bench_coverage(const std::string& filename, const Arguments& arg)
+{
+    std::ifstream file(filename);
+    if(!file)
+        throw std::invalid_argument("Cannot read --coverage file " + filename);
+
+    rocblas_gemm_bench_capture capture;
+    rocblas_gemm_bench_read(file, capture);
+    if(capture.malformed)
+        rocblas_cerr << "rocblas-bench warning: " << capture.malformed
+                     << " malformed GEMM lines are ignored" << std::endl;
+
+    static constexpr const char* names[]
+        = {"exact", "nearest", "fallback", "none", "error", "untimed"};
+    static constexpr int error = rocblas_gemm_coverage_none + 1, untimed = error + 1;
+    size_t               total_calls = 0, calls[untimed + 1]{};
+    double               total_us = 0, us[untimed + 1]{};
+
+    struct row
+    {
+        size_t      index;
+        int         coverage;
+        double      us;
+        std::string options;
+    };
+    std::vector<row> rows;
+
+    rocblas_local_handle handle{arg};
+    hipStream_t          stream;
+    CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+
+    for(size_t i = 0; i < capture.calls.size(); i++)
+    {
+        // Batched calls select the same solutions as their strided equivalents
+        const auto& call      = capture.calls[i];
+        auto        a_type    = string2rocblas_datatype(call.a_type);
+        auto        b_type    = string2rocblas_datatype(call.b_type);
+        auto        c_type    = string2rocblas_datatype(call.c_type);
+        auto        d_type    = string2rocblas_datatype(call.d_type);
+        auto        comp_type = string2rocblas_datatype(call.compute_type);
+        auto        transA    = char2rocblas_operation(call.transA);
+        auto        transB    = char2rocblas_operation(call.transB);
+
+        rocblas_union_t alpha, beta;
+        set_gemm_scalar(alpha, comp_type, call.alpha, call.alphai);
+        set_gemm_scalar(beta, comp_type, call.beta, call.betai);
+
+#define GEMM_COVERAGE_ARGS(a_, b_, c_, d_)                                                        \
+    handle, transA, transB, call.M, call.N, call.K, &alpha, a_, a_type, call.lda, call.stride_a,  \
+        b_, b_type, call.ldb, call.stride_b, &beta, c_, c_type, call.ldc, call.stride_c, d_,      \
+        d_type, call.ldd, call.stride_d, call.batch_count, comp_type
+
+        rocblas_gemm_coverage coverage;
+        int                   result = error;
+        if(rocblas_gemm_strided_batched_ex_get_coverage(
+               GEMM_COVERAGE_ARGS(nullptr, nullptr, nullptr, nullptr), call.flags, &coverage)
+           == rocblas_status_success)
+            result = coverage;
+
+        // Time the call with zero-initialized matrices
+        double call_us = 0;
+        if(result != error)
+        {
+            auto size = [&](const std::string& type, int64_t ld, int64_t cols, int64_t stride) {
+                return rocblas_gemm_bench_type_size(type)
+                       * (cols ? ld * cols + stride * (call.batch_count - 1) : 1);
+            };
+            size_t size_a = size(call.a_type, call.lda, call.transA == 'N' ? call.K : call.M,
+                                 call.stride_a);
+            size_t size_b = size(call.b_type, call.ldb, call.transB == 'N' ? call.N : call.K,
+                                 call.stride_b);
+            size_t size_c = size(call.c_type, call.ldc, call.N, call.stride_c);
+            size_t size_d = size(call.d_type, call.ldd, call.N, call.stride_d);
+
+            device_vector<uint8_t> dA(size_a), dB(size_b), dC(size_c), dD(size_d);
+            if(dA.memcheck() == hipSuccess && dB.memcheck() == hipSuccess
+               && dC.memcheck() == hipSuccess && dD.memcheck() == hipSuccess)
+            {
+                CHECK_HIP_ERROR(hipMemset(dA, 0, size_a));
+                CHECK_HIP_ERROR(hipMemset(dB, 0, size_b));
+                CHECK_HIP_ERROR(hipMemset(dC, 0, size_c));
+
+                for(int iter = 0; iter < arg.cold_iters; iter++)
+                    rocblas_gemm_strided_batched_ex(GEMM_COVERAGE_ARGS(dA, dB, dC, dD),
+                                                    rocblas_gemm_algo_standard,
+                                                    0,
+                                                    call.flags);
+
+                double start = get_time_us_sync(stream);
+                for(int iter = 0; iter < arg.iters; iter++)
+                    rocblas_gemm_strided_batched_ex(GEMM_COVERAGE_ARGS(dA, dB, dC, dD),
+                                                    rocblas_gemm_algo_standard,
+                                                    0,
+                                                    call.flags);
+                call_us = (get_time_us_sync(stream) - start) / std::max(arg.iters, 1);
+            }
+            else
+                result = untimed;
+        }
+
+#undef GEMM_COVERAGE_ARGS
+
+        size_t count = capture.counts[i];
+        total_calls += count;
+        total_us += count * call_us;
+        calls[result] += count;
+        us[result] += count * call_us;
+        rows.push_back({i, result, call_us, call.options()});
+    }
+
+    // The calls which take the most time first, as those are the ones worth tuning
+    std::stable_sort(rows.begin(), rows.end(), [&](const row& a, const row& b) {
+        return capture.counts[a.index] * a.us > capture.counts[b.index] * b.us;
+    });
+
+    rocblas_cout << "calls,us,total_us,coverage,rocblas-bench options" << std::endl;
+    for(const auto& r : rows)
+        rocblas_cout << capture.counts[r.index] << "," << r.us << ","
+                     << capture.counts[r.index] * r.us << "," << names[r.coverage] << ","
+                     << r.options << std::endl;
+
+    rocblas_cout << std::endl
+                 << "coverage,calls,calls_percent,total_us,time_percent" << std::endl;
+    for(int c = 0; c <= untimed; c++)
+        if(calls[c] || c <= rocblas_gemm_coverage_none)
+            rocblas_cout << names[c] << "," << calls[c] << ","
+                         << (total_calls ? 100.0 * calls[c] / total_calls : 0) << "," << us[c]
+                         << "," << (total_us ? 100.0 * us[c] / total_us : 0) << std::endl;
+    rocblas_cout << "GEMM calls: " << total_calls << " (" << capture.calls.size()
+                 << " distinct); other lines skipped: " << capture.skipped << std::endl;
+
+    return calls[error] ? 1 : 0;
+}
+
 // Replace --batch with --batch_count for backward compatibility
 void fix_batch(int argc, char* argv[])
 {
@@ -1330,17 +1510,23 @@ try
     std::string arithmetic_check;
     std::string filter;
     std::string name_filter;
+    std::string coverage;
     int32_t     device_id;
     int32_t     parallel_devices;
     int32_t     flags               = 0;
     int32_t     geam_ex_op          = 0;
+    size_t      rotating            = 0;
     bool        datafile            = rocblas_parse_data(argc, argv);
     bool        atomics_not_allowed = false;
     bool        log_function_name   = false;
     bool        log_datatype        = false;
+    bool        timing_stats        = false;
+    bool        flush               = false;
     bool        any_stride          = false;
     bool        fortran             = false;
 
+    rocblas_timing_options timing_options;
+
     arg.init(); // set all defaults
 
     options_description desc("rocblas-bench command line options");
@@ -1519,6 +1705,37 @@ try
          value<int32_t>(&arg.cold_iters)->default_value(2),
          "Cold Iterations to run before entering the timing loop")
 
+        ("rotating",
+         value<size_t>(&rotating)->default_value(0),
+         "Cache size in MiB, such as the size of the last level cache of the device. Hot "
+         "iterations cycle through enough copies of the operands that the operands of the "
+         "iterations between two uses of a copy exceed it. At most 1024 copies are made.")
+
+        ("flush",
+         bool_switch(&flush)->default_value(false),
+         "With --rotating, write a buffer of that size before each hot iteration instead of "
+         "rotating copies of the operands. The writes are not timed.")
+
+        ("timing_stats",
+         bool_switch(&timing_stats)->default_value(false),
+         "Time each hot iteration with events, reject slow outliers, and report the min, median, "
+         "p90, p99, standard deviation and 95% confidence interval of the median. Not supported "
+         "by rotg, rotmg and set_get_*.")
+
+        ("outlier_mad",
+         value<double>(&timing_options.outlier_mad)->default_value(5),
+         "With --timing_stats, reject hot iterations slower than the median by more than this "
+         "many scaled median absolute deviations. 0 keeps all iterations.")
+
+        ("ci_target",
+         value<double>(&timing_options.ci_target)->default_value(0),
+         "With --timing_stats, repeat batches of --iters hot iterations until the half width of "
+         "the confidence interval is at most this fraction of the median, such as 0.01")
+
+        ("max_iters",
+         value<int32_t>(&timing_options.max_iters)->default_value(1000),
+         "With --ci_target, hot iterations after which timing stops even if the target is missed")
+
         ("algo",
          value<uint32_t>(&arg.algo)->default_value(0),
          "extended precision gemm algorithm")
@@ -1547,6 +1764,11 @@ try
          value<int32_t>(&parallel_devices)->default_value(0),
          "Set number of devices used for parallel runs (device 0 to parallel_devices-1)")
 
+        ("coverage",
+         value<std::string>(&coverage),
+         "Read a capture of rocblas_layer_mode_log_bench, and report which of its GEMM calls, and "
+         "which fraction of their time, use tuned Tensile logic. --iters and --cold_iters apply.")
+
         ("outofplace",
          bool_switch(&arg.outofplace)->default_value(false),
          "for gemm_ex C and D are stored in separate memory, for trmm B and C are stored in separate memory")
@@ -1652,6 +1874,11 @@ try
 
     ArgumentModel_set_log_datatype(log_datatype);
 
+    timing_options.enabled = timing_stats;
+    ArgumentModel_set_timing_options(timing_options);
+
+    rocblas_set_rotating(rotating << 20, flush);
+
     // Device Query
     rocblas_int device_count = query_device_property();
 
@@ -1664,6 +1891,9 @@ try
     if(datafile)
         return rocblas_bench_datafile(filter, name_filter, any_stride);
 
+    if(!coverage.empty())
+        return rocblas_bench_coverage(coverage, arg);
+
     // single bench run
 
     // validate arguments
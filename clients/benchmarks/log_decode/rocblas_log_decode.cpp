@@ -0,0 +1,112 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*****************************************************************************
+ * rocblas-log-decode converts a binary log written with                     *
+ * ROCBLAS_LAYER=rocblas_layer_mode_log_binary into the text formats of      *
+ * trace and bench logging. Bench lines can be passed to rocblas-bench.      *
+ *****************************************************************************/
+
+#include "binary_log.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static void usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [options] binary_log_file\n"
+              << "Options:\n"
+              << "  --trace        Output only trace records\n"
+              << "  --bench        Output only bench records\n"
+              << "  --timestamps   Prefix each line with its timestamp (ns) and thread\n"
+              << "  -o file        Write output to file instead of stdout\n";
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned    kinds      = 0;
+    bool        timestamps = false;
+    const char* input      = nullptr;
+    const char* output     = nullptr;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "--trace"))
+            kinds |= 1u << rocblas_binary_log_kind_trace;
+        else if(!strcmp(argv[i], "--bench"))
+            kinds |= 1u << rocblas_binary_log_kind_bench;
+        else if(!strcmp(argv[i], "--timestamps"))
+            timestamps = true;
+        else if(!strcmp(argv[i], "-o") && i + 1 < argc)
+            output = argv[++i];
+        else if(argv[i][0] != '-' && !input)
+            input = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(!input)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(!kinds)
+        kinds = ~0u;
+
+    std::ifstream in(input, std::ios::binary);
+    if(!in)
+    {
+        std::cerr << "rocblas-log-decode: cannot open " << input << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream file;
+    if(output)
+    {
+        file.open(output);
+        if(!file)
+        {
+            std::cerr << "rocblas-log-decode: cannot open " << output << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    size_t dropped = 0;
+    if(!rocblas_binary_log_decode(in, output ? file : std::cout, kinds, timestamps, &dropped))
+    {
+        std::cerr << "rocblas-log-decode: " << input << " is not a rocBLAS binary log"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if(dropped)
+        std::cerr << "rocblas-log-decode: " << dropped
+                  << " records were dropped because a log buffer was full" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,182 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+/*****************************************************************************
+ * rocblas-pack-bench measures the host packing of strided vectors and       *
+ * matrices done by rocblas_set_vector, rocblas_get_vector,                  *
+ * rocblas_set_matrix and rocblas_get_matrix, comparing the packers of       *
+ * strided_pack.hpp, serial and threaded, against a loop of memcpy calls of  *
+ * runtime size. No GPU is used.                                             *
+ *****************************************************************************/
+
+#include "strided_pack.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+static void usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "Options:\n"
+              << "  -n count       Number of columns (elements of a vector) (default 1048576)\n"
+              << "  --rows rows    Rows of each column; 1 packs a vector (default 1)\n"
+              << "  --ld ld        Leading dimension or increment, in elements (default 4)\n"
+              << "  --iters iters  Timed iterations of each packer (default 20)\n"
+              << "  --unpack       Time unpacking (get) instead of packing (set)\n";
+}
+
+// The loop which the packers replace: one memcpy of runtime size per column
+static void memcpy_loop(char* t, const char* a, size_t col_bytes, size_t cols, size_t ld_bytes)
+{
+    for(size_t j = 0; j < cols; j++)
+        memcpy(t + j * col_bytes, a + j * ld_bytes, col_bytes);
+}
+
+static void
+    memcpy_loop_unpack(char* b, size_t ld_bytes, const char* t, size_t col_bytes, size_t cols)
+{
+    for(size_t j = 0; j < cols; j++)
+        memcpy(b + j * ld_bytes, t + j * col_bytes, col_bytes);
+}
+
+// Average time of iters calls of func, in seconds, after a warmup call
+template <typename FUNC>
+static double time_it(int iters, FUNC&& func)
+{
+    func();
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iters; ++i)
+        func();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iters;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t cols   = 1 << 20;
+    size_t rows   = 1;
+    size_t ld     = 4;
+    int    iters  = 20;
+    bool   unpack = false;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        if(!strcmp(argv[i], "-n") && i + 1 < argc)
+            cols = strtoull(argv[++i], nullptr, 0);
+        else if(!strcmp(argv[i], "--rows") && i + 1 < argc)
+            rows = strtoull(argv[++i], nullptr, 0);
+        else if(!strcmp(argv[i], "--ld") && i + 1 < argc)
+            ld = strtoull(argv[++i], nullptr, 0);
+        else if(!strcmp(argv[i], "--iters") && i + 1 < argc)
+            iters = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--unpack"))
+            unpack = true;
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(!cols || !rows || ld < rows || iters < 1)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    rocblas_pack_thread_pool  serial(1);
+    rocblas_pack_thread_pool& threaded = rocblas_pack_thread_pool::instance();
+
+    printf("%s of %zu columns of %zu rows, leading dimension %zu, %zu threads\n",
+           unpack ? "unpack" : "pack",
+           cols,
+           rows,
+           ld,
+           threaded.threads());
+    printf("%10s %14s %14s %14s %10s %10s\n",
+           "elem_size",
+           "memcpy GB/s",
+           "serial GB/s",
+           "threaded GB/s",
+           "serial x",
+           "threaded x");
+
+    for(size_t elem_size : {2, 4, 8, 16, 12})
+    {
+        size_t            col_bytes = rows * elem_size;
+        size_t            ld_bytes  = ld * elem_size;
+        std::vector<char> a(ld_bytes * (cols - 1) + col_bytes);
+        std::vector<char> t(col_bytes * cols);
+        std::vector<char> check(t.size());
+        for(size_t i = 0; i < a.size(); ++i)
+            a[i] = char(i * 7 + 3);
+
+        double base, one, many;
+        if(!unpack)
+        {
+            base = time_it(iters,
+                           [&] { memcpy_loop(t.data(), a.data(), col_bytes, cols, ld_bytes); });
+            check = t;
+            one   = time_it(iters, [&] {
+                rocblas_pack_columns(t.data(), a.data(), col_bytes, cols, ld_bytes, serial);
+            });
+            if(t != check)
+                std::cerr << "serial pack of " << elem_size << " byte elements is wrong\n";
+            many = time_it(iters, [&] {
+                rocblas_pack_columns(t.data(), a.data(), col_bytes, cols, ld_bytes, threaded);
+            });
+            if(t != check)
+                std::cerr << "threaded pack of " << elem_size << " byte elements is wrong\n";
+        }
+        else
+        {
+            memcpy_loop(t.data(), a.data(), col_bytes, cols, ld_bytes);
+            std::vector<char> expected = a;
+            base = time_it(iters, [&] {
+                memcpy_loop_unpack(a.data(), ld_bytes, t.data(), col_bytes, cols);
+            });
+            one = time_it(iters, [&] {
+                rocblas_unpack_columns(a.data(), ld_bytes, t.data(), col_bytes, cols, serial);
+            });
+            many = time_it(iters, [&] {
+                rocblas_unpack_columns(a.data(), ld_bytes, t.data(), col_bytes, cols, threaded);
+            });
+            if(a != expected)
+                std::cerr << "unpack of " << elem_size << " byte elements is wrong\n";
+        }
+
+        // Bandwidth counts the packed bytes read and written
+        double gb = 2e-9 * col_bytes * cols;
+        printf("%10zu %14.2f %14.2f %14.2f %10.2f %10.2f\n",
+               elem_size,
+               gb / base,
+               gb / one,
+               gb / many,
+               base / one,
+               base / many);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -47,3 +47,28 @@ bool ArgumentModel_get_log_datatype()
 {
     return log_datatype;
 }
+
+static rocblas_timing_options timing_options;
+
+void ArgumentModel_set_timing_options(const rocblas_timing_options& t)
+{
+    timing_options = t;
+}
+
+const rocblas_timing_options& ArgumentModel_get_timing_options()
+{
+    return timing_options;
+}
+
+// Per thread, since parallel_devices benchmarks run one thread per device
+static thread_local rocblas_timing_stats timing_stats;
+
+void ArgumentModel_set_timing_stats(const rocblas_timing_stats& s)
+{
+    timing_stats = s;
+}
+
+const rocblas_timing_stats& ArgumentModel_get_timing_stats()
+{
+    return timing_stats;
+}
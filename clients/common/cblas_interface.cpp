@@ -19,6 +19,7 @@
  * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  *
  * ************************************************************************/
+#include "blocked_gemm.hpp"
 #include "cblas_interface.hpp"
 #include "rocblas_vector.hpp"
 #include "utility.hpp"
@@ -696,35 +697,25 @@ void cblas_gemm<rocblas_bfloat16, float, float>(rocblas_operation
                                                 int64_t                              ldc,
                                                 rocblas_bfloat16::rocblas_truncate_t round)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
+    // cblas does not support rocblas_bfloat16, so compute in higher precision float
     // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    auto load = [](const auto& x) { return float(x); };
+
+    rocblas_blocked_gemm(transA != rocblas_operation_none,
+                         transB != rocblas_operation_none,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         B,
+                         ldb,
+                         beta,
+                         C,
+                         ldc,
+                         load,
+                         load);
 }
 
 template <>
@@ -744,41 +735,25 @@ void cblas_gemm<rocblas_bfloat16, rocblas_bfloat16, float>(
     int64_t                              ldc,
     rocblas_bfloat16::rocblas_truncate_t round)
 {
-    // cblas does not support rocblas_bfloat16, so convert to higher precision float
+    // cblas does not support rocblas_bfloat16, so compute in higher precision float
     // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = static_cast<float>(A[i]);
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = static_cast<float>(B[i]);
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = static_cast<float>(C[i]);
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = static_cast<rocblas_bfloat16>(C_float[i]);
+    auto load = [](const auto& x) { return float(x); };
+
+    rocblas_blocked_gemm(transA != rocblas_operation_none,
+                         transB != rocblas_operation_none,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         B,
+                         ldb,
+                         beta,
+                         C,
+                         ldc,
+                         load,
+                         load);
 }
 
 template <>
@@ -797,35 +772,25 @@ void cblas_gemm<rocblas_half, float, float>(rocblas_operation
                                             int64_t                              ldc,
                                             rocblas_bfloat16::rocblas_truncate_t round)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
+    // cblas does not support rocblas_half, so compute in higher precision float
     // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C,
-                ldc);
+    auto load = [](const auto& x) { return float(x); };
+
+    rocblas_blocked_gemm(transA != rocblas_operation_none,
+                         transB != rocblas_operation_none,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         B,
+                         ldb,
+                         beta,
+                         C,
+                         ldc,
+                         load,
+                         load);
 }
 
 template <>
@@ -844,53 +809,32 @@ void cblas_gemm<rocblas_half, rocblas_half, float>(rocblas_operation
                                                    int64_t                              ldc,
                                                    rocblas_bfloat16::rocblas_truncate_t round)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
+    // cblas does not support rocblas_half, so compute in higher precision float
     // This will give more precise result which is acceptable for testing
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
+    auto gemm = [&](auto load) {
+        rocblas_blocked_gemm(transA != rocblas_operation_none,
+                             transB != rocblas_operation_none,
+                             m,
+                             n,
+                             k,
+                             alpha,
+                             A,
+                             lda,
+                             B,
+                             ldb,
+                             beta,
+                             C,
+                             ldc,
+                             load,
+                             load);
+    };
+
+    // Inputs are rounded to rocblas_bfloat16 as they are converted, unless rounding is to
+    // nearest even
     if(round != rocblas_bfloat16::rocblas_truncate_t::rocblas_round_near_even)
-    {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = rocblas_bfloat16(float(A[i]), round);
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = rocblas_bfloat16(float(B[i]), round);
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = rocblas_bfloat16(float(C[i]), round);
-    }
+        gemm([round](rocblas_half x) { return float(rocblas_bfloat16(float(x), round)); });
     else
-    {
-        for(size_t i = 0; i < sizeA; i++)
-            A_float[i] = A[i];
-        for(size_t i = 0; i < sizeB; i++)
-            B_float[i] = B[i];
-        for(size_t i = 0; i < sizeC; i++)
-            C_float[i] = C[i];
-    }
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+        gemm([](rocblas_half x) { return float(x); });
 }
 
 template <>
@@ -910,43 +854,25 @@ void cblas_gemm<rocblas_half, rocblas_half, rocblas_half>(
     int64_t                              ldc,
     rocblas_bfloat16::rocblas_truncate_t round)
 {
-    // cblas does not support rocblas_half, so convert to higher precision float
+    // cblas does not support rocblas_half, so compute in higher precision float
     // This will give more precise result which is acceptable for testing
-    float alpha_float = alpha;
-    float beta_float  = beta;
-
-    size_t sizeA = (transA == rocblas_operation_none ? k : m) * size_t(lda);
-    size_t sizeB = (transB == rocblas_operation_none ? n : k) * size_t(ldb);
-    size_t sizeC = n * size_t(ldc);
-
-    host_vector<float> A_float(sizeA), B_float(sizeB), C_float(sizeC);
-
-    for(size_t i = 0; i < sizeA; i++)
-        A_float[i] = A[i];
-    for(size_t i = 0; i < sizeB; i++)
-        B_float[i] = B[i];
-    for(size_t i = 0; i < sizeC; i++)
-        C_float[i] = C[i];
-
-    // just directly cast, since transA, transB are integers in the enum
-    // printf("transA: rocblas =%d, cblas=%d\n", transA, static_cast<CBLAS_TRANSPOSE>(transA) );
-    cblas_sgemm(CblasColMajor,
-                static_cast<CBLAS_TRANSPOSE>(transA),
-                static_cast<CBLAS_TRANSPOSE>(transB),
-                m,
-                n,
-                k,
-                alpha_float,
-                A_float,
-                lda,
-                B_float,
-                ldb,
-                beta_float,
-                C_float,
-                ldc);
-
-    for(size_t i = 0; i < sizeC; i++)
-        C[i] = rocblas_half(C_float[i]);
+    auto load = [](const auto& x) { return float(x); };
+
+    rocblas_blocked_gemm(transA != rocblas_operation_none,
+                         transB != rocblas_operation_none,
+                         m,
+                         n,
+                         k,
+                         float(alpha),
+                         A,
+                         lda,
+                         B,
+                         ldb,
+                         float(beta),
+                         C,
+                         ldc,
+                         load,
+                         load);
 }
 
 template <>
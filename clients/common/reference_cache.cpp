@@ -0,0 +1,122 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "reference_cache.hpp"
+#include "rocblas_arguments.hpp"
+#include "rocblas_random.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// The cache is configured once from the environment; by default it is disabled
+static const rocblas_reference_cache& reference_cache()
+{
+    static const rocblas_reference_cache cache = [] {
+        const char* dir      = getenv("ROCBLAS_CLIENT_REFERENCE_CACHE");
+        const char* gb_limit = getenv("ROCBLAS_CLIENT_REFERENCE_CACHE_GB");
+        uint64_t    gb       = gb_limit ? strtoull(gb_limit, nullptr, 10) : 16;
+        return rocblas_reference_cache(dir ? dir : "", gb << 30);
+    }();
+    return cache;
+}
+
+// Fields which do not change host reference results: labels, timing and checking options, and
+// how the device computation is run
+static bool reference_independent(const char* field)
+{
+    for(const char* name : {"name",
+                            "category",
+                            "known_bug_platforms",
+                            "iters",
+                            "cold_iters",
+                            "os_flags",
+                            "gpu_arch",
+                            "threads",
+                            "streams",
+                            "devices",
+                            "norm_check",
+                            "unit_check",
+                            "timing",
+                            "pointer_mode_host",
+                            "pointer_mode_device",
+                            "HMM",
+                            "graph_test"})
+        if(!strcmp(field, name))
+            return true;
+    return false;
+}
+
+template <size_t N>
+static uint64_t hash_field(uint64_t hash, const char (&value)[N])
+{
+    return rocblas_reference_hash(value, strnlen(value, N), hash);
+}
+
+template <typename T>
+static uint64_t hash_field(uint64_t hash, const T& value)
+{
+    return rocblas_reference_hash(&value, sizeof(value), hash);
+}
+
+// Hash of the rocBLAS version, of the fields of arg which determine the reference results, and
+// of the seed the random data of the calling thread was initialized from
+static uint64_t reference_key(const Arguments& arg)
+{
+    size_t size;
+    rocblas_get_version_string_size(&size);
+    std::string version(size, '\0');
+    rocblas_get_version_string(&version[0], size);
+    uint64_t hash = rocblas_reference_hash(version.data(), version.size());
+
+#define HASH_FIELD(NAME)                                                     \
+    if(!reference_independent(#NAME))                                        \
+    {                                                                        \
+        hash = rocblas_reference_hash(#NAME, sizeof(#NAME), hash);           \
+        hash = hash_field(hash, arg.NAME);                                   \
+    }
+
+    FOR_EACH_ARGUMENT(HASH_FIELD, ;);
+
+#undef HASH_FIELD
+
+    return hash_field(hash, t_rocblas_rng.seed());
+}
+
+// Threads other than the main thread seed their random data from their thread id, which is not
+// the same from one run to the next, so their results are not cached
+static bool reference_cache_usable()
+{
+    return reference_cache().enabled() && std::this_thread::get_id() == g_main_thread_id;
+}
+
+bool rocblas_reference_cache_load(const Arguments& arg, const rocblas_reference_buffers& buffers)
+{
+    return reference_cache_usable() && reference_cache().load(reference_key(arg), buffers);
+}
+
+void rocblas_reference_cache_store(const Arguments& arg, const rocblas_reference_buffers& buffers)
+{
+    if(reference_cache_usable())
+        reference_cache().store(reference_key(arg), buffers);
+}
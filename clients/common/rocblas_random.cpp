@@ -35,98 +35,78 @@ std::thread::id g_main_thread_id = std::this_thread::get_id();
 // deterministically based on the thread id's hash function.
 thread_local rocblas_rng_t t_rocblas_rng = get_seed();
 
-thread_local int t_rocblas_rand_idx;
-
-// length to allow use as bitmask to wraparound
-#define RANDLEN 1024
-#define RANDWIN 256
-#define RANDBUF RANDLEN + RANDWIN
-static thread_local int    t_rand_init = 0;
-static thread_local float  t_rand_f_array[RANDBUF];
-static thread_local double t_rand_d_array[RANDBUF];
-
 /* ============================================================================================ */
 
 float rocblas_uniform_int_1_10()
 {
-    if(!t_rand_init)
-    {
-        for(int i = 0; i < RANDBUF; i++)
-        {
-            t_rand_f_array[i]
-                = (float)std::uniform_int_distribution<unsigned>(1, 10)(t_rocblas_rng);
-            t_rand_d_array[i] = (double)t_rand_f_array[i];
-        }
-        t_rand_init = 1;
-    }
-    t_rocblas_rand_idx = (t_rocblas_rand_idx + 1) & (RANDLEN - 1);
-    return t_rand_f_array[t_rocblas_rand_idx];
+    return float(rocblas_philox_uniform_int(t_rocblas_rng(), 1, 10));
 }
 
-inline int pseudo_rand_ptr_offset()
+// The loops only compute counter-based functions of the element index, so they vectorize, and
+// give the values random_generator<T>() draws after seeking to each element
+template <typename T>
+static void uniform_int_1_10_run(const rocblas_rng_stream& stream, T* ptr, size_t num, size_t first)
 {
-    t_rocblas_rand_idx = (t_rocblas_rand_idx + 1) & (RANDWIN - 1);
-    return t_rocblas_rand_idx;
-}
-
-void rocblas_uniform_int_1_10_run_float(float* ptr, size_t num)
-{
-    if(!t_rand_init)
-        rocblas_uniform_int_1_10();
-
-    for(size_t i = 0; i < num; i += RANDLEN)
+    const uint64_t seed = stream.seed();
+    const uint32_t id   = stream.id();
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for(size_t i = 0; i < num; i++)
     {
-        float* rptr = t_rand_f_array + pseudo_rand_ptr_offset();
-        size_t n    = i + RANDLEN < num ? RANDLEN : num - i;
-        memcpy(ptr, rptr, sizeof(float) * n);
-        ptr += RANDLEN;
+        auto draws = rocblas_philox_rng::first_draws(seed, id, first + i);
+        ptr[i]     = T(rocblas_philox_uniform_int(draws[0], 1, 10));
     }
 }
 
-void rocblas_uniform_int_1_10_run_double(double* ptr, size_t num)
+// Complex values are written as pairs of real values, the first and second draws of an element
+template <typename T>
+static void uniform_int_1_10_run_complex(const rocblas_rng_stream& stream,
+                                         T*                        ptr,
+                                         size_t                    num,
+                                         size_t                    first)
 {
-    if(!t_rand_init)
-        rocblas_uniform_int_1_10();
-
-    for(size_t i = 0; i < num; i += RANDLEN)
+    const uint64_t seed = stream.seed();
+    const uint32_t id   = stream.id();
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for(size_t i = 0; i < num; i++)
     {
-        double* rptr = t_rand_d_array + pseudo_rand_ptr_offset();
-        size_t  n    = i + RANDLEN < num ? RANDLEN : num - i;
-        memcpy(ptr, rptr, sizeof(double) * n);
-        ptr += RANDLEN;
+        auto draws     = rocblas_philox_rng::first_draws(seed, id, first + i);
+        ptr[2 * i]     = T(rocblas_philox_uniform_int(draws[0], 1, 10));
+        ptr[2 * i + 1] = T(rocblas_philox_uniform_int(draws[1], 1, 10));
     }
 }
 
-void rocblas_uniform_int_1_10_run_float_complex(rocblas_float_complex* ptr, size_t num)
+void rocblas_uniform_int_1_10_run_float(const rocblas_rng_stream& stream,
+                                        float*                    ptr,
+                                        size_t                    num,
+                                        size_t                    first)
 {
-    if(!t_rand_init)
-        rocblas_uniform_int_1_10();
-
-    constexpr int rand_len = RANDLEN / 2;
-    for(size_t i = 0; i < num; i += rand_len)
-    {
-        float* rptr = t_rand_f_array + pseudo_rand_ptr_offset();
-        size_t n    = i + rand_len < num ? rand_len : num - i;
-        memcpy(ptr, rptr, sizeof(float) * 2 * n);
-        ptr += rand_len;
-    }
+    uniform_int_1_10_run(stream, ptr, num, first);
 }
 
-void rocblas_uniform_int_1_10_run_double_complex(rocblas_double_complex* ptr, size_t num)
+void rocblas_uniform_int_1_10_run_double(const rocblas_rng_stream& stream,
+                                         double*                   ptr,
+                                         size_t                    num,
+                                         size_t                    first)
 {
-    if(!t_rand_init)
-        rocblas_uniform_int_1_10();
+    uniform_int_1_10_run(stream, ptr, num, first);
+}
 
-    constexpr int rand_len = RANDLEN / 2;
-    for(size_t i = 0; i < num; i += rand_len)
-    {
-        double* rptr = t_rand_d_array + pseudo_rand_ptr_offset();
-        size_t  n    = i + rand_len < num ? rand_len : num - i;
-        memcpy(ptr, rptr, sizeof(double) * 2 * n);
-        ptr += rand_len;
-    }
+void rocblas_uniform_int_1_10_run_float_complex(const rocblas_rng_stream& stream,
+                                                rocblas_float_complex*    ptr,
+                                                size_t                    num,
+                                                size_t                    first)
+{
+    uniform_int_1_10_run_complex(stream, reinterpret_cast<float*>(ptr), num, first);
 }
 
-#undef RANDLEN
-#undef RANDWIN
-#undef RANDBUF
+void rocblas_uniform_int_1_10_run_double_complex(const rocblas_rng_stream& stream,
+                                                 rocblas_double_complex*   ptr,
+                                                 size_t                    num,
+                                                 size_t                    first)
+{
+    uniform_int_1_10_run_complex(stream, reinterpret_cast<double*>(ptr), num, first);
+}
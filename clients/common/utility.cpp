@@ -28,6 +28,7 @@
 #include "../../library/src/include/handle.hpp"
 #include "d_vector.hpp"
 #include "utility.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
@@ -189,6 +190,100 @@ double get_time_us_no_sync(void)
     return (static_cast<double>(duration));
 };
 
+/* ============================================================================================ */
+/*  cache-cold benchmarking */
+static size_t rotating_bytes = 0;
+static bool   rotating_flush = false;
+
+void rocblas_set_rotating(size_t bytes, bool flush)
+{
+    rotating_bytes = bytes;
+    rotating_flush = flush;
+}
+
+size_t rocblas_get_rotating_bytes()
+{
+    return rotating_bytes;
+}
+
+size_t rocblas_get_flush_bytes()
+{
+    return rotating_flush ? rotating_bytes : 0;
+}
+
+size_t rocblas_rotating_sets(size_t operand_bytes)
+{
+    if(rotating_flush || !rotating_bytes || !operand_bytes)
+        return 1;
+
+    // The operands of the calls between two uses of a set must not fit in the cache, so the
+    // other sets take floor(rotating_bytes / operand_bytes) + 1 times operand_bytes
+    size_t sets = rotating_bytes / operand_bytes + 2;
+    if(sets > rocblas_rotating_max_sets)
+    {
+        rocblas_cerr << "rocblas-bench WARNING: --rotating needs " << sets
+                     << " sets of operands of " << operand_bytes << " bytes, but only "
+                     << rocblas_rotating_max_sets
+                     << " are used, so operands may stay in the cache between their uses"
+                     << std::endl;
+        sets = rocblas_rotating_max_sets;
+    }
+    return sets;
+}
+
+/* ============================================================================================ */
+/*  events which time individual hot calls of a benchmark */
+rocblas_timing_events::rocblas_timing_events(hipStream_t stream, int iters, size_t flush_bytes)
+    : m_stream(stream)
+    , m_start(iters)
+    , m_stop(iters)
+{
+    for(auto& event : m_start)
+        CHECK_HIP_ERROR(hipEventCreate(&event));
+    for(auto& event : m_stop)
+        CHECK_HIP_ERROR(hipEventCreate(&event));
+
+    if(flush_bytes)
+    {
+        CHECK_DEVICE_ALLOCATION((hipMalloc)(&m_flush, flush_bytes));
+        m_flush_bytes = flush_bytes;
+    }
+}
+
+rocblas_timing_events::~rocblas_timing_events()
+{
+    for(auto& event : m_start)
+        hipEventDestroy(event);
+    for(auto& event : m_stop)
+        hipEventDestroy(event);
+    if(m_flush)
+        (hipFree)(m_flush);
+}
+
+void rocblas_timing_events::start(int i)
+{
+    // Writing a buffer larger than the caches evicts the operands of the previous calls
+    if(m_flush)
+        CHECK_HIP_ERROR(hipMemsetAsync(m_flush, i & 0xff, m_flush_bytes, m_stream));
+    CHECK_HIP_ERROR(hipEventRecord(m_start[i], m_stream));
+}
+
+void rocblas_timing_events::stop(int i)
+{
+    CHECK_HIP_ERROR(hipEventRecord(m_stop[i], m_stream));
+}
+
+void rocblas_timing_events::append_us(std::vector<double>& samples)
+{
+    CHECK_HIP_ERROR(hipEventSynchronize(m_stop.back()));
+    for(size_t i = 0; i < m_start.size(); i++)
+    {
+        float ms;
+        CHECK_HIP_ERROR(hipEventElapsedTime(&ms, m_start[i], m_stop[i]));
+        samples.push_back(ms * 1000.0);
+    }
+}
+
 /* ============================================================================================ */
 /*  device query and print out their ID and name; return number of compute-capable devices. */
 rocblas_int query_device_property()
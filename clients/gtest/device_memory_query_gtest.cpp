@@ -0,0 +1,117 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstring>
+
+namespace
+{
+    template <typename...>
+    struct testing_device_memory_query : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            size_t         count = 0, size;
+            rocblas_handle handle;
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+
+            // The breakdown is only available once the query is stopped
+            CHECK_ROCBLAS_ERROR(rocblas_start_device_memory_size_query(handle));
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_device_memory_query_breakdown(handle, &count, nullptr),
+                rocblas_status_size_query_mismatch);
+
+            // Each call which requests device memory is recorded under its API name
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_sdot(handle, 100000, nullptr, 1, nullptr, 1, nullptr),
+                rocblas_status_size_increased);
+            EXPECT_ROCBLAS_STATUS(rocblas_sdot(handle, 1000, nullptr, 1, nullptr, 1, nullptr),
+                                  rocblas_status_size_unchanged);
+            CHECK_ROCBLAS_ERROR(rocblas_stop_device_memory_size_query(handle, &size));
+
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_get_device_memory_query_breakdown(handle, nullptr, nullptr),
+                rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_query_breakdown(handle, &count, nullptr));
+            ASSERT_EQ(count, 2u);
+
+            // At most the input count of records are copied
+            rocblas_device_memory_query_entry entries[2];
+            count = 1;
+            CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_query_breakdown(handle, &count, entries));
+            EXPECT_EQ(count, 2u);
+            EXPECT_EQ(entries[0].total, size);
+            EXPECT_EQ(entries[0].num_sizes, 1u);
+            EXPECT_LE(entries[0].sizes[0], entries[0].total);
+            EXPECT_STREQ(entries[0].function, "rocblas_sdot");
+
+            CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_query_breakdown(handle, &count, entries));
+            EXPECT_LE(entries[1].total, entries[0].total);
+            EXPECT_STREQ(entries[1].function, "rocblas_sdot");
+
+            // Sizes set by other libraries are recorded under the setter's name
+            CHECK_ROCBLAS_ERROR(rocblas_start_device_memory_size_query(handle));
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_set_optimal_device_memory_size_impl(handle, 1, size_t(1024)),
+                rocblas_status_size_increased);
+            CHECK_ROCBLAS_ERROR(rocblas_stop_device_memory_size_query(handle, &size));
+            count = 2;
+            CHECK_ROCBLAS_ERROR(rocblas_get_device_memory_query_breakdown(handle, &count, entries));
+            ASSERT_EQ(count, 1u);
+            EXPECT_STREQ(entries[0].function, "rocblas_set_optimal_device_memory_size");
+
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(handle));
+        }
+    };
+
+    struct device_memory_query : RocBLAS_Test<device_memory_query, testing_device_memory_query>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "device_memory_query");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<device_memory_query>(arg.name);
+        }
+    };
+
+    TEST_P(device_memory_query, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_device_memory_query<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(device_memory_query)
+
+} // namespace
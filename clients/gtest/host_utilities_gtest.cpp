@@ -0,0 +1,1859 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../library/src/include/binary_log.hpp"
+#include "../../library/src/include/check_numerics_range.hpp"
+#include "../../library/src/include/check_numerics_ring.hpp"
+#include "../../library/src/include/chrome_trace.hpp"
+#include "../../library/src/include/gemm_coverage.hpp"
+#include "../../library/src/include/latency_histogram.hpp"
+#include "../../library/src/include/level2_variants.hpp"
+#include "../../library/src/include/log_sampler.hpp"
+#include "../../library/src/include/sharded_profile.hpp"
+#include "../../library/src/include/staging_pool.hpp"
+#include "../../library/src/include/strided_pack.hpp"
+#include "../../library/src/include/trsm_block_tables.hpp"
+#include "blocked_gemm.hpp"
+#include "gemm_bench_log.hpp"
+#include "reference_cache.hpp"
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_philox.hpp"
+#include "rocblas_test.hpp"
+#include "timing_stats.hpp"
+#include "utility.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template <typename...>
+    struct testing_binary_log : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // Arguments render in the text formats of log_trace and log_bench
+            rocblas_binary_log_record record;
+            record.begin(rocblas_binary_log_kind_trace, 0);
+            record.put_string("rocblas_zaxpy");
+            record.put_int(-100);
+            record.put_complex(1.5, -2);
+            record.put_pointer(nullptr);
+            record.put_uint(1);
+            record.put_char('T');
+            record.put_real(0.25);
+            EXPECT_EQ(record.nargs, 7u);
+            EXPECT_EQ(record.render(), "rocblas_zaxpy,-100,(1.5,-2),0,1,T,0.25");
+
+            record.begin(rocblas_binary_log_kind_bench, 0);
+            record.put_string("./rocblas-bench -f axpy -r");
+            record.put_string(std::string("f32_r").c_str());
+            record.put_string("--alpha 2");
+            EXPECT_EQ(record.render(), "./rocblas-bench -f axpy -r f32_r --alpha 2");
+
+            // Symbols and scalars are rendered by the decoder
+            rocblas_binary_log_symbols symbols{{0, "rocblas_caxpy"}, {1, "alpha"}};
+            float                      c[2]    = {1.5f, -2};
+            uint16_t                   half    = 0x3e00; // 1.5
+            double                     d       = 0.125;
+            record.begin(rocblas_binary_log_kind_trace, 0);
+            record.put_symbol(0);
+            record.put_scalar(rocblas_binary_log_scalar_float_complex, c);
+            record.put_scalar(rocblas_binary_log_scalar_half, &half);
+            record.put_scalar(rocblas_binary_log_scalar_double, nullptr);
+            record.put_symbol(7);
+            EXPECT_EQ(record.render(symbols), "rocblas_caxpy,(1.5,-2),1.5,nan,<symbol 7>");
+
+            record.begin(rocblas_binary_log_kind_bench, 0);
+            record.put_bench_scalar(1, rocblas_binary_log_scalar_float_complex, c);
+            record.put_bench_scalar(1, rocblas_binary_log_scalar_double, &d);
+            record.put_bench_scalar(1, rocblas_binary_log_scalar_float_complex, nullptr);
+            EXPECT_EQ(record.render(symbols),
+                      "--alpha 1.5 --alphai -2 --alpha 0.125 --alpha nan");
+
+            // Arguments which do not fit are omitted and the record is marked truncated
+            record.begin(rocblas_binary_log_kind_trace, 0);
+            std::string long_string(200, 'x');
+            for(int i = 0; i < 3; ++i)
+                record.put_string(long_string.c_str());
+            EXPECT_EQ(record.nargs, 2u);
+            EXPECT_TRUE(record.truncated);
+            record.put_char('N');
+            EXPECT_EQ(record.nargs, 2u);
+
+            // A full ring drops records instead of blocking
+            rocblas_binary_log_ring ring(0);
+            for(size_t i = 0; i < rocblas_binary_log_ring::CAPACITY; ++i)
+            {
+                ASSERT_NE(ring.reserve(), nullptr);
+                ring.commit();
+            }
+            EXPECT_EQ(ring.reserve(), nullptr);
+            EXPECT_EQ(ring.reserve(), nullptr);
+            EXPECT_EQ(ring.take_dropped(), 2u);
+            EXPECT_EQ(ring.take_dropped(), 0u);
+            EXPECT_EQ(ring.drain([](auto&) {}), rocblas_binary_log_ring::CAPACITY);
+            EXPECT_TRUE(ring.empty());
+            EXPECT_NE(ring.reserve(), nullptr);
+
+            // Records from several threads round trip through the log file
+            std::string            path   = rocblas_tempname();
+            rocblas_binary_logger& logger = rocblas_binary_logger::instance();
+            ASSERT_TRUE(logger.open(path.c_str()));
+            EXPECT_TRUE(logger.is_open());
+
+            constexpr int threads = 4, calls = 100;
+            auto          log_calls = [&](int t) {
+                for(int i = 0; i < calls; ++i)
+                {
+                    logger.log(rocblas_binary_log_kind_trace, [&](auto& r) {
+                        r.put_symbol(logger.intern("rocblas_sscal"));
+                        r.put_int(t);
+                        r.put_int(i);
+                    });
+                    logger.log(rocblas_binary_log_kind_bench, [&](auto& r) {
+                        r.put_string("./rocblas-bench -f scal -r f32_r -n");
+                        r.put_int(t * calls + i);
+                    });
+                }
+            };
+            std::vector<std::thread> workers;
+            for(int t = 0; t < threads; ++t)
+                workers.emplace_back(log_calls, t);
+            for(auto& w : workers)
+                w.join();
+            logger.close();
+            EXPECT_FALSE(logger.is_open());
+
+            std::ostringstream trace, bench;
+            size_t             dropped = 0;
+            {
+                std::ifstream in(path, std::ios::binary);
+                EXPECT_TRUE(rocblas_binary_log_decode(
+                    in, trace, 1u << rocblas_binary_log_kind_trace, false, &dropped));
+            }
+            {
+                std::ifstream in(path, std::ios::binary);
+                EXPECT_TRUE(
+                    rocblas_binary_log_decode(in, bench, 1u << rocblas_binary_log_kind_bench));
+            }
+            remove(path.c_str());
+            EXPECT_EQ(dropped, 0u);
+
+            // Each thread's calls appear in order
+            std::istringstream trace_lines(trace.str());
+            std::string        line;
+            int                next[threads] = {};
+            size_t             lines         = 0;
+            while(std::getline(trace_lines, line))
+            {
+                int t = -1, i = -1;
+                ASSERT_EQ(sscanf(line.c_str(), "rocblas_sscal,%d,%d", &t, &i), 2);
+                ASSERT_TRUE(t >= 0 && t < threads);
+                EXPECT_EQ(i, next[t]++);
+                ++lines;
+            }
+            EXPECT_EQ(lines, size_t(threads * calls));
+            EXPECT_NE(bench.str().find("./rocblas-bench -f scal -r f32_r -n 399\n"),
+                      std::string::npos);
+
+            // Records are decoded in time order, whatever order they were written in
+            {
+                std::ostringstream file;
+                rocblas_binary_log_header header{};
+                memcpy(header.magic, rocblas_binary_log_header::MAGIC, sizeof(header.magic));
+                header.version     = rocblas_binary_log_header::VERSION;
+                header.record_size = rocblas_binary_log_record::SIZE;
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                for(uint64_t t : {2, 1})
+                {
+                    record.begin(rocblas_binary_log_kind_trace, 0);
+                    record.timestamp = t;
+                    record.put_uint(t);
+                    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+                }
+                std::istringstream in(file.str());
+                std::ostringstream out;
+                EXPECT_TRUE(rocblas_binary_log_decode(in, out));
+                EXPECT_EQ(out.str(), "1\n2\n");
+            }
+
+            // Input which is not a binary log is rejected
+            std::istringstream text("rocblas_sscal,1,2\n");
+            EXPECT_FALSE(rocblas_binary_log_decode(text, trace));
+        }
+    };
+
+    // Compares rocblas_blocked_gemm with a naive product of small integers, which is exact
+    void check_blocked_gemm(bool    transA,
+                            bool    transB,
+                            int64_t m,
+                            int64_t n,
+                            int64_t k,
+                            float   alpha,
+                            float   beta,
+                            float   scale)
+    {
+        const int64_t lda = (transA ? k : m) + 1;
+        const int64_t ldb = (transB ? n : k) + 2;
+        const int64_t ldc = m + 3;
+
+        std::vector<int> A(lda * (transA ? m : k)), B(ldb * (transB ? k : n));
+        std::vector<float> C(ldc * n);
+        for(size_t i = 0; i < A.size(); i++)
+            A[i] = int(i * 7 % 9) - 4;
+        for(size_t i = 0; i < B.size(); i++)
+            B[i] = int(i * 5 % 7) - 3;
+        for(size_t i = 0; i < C.size(); i++)
+            C[i] = beta == 0 ? std::numeric_limits<float>::quiet_NaN() : float(int(i % 5) - 2);
+
+        std::vector<float> C_gold = C;
+        for(int64_t j = 0; j < n; j++)
+            for(int64_t i = 0; i < m; i++)
+            {
+                double sum = 0;
+                for(int64_t p = 0; p < k; p++)
+                    sum += double(scale * A[transA ? p + i * lda : i + p * lda])
+                           * (scale * B[transB ? j + p * ldb : p + j * ldb]);
+                double c = beta == 0 ? 0 : beta * double(scale * C[i + j * ldc]);
+                C_gold[i + j * ldc] = float(alpha * sum + c);
+            }
+
+        // Inputs and C are scaled by the conversions, which must be applied to every element
+        auto load   = [scale](int x) { return scale * x; };
+        auto load_c = [scale](float x) { return scale * x; };
+        rocblas_blocked_gemm(transA,
+                             transB,
+                             m,
+                             n,
+                             k,
+                             alpha,
+                             A.data(),
+                             lda,
+                             B.data(),
+                             ldb,
+                             beta,
+                             C.data(),
+                             ldc,
+                             load,
+                             load_c);
+
+        int64_t errors = 0;
+        for(int64_t j = 0; j < n; j++)
+            for(int64_t i = 0; i < m; i++)
+                errors += !(C[i + j * ldc] == C_gold[i + j * ldc]);
+        EXPECT_EQ(errors, 0) << "transA " << transA << " transB " << transB << " m " << m
+                             << " n " << n << " k " << k << " alpha " << alpha << " beta "
+                             << beta;
+
+        // Elements between columns are not written
+        for(int64_t j = 0; j < n; j++)
+            for(int64_t i = m; i < ldc && j * ldc + i < int64_t(C.size()); i++)
+                EXPECT_TRUE(C[i + j * ldc] == C_gold[i + j * ldc] || std::isnan(C[i + j * ldc]));
+    }
+
+    template <typename...>
+    struct testing_blocked_gemm : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            const int64_t mr = rocblas_blocked_gemm_mr, mc = rocblas_blocked_gemm_mc;
+            const int64_t nr = rocblas_blocked_gemm_nr, nc = rocblas_blocked_gemm_nc;
+            const int64_t kc = rocblas_blocked_gemm_kc;
+
+            // Sizes around the register tile and cache blocks of each dimension
+            for(int transA = 0; transA < 2; transA++)
+                for(int transB = 0; transB < 2; transB++)
+                    for(int64_t m : {int64_t(1), mr - 1, mr + 1, mc + 3})
+                        for(int64_t n : {int64_t(1), nr + 1, nc + 1})
+                            for(int64_t k : {int64_t(1), int64_t(3), kc + 5})
+                                check_blocked_gemm(transA, transB, m, n, k, 1, 0, 1);
+
+            // beta == 0 does not read C, alpha == 0 and k == 0 only scale C
+            check_blocked_gemm(false, true, mc + 3, nc + 1, 7, -2, 0, 1);
+            check_blocked_gemm(true, false, mc + 3, nc + 1, 7, 0, 0.5f, 1);
+            check_blocked_gemm(false, false, mc + 3, nc + 1, 0, 2, -1, 1);
+            check_blocked_gemm(true, true, mc + 3, nc + 1, kc + 5, 0.5f, 2, 0.5f);
+
+            // Empty products do not touch C
+            float  c    = 1;
+            float* p    = &c;
+            auto   load = [](float x) { return x; };
+            rocblas_blocked_gemm(false, false, 0, 1, 1, 1.f, p, 1, p, 1, 0.f, p, 1, load, load);
+            rocblas_blocked_gemm(false, false, 1, 0, 1, 1.f, p, 1, p, 1, 0.f, p, 1, load, load);
+            EXPECT_EQ(c, 1);
+        }
+    };
+
+    rocblas_check_numerics_range_t make_record(const std::vector<double>& values)
+    {
+        rocblas_check_numerics_range_t record{};
+        for(double value : values)
+            rocblas_check_numerics_range_add(record, value);
+        return record;
+    }
+
+    template <typename...>
+    struct testing_check_numerics_range : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            constexpr int MIN  = ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN;
+            constexpr int BINS = ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS;
+
+            // Exponents outside the histogram are counted by its first and last bins;
+            // the range covers the denormals of float and its largest exponent
+            EXPECT_EQ(rocblas_check_numerics_exponent_bin(MIN), 0);
+            EXPECT_EQ(rocblas_check_numerics_exponent_bin(MIN - 100), 0);
+            EXPECT_EQ(rocblas_check_numerics_exponent_bin(0), -MIN);
+            EXPECT_EQ(rocblas_check_numerics_exponent_bin(MIN + BINS - 1), BINS - 1);
+            EXPECT_EQ(rocblas_check_numerics_exponent_bin(1023), BINS - 1);
+            EXPECT_LE(MIN, -149);
+            EXPECT_GE(MIN + BINS - 1, 127);
+
+            // An empty record has no magnitudes
+            auto empty = rocblas_check_numerics_range_summary(
+                "rocblas_hgemm", true, rocblas_check_numerics_range_t{});
+            EXPECT_EQ(empty.checks, 1u);
+            EXPECT_EQ(empty.nonzeros, 0u);
+            EXPECT_EQ(empty.abs_max, 0.0);
+            EXPECT_EQ(empty.min_nonzero, 0.0);
+
+            // Extremes of half precision, signs, zeros and non-finite values
+            double inf    = std::numeric_limits<double>::infinity();
+            double nan    = std::numeric_limits<double>::quiet_NaN();
+            auto   record = make_record({65504.0, -std::ldexp(1.0, -24), 0.0, -0.0, 1.5, -3.0, inf,
+                                         -inf, nan, 0.75});
+            auto   range  = rocblas_check_numerics_range_summary("rocblas_hgemm", true, record);
+            EXPECT_EQ(range.nonzeros, 5u);
+            EXPECT_EQ(range.zeros, 2u);
+            EXPECT_EQ(range.non_finite, 3u);
+            EXPECT_EQ(range.abs_max, 65504.0);
+            EXPECT_EQ(range.min_nonzero, std::ldexp(1.0, -24));
+            EXPECT_EQ(range.exponent_histogram[15 - MIN], 1u);
+            EXPECT_EQ(range.exponent_histogram[-24 - MIN], 1u);
+            EXPECT_EQ(range.exponent_histogram[0 - MIN], 1u);
+            EXPECT_EQ(range.exponent_histogram[1 - MIN], 1u);
+            EXPECT_EQ(range.exponent_histogram[-1 - MIN], 1u);
+
+            uint64_t total = 0;
+            for(int i = 0; i < BINS; i++)
+                total += range.exponent_histogram[i];
+            EXPECT_EQ(total, range.nonzeros);
+
+            // Magnitudes beyond the histogram keep their exact values
+            auto wide = rocblas_check_numerics_range_summary(
+                "rocblas_dgemm", false, make_record({1e300, 1e-310}));
+            EXPECT_EQ(wide.abs_max, 1e300);
+            EXPECT_EQ(wide.min_nonzero, 1e-310);
+            EXPECT_EQ(wide.exponent_histogram[0], 1u);
+            EXPECT_EQ(wide.exponent_histogram[BINS - 1], 1u);
+
+            // Merging takes the extremes over the summaries which have nonzero values
+            auto merged = empty;
+            rocblas_check_numerics_range_merge(merged, range);
+            rocblas_check_numerics_range_merge(
+                merged,
+                rocblas_check_numerics_range_summary(
+                    "rocblas_hgemm", true, make_record({0.0, 1e-30, 2.0})));
+            EXPECT_EQ(merged.checks, 3u);
+            EXPECT_EQ(merged.nonzeros, 7u);
+            EXPECT_EQ(merged.zeros, 3u);
+            EXPECT_EQ(merged.non_finite, 3u);
+            EXPECT_EQ(merged.abs_max, 65504.0);
+            EXPECT_EQ(merged.min_nonzero, 1e-30);
+            EXPECT_EQ(merged.exponent_histogram[1 - MIN], 2u);
+
+            // The table accumulates per function and argument kind, in first-added order
+            rocblas_check_numerics_range_table table;
+            table.add(range);
+            table.add(wide);
+            table.add(rocblas_check_numerics_range_summary(
+                "rocblas_hgemm", false, make_record({4.0})));
+            table.add(rocblas_check_numerics_range_summary(
+                "rocblas_hgemm", true, make_record({131072.0})));
+            EXPECT_EQ(table.size(), 3u);
+
+            size_t count = 0;
+            table.get(nullptr, &count);
+            EXPECT_EQ(count, 3u);
+
+            std::vector<rocblas_check_numerics_range> ranges(4);
+            count = ranges.size();
+            table.get(ranges.data(), &count);
+            EXPECT_EQ(count, 3u);
+            EXPECT_EQ(std::string(ranges[0].function_name), "rocblas_hgemm");
+            EXPECT_EQ(ranges[0].is_input, 1);
+            EXPECT_EQ(ranges[0].checks, 2u);
+            EXPECT_EQ(ranges[0].abs_max, 131072.0);
+            EXPECT_EQ(std::string(ranges[1].function_name), "rocblas_dgemm");
+            EXPECT_EQ(ranges[2].is_input, 0);
+            EXPECT_EQ(ranges[2].abs_max, 4.0);
+
+            count = 1;
+            table.get(ranges.data(), &count);
+            EXPECT_EQ(count, 1u);
+
+            table.clear();
+            table.get(nullptr, &count);
+            EXPECT_EQ(count, 0u);
+
+            EXPECT_EQ(rocblas_check_numerics_range_message(rocblas_check_numerics_range_summary(
+                          "rocblas_sscal", false, make_record({0.0, 0.5, 0.75, 3.0, nan}))),
+                      std::string("Funtion name:\trocblas_sscal :- Output :\t nonzeros 3 zeros 1"
+                                  " non_finite 1 abs_max 3 min_nonzero 0.5 exponents -1:2 1:1"));
+        }
+    };
+
+    template <typename...>
+    struct testing_check_numerics_ring : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            EXPECT_EQ(rocblas_check_numerics_ring().capacity(),
+                      rocblas_check_numerics_ring::DEFAULT_CAPACITY);
+            EXPECT_EQ(rocblas_check_numerics_ring(0).capacity(), 1u);
+
+            rocblas_check_numerics_ring ring(4);
+            EXPECT_EQ(ring.pending(), 0u);
+            EXPECT_FALSE(ring.full());
+
+            // Each check keeps the number of its call and its stream; a call whose output
+            // check is skipped does not merge with the next call
+            int streams[2];
+            EXPECT_EQ(ring.push("rocblas_saxpy", 1, true, &streams[0]), 0u);
+            EXPECT_EQ(ring.push("rocblas_saxpy", 1, true, &streams[0]), 1u);
+            EXPECT_EQ(ring.push("rocblas_saxpy", 2, true, &streams[0]), 2u);
+            EXPECT_EQ(ring.back().call_id, 2u);
+            EXPECT_EQ(ring.push("rocblas_sscal", 3, true, &streams[1]), 3u);
+            EXPECT_TRUE(ring.full());
+            EXPECT_EQ(ring.front().stream, &streams[0]);
+            EXPECT_EQ(ring.back().slot, 3u);
+            EXPECT_EQ(ring.back().call_id, 3u);
+            EXPECT_EQ(ring.back().stream, &streams[1]);
+            EXPECT_TRUE(ring.back().is_input);
+            EXPECT_EQ(ring.back().event, nullptr);
+
+            // Collecting stops at the first check whose record is not ready
+            std::vector<size_t> slots;
+            EXPECT_EQ(ring.collect([&](rocblas_check_numerics_ring::entry& e) {
+                if(e.slot == 2)
+                    return false;
+                slots.push_back(e.slot);
+                return true;
+            }),
+                      2u);
+            EXPECT_EQ(slots, (std::vector<size_t>{0, 1}));
+            EXPECT_EQ(ring.pending(), 2u);
+            EXPECT_EQ(ring.front().slot, 2u);
+            EXPECT_FALSE(ring.collect([](rocblas_check_numerics_ring::entry&) { return false; }));
+
+            // Slots wrap around, and a check which could not be issued releases its slot
+            EXPECT_EQ(ring.push("rocblas_sscal", 3, false, &streams[1]), 0u);
+            ring.pop_back();
+            EXPECT_EQ(ring.pending(), 2u);
+            EXPECT_EQ(ring.push("rocblas_sscal", 3, false, &streams[1]), 0u);
+            EXPECT_EQ(ring.push("rocblas_sdot", 4, true, &streams[1]), 1u);
+            EXPECT_EQ(ring.back().call_id, 4u);
+            EXPECT_TRUE(ring.full());
+
+            // Slots in flight are never handed out twice
+            slots.clear();
+            ring.collect([&](rocblas_check_numerics_ring::entry& e) {
+                slots.push_back(e.slot);
+                return true;
+            });
+            EXPECT_EQ(slots, (std::vector<size_t>{2, 3, 0, 1}));
+            EXPECT_EQ(ring.pending(), 0u);
+
+            EXPECT_EQ(rocblas_check_numerics_message("rocblas_sdot", 3, true, 1, 0, 0, 1),
+                      std::string("Funtion name:\trocblas_sdot (call 3) :- Input :\t"
+                                  " has_NaN 1 has_zero 0 has_Inf 0 has_denorm 1"));
+            EXPECT_EQ(rocblas_check_numerics_message("rocblas_sdot", 4, false, 0, 1, 1, 0),
+                      std::string("Funtion name:\trocblas_sdot (call 4) :- Output :\t"
+                                  " has_NaN 0 has_zero 1 has_Inf 1 has_denorm 0"));
+        }
+    };
+
+    template <typename...>
+    struct testing_chrome_trace : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            using event_t = rocblas_chrome_trace_event;
+
+            // Strings are quoted, with JSON escapes for quotes, backslashes and
+            // control characters
+            std::string s;
+            event_t::escape(s, "plain");
+            EXPECT_EQ(s, "\"plain\"");
+            s.clear();
+            event_t::escape(s, "a\"b\\c\nd\te\x01");
+            EXPECT_EQ(s, "\"a\\\"b\\\\c\\nd\\te\\u0001\"");
+
+            // A complete event with its arguments, followed by a separator
+            event_t event;
+            event.name   = "rocblas_sgemm";
+            event.ts     = 1000.5;
+            event.dur    = 12.25;
+            event.pid    = 42;
+            event.tid    = 7;
+            event.stream = "0x1234";
+            event.args   = {"N", "T", "128", "1", "0x7f00"};
+            std::string json;
+            event.write(json);
+            EXPECT_EQ(json,
+                      "{\"name\":\"rocblas_sgemm\",\"cat\":\"rocblas\",\"ph\":\"X\","
+                      "\"ts\":1000.500,\"dur\":12.250,\"pid\":42,\"tid\":7,"
+                      "\"args\":{\"stream\":\"0x1234\","
+                      "\"arguments\":[\"N\",\"T\",\"128\",\"1\",\"0x7f00\"]}},");
+
+            // Events are appended, and a negative duration is clamped to zero
+            event.args.clear();
+            event.dur = -1;
+            event.write(json);
+            EXPECT_NE(json.find("\"dur\":0.000,"), std::string::npos);
+            std::string tail = "\"arguments\":[]}},";
+            EXPECT_EQ(json.substr(json.size() - tail.size()), tail);
+            EXPECT_EQ(std::string(event_t::HEADER) + "\n", "[\n");
+
+            // The array is closed by a metadata event with no separator
+            std::string footer = event_t::footer();
+            EXPECT_EQ(footer.substr(0, 38), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":");
+            EXPECT_NE(footer.find(std::to_string(event_t::process_id())), std::string::npos);
+            EXPECT_EQ(footer.substr(footer.size() - 3), "}}]");
+
+            // The clock is monotonic, and thread IDs distinguish threads
+            double t0 = event_t::now();
+            double t1 = event_t::now();
+            EXPECT_LE(t0, t1);
+            EXPECT_EQ(event_t::thread_id(), event_t::thread_id());
+            uint64_t other = 0;
+            std::thread([&] { other = event_t::thread_id(); }).join();
+            EXPECT_NE(other, event_t::thread_id());
+            EXPECT_NE(event_t::process_id(), 0u);
+        }
+    };
+
+    template <typename...>
+    struct testing_gemm_bench_log : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // A line as written by gemm_ex
+            rocblas_gemm_bench_call call;
+            EXPECT_EQ(rocblas_gemm_bench_parse(
+                          "./rocblas-bench -f gemm_ex --transposeA N --transposeB T -m 1024 -n 512 "
+                          "-k 256 --alpha 2 --a_type f16_r --lda 1024 --b_type f16_r --ldb 600 "
+                          "--beta 0 --c_type f16_r --ldc 1100 --d_type f16_r --ldd 1200 "
+                          "--compute_type f32_r --algo 0 --solution_index 0 --flags 4",
+                          call),
+                      1);
+            EXPECT_EQ(call.function, "gemm_ex");
+            EXPECT_EQ(call.transA, 'N');
+            EXPECT_EQ(call.transB, 'T');
+            EXPECT_EQ(call.M, 1024);
+            EXPECT_EQ(call.N, 512);
+            EXPECT_EQ(call.K, 256);
+            EXPECT_EQ(call.alpha, 2);
+            EXPECT_EQ(call.beta, 0);
+            EXPECT_EQ(call.a_type, "f16_r");
+            EXPECT_EQ(call.d_type, "f16_r");
+            EXPECT_EQ(call.compute_type, "f32_r");
+            EXPECT_EQ(call.ldb, 600);
+            EXPECT_EQ(call.ldc, 1100);
+            EXPECT_EQ(call.ldd, 1200);
+            EXPECT_EQ(call.flags, 4u);
+            EXPECT_EQ(call.batch_count, 1);
+            EXPECT_FALSE(call.batched());
+
+            // gemm takes its types from the precision, and has no ldd or flags
+            EXPECT_EQ(rocblas_gemm_bench_parse("./rocblas-bench -f gemm -r z --transposeA C "
+                                               "--transposeB N -m 8 -n 9 -k 10 --alpha -1 "
+                                               "--alphai 0.5 --lda 10 --ldb 10 --beta -nan "
+                                               "--ldc 8 --a_type f32_r --flags 4",
+                                               call),
+                      1);
+            EXPECT_EQ(call.a_type, "f64_c");
+            EXPECT_EQ(call.compute_type, "f64_c");
+            EXPECT_EQ(call.transA, 'C');
+            EXPECT_EQ(call.alpha, -1);
+            EXPECT_EQ(call.alphai, 0.5);
+            EXPECT_TRUE(call.beta != call.beta);
+            EXPECT_EQ(call.ldd, 8);
+            EXPECT_EQ(call.flags, 0u);
+            EXPECT_EQ(call.stride_d, 8 * 9);
+
+            // Batched calls have packed matrices, like their strided equivalents
+            rocblas_gemm_bench_call batched, strided;
+            EXPECT_EQ(rocblas_gemm_bench_parse(
+                          "-f gemm_batched_ex --transposeA T --transposeB N -m 4 -n 5 -k 6 "
+                          "--alpha 1 --a_type f32_r --lda 7 --b_type f32_r --ldb 8 --beta 1 "
+                          "--c_type f32_r --ldc 9 --d_type f32_r --ldd 9 --batch_count 3 "
+                          "--compute_type f32_r --algo 0 --solution_index 0 --flags 0",
+                          batched),
+                      1);
+            EXPECT_TRUE(batched.batched());
+            EXPECT_EQ(batched.stride_a, 7 * 4);
+            EXPECT_EQ(batched.stride_b, 8 * 5);
+            EXPECT_EQ(batched.stride_c, 9 * 5);
+            EXPECT_EQ(rocblas_gemm_bench_parse(
+                          "-f gemm_strided_batched -r s --transposeA T --transposeB N -m 4 -n 5 "
+                          "-k 6 --alpha 1 --lda 7 --stride_a 28 --ldb 8 --stride_b 40 --beta 1 "
+                          "--ldc 9 --stride_c 45 --batch_count 3",
+                          strided),
+                      1);
+            EXPECT_FALSE(strided.batched());
+            EXPECT_EQ(strided.options(), batched.options());
+
+            // Other functions are not GEMM calls
+            for(const char* line : {"./rocblas-bench -f gemv -r s -m 4 -n 4 --lda 4",
+                                    "./rocblas-bench -f gemmt -r s -n 4 -k 4",
+                                    "rocblas_gemm_ex,N,T,1024,512,256",
+                                    ""})
+                EXPECT_EQ(rocblas_gemm_bench_parse(line, call), 0);
+
+            // Malformed GEMM calls leave call unchanged
+            std::string unchanged = call.options();
+            for(const char* line : {"-f gemm -r s -m x -n 4 -k 4",
+                                    "-f gemm -r s -m 4 -n 4 -k 4 --transposeA Q",
+                                    "-f gemm -r s -m 4 -n 4 -k 4 --lda 3",
+                                    "-f gemm -r s -m -4 -n 4 -k 4",
+                                    "-f gemm -r f99_r -m 4 -n 4 -k 4",
+                                    "-f gemm_ex -m 4 -n 4 -k 4 --a_type f32_r --b_type bf16",
+                                    "-f gemm -r s -m 4 -n 4 -k 4 --batch_count"})
+            {
+                EXPECT_EQ(rocblas_gemm_bench_parse(line, call), -1);
+                EXPECT_EQ(call.options(), unchanged);
+            }
+
+            // Repeated calls are counted once per distinct problem
+            std::istringstream log("./rocblas-bench -f gemm -r s -m 4 -n 4 -k 4\n"
+                                   "./rocblas-bench -f gemv -r s -m 4 -n 4\n"
+                                   "\n"
+                                   "./rocblas-bench -f gemm -r s -m 8 -n 4 -k 4\n"
+                                   "./rocblas-bench -f gemm -r s -m 4 -n 4 -k 4\n"
+                                   "./rocblas-bench -f gemm -r s -m 4 -n 4 -k 4 --lda 4\n"
+                                   "./rocblas-bench -f gemm -r s -m 4 -n 4 -k x\n");
+            rocblas_gemm_bench_capture capture;
+            rocblas_gemm_bench_read(log, capture);
+            EXPECT_EQ(capture.calls.size(), 2u);
+            EXPECT_EQ(capture.counts[0], 3u);
+            EXPECT_EQ(capture.counts[1], 1u);
+            EXPECT_EQ(capture.calls[1].M, 8);
+            EXPECT_EQ(capture.skipped, 1u);
+            EXPECT_EQ(capture.malformed, 1u);
+
+            // Reading more of the capture adds to the counts
+            std::istringstream more("./rocblas-bench -f gemm -r s -m 8 -n 4 -k 4 --ldc 8\n");
+            rocblas_gemm_bench_read(more, capture);
+            EXPECT_EQ(capture.calls.size(), 2u);
+            EXPECT_EQ(capture.counts[1], 2u);
+
+            // Coverage is classified from the fitness which Tensile reports for the solution
+            EXPECT_EQ(rocblas_gemm_solution_coverage(true, 0.0), rocblas_gemm_coverage_exact);
+            EXPECT_EQ(rocblas_gemm_solution_coverage(true, 0.5), rocblas_gemm_coverage_nearest);
+            EXPECT_EQ(rocblas_gemm_solution_coverage(true, 3.0e6), rocblas_gemm_coverage_nearest);
+            EXPECT_EQ(rocblas_gemm_solution_coverage(true, rocblas_gemm_fitness_unset),
+                      rocblas_gemm_coverage_fallback);
+            EXPECT_EQ(rocblas_gemm_solution_coverage(true, std::numeric_limits<double>::max()),
+                      rocblas_gemm_coverage_fallback);
+            EXPECT_EQ(rocblas_gemm_solution_coverage(true, std::numeric_limits<double>::infinity()),
+                      rocblas_gemm_coverage_fallback);
+            EXPECT_EQ(rocblas_gemm_solution_coverage(false, 0.0), rocblas_gemm_coverage_none);
+        }
+    };
+
+    template <typename...>
+    struct testing_latency_histogram : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            using histogram = rocblas_latency_histogram;
+
+            // Buckets are log-scale, with underflow and overflow buckets
+            EXPECT_EQ(histogram::bucket(0), 0);
+            EXPECT_EQ(histogram::bucket(-1), 0);
+            EXPECT_EQ(histogram::bucket(NAN), 0);
+            EXPECT_EQ(histogram::bucket(0.0625), 1);
+            EXPECT_EQ(histogram::bucket(1), 1 + 4 * histogram::SUB_BUCKETS);
+            EXPECT_EQ(histogram::bucket(2), 1 + 5 * histogram::SUB_BUCKETS);
+            EXPECT_EQ(histogram::bucket(1e12), histogram::NUM_BUCKETS - 1);
+            for(double us = 0.1; us < 1e9; us *= 1.7)
+            {
+                int b = histogram::bucket(us);
+                EXPECT_LE(std::abs(std::log2(histogram::bucket_value(b) / us)),
+                          0.5 / histogram::SUB_BUCKETS + 1e-9);
+            }
+
+            // An empty histogram has no quantiles
+            histogram h;
+            EXPECT_EQ(h.count(), 0u);
+            EXPECT_EQ(h.quantile(0.5), 0);
+
+            // Quantiles of synthetic timings are within a bucket of the exact value:
+            // 98% of calls take 10 us, and 2% take 1 ms
+            for(int i = 0; i < 980; ++i)
+                h.add(10);
+            for(int i = 0; i < 20; ++i)
+                h.add(1000);
+            EXPECT_EQ(h.count(), 1000u);
+            EXPECT_NEAR(h.total(), 980 * 10 + 20 * 1000, 1e-6);
+            double tolerance = std::exp2(0.5 / histogram::SUB_BUCKETS);
+            EXPECT_GE(h.quantile(0.5), 10 / tolerance);
+            EXPECT_LE(h.quantile(0.5), 10 * tolerance);
+            EXPECT_GE(h.quantile(0.99), 1000 / tolerance);
+            EXPECT_LE(h.quantile(0.99), 1000 * tolerance);
+            EXPECT_LE(h.quantile(0.98), 10 * tolerance);
+
+            // Log-normal timings from several threads give the expected median
+            histogram                lognormal;
+            std::vector<std::thread> threads;
+            for(int t = 0; t < 4; ++t)
+                threads.emplace_back([&, t] {
+                    std::mt19937                     rng(t);
+                    std::lognormal_distribution<double> dist(std::log(50.0), 0.5);
+                    for(int i = 0; i < 25000; ++i)
+                        lognormal.add(dist(rng));
+                });
+            for(auto& t : threads)
+                t.join();
+            EXPECT_EQ(lognormal.count(), 100000u);
+            EXPECT_NEAR(lognormal.quantile(0.5), 50, 50 * 0.1);
+            EXPECT_NEAR(lognormal.quantile(0.99), 50 * std::exp(0.5 * 2.326), 160 * 0.1);
+
+            // Histograms are merged by adding their buckets
+            histogram merged;
+            merged.add(h);
+            merged.add(h);
+            EXPECT_EQ(merged.count(), 2000u);
+            EXPECT_DOUBLE_EQ(merged.quantile(0.5), h.quantile(0.5));
+            EXPECT_DOUBLE_EQ(merged.quantile(0.99), h.quantile(0.99));
+        }
+    };
+
+    using V = rocblas_level2_variant;
+
+    // Block size of the double buffered gemv kernels on wave64 architectures
+    constexpr int64_t gemv_bx = 128;
+
+    // The selection of rocBLAS 3.0, which compared the architecture with hard-coded
+    // thresholds, to check that the compiled rules reproduce it
+    V legacy_gemv_n(
+        const std::string& arch, char p, int64_t m, int64_t n, int64_t batch, bool atomics)
+    {
+        bool s = p == 's', d = p == 'd', c = p == 'c', z = p == 'z';
+        if(arch == "gfx90a" && m <= 32 && n <= 32 && batch >= 256)
+            return V::sm_mn_batched;
+        if(atomics && arch == "gfx90a" && (s || d) && m == n && m % gemv_bx == 0)
+            return V::double_buffered;
+        if((arch == "gfx908"
+            && (((s || d || c) && m <= 15000 && n <= 15000) || (z && m <= 18000 && n <= 18000)))
+           || (arch == "gfx906"
+               && (c || ((s || d) && m <= 6000 && n <= 6000)
+                   || (d && ((m >= 15000 && n >= 15000) || (m <= 24000 && n <= 24000))))))
+            return V::threads_512;
+        return V::generic;
+    }
+
+    V legacy_gemv_t(
+        const std::string& arch, char p, bool conj, int64_t m, int64_t n, bool atomics)
+    {
+        bool s = p == 's', d = p == 'd', c = p == 'c', z = p == 'z';
+        bool arch_10_or_11 = !arch.compare(0, 5, "gfx10") || !arch.compare(0, 5, "gfx11");
+        if(atomics && m == n && m % gemv_bx == 0 && arch == "gfx908"
+           && ((s && m > 7000) || (d && m > 3000)))
+            return V::double_buffered;
+        if(conj)
+            return s || m < 6000 || n < 6000 ? V::shared_reduce_256 : V::generic;
+        if(arch_10_or_11 && (d || c || (s && (m < 4000 || n < 4000))))
+            return V::warp_reduce_256;
+        if(s || m < 6000 || n < 6000 || (arch_10_or_11 && z))
+            return V::shared_reduce_256;
+        return V::generic;
+    }
+
+    V legacy_symv(const std::string& arch, char p, bool upper, int64_t n, bool atomics)
+    {
+        bool s = p == 's', d = p == 'd';
+        bool gfx90a = arch == "gfx90a", gfx908 = arch == "gfx908";
+        bool double_buffered
+            = upper ? atomics
+                          && ((gfx90a && ((s && n < 22000) || (d && n < 16000)))
+                              || (gfx908
+                                  && ((s && n < 22000)
+                                      || (d
+                                          && ((n % 32 == 0 && n < 23000)
+                                              || (n % 32 != 0 && (n < 14000 || n > 19000)))))))
+                    : atomics
+                          && ((gfx908 && (s || d))
+                              || (gfx90a
+                                  && ((s && n < 29000) || (n % 32 == 0 && d && n < 20000)
+                                      || (n % 32 != 0 && d && n < 26000))));
+        return double_buffered ? V::double_buffered : V::generic;
+    }
+
+    V legacy_ger(const std::string& arch, char p, int64_t m, int64_t n)
+    {
+        bool s = p == 's', d = p == 'd', c = p == 'c';
+        return arch == "gfx90a" && m > 2000 && m == n
+                       && ((m % 64 == 0 && (d || c)) || (m % 128 == 0 && s))
+                   ? V::double_buffered
+                   : V::generic;
+    }
+
+    std::vector<rocblas_level2_rule> parse(const std::string& text, int expected)
+    {
+        std::vector<rocblas_level2_rule> rules;
+        std::istringstream               in(text);
+        std::string                      error;
+        EXPECT_EQ(rocblas_level2_variants_parse(in, rules, error), expected);
+        EXPECT_EQ(expected < 0, !error.empty());
+        return rules;
+    }
+
+    template <typename...>
+    struct testing_level2_variants : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            std::vector<rocblas_level2_rule> defaults;
+            std::istringstream               in(rocblas_level2_default_variants);
+            std::string                      error;
+            EXPECT_GE(rocblas_level2_variants_parse(in, defaults, error), 1);
+            EXPECT_TRUE(error.empty());
+
+            // The compiled rules reproduce the thresholds which they replace
+            const std::vector<int64_t> sizes = {1,     32,    33,    128,   2048,  2944,
+                                                3000,  3072,  3968,  4000,  5888,  6000,
+                                                6016,  7040,  13952, 14016, 15000, 15104,
+                                                16000, 18000, 19008, 19968, 20000, 21952,
+                                                22016, 23040, 24000, 25984, 26112, 28928,
+                                                29056, 30000};
+            const std::vector<int64_t> batches = {1, 9, 256};
+
+            for(std::string arch :
+                {"gfx803", "gfx906", "gfx908", "gfx90a", "gfx942", "gfx1030", "gfx1100"})
+            {
+                rocblas_level2_variant_table table(defaults, arch);
+                for(char p : {'s', 'd', 'c', 'z', char(0)})
+                    for(bool atomics : {false, true})
+                    {
+                        auto gemv_feasible = [&](int64_t m, int64_t n) {
+                            return [=](V v) {
+                                return v == V::sm_mn_batched
+                                           ? m <= 32 && n <= 32
+                                           : v != V::double_buffered
+                                                 || (atomics && (p == 's' || p == 'd') && m == n
+                                                     && m % gemv_bx == 0);
+                            };
+                        };
+                        auto symv_feasible = [&](V v) {
+                            return v != V::double_buffered || (atomics && (p == 's' || p == 'd'));
+                        };
+
+                        for(int64_t m : sizes)
+                            for(int64_t n : sizes)
+                                for(int64_t batch : batches)
+                                {
+                                    auto feasible = gemv_feasible(m, n);
+                                    EXPECT_EQ(
+                                        table.select(
+                                            rocblas_level2_op::gemv_n, p, m, n, batch, feasible),
+                                        legacy_gemv_n(arch, p, m, n, batch, atomics));
+                                    EXPECT_EQ(
+                                        table.select(
+                                            rocblas_level2_op::gemv_t, p, m, n, batch, feasible),
+                                        legacy_gemv_t(arch, p, false, m, n, atomics));
+                                    EXPECT_EQ(
+                                        table.select(
+                                            rocblas_level2_op::gemv_c, p, m, n, batch, feasible),
+                                        legacy_gemv_t(arch, p, true, m, n, atomics));
+                                }
+
+                        for(int64_t n : sizes)
+                            for(int64_t dn : {0, 1, 31})
+                            {
+                                EXPECT_EQ(table.select(rocblas_level2_op::symv_upper,
+                                                       p,
+                                                       n + dn,
+                                                       n + dn,
+                                                       1,
+                                                       symv_feasible),
+                                          legacy_symv(arch, p, true, n + dn, atomics));
+                                EXPECT_EQ(table.select(rocblas_level2_op::symv_lower,
+                                                       p,
+                                                       n + dn,
+                                                       n + dn,
+                                                       1,
+                                                       symv_feasible),
+                                          legacy_symv(arch, p, false, n + dn, atomics));
+                            }
+                    }
+
+                for(char p : {'s', 'd', 'c', 'z'})
+                    for(int64_t m : sizes)
+                        for(int64_t n : {m, m + 64})
+                        {
+                            auto ger_feasible = [&](V v) {
+                                return v != V::double_buffered
+                                       || (m == n
+                                           && ((m % 64 == 0 && (p == 'd' || p == 'c'))
+                                               || (m % 128 == 0 && p == 's')));
+                            };
+                            EXPECT_EQ(
+                                table.select(rocblas_level2_op::ger, p, m, n, 1, ger_feasible),
+                                legacy_ger(arch, p, m, n));
+                        }
+            }
+
+            // Rules of a file are tried first, and may target architectures by prefix
+            const std::string header = "rocblas_level2_variants 1\n";
+            auto              rules  = parse(header
+                                         + "# tuned on gfx942\n"
+                                           "gfx94* gemv_t sd - - - 2048 2 - 32 warp_reduce_256\n"
+                                           "gfx942 gemv_n *  100 - - - - - - threads_512 # all\n",
+                                     2);
+            rules.insert(rules.end(), defaults.begin(), defaults.end());
+
+            rocblas_level2_variant_table gfx942(rules, "gfx942");
+            EXPECT_EQ(gfx942.select(rocblas_level2_op::gemv_t, 'd', 10000, 1024, 2),
+                      V::warp_reduce_256);
+            EXPECT_EQ(gfx942.select(rocblas_level2_op::gemv_t, 'd', 10000, 1000, 2),
+                      V::shared_reduce_256);
+            EXPECT_EQ(gfx942.select(rocblas_level2_op::gemv_t, 'd', 10000, 1024, 1),
+                      V::shared_reduce_256);
+            EXPECT_EQ(gfx942.select(rocblas_level2_op::gemv_t, 'c', 10000, 10240, 2), V::generic);
+            EXPECT_EQ(gfx942.select(rocblas_level2_op::gemv_n, 'z', 100, 1, 1), V::threads_512);
+            EXPECT_EQ(gfx942.select(rocblas_level2_op::gemv_n, 0, 99, 1, 1), V::generic);
+            EXPECT_EQ(gfx942.size(rocblas_level2_op::symv_upper), 0u);
+
+            rocblas_level2_variant_table gfx90a(rules, "gfx90a");
+            rocblas_level2_variant_table gfx90a_defaults(defaults, "gfx90a");
+            EXPECT_EQ(gfx90a.size(rocblas_level2_op::gemv_n),
+                      gfx90a_defaults.size(rocblas_level2_op::gemv_n));
+
+            // Malformed files are rejected and leave the rules unchanged
+            for(const std::string& text :
+                {std::string(""),
+                 std::string("# comment only\n"),
+                 std::string("rocblas_level2_rules 1\n"),
+                 std::string("rocblas_level2_variants 2\n"),
+                 header + "gfx90a gemv_n s - - - - - - - generic extra\n",
+                 header + "gfx90a gemv_n s - - - - - -\n",
+                 header + "gfx90a trmv s - - - - - - - generic\n",
+                 header + "gfx90a gemv_n h - - - - - - - generic\n",
+                 header + "gfx90a gemv_n s x - - - - - - generic\n",
+                 header + "gfx90a gemv_n s -1 - - - - - - generic\n",
+                 header + "gfx90a gemv_n s 10 9 - - - - - generic\n",
+                 header + "gfx90a gemv_n s - - - - - - 0 generic\n",
+                 header + "gfx90a gemv_n s - - - - - - - fastest\n",
+                 header + "gfx90a gemv_n s - - - - - - - warp_reduce_256\n",
+                 header + "gfx90a symv_lower s - - - - - - - threads_512\n",
+                 header + "gfx90a ger s - - - - - - - generic\nrocblas_level2_variants 1\n"})
+            {
+                std::vector<rocblas_level2_rule> unchanged = defaults;
+                std::istringstream               file(text);
+                std::string                      message;
+                EXPECT_EQ(rocblas_level2_variants_parse(file, unchanged, message), -1);
+                EXPECT_FALSE(message.empty());
+                EXPECT_EQ(unchanged.size(), defaults.size());
+            }
+        }
+    };
+
+    template <typename...>
+    struct testing_log_sampler : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            using namespace std::chrono_literals;
+            const uint64_t gemm = rocblas_log_sampler::hash("rocblas_sgemm");
+            const uint64_t axpy = rocblas_log_sampler::hash("rocblas_saxpy");
+
+            // Without sampling or a rate limit every call is logged
+            EXPECT_FALSE(rocblas_log_sampler(0, 0).enabled());
+            EXPECT_FALSE(rocblas_log_sampler(1, 0).enabled());
+
+            // Leading strings are hashed with separators
+            EXPECT_NE(rocblas_log_sampler::hash("c", rocblas_log_sampler::hash("ab")),
+                      rocblas_log_sampler::hash("bc", rocblas_log_sampler::hash("a")));
+
+            // 1 in N calls are logged, counted separately for each stream
+            {
+                rocblas_log_sampler sampler(4, 0);
+                EXPECT_TRUE(sampler.enabled());
+                int traced = 0, benched = 0;
+                for(int i = 0; i < 100; ++i)
+                {
+                    traced += sampler.sample(rocblas_log_sampler::trace, i % 2 ? gemm : axpy);
+                    if(i < 8)
+                        benched += sampler.sample(rocblas_log_sampler::bench, gemm);
+                }
+                EXPECT_EQ(traced, 25);
+                EXPECT_EQ(benched, 2);
+
+                size_t logged, skipped;
+                sampler.get_stats(&logged, &skipped);
+                EXPECT_EQ(logged, 27u);
+                EXPECT_EQ(skipped, 81u);
+            }
+
+            // At most K records per second per function, after a burst of K
+            {
+                rocblas_log_sampler sampler(0, 10);
+                auto                t0 = rocblas_log_sampler::clock::now();
+                int                 n  = 0;
+                for(int i = 0; i < 100; ++i)
+                    n += sampler.sample(rocblas_log_sampler::trace, gemm, t0);
+                EXPECT_EQ(n, 10);
+
+                // Other functions and streams have their own limit
+                EXPECT_TRUE(sampler.sample(rocblas_log_sampler::trace, axpy, t0));
+                EXPECT_TRUE(sampler.sample(rocblas_log_sampler::bench, gemm, t0));
+
+                // Tokens are refilled at K per second, up to K
+                EXPECT_FALSE(sampler.sample(rocblas_log_sampler::trace, gemm, t0 + 50ms));
+                EXPECT_TRUE(sampler.sample(rocblas_log_sampler::trace, gemm, t0 + 100ms));
+                EXPECT_FALSE(sampler.sample(rocblas_log_sampler::trace, gemm, t0 + 100ms));
+                n = 0;
+                for(int i = 0; i < 100; ++i)
+                    n += sampler.sample(rocblas_log_sampler::trace, gemm, t0 + 60s);
+                EXPECT_EQ(n, 10);
+            }
+
+            // Rates below 1 per second still allow one record
+            {
+                rocblas_log_sampler sampler(0, 0.5);
+                auto                t0 = rocblas_log_sampler::clock::now();
+                EXPECT_TRUE(sampler.sample(rocblas_log_sampler::trace, gemm, t0));
+                EXPECT_FALSE(sampler.sample(rocblas_log_sampler::trace, gemm, t0 + 1s));
+                EXPECT_TRUE(sampler.sample(rocblas_log_sampler::trace, gemm, t0 + 2s));
+            }
+
+            // Sampling is applied before rate limiting
+            {
+                rocblas_log_sampler sampler(2, 3);
+                auto                t0 = rocblas_log_sampler::clock::now();
+                int                 n  = 0;
+                for(int i = 0; i < 20; ++i)
+                    n += sampler.sample(rocblas_log_sampler::trace, gemm, t0);
+                EXPECT_EQ(n, 3);
+            }
+        }
+    };
+
+    template <typename...>
+    struct testing_philox : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // Known answers of the reference implementation of Philox4x32-10
+            EXPECT_TRUE(rocblas_philox4x32_10({0, 0, 0, 0}, 0, 0)
+                        == rocblas_philox_block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+            EXPECT_TRUE(rocblas_philox4x32_10({~0u, ~0u, ~0u, ~0u}, ~0u, ~0u)
+                        == rocblas_philox_block({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+            EXPECT_TRUE(
+                rocblas_philox4x32_10({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                      0xa4093822,
+                                      0x299f31d0)
+                == rocblas_philox_block({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+            // After a seek, the engine draws the blocks of the element one after the other
+            const uint64_t     seed = 0x0123456789abcdef;
+            rocblas_philox_rng rng(seed);
+            uint32_t           stream = rng.next_stream();
+            EXPECT_EQ(stream, 0u);
+            EXPECT_EQ(rng.next_stream(), 1u);
+
+            const uint64_t element = (uint64_t(5) << 32) + 7;
+            rng.seek(seed, stream, element);
+            auto first = rocblas_philox_rng::first_draws(seed, stream, element);
+            auto next  = rocblas_philox4x32_10({1, 7, 5, stream}, uint32_t(seed), seed >> 32);
+            for(int i = 0; i < 4; i++)
+                EXPECT_EQ(rng(), first[i]);
+            for(int i = 0; i < 4; i++)
+                EXPECT_EQ(rng(), next[i]);
+
+            // Values depend on the element, not on the order in which elements are drawn
+            const size_t          n = 1000;
+            std::vector<uint32_t> forward(n), backward(n);
+            for(size_t e = 0; e < n; e++)
+            {
+                rng.seek(seed, stream, e);
+                forward[e] = rng();
+            }
+            rng.seek(seed, 1, 0);
+            rng.discard(3);
+            for(size_t e = n; e-- > 0;)
+            {
+                rng.seek(seed, stream, e);
+                backward[e] = rng();
+            }
+            EXPECT_TRUE(forward == backward);
+
+            // Streams, seeds and the sequential draws of a new engine are distinct
+            EXPECT_NE(rocblas_philox_rng::first_draws(seed, 0, 0)[0],
+                      rocblas_philox_rng::first_draws(seed, 1, 0)[0]);
+            EXPECT_NE(rocblas_philox_rng::first_draws(seed, 0, 0)[0],
+                      rocblas_philox_rng::first_draws(seed + 1, 0, 0)[0]);
+            EXPECT_EQ(rocblas_philox_rng(seed)(),
+                      rocblas_philox_rng::first_draws(
+                          seed, rocblas_philox_rng::sequential_stream, 0)[0]);
+
+            // Uniform integers cover the whole range evenly
+            EXPECT_EQ(rocblas_philox_uniform_int(0, 1, 10), 1);
+            EXPECT_EQ(rocblas_philox_uniform_int(~0u, 1, 10), 10);
+            EXPECT_EQ(rocblas_philox_uniform_int(~0u, -2, 2), 2);
+            std::vector<int> counts(10);
+            for(size_t e = 0; e < 10 * n; e++)
+                counts[rocblas_philox_uniform_int(
+                           rocblas_philox_rng::first_draws(seed, stream, e)[0], 1, 10)
+                       - 1]++;
+            for(int count : counts)
+            {
+                EXPECT_GT(count, 800);
+                EXPECT_LT(count, 1200);
+            }
+        }
+    };
+
+    template <typename...>
+    struct testing_reference_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            EXPECT_EQ(rocblas_reference_hash("", 0), 0xcbf29ce484222325);
+            EXPECT_EQ(rocblas_reference_hash("a", 1), 0xaf63dc4c8601ec8c);
+
+            char temp[] = "/tmp/rocblas_reference_cache_XXXXXX";
+            EXPECT_TRUE(mkdtemp(temp) != nullptr);
+            const std::string dir = std::string(temp) + "/cache";
+
+            std::vector<double> a(100);
+            std::vector<int>    b(10);
+            for(size_t i = 0; i < a.size(); i++)
+                a[i] = i * 0.5;
+            for(size_t i = 0; i < b.size(); i++)
+                b[i] = -int(i);
+            const std::vector<double> a_gold = a;
+            const std::vector<int>    b_gold = b;
+
+            rocblas_reference_buffers buffers = {{a.data(), a.size() * sizeof(double)},
+                                                 {b.data(), b.size() * sizeof(int)}};
+
+            // A stored entry is loaded only for the same key and buffer sizes
+            rocblas_reference_cache cache(dir, 1 << 20);
+            EXPECT_FALSE(cache.load(1, buffers));
+            EXPECT_TRUE(cache.store(1, buffers));
+            const uint64_t entry = cache.size();
+            EXPECT_GT(entry, 100 * sizeof(double) + 10 * sizeof(int));
+
+            std::fill(a.begin(), a.end(), 0.0);
+            std::fill(b.begin(), b.end(), 0);
+            EXPECT_TRUE(cache.load(1, buffers));
+            EXPECT_TRUE(a == a_gold);
+            EXPECT_TRUE(b == b_gold);
+            EXPECT_FALSE(cache.load(2, buffers));
+            EXPECT_FALSE(cache.load(1, {{a.data(), 99 * sizeof(double)}, buffers[1]}));
+            EXPECT_FALSE(cache.load(1, {buffers[0]}));
+
+            // The least recently used entry is evicted above the capacity
+            rocblas_reference_cache small(dir, 2 * entry + entry / 2);
+            EXPECT_TRUE(small.store(2, buffers));
+            EXPECT_EQ(small.size(), 2 * entry);
+            timespec times[2] = {{1000, 0}, {1000, 0}};
+            EXPECT_EQ(utimensat(AT_FDCWD, small.path(1).c_str(), times, 0), 0);
+            times[0].tv_sec = times[1].tv_sec = 2000;
+            EXPECT_EQ(utimensat(AT_FDCWD, small.path(2).c_str(), times, 0), 0);
+            EXPECT_TRUE(small.load(1, buffers));
+            EXPECT_TRUE(small.store(3, buffers));
+            EXPECT_EQ(small.size(), 2 * entry);
+            EXPECT_TRUE(small.load(1, buffers));
+            EXPECT_FALSE(small.load(2, buffers));
+            EXPECT_TRUE(small.load(3, buffers));
+
+            // Stale temporary files of killed processes are counted and evicted first, while
+            // recent ones may still be written and are left alone
+            const std::string stale = small.path(5) + ".tmp1", fresh = small.path(6) + ".tmp2";
+            for(const std::string& temp_file : {stale, fresh})
+            {
+                FILE* f = fopen(temp_file.c_str(), "w");
+                EXPECT_TRUE(f != nullptr);
+                if(f)
+                {
+                    fwrite(a.data(), sizeof(double), a.size(), f);
+                    fclose(f);
+                }
+            }
+            times[0].tv_sec = times[1].tv_sec = 500;
+            EXPECT_EQ(utimensat(AT_FDCWD, stale.c_str(), times, 0), 0);
+            EXPECT_EQ(small.size(), 2 * entry + a.size() * sizeof(double));
+            small.evict();
+            EXPECT_EQ(small.size(), 2 * entry);
+            EXPECT_NE(access(stale.c_str(), F_OK), 0);
+            EXPECT_EQ(access(fresh.c_str(), F_OK), 0);
+            EXPECT_TRUE(small.load(1, buffers));
+            EXPECT_TRUE(small.load(3, buffers));
+            unlink(fresh.c_str());
+
+            // Entries larger than the capacity are not stored, and an empty directory disables
+            rocblas_reference_cache tiny(dir, entry - 1);
+            EXPECT_FALSE(tiny.store(4, buffers));
+            rocblas_reference_cache disabled("", 1 << 20);
+            EXPECT_FALSE(disabled.enabled());
+            EXPECT_FALSE(disabled.store(1, buffers));
+            EXPECT_FALSE(disabled.load(1, buffers));
+
+            for(uint64_t key : {1, 3})
+                unlink(cache.path(key).c_str());
+            rmdir(dir.c_str());
+            rmdir(temp);
+        }
+    };
+
+    // A profile source whose snapshot is a fixed string
+    struct fixed_source : rocblas_profile_source
+    {
+        std::string text;
+        void        snapshot(std::string& out) const override
+        {
+            out += text;
+        }
+    };
+
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream      in(path);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    template <typename...>
+    struct testing_sharded_profile : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // Counts from many threads are merged
+            rocblas_sharded_counter<std::string> counter;
+            constexpr int                        threads = 16, calls = 1000;
+            std::vector<std::thread>             workers;
+            for(int t = 0; t < threads; ++t)
+                workers.emplace_back([&, t] {
+                    for(int i = 0; i < calls; ++i)
+                    {
+                        counter.add("gemm");
+                        counter.add("thread" + std::to_string(t));
+                    }
+                });
+            for(auto& w : workers)
+                w.join();
+
+            auto merged = counter.merge();
+            EXPECT_EQ(merged.size(), size_t(threads + 1));
+            EXPECT_EQ(merged["gemm"].calls, size_t(threads * calls));
+            EXPECT_EQ(merged["thread3"].calls, size_t(calls));
+            EXPECT_EQ(merged["gemm"].latency, nullptr);
+            EXPECT_EQ(counter.shard_count(), size_t(threads));
+
+            // A thread using two counters of the same type has a shard in each
+            rocblas_sharded_counter<std::string> other;
+            other.add("trsm");
+            counter.add("trsm");
+            other.add("trsm");
+            EXPECT_EQ(other.merge()["trsm"].calls, 2u);
+            EXPECT_EQ(counter.merge()["trsm"].calls, 1u);
+            EXPECT_EQ(other.shard_count(), 1u);
+
+            // Latencies of timed calls from several threads are merged, and may
+            // be added by a thread other than the one which counted the call
+            rocblas_latency_histogram* first = other.add("gemm", true);
+            ASSERT_NE(first, nullptr);
+            EXPECT_EQ(other.add("gemm", true), first);
+            std::thread([&] { other.add("gemm", true)->add(100); }).join();
+            std::thread([&] { first->add(10); }).join();
+            first->add(10);
+            other.add("gemm");
+            auto timed = other.merge();
+            EXPECT_EQ(timed["gemm"].calls, 4u);
+            ASSERT_NE(timed["gemm"].latency, nullptr);
+            EXPECT_EQ(timed["gemm"].latency->count(), 3u);
+            EXPECT_DOUBLE_EQ(timed["gemm"].latency->total(), 120);
+            EXPECT_EQ(timed["trsm"].latency, nullptr);
+
+            // Snapshots are written periodically and rotated, newest first
+            std::string                path = rocblas_tempname();
+            fixed_source               source;
+            rocblas_profile_snapshots& snapshots = rocblas_profile_snapshots::instance();
+            snapshots.add(&source);
+            EXPECT_FALSE(snapshots.start("", 1, 2));
+            EXPECT_FALSE(snapshots.start(path, 0, 2));
+            ASSERT_TRUE(snapshots.start(path, 3600, 2));
+
+            source.text = "- first\n";
+            snapshots.write_now();
+            EXPECT_EQ(read_file(path + ".0"), "- first\n");
+            source.text = "- second\n";
+            snapshots.write_now();
+            source.text = "- third\n";
+            snapshots.write_now();
+            EXPECT_EQ(read_file(path + ".0"), "- third\n");
+            EXPECT_EQ(read_file(path + ".1"), "- second\n");
+            EXPECT_FALSE(std::ifstream(path + ".2").good());
+
+            snapshots.stop();
+            snapshots.remove(&source);
+            remove((path + ".0").c_str());
+            remove((path + ".1").c_str());
+            remove(path.c_str());
+        }
+    };
+
+    // Backend which allocates host memory, counts calls, and fails once its
+    // budget of live bytes would be exceeded
+    struct counting_backend
+    {
+        size_t                               budget = SIZE_MAX;
+        std::shared_ptr<std::atomic<size_t>> live   = std::make_shared<std::atomic<size_t>>(0);
+        std::shared_ptr<std::atomic<size_t>> allocs = std::make_shared<std::atomic<size_t>>(0);
+
+        bool allocate(void** ptr, size_t size)
+        {
+            if(*live + size > budget)
+                return false;
+            *ptr = malloc(size + sizeof(size_t));
+            if(!*ptr)
+                return false;
+            *static_cast<size_t*>(*ptr) = size;
+            *ptr                        = static_cast<size_t*>(*ptr) + 1;
+            *live += size;
+            ++*allocs;
+            return true;
+        }
+
+        bool deallocate(void* ptr)
+        {
+            size_t* p = static_cast<size_t*>(ptr) - 1;
+            *live -= *p;
+            free(p);
+            return true;
+        }
+    };
+
+    template <typename...>
+    struct testing_staging_pool : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            using pool_t = rocblas_staging_pool<counting_backend>;
+
+            // Requests are rounded up to power-of-two size classes
+            EXPECT_EQ(pool_t::class_size(1), pool_t::MIN_CLASS_BYTES);
+            EXPECT_EQ(pool_t::class_size(4096), 4096u);
+            EXPECT_EQ(pool_t::class_size(4097), 8192u);
+            EXPECT_EQ(pool_t::class_size(3 << 20), size_t(4 << 20));
+
+            {
+                pool_t pool(1 << 20);
+                auto   live   = pool.backend().live;
+                auto   allocs = pool.backend().allocs;
+
+                // A released buffer is reused by a request of the same class
+                void* first;
+                {
+                    auto a = pool.acquire(5000);
+                    ASSERT_TRUE(a);
+                    EXPECT_EQ(a.size(), 8192u);
+                    first = a.get();
+                    memset(a.get(), 1, a.size());
+                }
+                auto stats = pool.get_stats();
+                EXPECT_EQ(stats.misses, 1u);
+                EXPECT_EQ(stats.cached_bytes, 8192u);
+                EXPECT_EQ(stats.in_use_bytes, 0u);
+                {
+                    auto b = pool.acquire(8000);
+                    EXPECT_EQ(b.get(), first);
+
+                    // A request of another class allocates
+                    auto c = pool.acquire(100);
+                    EXPECT_NE(c.get(), first);
+                    EXPECT_EQ(pool.get_stats().in_use_bytes, 8192u + 4096u);
+
+                    // Buffers may be moved
+                    pool_t::buffer d = std::move(c);
+                    EXPECT_FALSE(c);
+                    EXPECT_TRUE(d);
+                }
+                stats = pool.get_stats();
+                EXPECT_EQ(stats.hits, 1u);
+                EXPECT_EQ(stats.misses, 2u);
+                EXPECT_EQ(stats.cached_bytes, 8192u + 4096u);
+                EXPECT_EQ(stats.peak_bytes, 8192u + 4096u);
+                EXPECT_EQ(*allocs, 2u);
+
+                // Released buffers beyond the cap are freed
+                {
+                    auto big1 = pool.acquire(300 << 10);
+                    auto big2 = pool.acquire(300 << 10);
+                }
+                stats = pool.get_stats();
+                EXPECT_LE(stats.cached_bytes, size_t(1 << 20));
+                EXPECT_EQ(stats.frees, 1u);
+                EXPECT_EQ(*live, stats.cached_bytes);
+
+                // Lowering the cap frees the cached buffers
+                pool.set_cap(4096);
+                EXPECT_EQ(pool.get_stats().cached_bytes, 0u);
+                EXPECT_EQ(*live, 0u);
+
+                // A cap of 0 disables caching
+                pool.set_cap(0);
+                pool.acquire(100);
+                pool.acquire(100);
+                stats = pool.get_stats();
+                EXPECT_EQ(stats.hits, 1u);
+                EXPECT_EQ(stats.cached_bytes, 0u);
+                EXPECT_EQ(*live, 0u);
+            }
+
+            // When the backend fails, cached buffers are freed and the
+            // allocation is retried
+            {
+                counting_backend backend;
+                backend.budget = 64 << 10;
+                pool_t pool(1 << 20, backend);
+                pool.acquire(32 << 10);
+                EXPECT_EQ(pool.get_stats().cached_bytes, size_t(32 << 10));
+                auto a = pool.acquire(64 << 10);
+                EXPECT_TRUE(a);
+                EXPECT_EQ(pool.get_stats().cached_bytes, 0u);
+                auto b = pool.acquire(4096);
+                EXPECT_FALSE(b);
+            }
+
+            // Concurrent threads never share a buffer, and all buffers are
+            // returned to the pool
+            {
+                pool_t                   pool(64 << 20);
+                auto                     live = pool.backend().live;
+                std::atomic<int>         errors{0};
+                std::vector<std::thread> threads;
+                for(int t = 0; t < 8; ++t)
+                    threads.emplace_back([&, t] {
+                        for(int i = 0; i < 2000; ++i)
+                        {
+                            auto buf = pool.acquire(size_t(4096) << ((t + i) % 4));
+                            auto p   = static_cast<unsigned char*>(buf.get());
+                            p[0] = p[buf.size() - 1] = (unsigned char)t;
+                            std::this_thread::yield();
+                            if(p[0] != t || p[buf.size() - 1] != t)
+                                ++errors;
+                        }
+                    });
+                for(auto& t : threads)
+                    t.join();
+                EXPECT_EQ(errors, 0);
+                auto stats = pool.get_stats();
+                EXPECT_EQ(stats.hits + stats.misses, 16000u);
+                EXPECT_EQ(stats.in_use_bytes, 0u);
+                EXPECT_EQ(*live, stats.cached_bytes);
+            }
+            EXPECT_EQ(rocblas_get_staging_pool_stats(nullptr, nullptr, nullptr, nullptr),
+                      rocblas_status_invalid_pointer);
+        }
+    };
+
+    // Check packing and unpacking against a loop of memcpy calls, with
+    // misaligned data and counts which are not multiples of the SIMD width
+    void check_pack(rocblas_pack_thread_pool& pool,
+                    size_t                    col_bytes,
+                    size_t                    cols,
+                    size_t                    ld_bytes,
+                    size_t                    offset)
+    {
+        std::vector<char> a(offset + ld_bytes * (cols - 1) + col_bytes);
+        for(size_t i = 0; i < a.size(); ++i)
+            a[i] = char(i * 131 + 7);
+        std::vector<char> expected(col_bytes * cols), t(col_bytes * cols + 1);
+        for(size_t j = 0; j < cols; ++j)
+            memcpy(&expected[j * col_bytes], &a[offset + j * ld_bytes], col_bytes);
+
+        rocblas_pack_columns(t.data() + 1, a.data() + offset, col_bytes, cols, ld_bytes, pool);
+        EXPECT_EQ(memcmp(t.data() + 1, expected.data(), expected.size()), 0)
+            << "pack col_bytes " << col_bytes << " cols " << cols << " ld_bytes " << ld_bytes;
+
+        // Unpacking writes the columns and nothing between them
+        std::vector<char> b(a.size(), 'x'), b_expected(a.size(), 'x');
+        for(size_t j = 0; j < cols; ++j)
+            memcpy(&b_expected[offset + j * ld_bytes], &expected[j * col_bytes], col_bytes);
+        rocblas_unpack_columns(b.data() + offset, ld_bytes, t.data() + 1, col_bytes, cols, pool);
+        EXPECT_EQ(b, b_expected) << "unpack col_bytes " << col_bytes << " cols " << cols
+                                 << " ld_bytes " << ld_bytes;
+    }
+
+    template <typename...>
+    struct testing_strided_pack : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            rocblas_pack_thread_pool serial(1), threaded(4);
+            EXPECT_EQ(serial.threads(), 1u);
+            EXPECT_EQ(threaded.threads(), 4u);
+
+            for(auto* pool : {&serial, &threaded})
+                for(size_t elem : {1, 2, 3, 4, 8, 12, 16})
+                    for(size_t cols : {1, 3, 4, 5, 17, 300000})
+                        for(size_t inc : {1, 2, 3, 7})
+                        {
+                            // Vectors, whose columns are single elements
+                            check_pack(*pool, elem, cols, inc * elem, 0);
+                            check_pack(*pool, elem, cols, inc * elem, 1);
+
+                            // Matrices with a few rows
+                            if(cols < 1000)
+                                check_pack(*pool, elem * 3, cols, (inc + 2) * elem, 1);
+                        }
+
+            // Tasks run once each, also when several threads start packs at once
+            std::atomic<int>         errors{0};
+            std::vector<std::thread> callers;
+            for(int c = 0; c < 4; ++c)
+                callers.emplace_back([&] {
+                    for(int rep = 0; rep < 200; ++rep)
+                    {
+                        std::vector<std::atomic<int>> runs(37);
+                        threaded.run(runs.size(), [&](size_t i) { ++runs[i]; });
+                        for(auto& r : runs)
+                            if(r != 1)
+                                ++errors;
+                    }
+                });
+            for(auto& c : callers)
+                c.join();
+            EXPECT_EQ(errors, 0);
+        }
+    };
+
+    template <typename...>
+    struct testing_timing_stats : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // Percentiles interpolate between ranks
+            std::vector<double> sorted{1, 2, 3, 4, 5};
+            EXPECT_EQ(rocblas_timing_percentile(sorted, 0), 1);
+            EXPECT_EQ(rocblas_timing_percentile(sorted, 0.5), 3);
+            EXPECT_NEAR(rocblas_timing_percentile(sorted, 0.9), 4.6, 1e-12);
+            EXPECT_EQ(rocblas_timing_percentile(sorted, 1), 5);
+            EXPECT_EQ(rocblas_timing_percentile({}, 0.5), 0);
+
+            // Without outlier rejection all samples are kept, in any order
+            rocblas_timing_options keep_all;
+            keep_all.outlier_mad = 0;
+            auto stats = rocblas_timing_compute({9, 4, 2, 5, 4, 7, 4, 5}, keep_all);
+            EXPECT_EQ(stats.samples, 8u);
+            EXPECT_EQ(stats.rejected, 0u);
+            EXPECT_EQ(stats.min, 2);
+            EXPECT_EQ(stats.median, 4.5);
+            EXPECT_EQ(stats.mean, 5);
+            EXPECT_NEAR(stats.stddev, std::sqrt(32.0 / 7), 1e-12);
+            EXPECT_EQ(rocblas_timing_compute({}, keep_all).samples, 0u);
+
+            // Slow warm-up samples are rejected, fast ones are kept
+            std::vector<double> samples{250, 120};
+            for(int i = 0; i < 40; i++)
+                samples.push_back(100 + i % 5);
+            samples.push_back(50);
+            rocblas_timing_options options;
+            stats = rocblas_timing_compute(samples, options);
+            EXPECT_EQ(stats.rejected, 2u);
+            EXPECT_EQ(stats.samples, 41u);
+            EXPECT_EQ(stats.min, 50);
+            EXPECT_EQ(stats.median, 102);
+            EXPECT_EQ(stats.p99, 104);
+            EXPECT_LE(stats.ci_low, stats.median);
+            EXPECT_GE(stats.ci_high, stats.median);
+            EXPECT_GE(stats.ci_low, 100);
+            EXPECT_LE(stats.ci_high, 104);
+
+            // When most samples are equal, samples a few steps away are still kept
+            stats = rocblas_timing_compute({3, 3, 3, 3, 2, 4}, options);
+            EXPECT_EQ(stats.samples, 6u);
+            EXPECT_EQ(stats.median, 3);
+            EXPECT_NEAR(stats.stddev, std::sqrt(0.4), 1e-12);
+
+            // Quantized timings which mostly repeat keep their tail, and only far outliers
+            // are rejected
+            samples.clear();
+            for(int i = 0; i < 100; i++)
+                samples.push_back(i % 10 < 7 ? 8 : i % 10 < 9 ? 9 : 10);
+            samples.push_back(40);
+            stats = rocblas_timing_compute(samples, options);
+            EXPECT_EQ(stats.rejected, 1u);
+            EXPECT_EQ(stats.median, 8);
+            EXPECT_NEAR(stats.p90, 9.1, 1e-12);
+            EXPECT_EQ(stats.p99, 10);
+            EXPECT_NEAR(stats.mean, 8.4, 1e-12);
+            EXPECT_GT(stats.stddev, 0);
+
+            // Below the floor relative to the median, small steps do not narrow the limit
+            stats = rocblas_timing_compute({100, 100, 100, 100, 100.1, 103, 120}, options);
+            EXPECT_EQ(stats.rejected, 1u);
+            EXPECT_GT(stats.p99, 102);
+
+            // The confidence interval narrows as samples accumulate
+            samples.clear();
+            for(int i = 0; i < 1000; i++)
+                samples.push_back(100 + i % 10);
+            std::vector<double> first(samples.begin(), samples.begin() + 20);
+            double              wide   = rocblas_timing_compute(first, options).ci_relative();
+            double              narrow = rocblas_timing_compute(samples, options).ci_relative();
+            EXPECT_GT(wide, narrow);
+            EXPECT_GT(narrow, 0);
+
+            // Iterating stops without a target, once the target is met, or after max_iters
+            stats = rocblas_timing_compute(samples, options);
+            EXPECT_TRUE(rocblas_timing_done(stats, options, 1));
+            options.ci_target = narrow;
+            EXPECT_TRUE(rocblas_timing_done(stats, options, 1));
+            options.ci_target = narrow / 2;
+            EXPECT_FALSE(rocblas_timing_done(stats, options, 999));
+            EXPECT_TRUE(rocblas_timing_done(stats, options, 1000));
+            EXPECT_FALSE(rocblas_timing_done({}, options, 10));
+        }
+    };
+
+    int parse(const std::string& text, const std::string& arch, rocblas_trsm_block_tables& tables)
+    {
+        std::istringstream in(text);
+        std::string        error;
+        int                replaced = rocblas_trsm_block_tables_parse(in, arch, tables, error);
+        EXPECT_EQ(replaced < 0, !error.empty());
+        return replaced;
+    }
+
+    template <typename...>
+    struct testing_trsm_block_tables : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            const std::string header = "rocblas_trsm_block_tables 1\n";
+            const std::string gfx90a = "arch gfx90a # comment\n"
+                                       "table real_batched\n"
+                                       "rows 20 28 40\n"
+                                       "cols 6 10\n"
+                                       "blksizes 1 1 1\n"
+                                       "         16 16 16\n"
+                                       "         24 24 16\n"
+                                       "         64 32 0\n";
+            const std::string gfx908 = "arch gfx908\n"
+                                       "table complex rows cols blksizes 8\n";
+
+            // Only the tables of the requested arch are replaced
+            rocblas_trsm_block_tables tables;
+            EXPECT_EQ(parse(header + gfx90a + gfx908, "gfx90a", tables), 1);
+            EXPECT_TRUE(tables.tables[rocblas_trsm_block_tables::complex].blksizes.empty());
+
+            // Bounds are inclusive upper bounds of the intervals
+            const auto& table = tables.get(false, true);
+            EXPECT_EQ(table.lookup(1, 1), 1);
+            EXPECT_EQ(table.lookup(20, 6), 1);
+            EXPECT_EQ(table.lookup(21, 6), 16);
+            EXPECT_EQ(table.lookup(28, 7), 16);
+            EXPECT_EQ(table.lookup(40, 10), 24);
+            EXPECT_EQ(table.lookup(40, 11), 16);
+            EXPECT_EQ(table.lookup(41, 1), 64);
+            EXPECT_EQ(table.lookup(100000, 8), 32);
+            EXPECT_EQ(table.lookup(100000, 100000), 0);
+
+            // A table without intervals has a single block size
+            EXPECT_EQ(parse(header + gfx90a + gfx908, "gfx908", tables), 1);
+            EXPECT_EQ(tables.get(true, false).lookup(3, 4096), 8);
+            EXPECT_EQ(tables.get(false, true).lookup(41, 1), 64);
+            EXPECT_EQ(parse(header, "gfx90a", tables), 0);
+
+            // Malformed files leave the tables unchanged
+            for(const std::string& text :
+                {std::string(""),
+                 std::string("rocblas_trsm_tables 1\n"),
+                 std::string("rocblas_trsm_block_tables 2\n"),
+                 header + "arch gfx90a table real rows 4 cols blksizes 1\n",
+                 header + "arch gfx90a table real rows 4 4 cols blksizes 1 1 1\n",
+                 header + "arch gfx90a table real rows 4 2 cols blksizes 1 1 1\n",
+                 header + "arch gfx90a table real rows cols blksizes -1\n",
+                 header + "arch gfx90a table real rows cols blksizes 513\n",
+                 header + "arch gfx90a table real rows 4 cols blksizes 1 2048\n",
+                 header + "arch gfx90a table double rows cols blksizes 1\n",
+                 header + "arch gfx90a table real cols rows blksizes 1\n",
+                 header + "arch gfx90a table real rows cols\n",
+                 header + "arch gfx90a table real rows cols blksizes 1 x\n",
+                 header + gfx908 + "arch gfx90a table real rows cols blksizes 1 2\n"})
+            {
+                rocblas_trsm_block_tables unchanged = tables;
+                EXPECT_EQ(parse(text, "gfx908", unchanged), -1);
+                for(int kind = 0; kind < rocblas_trsm_block_tables::kinds; kind++)
+                    EXPECT_TRUE(unchanged.tables[kind].blksizes == tables.tables[kind].blksizes);
+            }
+
+            // Writing and reading back the tables reproduces them
+            tables.tables[rocblas_trsm_block_tables::real]            = tables.get(false, true);
+            tables.tables[rocblas_trsm_block_tables::complex_batched] = tables.get(true, false);
+            std::ostringstream out;
+            rocblas_trsm_block_tables_write(out, "gfx1100", tables);
+            rocblas_trsm_block_tables read;
+            EXPECT_EQ(parse(out.str(), "gfx1100", read), int(rocblas_trsm_block_tables::kinds));
+            for(int kind = 0; kind < rocblas_trsm_block_tables::kinds; kind++)
+            {
+                EXPECT_TRUE(read.tables[kind].row_intervals == tables.tables[kind].row_intervals);
+                EXPECT_TRUE(read.tables[kind].col_intervals == tables.tables[kind].col_intervals);
+                EXPECT_TRUE(read.tables[kind].blksizes == tables.tables[kind].blksizes);
+            }
+        }
+    };
+
+    // Unit tests of library and client components which run on the host without a device.
+    // Each component is a test of one fixture, instantiated by host_utilities_gtest.yaml.
+    template <typename...>
+    struct testing_host_utilities : rocblas_test_valid
+    {
+    };
+
+    struct host_utilities : RocBLAS_Test<host_utilities, testing_host_utilities>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "host_utilities");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<host_utilities>(arg.name);
+        }
+    };
+
+    TEST_P(host_utilities, binary_log)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_binary_log<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, blocked_gemm)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_blocked_gemm<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, check_numerics_range)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_check_numerics_range<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, check_numerics_ring)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_check_numerics_ring<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, chrome_trace)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_chrome_trace<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, gemm_bench_log)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_gemm_bench_log<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, latency_histogram)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_latency_histogram<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, level2_variants)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_level2_variants<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, log_sampler)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_log_sampler<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, philox)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_philox<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, reference_cache)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_reference_cache<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, sharded_profile)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_sharded_profile<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, staging_pool)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_staging_pool<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, strided_pack)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_strided_pack<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, timing_stats)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_timing_stats<>{}(GetParam()));
+    }
+
+    TEST_P(host_utilities, trsm_block_tables)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_trsm_block_tables<>{}(GetParam()));
+    }
+
+    INSTANTIATE_TEST_CATEGORIES(host_utilities)
+
+} // namespace
@@ -24,6 +24,8 @@
 #include "rocblas_datatype2string.hpp"
 #include "testing_set_get_matrix.hpp"
 #include "testing_set_get_matrix_async.hpp"
+#include "testing_set_get_matrix_batched.hpp"
+#include "testing_set_get_matrix_strided_batched.hpp"
 #include "type_dispatch.hpp"
 #include <cstring>
 #include <type_traits>
@@ -34,6 +36,8 @@ namespace
     {
         SET_GET_MATRIX_SYNC,
         SET_GET_MATRIX_ASYNC,
+        SET_GET_MATRIX_BATCHED,
+        SET_GET_MATRIX_STRIDED_BATCHED,
     };
 
     template <template <typename...> class FILTER, sync_type TRANSFER_TYPE>
@@ -56,6 +60,10 @@ namespace
                 return !strcmp(arg.function, "set_get_matrix_sync");
             case SET_GET_MATRIX_ASYNC:
                 return !strcmp(arg.function, "set_get_matrix_async");
+            case SET_GET_MATRIX_BATCHED:
+                return !strcmp(arg.function, "set_get_matrix_batched");
+            case SET_GET_MATRIX_STRIDED_BATCHED:
+                return !strcmp(arg.function, "set_get_matrix_strided_batched");
             }
             return false;
         }
@@ -74,6 +82,13 @@ namespace
             else
             {
                 name << arg.M << '_' << arg.N << '_' << arg.lda << '_' << arg.ldb << '_' << arg.ldc;
+
+                if(TRANSFER_TYPE == SET_GET_MATRIX_STRIDED_BATCHED)
+                    name << '_' << arg.stride_a << '_' << arg.stride_b << '_' << arg.stride_c;
+
+                if(TRANSFER_TYPE == SET_GET_MATRIX_BATCHED
+                   || TRANSFER_TYPE == SET_GET_MATRIX_STRIDED_BATCHED)
+                    name << '_' << arg.batch_count;
             }
             return std::move(name);
         }
@@ -100,6 +115,10 @@ namespace
                 testing_set_get_matrix<T>(arg);
             else if(!strcmp(arg.function, "set_get_matrix_async"))
                 testing_set_get_matrix_async<T>(arg);
+            else if(!strcmp(arg.function, "set_get_matrix_batched"))
+                testing_set_get_matrix_batched<T>(arg);
+            else if(!strcmp(arg.function, "set_get_matrix_strided_batched"))
+                testing_set_get_matrix_strided_batched<T>(arg);
             else
                 FAIL() << "Internal error: Test called with unknown function: " << arg.function;
         }
@@ -123,4 +142,22 @@ namespace
     }
     INSTANTIATE_TEST_CATEGORIES(set_get_matrix_async);
 
+    using set_get_matrix_batched
+        = matrix_set_get_template<set_get_matrix_testing, SET_GET_MATRIX_BATCHED>;
+    TEST_P(set_get_matrix_batched, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_simple_dispatch<set_get_matrix_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(set_get_matrix_batched);
+
+    using set_get_matrix_strided_batched
+        = matrix_set_get_template<set_get_matrix_testing, SET_GET_MATRIX_STRIDED_BATCHED>;
+    TEST_P(set_get_matrix_strided_batched, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(
+            rocblas_simple_dispatch<set_get_matrix_testing>(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(set_get_matrix_strided_batched);
+
 } // namespace
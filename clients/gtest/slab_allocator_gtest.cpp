@@ -0,0 +1,177 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../library/src/include/slab_allocator.hpp"
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <cstdlib>
+#include <set>
+
+namespace
+{
+    // Host memory backend, which records the live slabs
+    struct host_backend
+    {
+        std::set<void*>* live;
+        bool             fail = false;
+
+        bool allocate(void** ptr, size_t size)
+        {
+            if(fail)
+                return false;
+            *ptr = malloc(size);
+            if(*ptr)
+                live->insert(*ptr);
+            return *ptr != nullptr;
+        }
+
+        bool deallocate(void* ptr)
+        {
+            live->erase(ptr);
+            free(ptr);
+            return true;
+        }
+    };
+
+    template <typename...>
+    struct testing_slab_allocator : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            using allocator = rocblas_slab_allocator<host_backend>;
+
+            std::set<void*> live;
+            allocator       slabs(host_backend{&live}, 1024);
+            allocator::block a, b, c, d;
+
+            // Without growth, nothing can be allocated from an empty allocator
+            EXPECT_EQ(slabs.allocate(16, a, false), nullptr);
+
+            // Growth adds a slab of at least the minimum slab size
+            char* pa = static_cast<char*>(slabs.allocate(256, a, true));
+            ASSERT_NE(pa, nullptr);
+            EXPECT_EQ(slabs.slab_count(), 1u);
+            EXPECT_EQ(slabs.capacity(), 1024u);
+            EXPECT_EQ(slabs.available(), 768u);
+
+            // Nested allocations are stacked in the same slab
+            char* pb = static_cast<char*>(slabs.allocate(512, b, true));
+            EXPECT_EQ(pb, pa + 256);
+
+            // An allocation which does not fit adds a slab, leaving memory in use untouched
+            char* pc = static_cast<char*>(slabs.allocate(4096, c, true));
+            ASSERT_NE(pc, nullptr);
+            EXPECT_EQ(slabs.slab_count(), 2u);
+            EXPECT_EQ(slabs.capacity(), 1024u + 4096u);
+            EXPECT_EQ(slabs.in_use(), 256u + 512u + 4096u);
+
+            // A small allocation uses the best fitting slab
+            char* pd = static_cast<char*>(slabs.allocate(128, d, true));
+            EXPECT_EQ(pd, pa + 768);
+
+            // Memory can only be freed in reverse order of allocation
+            EXPECT_FALSE(slabs.deallocate(c));
+            EXPECT_TRUE(slabs.deallocate(d));
+            EXPECT_TRUE(slabs.deallocate(c));
+            EXPECT_TRUE(slabs.deallocate(b));
+            EXPECT_EQ(slabs.in_use(), 256u);
+
+            // Memory cannot be released while it is in use
+            EXPECT_FALSE(slabs.release());
+            EXPECT_TRUE(slabs.deallocate(a));
+            EXPECT_EQ(slabs.in_use(), 0u);
+            EXPECT_EQ(slabs.high_water_mark(), 256u + 512u + 4096u + 128u);
+
+            // Freed slabs are reused
+            EXPECT_EQ(slabs.allocate(4096, a, true), pc);
+            EXPECT_EQ(live.size(), 2u);
+            EXPECT_TRUE(slabs.deallocate(a));
+
+            // Growth while nothing is in use replaces the slabs with a single slab
+            ASSERT_NE(slabs.allocate(8192, a, true), nullptr);
+            EXPECT_EQ(slabs.slab_count(), 1u);
+            EXPECT_EQ(live.size(), 1u);
+            EXPECT_EQ(slabs.max_capacity(), 8192u);
+            EXPECT_TRUE(slabs.deallocate(a));
+
+            // Backend failures are reported as failed allocations
+            slabs.backend().fail = true;
+            EXPECT_EQ(slabs.allocate(16384, a, true), nullptr);
+            EXPECT_EQ(slabs.in_use(), 0u);
+            slabs.backend().fail = false;
+
+            // Adopted memory is used, but not freed
+            char workspace[64];
+            EXPECT_TRUE(slabs.release());
+            EXPECT_TRUE(live.empty());
+            slabs.adopt(workspace, sizeof(workspace));
+            EXPECT_EQ(slabs.allocate(64, a, false), workspace);
+            EXPECT_EQ(slabs.allocate(1, b, false), nullptr);
+            EXPECT_TRUE(slabs.deallocate(a));
+            EXPECT_TRUE(slabs.release());
+            EXPECT_EQ(slabs.slab_count(), 0u);
+
+            // A new handle has one slab of device memory, and nothing used yet
+            size_t         high_water_mark, slab_count;
+            rocblas_handle handle;
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+            EXPECT_ROCBLAS_STATUS(rocblas_get_device_memory_stats(handle, nullptr, nullptr),
+                                  rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(
+                rocblas_get_device_memory_stats(handle, &high_water_mark, &slab_count));
+            EXPECT_EQ(high_water_mark, 0u);
+            EXPECT_LE(slab_count, 1u);
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(handle));
+        }
+    };
+
+    struct slab_allocator : RocBLAS_Test<slab_allocator, testing_slab_allocator>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "slab_allocator");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<slab_allocator>(arg.name);
+        }
+    };
+
+    TEST_P(slab_allocator, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_slab_allocator<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(slab_allocator)
+
+} // namespace
@@ -0,0 +1,220 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../library/src/include/solution_cache_file.hpp"
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <memory>
+#include <random>
+#include <string>
+
+#if __has_include(<filesystem>)
+#include <filesystem>
+namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#error no filesystem found
+#endif
+
+namespace
+{
+    // Mocked solution library, which counts how often solution selection is performed
+    struct mock_solution_library
+    {
+        size_t lookups = 0;
+
+        std::shared_ptr<int> find_best_solution(const rocblas_solution_cache_key& key)
+        {
+            ++lookups;
+            // Problems with m == 0 have no solution
+            return key.m ? std::make_shared<int>(int(key.m)) : nullptr;
+        }
+    };
+
+    rocblas_solution_cache_key make_key(uint64_t m, uint64_t n = 64, uint64_t k = 64)
+    {
+        rocblas_solution_cache_key key{};
+        key.a_type = key.c_type = key.compute_type = rocblas_datatype_f32_r;
+        key.m                                      = m;
+        key.n                                      = n;
+        key.k                                      = k;
+        key.batch_count                            = 1;
+        key.col_stride_a = key.col_stride_b = key.col_stride_c = key.col_stride_d = m;
+        return key;
+    }
+
+    template <typename...>
+    struct testing_solution_cache : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            mock_solution_library                        library;
+            rocblas_solution_cache<std::shared_ptr<int>> cache(2);
+
+            auto find = [&](const rocblas_solution_cache_key& key) {
+                return cache.find_or_insert(key, [&] { return library.find_best_solution(key); });
+            };
+
+            size_t hits, misses, entries;
+
+            // The first lookup of a problem is a miss, and repeats are hits
+            EXPECT_EQ(*find(make_key(16)), 16);
+            EXPECT_EQ(*find(make_key(16)), 16);
+            EXPECT_EQ(*find(make_key(16)), 16);
+            EXPECT_EQ(library.lookups, 1u);
+            cache.get_stats(&hits, &misses, &entries);
+            EXPECT_EQ(hits, 2u);
+            EXPECT_EQ(misses, 1u);
+            EXPECT_EQ(entries, 1u);
+
+            // Any difference in the key is a different problem
+            auto key = make_key(16);
+            key.beta_category = 1;
+            EXPECT_NE(key, make_key(16));
+            EXPECT_EQ(*find(key), 16);
+            EXPECT_EQ(library.lookups, 2u);
+
+            // Problems without a solution are not cached
+            EXPECT_EQ(find(make_key(0)), nullptr);
+            EXPECT_EQ(find(make_key(0)), nullptr);
+            EXPECT_EQ(library.lookups, 4u);
+
+            // With a capacity of 2, the least recently used entry (key) is evicted
+            find(make_key(16));
+            find(make_key(32));
+            EXPECT_EQ(library.lookups, 5u);
+            find(key);
+            EXPECT_EQ(library.lookups, 6u);
+            find(make_key(32));
+            EXPECT_EQ(library.lookups, 6u);
+            cache.get_stats(nullptr, nullptr, &entries);
+            EXPECT_EQ(entries, 2u);
+
+            // Clearing the cache forces selection again
+            cache.clear();
+            find(make_key(32));
+            EXPECT_EQ(library.lookups, 7u);
+
+            // A capacity of 0 disables the cache
+            cache.set_capacity(0);
+            find(make_key(32));
+            find(make_key(32));
+            EXPECT_EQ(library.lookups, 9u);
+            cache.get_stats(nullptr, nullptr, &entries);
+            EXPECT_EQ(entries, 0u);
+
+            // Persisted selections round trip through a file, which is ignored
+            // when it was written for a different library or architecture
+            std::string path
+                = (fs::temp_directory_path()
+                   / ("rocblas-solution-cache-" + std::to_string(std::random_device{}()) + ".dat"))
+                      .generic_string();
+            {
+                rocblas_solution_cache_file file;
+                EXPECT_FALSE(file.load(path, 42, "gfx90a"));
+                for(int32_t i = 0; i < 100; ++i)
+                    file.record(make_key((i * 37) % 100 + 1), i);
+                EXPECT_TRUE(file.dirty());
+                EXPECT_TRUE(file.save());
+                EXPECT_FALSE(file.dirty());
+            }
+            {
+                rocblas_solution_cache_file file;
+                EXPECT_TRUE(file.load(path, 42, "gfx90a"));
+                EXPECT_EQ(file.size(), 100u);
+                for(int32_t i = 0; i < 100; ++i)
+                    EXPECT_EQ(file.find(make_key((i * 37) % 100 + 1)), i);
+                EXPECT_EQ(file.find(make_key(1000)), -1);
+            }
+            {
+                rocblas_solution_cache_file file;
+                EXPECT_FALSE(file.load(path, 43, "gfx90a"));
+                EXPECT_EQ(file.find(make_key(1)), -1);
+                EXPECT_FALSE(file.load(path, 42, "gfx908"));
+            }
+            {
+                // Saves merge the entries which others saved to the file since it was loaded
+                rocblas_solution_cache_file first, second;
+                EXPECT_TRUE(first.load(path, 42, "gfx90a"));
+                EXPECT_TRUE(second.load(path, 42, "gfx90a"));
+                first.record(make_key(101), 1);
+                second.record(make_key(102), 2);
+                second.record(make_key(1), 3);
+                EXPECT_TRUE(first.save());
+                EXPECT_TRUE(second.save());
+
+                rocblas_solution_cache_file file;
+                EXPECT_TRUE(file.load(path, 42, "gfx90a"));
+                EXPECT_EQ(file.size(), 102u);
+                EXPECT_EQ(file.find(make_key(101)), 1);
+                EXPECT_EQ(file.find(make_key(102)), 2);
+                EXPECT_EQ(file.find(make_key(1)), 3);
+            }
+            fs::remove(path);
+            fs::remove(path + ".lock");
+
+            // A new handle starts with an empty cache
+            rocblas_handle handle;
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+            EXPECT_ROCBLAS_STATUS(rocblas_get_solution_cache_stats(handle, nullptr, nullptr, nullptr),
+                                  rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(rocblas_get_solution_cache_stats(handle, &hits, &misses, &entries));
+            EXPECT_EQ(hits, 0u);
+            EXPECT_EQ(misses, 0u);
+            EXPECT_EQ(entries, 0u);
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(handle));
+        }
+    };
+
+    struct solution_cache : RocBLAS_Test<solution_cache, testing_solution_cache>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "solution_cache");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<solution_cache>(arg.name);
+        }
+    };
+
+    TEST_P(solution_cache, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_solution_cache<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(solution_cache)
+
+} // namespace
@@ -0,0 +1,153 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../library/src/include/workspace_plan.hpp"
+#include "rocblas.hpp"
+#include "rocblas_data.hpp"
+#include "rocblas_datatype2string.hpp"
+#include "rocblas_test.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Stubbed workspace query standing in for Tensile, so that planning can be
+    // tested without a device: gemm needs m * n elements, trsm needs a 128x128 block
+    struct stub_workspace_query : rocblas_workspace_query
+    {
+        size_t queries = 0;
+
+        rocblas_status workspace(const rocblas_bench_call& call, size_t& size) override
+        {
+            ++queries;
+            size_t elem = call.precision() == "f64_r" ? sizeof(double) : sizeof(float);
+            if(call.function() == "gemm")
+                size = elem * call.get_int("m", 128) * call.get_int("n", 128);
+            else if(call.function() == "trsm")
+                size = elem * 128 * 128;
+            else if(call.function() == "syrk")
+                size = 0;
+            else
+                return rocblas_status_not_implemented;
+            return rocblas_status_success;
+        }
+    };
+
+    template <typename...>
+    struct testing_workspace_plan : rocblas_test_valid
+    {
+        void operator()(const Arguments&)
+        {
+            // Parsing of bench log lines, including negative values, flags and a prefix
+            rocblas_bench_call call;
+            EXPECT_FALSE(call.parse("rocblas_sgemm,N,N,128"));
+            EXPECT_TRUE(call.parse("log: ./rocblas-bench -f gemv -r f64_r --transposeA T -m 100 "
+                                   "-n 200 --alpha -2.5 --lda 100 --incx -1 --incy 3 "
+                                   "--atomics_not_allowed"));
+            EXPECT_EQ(call.function(), "gemv");
+            EXPECT_EQ(call.precision(), "f64_r");
+            EXPECT_EQ(call.get_char("transposeA", 'N'), 'T');
+            EXPECT_EQ(call.get_int("m"), 100);
+            EXPECT_EQ(call.get_int("n"), 200);
+            EXPECT_EQ(call.get_double("alpha"), -2.5);
+            EXPECT_EQ(call.get_int("incx"), -1);
+            EXPECT_EQ(call.get_int("incy"), 3);
+            EXPECT_TRUE(call.has("atomics_not_allowed"));
+            EXPECT_EQ(call.get_int("ldc", 7), 7);
+
+            // A trsm -> gemm -> syrk pipeline, planned with the stubbed query
+            std::vector<const char*> calls = {
+                "./rocblas-bench -f trsm -r f32_r --side L --uplo L --transposeA N --diag N -m "
+                "512 -n 512 --alpha 1 --lda 512 --ldb 512",
+                "./rocblas-bench -f gemm -r f32_r --transposeA N --transposeB T -m 1024 -n 256 "
+                "-k 512 --alpha -1 --lda 1024 --ldb 256 --beta 1 --ldc 1024",
+                "./rocblas-bench -f syrk -r f32_r --uplo U --transposeA N -n 512 -k 512 --alpha "
+                "1 --lda 512 --beta 0 --ldc 512"};
+
+            stub_workspace_query stub_query;
+            size_t               peak = 0;
+            std::vector<size_t>  steps(calls.size());
+            EXPECT_EQ(rocblas_plan_workspace_sequence(
+                          calls.size(), calls.data(), stub_query, steps.data(), &peak),
+                      rocblas_status_success);
+            EXPECT_EQ(stub_query.queries, calls.size());
+            EXPECT_EQ(steps[0], sizeof(float) * 128 * 128);
+            EXPECT_EQ(steps[1], sizeof(float) * 1024 * 256);
+            EXPECT_EQ(steps[2], 0u);
+            EXPECT_EQ(peak, steps[1]);
+
+            // Planning stops at the first invalid or unsupported call
+            const char* bad[] = {"not a bench line"};
+            EXPECT_EQ(rocblas_plan_workspace_sequence(1, bad, stub_query, nullptr, &peak),
+                      rocblas_status_invalid_value);
+            const char* unsupported[] = {"./rocblas-bench -f geam -r f32_r"};
+            EXPECT_EQ(rocblas_plan_workspace_sequence(1, unsupported, stub_query, nullptr, &peak),
+                      rocblas_status_not_implemented);
+            EXPECT_EQ(rocblas_plan_workspace_sequence(1, nullptr, stub_query, nullptr, &peak),
+                      rocblas_status_invalid_pointer);
+
+            // The library plans the same pipeline with real size queries
+            rocblas_handle handle;
+            CHECK_ROCBLAS_ERROR(rocblas_create_handle(&handle));
+            EXPECT_ROCBLAS_STATUS(
+                rocblas_plan_workspace(handle, calls.size(), calls.data(), steps.data(), nullptr),
+                rocblas_status_invalid_pointer);
+            CHECK_ROCBLAS_ERROR(
+                rocblas_plan_workspace(handle, calls.size(), calls.data(), steps.data(), &peak));
+            EXPECT_GT(steps[0], 0u);
+            EXPECT_EQ(peak, *std::max_element(steps.begin(), steps.end()));
+            EXPECT_ROCBLAS_STATUS(rocblas_plan_workspace(handle, 1, unsupported, nullptr, &peak),
+                                  rocblas_status_not_implemented);
+            CHECK_ROCBLAS_ERROR(rocblas_destroy_handle(handle));
+        }
+    };
+
+    struct workspace_plan : RocBLAS_Test<workspace_plan, testing_workspace_plan>
+    {
+        // Filter for which types apply to this suite
+        static bool type_filter(const Arguments&)
+        {
+            return true;
+        }
+
+        // Filter for which functions apply to this suite
+        static bool function_filter(const Arguments& arg)
+        {
+            return !strcmp(arg.function, "workspace_plan");
+        }
+
+        // Google Test name suffix based on parameters
+        static std::string name_suffix(const Arguments& arg)
+        {
+            return RocBLAS_TestName<workspace_plan>(arg.name);
+        }
+    };
+
+    TEST_P(workspace_plan, auxiliary)
+    {
+        CATCH_SIGNALS_AND_EXCEPTIONS_AS_FAILURES(testing_workspace_plan<>{}(GetParam()));
+    }
+    INSTANTIATE_TEST_CATEGORIES(workspace_plan)
+
+} // namespace
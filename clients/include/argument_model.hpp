@@ -23,6 +23,7 @@
 #pragma once
 
 #include "rocblas_arguments.hpp"
+#include "timing_stats.hpp"
 
 namespace ArgumentLogging
 {
@@ -35,6 +36,13 @@ bool ArgumentModel_get_log_function_name();
 void ArgumentModel_set_log_datatype(bool d);
 bool ArgumentModel_get_log_datatype();
 
+void                          ArgumentModel_set_timing_options(const rocblas_timing_options& t);
+const rocblas_timing_options& ArgumentModel_get_timing_options();
+
+// Statistics of the hot calls most recently timed by this thread, which log_perf reports and clears
+void                        ArgumentModel_set_timing_stats(const rocblas_timing_stats& s);
+const rocblas_timing_stats& ArgumentModel_get_timing_stats();
+
 // ArgumentModel template has a variadic list of argument enums
 template <rocblas_argument... Args>
 class ArgumentModel
@@ -92,6 +100,17 @@ public:
         name_line << ",us";
         val_line << ", " << gpu_us;
 
+        const rocblas_timing_stats& stats = ArgumentModel_get_timing_stats();
+        if(stats.samples)
+        {
+            name_line << ",us_min,us_median,us_p90,us_p99,us_stddev,us_ci_low,us_ci_high"
+                         ",samples,rejected";
+            val_line << ", " << stats.min << ", " << stats.median << ", " << stats.p90 << ", "
+                     << stats.p99 << ", " << stats.stddev << ", " << stats.ci_low << ", "
+                     << stats.ci_high << ", " << stats.samples << ", " << stats.rejected;
+            ArgumentModel_set_timing_stats({});
+        }
+
         if(arg.unit_check || arg.norm_check)
         {
             if(cpu_us != ArgumentLogging::NA_value)
@@ -241,7 +241,6 @@ void testing_axpy_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
         // Transfer from host to device.
@@ -265,9 +264,7 @@ void testing_axpy_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx, dy), [&] {
             rocblas_axpy_batched_fn(handle,
                                     N,
                                     &h_alpha,
@@ -276,8 +273,7 @@ void testing_axpy_batched(const Arguments& arg)
                                     dy.ptr_on_device(),
                                     incy,
                                     batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_N, e_alpha, e_incx, e_incy, e_batch_count>{}.log_args<T>(
             rocblas_cout,
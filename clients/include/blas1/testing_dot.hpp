@@ -267,7 +267,6 @@ void testing_dot(const Arguments& arg)
     {
         double gpu_time_used;
         int    number_cold_calls = arg.cold_iters;
-        int    number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
 
         for(int iter = 0; iter < number_cold_calls; iter++)
@@ -277,14 +276,15 @@ void testing_dot(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
-            (rocblas_dot_fn)(handle, N, dx, incx, dy_ptr, incy, d_rocblas_result_2);
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx, dy), [&] {
+            (rocblas_dot_fn)(handle,
+                             N,
+                             dx,
+                             incx,
+                             (arg.algo) ? (T*)(dx) : (T*)(dy),
+                             incy,
+                             d_rocblas_result_2);
+        });
 
         ArgumentModel<e_N, e_incx, e_incy, e_algo>{}.log_args<T>(rocblas_cout,
                                                                  arg,
@@ -189,7 +189,6 @@ void template_testing_reduction_batched(const Arguments&                  arg,
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
         for(int iter = 0; iter < number_cold_calls; iter++)
@@ -199,14 +198,9 @@ void template_testing_reduction_batched(const Arguments&                  arg,
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx), [&] {
             func(handle, N, dx.ptr_on_device(), incx, batch_count, hr2);
-        }
-
-        gpu_time_used = (get_time_us_sync(stream) - gpu_time_used);
+        });
 
         ArgumentModel<e_N, e_incx, e_batch_count>{}.log_args<T>(rocblas_cout,
                                                                 arg,
@@ -249,7 +249,6 @@ void testing_rotg_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         // Device mode will be much quicker
         // (TODO: or is there another reason we are typically using host_mode for timing?)
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
@@ -274,17 +273,14 @@ void testing_rotg_batched(const Arguments& arg)
         }
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(da, db, dc, ds), [&] {
             rocblas_rotg_batched_fn(handle,
                                     da.ptr_on_device(),
                                     db.ptr_on_device(),
                                     dc.ptr_on_device(),
                                     ds.ptr_on_device(),
                                     batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_batch_count>{}.log_args<T>(rocblas_cout,
                                                    arg,
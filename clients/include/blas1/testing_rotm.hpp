@@ -207,7 +207,6 @@ void testing_rotm(const Arguments& arg)
         // Initializing flag value to -1
         hparam[0]             = FLAGS[0];
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
 
         CHECK_HIP_ERROR(dx.transfer_from(hx));
@@ -221,12 +220,9 @@ void testing_rotm(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx, dy, dparam), [&] {
             rocblas_rotm_fn(handle, N, dx, incx, dy, incy, dparam);
-        }
-        gpu_time_used = (get_time_us_sync(stream) - gpu_time_used);
+        });
 
         ArgumentModel<e_N, e_incx, e_incy>{}.log_args<T>(rocblas_cout,
                                                          arg,
@@ -277,7 +277,6 @@ void testing_rotm_strided_batched(const Arguments& arg)
         }
 
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
 
         CHECK_HIP_ERROR(dx.transfer_from(hx));
@@ -300,9 +299,7 @@ void testing_rotm_strided_batched(const Arguments& arg)
         }
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx, dy, dparam), [&] {
             rocblas_rotm_strided_batched_fn(handle,
                                             N,
                                             dx,
@@ -314,8 +311,7 @@ void testing_rotm_strided_batched(const Arguments& arg)
                                             dparam,
                                             stride_param,
                                             batch_count);
-        }
-        gpu_time_used = (get_time_us_sync(stream) - gpu_time_used);
+        });
 
         ArgumentModel<e_N, e_incx, e_incy, e_stride_x, e_stride_y, e_batch_count>{}.log_args<T>(
             rocblas_cout,
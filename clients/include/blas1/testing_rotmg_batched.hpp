@@ -278,7 +278,6 @@ void testing_rotmg_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
 
@@ -312,18 +311,16 @@ void testing_rotmg_batched(const Arguments& arg)
         }
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
-            rocblas_rotgm_batched_fn(handle,
-                                     dd1.ptr_on_device(),
-                                     dd2.ptr_on_device(),
-                                     dx.ptr_on_device(),
-                                     dy.ptr_on_device(),
-                                     dparams.ptr_on_device(),
-                                     batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        gpu_time_used
+            = rocblas_time_hot_calls(arg, stream, std::tie(dd1, dd2, dx, dy, dparams), [&] {
+                  rocblas_rotgm_batched_fn(handle,
+                                           dd1.ptr_on_device(),
+                                           dd2.ptr_on_device(),
+                                           dx.ptr_on_device(),
+                                           dy.ptr_on_device(),
+                                           dparams.ptr_on_device(),
+                                           batch_count);
+              });
 
         ArgumentModel<e_batch_count>{}.log_args<T>(rocblas_cout,
                                                    arg,
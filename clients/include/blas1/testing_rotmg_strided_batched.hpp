@@ -293,7 +293,6 @@ void testing_rotmg_strided_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
 
@@ -334,23 +333,21 @@ void testing_rotmg_strided_batched(const Arguments& arg)
         }
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
-            rocblas_rotgm_strided_batched_fn(handle,
-                                             dd1,
-                                             stride_d1,
-                                             dd2,
-                                             stride_d2,
-                                             dx,
-                                             stride_x,
-                                             dy,
-                                             stride_y,
-                                             dparams,
-                                             stride_param,
-                                             batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        gpu_time_used
+            = rocblas_time_hot_calls(arg, stream, std::tie(dd1, dd2, dx, dy, dparams), [&] {
+                  rocblas_rotgm_strided_batched_fn(handle,
+                                                   dd1,
+                                                   stride_d1,
+                                                   dd2,
+                                                   stride_d2,
+                                                   dx,
+                                                   stride_x,
+                                                   dy,
+                                                   stride_y,
+                                                   dparams,
+                                                   stride_param,
+                                                   batch_count);
+              });
 
         ArgumentModel<e_stride_a, e_stride_b, e_stride_x, e_stride_y, e_stride_c, e_batch_count>{}
             .log_args<T>(rocblas_cout,
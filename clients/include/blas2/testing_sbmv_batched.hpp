@@ -448,7 +448,6 @@ void testing_sbmv_batched(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int iter = 0; iter < number_cold_calls; iter++)
         {
@@ -469,10 +468,7 @@ void testing_sbmv_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dAb, dx, dy), [&] {
             CHECK_ROCBLAS_ERROR(rocblas_sbmv_batched_fn(handle,
                                                         uplo,
                                                         N,
@@ -486,9 +482,7 @@ void testing_sbmv_batched(const Arguments& arg)
                                                         dy.ptr_on_device(),
                                                         incy,
                                                         batch_count));
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_uplo, e_N, e_K, e_alpha, e_lda, e_incx, e_beta, e_incy, e_batch_count>{}
             .log_args<T>(rocblas_cout,
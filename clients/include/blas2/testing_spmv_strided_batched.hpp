@@ -441,7 +441,6 @@ void testing_spmv_strided_batched(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int iter = 0; iter < number_cold_calls; iter++)
         {
@@ -463,10 +462,7 @@ void testing_spmv_strided_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dAp, dx, dy), [&] {
             CHECK_ROCBLAS_ERROR(rocblas_spmv_strided_batched_fn(handle,
                                                                 uplo,
                                                                 N,
@@ -481,9 +477,7 @@ void testing_spmv_strided_batched(const Arguments& arg)
                                                                 incy,
                                                                 stridey,
                                                                 batch_count));
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         Arguments targ(arg);
         targ.stride_a = strideA;
@@ -244,7 +244,6 @@ void testing_tbsv_batched(const Arguments& arg)
         CHECK_HIP_ERROR(dx_or_b.transfer_from(hx_or_b));
 
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int i = 0; i < number_cold_calls; i++)
             rocblas_tbsv_batched_fn(handle,
@@ -261,9 +260,7 @@ void testing_tbsv_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int i = 0; i < number_hot_calls; i++)
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dAb, dx_or_b), [&] {
             rocblas_tbsv_batched_fn(handle,
                                     uplo,
                                     transA,
@@ -275,8 +272,7 @@ void testing_tbsv_batched(const Arguments& arg)
                                     dx_or_b.ptr_on_device(),
                                     incx,
                                     batch_count);
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
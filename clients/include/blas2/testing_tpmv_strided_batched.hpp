@@ -222,14 +222,10 @@ void testing_tpmv_strided_batched(const Arguments& arg)
         {
             hipStream_t stream;
             CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-            gpu_time_used        = get_time_us_sync(stream); // in microseconds
-            int number_hot_calls = arg.iters;
-            for(int iter = 0; iter < number_hot_calls; iter++)
-            {
+            gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dAp, dx), [&] {
                 rocblas_tpmv_strided_batched_fn(
                     handle, uplo, transA, diag, M, dAp, stride_a, dx, incx, stride_x, batch_count);
-            }
-            gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+            });
         }
 
         // Log performance.
@@ -187,19 +187,15 @@ void testing_tpsv(const Arguments& arg)
         CHECK_HIP_ERROR(dx_or_b.transfer_from(cpu_x_or_b));
 
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int i = 0; i < number_cold_calls; i++)
             rocblas_tpsv_fn(handle, uplo, transA, diag, N, dAp, dx_or_b, incx);
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int i = 0; i < number_hot_calls; i++)
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dAp, dx_or_b), [&] {
             rocblas_tpsv_fn(handle, uplo, transA, diag, N, dAp, dx_or_b, incx);
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
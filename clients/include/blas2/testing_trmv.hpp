@@ -187,13 +187,9 @@ void testing_trmv(const Arguments& arg)
         {
             hipStream_t stream;
             CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-            gpu_time_used        = get_time_us_sync(stream); // in microseconds
-            int number_hot_calls = arg.iters;
-            for(int iter = 0; iter < number_hot_calls; iter++)
-            {
+            gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dx), [&] {
                 rocblas_trmv_fn(handle, uplo, transA, diag, M, dA, lda, dx, incx);
-            }
-            gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+            });
         }
 
         // Log performance.
@@ -324,7 +324,6 @@ void testing_trsv_strided_batched(const Arguments& arg)
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int i = 0; i < number_cold_calls; i++)
             rocblas_trsv_strided_batched_fn(handle,
@@ -342,9 +341,7 @@ void testing_trsv_strided_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int i = 0; i < number_hot_calls; i++)
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dx_or_b), [&] {
             rocblas_trsv_strided_batched_fn(handle,
                                             uplo,
                                             transA,
@@ -357,8 +354,7 @@ void testing_trsv_strided_batched(const Arguments& arg)
                                             incx,
                                             stride_x,
                                             batch_count);
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
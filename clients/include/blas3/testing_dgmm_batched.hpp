@@ -203,7 +203,6 @@ void testing_dgmm_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int i = 0; i < number_cold_calls; i++)
         {
@@ -222,9 +221,7 @@ void testing_dgmm_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dx, dC), [&] {
             rocblas_dgmm_batched_fn(handle,
                                     side,
                                     M,
@@ -236,8 +233,7 @@ void testing_dgmm_batched(const Arguments& arg)
                                     dC.ptr_on_device(),
                                     ldc,
                                     batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_side, e_M, e_N, e_lda, e_incx, e_ldc, e_batch_count>{}.log_args<T>(
             rocblas_cout,
@@ -306,7 +306,6 @@ void testing_dgmm_strided_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         for(int i = 0; i < number_cold_calls; i++)
         {
@@ -328,9 +327,7 @@ void testing_dgmm_strided_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dx, dC), [&] {
             rocblas_dgmm_strided_batched_fn(handle,
                                             side,
                                             M,
@@ -345,8 +342,7 @@ void testing_dgmm_strided_batched(const Arguments& arg)
                                             ldc,
                                             stride_c,
                                             batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_side,
                       e_M,
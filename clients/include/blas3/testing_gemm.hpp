@@ -345,11 +345,14 @@ void testing_gemm(const Arguments& arg)
             cpu_time_used = get_time_us_no_sync();
         }
 
-        cblas_gemm<T>(transA, transB, M, N, K, h_alpha, hA, lda, hB, ldb, h_beta, hC_gold, ldc);
+        bool cached = rocblas_cached_reference(arg, hC_gold, [&] {
+            cblas_gemm<T>(transA, transB, M, N, K, h_alpha, hA, lda, hB, ldb, h_beta, hC_gold, ldc);
+        });
 
         if(arg.timing)
         {
-            cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+            cpu_time_used = cached ? ArgumentLogging::NA_value
+                                   : get_time_us_no_sync() - cpu_time_used;
         }
 
         //releasing already used host memory
@@ -416,7 +419,6 @@ void testing_gemm(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -428,13 +430,10 @@ void testing_gemm(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dB, dC), [&] {
             rocblas_gemm_fn(
                 handle, transA, transB, M, N, K, &h_alpha, dA, lda, dB, ldb, &h_beta, dC, ldc);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_transA, e_transB, e_M, e_N, e_K, e_alpha, e_lda, e_beta, e_ldb, e_ldc>{}
             .log_args<T>(rocblas_cout,
@@ -422,12 +422,25 @@ void testing_gemm_batched(const Arguments& arg)
 
         // CPU BLAS
         cpu_time_used = get_time_us_no_sync();
-        for(rocblas_int b = 0; b < batch_count; b++)
-        {
-            cblas_gemm<T>(
-                transA, transB, M, N, K, h_alpha, hA[b], lda, hB[b], ldb, h_beta, hC_gold[b], ldc);
-        }
-        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+        bool cached = rocblas_cached_reference(arg, hC_gold, [&] {
+            for(rocblas_int b = 0; b < batch_count; b++)
+            {
+                cblas_gemm<T>(transA,
+                              transB,
+                              M,
+                              N,
+                              K,
+                              h_alpha,
+                              hA[b],
+                              lda,
+                              hB[b],
+                              ldb,
+                              h_beta,
+                              hC_gold[b],
+                              ldc);
+            }
+        });
+        cpu_time_used = cached ? ArgumentLogging::NA_value : get_time_us_no_sync() - cpu_time_used;
 
         // GPU fetch
         if(arg.pointer_mode_host)
@@ -495,7 +508,6 @@ void testing_gemm_batched(const Arguments& arg)
     if(arg.timing && arg.api != INTERNAL)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -520,10 +532,7 @@ void testing_gemm_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        double gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        double gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dB, dC), [&] {
             rocblas_gemm_batched_fn(handle,
                                     transA,
                                     transB,
@@ -539,9 +548,7 @@ void testing_gemm_batched(const Arguments& arg)
                                     dC.ptr_on_device(),
                                     ldc,
                                     batch_count);
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_transA,
                       e_transB,
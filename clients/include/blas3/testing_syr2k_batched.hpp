@@ -532,7 +532,6 @@ void testing_syr2k_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -556,9 +555,7 @@ void testing_syr2k_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dB, dC), [&] {
             rocblas_syrXX_batched_fn(handle,
                                      uplo,
                                      transA,
@@ -573,8 +570,7 @@ void testing_syr2k_batched(const Arguments& arg)
                                      dC.ptr_on_device(),
                                      ldc,
                                      batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         double gflops = syrXX_gflop_count_fn(N, K);
         ArgumentModel<e_uplo,
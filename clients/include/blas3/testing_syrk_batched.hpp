@@ -350,12 +350,15 @@ void testing_syrk_batched(const Arguments& arg)
         cpu_time_used = get_time_us_no_sync();
 
         // cpu reference
-        for(int i = 0; i < batch_count; i++)
-        {
-            cblas_syrk<T>(uplo, transA, N, K, h_alpha[0], hA[i], lda, h_beta[0], hC_gold[i], ldc);
-        }
+        bool cached = rocblas_cached_reference(arg, hC_gold, [&] {
+            for(int i = 0; i < batch_count; i++)
+            {
+                cblas_syrk<T>(
+                    uplo, transA, N, K, h_alpha[0], hA[i], lda, h_beta[0], hC_gold[i], ldc);
+            }
+        });
 
-        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+        cpu_time_used = cached ? ArgumentLogging::NA_value : get_time_us_no_sync() - cpu_time_used;
 
         if(arg.pointer_mode_host)
         {
@@ -416,7 +419,6 @@ void testing_syrk_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -438,9 +440,7 @@ void testing_syrk_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dC), [&] {
             rocblas_syrk_batched_fn(handle,
                                     uplo,
                                     transA,
@@ -453,8 +453,7 @@ void testing_syrk_batched(const Arguments& arg)
                                     dC.ptr_on_device(),
                                     ldc,
                                     batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_uplo, e_transA, e_N, e_K, e_alpha, e_lda, e_beta, e_ldc, e_batch_count>{}
             .log_args<T>(rocblas_cout,
@@ -482,12 +482,15 @@ void testing_syrk_strided_batched(const Arguments& arg)
         cpu_time_used = get_time_us_no_sync();
 
         // cpu reference
-        for(int b = 0; b < batch_count; b++)
-        {
-            cblas_syrk<T>(uplo, transA, N, K, h_alpha[0], hA[b], lda, h_beta[0], hC_gold[b], ldc);
-        }
+        bool cached = rocblas_cached_reference(arg, hC_gold, [&] {
+            for(int b = 0; b < batch_count; b++)
+            {
+                cblas_syrk<T>(
+                    uplo, transA, N, K, h_alpha[0], hA[b], lda, h_beta[0], hC_gold[b], ldc);
+            }
+        });
 
-        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+        cpu_time_used = cached ? ArgumentLogging::NA_value : get_time_us_no_sync() - cpu_time_used;
 
         if(arg.pointer_mode_host)
         {
@@ -548,7 +551,6 @@ void testing_syrk_strided_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -572,9 +574,7 @@ void testing_syrk_strided_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dC), [&] {
             rocblas_syrk_strided_batched_fn(handle,
                                             uplo,
                                             transA,
@@ -589,8 +589,7 @@ void testing_syrk_strided_batched(const Arguments& arg)
                                             ldc,
                                             strideC,
                                             batch_count);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         Arguments targ(arg);
         targ.stride_a = strideA;
@@ -521,7 +521,6 @@ void testing_trmm(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
@@ -545,9 +544,7 @@ void testing_trmm(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dB, dC), [&] {
             CHECK_ROCBLAS_ERROR(rocblas_trmm_fn(handle,
                                                 side,
                                                 uplo,
@@ -562,8 +559,7 @@ void testing_trmm(const Arguments& arg)
                                                 ldb,
                                                 *dOut,
                                                 ldOut));
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_side,
                       e_uplo,
@@ -274,7 +274,9 @@ void testing_trsm(const Arguments& arg)
     copy_matrix_with_different_leading_dimensions(hX, hB);
 
     // Calculate hB = hA*hX;
-    cblas_trmm<T>(side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA, lda, hB, M);
+    rocblas_cached_reference(arg, hB, [&] {
+        cblas_trmm<T>(side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA, lda, hB, M);
+    });
     copy_matrix_with_different_leading_dimensions(hB, hXorB_1);
 
     // copy data from CPU to device
@@ -458,7 +460,6 @@ void testing_trsm(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         // GPU rocBLAS
         CHECK_HIP_ERROR(dXorB.transfer_from(hXorB_1));
@@ -473,15 +474,10 @@ void testing_trsm(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dXorB), [&] {
             CHECK_ROCBLAS_ERROR(rocblas_trsm_fn(
                 handle, side, uplo, transA, diag, M, N, &alpha_h, dA, lda, dXorB, ldb));
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         // CPU cblas
         copy_matrix_with_different_leading_dimensions(hB, hXorB_1);
@@ -386,11 +386,13 @@ void testing_trsm_batched(const Arguments& arg)
 
     copy_matrix_with_different_leading_dimensions(hX, hB);
 
-    for(int b = 0; b < batch_count; b++)
-    {
-        // Calculate hB = hA*hX
-        cblas_trmm<T>(side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA[b], lda, hB[b], M);
-    }
+    rocblas_cached_reference(arg, hB, [&] {
+        for(int b = 0; b < batch_count; b++)
+        {
+            // Calculate hB = hA*hX
+            cblas_trmm<T>(side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA[b], lda, hB[b], M);
+        }
+    });
 
     copy_matrix_with_different_leading_dimensions(hB, hXorB_1);
 
@@ -623,7 +625,6 @@ void testing_trsm_batched(const Arguments& arg)
     if(arg.timing && !internal_api)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         // GPU rocBLAS
         CHECK_HIP_ERROR(dXorB.transfer_from(hXorB_1));
@@ -651,10 +652,7 @@ void testing_trsm_batched(const Arguments& arg)
                                                         batch_count));
         }
 
-        gpu_time_used = get_time_us_sync(stream);
-
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dXorB), [&] {
             CHECK_ROCBLAS_ERROR(rocblas_trsm_batched_fn(handle,
                                                         side,
                                                         uplo,
@@ -668,9 +666,7 @@ void testing_trsm_batched(const Arguments& arg)
                                                         dXorB.ptr_on_device(),
                                                         ldb,
                                                         batch_count));
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
@@ -507,8 +507,10 @@ void testing_trsm_strided_batched(const Arguments& arg)
     hB.copy_from(hX);
 
     // Calculate hB = hA*hX;
-    for(int b = 0; b < batch_count; b++)
-        cblas_trmm<T>(side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA[b], lda, hB[b], ldb);
+    rocblas_cached_reference(arg, hB, [&] {
+        for(int b = 0; b < batch_count; b++)
+            cblas_trmm<T>(side, uplo, transA, diag, M, N, 1.0 / alpha_h, hA[b], lda, hB[b], ldb);
+    });
 
     hXorB_1.copy_from(hB);
 
@@ -742,7 +744,6 @@ void testing_trsm_strided_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
 
         // GPU rocBLAS
         CHECK_HIP_ERROR(dXorB.transfer_from(hXorB_1));
@@ -770,10 +771,7 @@ void testing_trsm_strided_batched(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dXorB), [&] {
             CHECK_ROCBLAS_ERROR(rocblas_trsm_strided_batched_fn(handle,
                                                                 side,
                                                                 uplo,
@@ -789,9 +787,7 @@ void testing_trsm_strided_batched(const Arguments& arg)
                                                                 ldb,
                                                                 stride_B,
                                                                 batch_count));
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
@@ -298,19 +298,17 @@ void testing_trtri(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int total_calls       = number_cold_calls + arg.iters;
 
-        hipStream_t stream;
-        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        for(int i = 0; i < total_calls; i++)
+        for(int i = 0; i < number_cold_calls; i++)
         {
-            if(i == number_cold_calls)
-                gpu_time_used = get_time_us_sync(stream);
-
             rocblas_trtri_fn(handle, uplo, diag, N, dA, lda, dinvA, ldinvA);
         }
 
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dinvA), [&] {
+            rocblas_trtri_fn(handle, uplo, diag, N, dA, lda, dinvA, ldinvA);
+        });
         ArgumentModel<e_uplo, e_diag, e_N, e_lda>{}.log_args<T>(rocblas_cout,
                                                                 arg,
                                                                 gpu_time_used,
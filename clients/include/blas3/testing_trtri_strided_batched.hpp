@@ -364,20 +364,19 @@ void testing_trtri_strided_batched(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int total_calls       = number_cold_calls + arg.iters;
 
-        hipStream_t stream;
-        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        for(int i = 0; i < total_calls; i++)
+        for(int i = 0; i < number_cold_calls; i++)
         {
-            if(i == number_cold_calls)
-                gpu_time_used = get_time_us_sync(stream);
-
             rocblas_trtri_strided_batched_fn(
                 handle, uplo, diag, N, dA, lda, stride_A, dinvA, lda, stride_A, batch_count);
         }
 
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        hipStream_t stream;
+        CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dinvA), [&] {
+            rocblas_trtri_strided_batched_fn(
+                handle, uplo, diag, N, dA, lda, stride_A, dinvA, lda, stride_A, batch_count);
+        });
 
         ArgumentModel<e_uplo, e_diag, e_N, e_lda, e_stride_a, e_batch_count>{}.log_args<T>(
             rocblas_cout,
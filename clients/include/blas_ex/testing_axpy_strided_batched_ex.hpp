@@ -399,7 +399,6 @@ void testing_axpy_strided_batched_ex(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_host));
 
         // Transfer from host to device.
@@ -429,9 +428,7 @@ void testing_axpy_strided_batched_ex(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx, dy), [&] {
             rocblas_axpy_strided_batched_ex_fn(handle,
                                                N,
                                                &h_alpha,
@@ -446,8 +443,7 @@ void testing_axpy_strided_batched_ex(const Arguments& arg)
                                                stridey,
                                                batch_count,
                                                execution_type);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_N, e_alpha, e_incx, e_incy, e_stride_x, e_stride_y, e_batch_count>{}
             .log_args<Ta>(rocblas_cout,
@@ -373,7 +373,6 @@ void testing_dot_strided_batched_ex(const Arguments& arg)
     if(arg.timing)
     {
         int number_cold_calls = arg.cold_iters;
-        int number_hot_calls  = arg.iters;
         CHECK_ROCBLAS_ERROR(rocblas_set_pointer_mode(handle, rocblas_pointer_mode_device));
 
         for(int iter = 0; iter < number_cold_calls; iter++)
@@ -396,17 +395,14 @@ void testing_dot_strided_batched_ex(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        for(int iter = 0; iter < number_hot_calls; iter++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dx, dy), [&] {
             (rocblas_dot_strided_batched_ex_fn)(handle,
                                                 N,
                                                 dx,
                                                 x_type,
                                                 incx,
                                                 stride_x,
-                                                dy_ptr,
+                                                (arg.algo) ? (Tx*)(dx) : (Ty*)(dy),
                                                 y_type,
                                                 incy,
                                                 stride_y,
@@ -414,9 +410,7 @@ void testing_dot_strided_batched_ex(const Arguments& arg)
                                                 d_rocblas_result_2,
                                                 result_type,
                                                 execution_type);
-        }
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_N, e_incx, e_incy, e_stride_x, e_stride_y, e_batch_count, e_algo>{}
             .log_args<Tx>(rocblas_cout,
@@ -641,12 +641,9 @@ void testing_gemm_strided_batched_ex(const Arguments& arg)
                                                                    flags));
         }
 
-        int         number_hot_calls = arg.iters;
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-        for(int i = 0; i < number_hot_calls; i++)
-        {
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dB, dC, dD), [&] {
             rocblas_gemm_strided_batched_ex_fn(handle,
                                                transA,
                                                transB,
@@ -676,8 +673,7 @@ void testing_gemm_strided_batched_ex(const Arguments& arg)
                                                algo,
                                                solution_index,
                                                flags);
-        }
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        });
 
         ArgumentModel<e_transA,
                       e_transB,
@@ -584,26 +584,24 @@ void testing_trsm_batched_ex(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        CHECK_ROCBLAS_ERROR(rocblas_trsm_batched_ex_fn(handle,
-                                                       side,
-                                                       uplo,
-                                                       transA,
-                                                       diag,
-                                                       M,
-                                                       N,
-                                                       &alpha_h,
-                                                       dA.ptr_on_device(),
-                                                       lda,
-                                                       dXorB.ptr_on_device(),
-                                                       ldb,
-                                                       batch_count,
-                                                       dinvA.ptr_on_device(),
-                                                       TRSM_BLOCK * K,
-                                                       arg.compute_type));
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dXorB, dinvA), [&] {
+            CHECK_ROCBLAS_ERROR(rocblas_trsm_batched_ex_fn(handle,
+                                                           side,
+                                                           uplo,
+                                                           transA,
+                                                           diag,
+                                                           M,
+                                                           N,
+                                                           &alpha_h,
+                                                           dA.ptr_on_device(),
+                                                           lda,
+                                                           dXorB.ptr_on_device(),
+                                                           ldb,
+                                                           batch_count,
+                                                           dinvA.ptr_on_device(),
+                                                           TRSM_BLOCK * K,
+                                                           arg.compute_type));
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
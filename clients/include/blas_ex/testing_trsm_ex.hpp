@@ -526,12 +526,10 @@ void testing_trsm_ex(const Arguments& arg)
 
         hipStream_t stream;
         CHECK_ROCBLAS_ERROR(rocblas_get_stream(handle, &stream));
-        gpu_time_used = get_time_us_sync(stream); // in microseconds
-
-        CHECK_ROCBLAS_ERROR(
-            rocblas_trsm<T>(handle, side, uplo, transA, diag, M, N, &alpha_h, dA, lda, dXorB, ldb));
-
-        gpu_time_used = get_time_us_sync(stream) - gpu_time_used;
+        gpu_time_used = rocblas_time_hot_calls(arg, stream, std::tie(dA, dXorB), [&] {
+            CHECK_ROCBLAS_ERROR(rocblas_trsm<T>(
+                handle, side, uplo, transA, diag, M, N, &alpha_h, dA, lda, dXorB, ldb));
+        });
 
         // CPU cblas
         cpu_time_used = get_time_us_no_sync();
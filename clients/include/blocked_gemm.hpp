@@ -0,0 +1,256 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Cache-blocked host GEMM for 16-bit floating point reference results       *
+ *                                                                           *
+ * C = alpha * op(A) * op(B) + beta * C is computed in float, one tile of C  *
+ * at a time. Blocks of A and B are converted to float while they are packed *
+ * into panels, so no full-size float copy of any matrix is made. Tiles of C *
+ * are distributed over OpenMP threads, and each thread owns its packing and *
+ * accumulation buffers.                                                     *
+ *                                                                           *
+ * The conversions of A, B and C to float are passed in, so that the caller  *
+ * can apply the rounding of the data type under test. Results are converted *
+ * to the type of C with static_cast.                                        *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Rows and columns of the register tile, and rows, columns and depth of the cache blocks
+constexpr int64_t rocblas_blocked_gemm_mr = 16;
+constexpr int64_t rocblas_blocked_gemm_nr = 4;
+constexpr int64_t rocblas_blocked_gemm_mc = 128;
+constexpr int64_t rocblas_blocked_gemm_nc = 128;
+constexpr int64_t rocblas_blocked_gemm_kc = 256;
+
+//! @brief Packs op(A)(i0:i0+mb, p0:p0+kb) as float into panels of mr rows, zero padded
+template <typename Ti, typename F>
+void rocblas_blocked_gemm_pack_a(bool      trans,
+                                 const Ti* A,
+                                 int64_t   lda,
+                                 int64_t   i0,
+                                 int64_t   p0,
+                                 int64_t   mb,
+                                 int64_t   kb,
+                                 float*    pack,
+                                 F&        load)
+{
+    constexpr int64_t mr = rocblas_blocked_gemm_mr;
+    const int64_t     mp = (mb + mr - 1) / mr * mr;
+
+    if(!trans)
+    {
+        for(int64_t p = 0; p < kb; p++)
+        {
+            const Ti* src = A + i0 + (p0 + p) * lda;
+            for(int64_t i = 0; i < mp; i += mr)
+            {
+                float*        dst  = pack + i * kb + p * mr;
+                const int64_t rows = std::min(mr, mb - i);
+                for(int64_t r = 0; r < rows; r++)
+                    dst[r] = load(src[i + r]);
+                for(int64_t r = rows; r < mr; r++)
+                    dst[r] = 0;
+            }
+        }
+    }
+    else
+    {
+        for(int64_t i = 0; i < mp; i++)
+        {
+            float* dst = pack + (i / mr) * mr * kb + i % mr;
+            if(i < mb)
+            {
+                const Ti* src = A + p0 + (i0 + i) * lda;
+                for(int64_t p = 0; p < kb; p++)
+                    dst[p * mr] = load(src[p]);
+            }
+            else
+            {
+                for(int64_t p = 0; p < kb; p++)
+                    dst[p * mr] = 0;
+            }
+        }
+    }
+}
+
+//! @brief Packs op(B)(p0:p0+kb, j0:j0+nb) as float into panels of nr columns, zero padded
+template <typename Ti, typename F>
+void rocblas_blocked_gemm_pack_b(bool      trans,
+                                 const Ti* B,
+                                 int64_t   ldb,
+                                 int64_t   p0,
+                                 int64_t   j0,
+                                 int64_t   kb,
+                                 int64_t   nb,
+                                 float*    pack,
+                                 F&        load)
+{
+    constexpr int64_t nr = rocblas_blocked_gemm_nr;
+    const int64_t     np = (nb + nr - 1) / nr * nr;
+
+    if(!trans)
+    {
+        for(int64_t j = 0; j < np; j++)
+        {
+            float* dst = pack + (j / nr) * nr * kb + j % nr;
+            if(j < nb)
+            {
+                const Ti* src = B + p0 + (j0 + j) * ldb;
+                for(int64_t p = 0; p < kb; p++)
+                    dst[p * nr] = load(src[p]);
+            }
+            else
+            {
+                for(int64_t p = 0; p < kb; p++)
+                    dst[p * nr] = 0;
+            }
+        }
+    }
+    else
+    {
+        for(int64_t p = 0; p < kb; p++)
+        {
+            const Ti* src = B + j0 + (p0 + p) * ldb;
+            for(int64_t j = 0; j < np; j += nr)
+            {
+                float*        dst  = pack + j * kb + p * nr;
+                const int64_t cols = std::min(nr, nb - j);
+                for(int64_t c = 0; c < cols; c++)
+                    dst[c] = load(src[j + c]);
+                for(int64_t c = cols; c < nr; c++)
+                    dst[c] = 0;
+            }
+        }
+    }
+}
+
+//! @brief Adds the product of a packed panel of A and a packed panel of B to an mr x nr tile
+inline void rocblas_blocked_gemm_kernel(
+    int64_t kb, const float* __restrict__ a, const float* __restrict__ b, float* c, int64_t ldc)
+{
+    constexpr int64_t mr = rocblas_blocked_gemm_mr;
+    constexpr int64_t nr = rocblas_blocked_gemm_nr;
+
+    // The panels are copied to locals so that the accumulators stay in vector registers
+    float acc[nr][mr] = {};
+    for(int64_t p = 0; p < kb; p++)
+    {
+        float ap[mr], bp[nr];
+        for(int64_t i = 0; i < mr; i++)
+            ap[i] = a[p * mr + i];
+        for(int64_t j = 0; j < nr; j++)
+            bp[j] = b[p * nr + j];
+
+        for(int64_t j = 0; j < nr; j++)
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for(int64_t i = 0; i < mr; i++)
+                acc[j][i] += ap[i] * bp[j];
+    }
+
+    for(int64_t j = 0; j < nr; j++)
+        for(int64_t i = 0; i < mr; i++)
+            c[j * ldc + i] += acc[j][i];
+}
+
+/*! @brief C = alpha * op(A) * op(B) + beta * C with float accumulation
+    @param[in] load_ab converts an element of A or B to float
+    @param[in] load_c  converts an element of C to float; C is not read when beta is 0 */
+template <typename Ti, typename To, typename FAB, typename FC>
+void rocblas_blocked_gemm(bool      transA,
+                          bool      transB,
+                          int64_t   m,
+                          int64_t   n,
+                          int64_t   k,
+                          float     alpha,
+                          const Ti* A,
+                          int64_t   lda,
+                          const Ti* B,
+                          int64_t   ldb,
+                          float     beta,
+                          To*       C,
+                          int64_t   ldc,
+                          FAB       load_ab,
+                          FC        load_c)
+{
+    constexpr int64_t mr = rocblas_blocked_gemm_mr;
+    constexpr int64_t nr = rocblas_blocked_gemm_nr;
+    constexpr int64_t mc = rocblas_blocked_gemm_mc;
+    constexpr int64_t nc = rocblas_blocked_gemm_nc;
+    constexpr int64_t kc = rocblas_blocked_gemm_kc;
+
+    if(m <= 0 || n <= 0)
+        return;
+
+    const int64_t m_tiles = (m + mc - 1) / mc;
+    const int64_t tiles   = m_tiles * ((n + nc - 1) / nc);
+
+#ifdef _OPENMP
+#pragma omp parallel if(tiles > 1)
+#endif
+    {
+        std::vector<float> a_pack(mc * kc), b_pack(kc * nc), c_tile(mc * nc);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for(int64_t t = 0; t < tiles; t++)
+        {
+            const int64_t i0 = t % m_tiles * mc, mb = std::min(mc, m - i0);
+            const int64_t j0 = t / m_tiles * nc, nb = std::min(nc, n - j0);
+
+            std::fill(c_tile.begin(), c_tile.end(), 0.0f);
+
+            // The product is skipped when alpha is 0, as by cblas_sgemm
+            for(int64_t p0 = 0; alpha != 0 && p0 < k; p0 += kc)
+            {
+                const int64_t kb = std::min(kc, k - p0);
+                rocblas_blocked_gemm_pack_a(transA, A, lda, i0, p0, mb, kb, a_pack.data(), load_ab);
+                rocblas_blocked_gemm_pack_b(transB, B, ldb, p0, j0, kb, nb, b_pack.data(), load_ab);
+
+                for(int64_t j = 0; j < nb; j += nr)
+                    for(int64_t i = 0; i < mb; i += mr)
+                        rocblas_blocked_gemm_kernel(
+                            kb, &a_pack[i * kb], &b_pack[j * kb], &c_tile[i + j * mc], mc);
+            }
+
+            for(int64_t j = 0; j < nb; j++)
+            {
+                const float* src = &c_tile[j * mc];
+                To*          dst = C + i0 + (j0 + j) * ldc;
+                if(beta == 0)
+                    for(int64_t i = 0; i < mb; i++)
+                        dst[i] = static_cast<To>(alpha * src[i]);
+                else
+                    for(int64_t i = 0; i < mb; i++)
+                        dst[i] = static_cast<To>(alpha * src[i] + beta * load_c(dst[i]));
+            }
+        }
+    }
+}
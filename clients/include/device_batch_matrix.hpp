@@ -221,6 +221,19 @@ public:
         return hipSuccess;
     }
 
+    //!
+    //! @brief Copy from a device batched matrix of the same dimensions.
+    //! @param that The device_batch_matrix to copy.
+    //!
+    hipError_t transfer_from(const device_batch_matrix& that)
+    {
+        if(m_batch_count > 0)
+            return hipMemcpy(
+                (*this)[0], that[0], sizeof(T) * m_nmemb * m_batch_count, hipMemcpyDefault);
+
+        return hipSuccess;
+    }
+
     //!
     //! @brief Check if memory exists.
     //! @return hipSuccess if memory exists, hipErrorOutOfMemory otherwise.
@@ -233,6 +246,16 @@ public:
             return hipErrorOutOfMemory;
     }
 
+    //!
+    //! @brief Exchange the device memory with that of a batch matrix of the same dimensions.
+    //! @param that The device batch matrix.
+    //!
+    void swap_memory(device_batch_matrix& that)
+    {
+        std::swap(m_data, that.m_data);
+        std::swap(m_device_data, that.m_device_data);
+    }
+
 private:
     size_t  m_m{};
     size_t  m_n{};
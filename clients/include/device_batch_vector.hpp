@@ -209,6 +209,19 @@ public:
         return hipSuccess;
     }
 
+    //!
+    //! @brief Copy from a device batched vector of the same dimensions.
+    //! @param that The device_batch_vector to copy.
+    //!
+    hipError_t transfer_from(const device_batch_vector& that)
+    {
+        if(m_batch_count > 0)
+            return hipMemcpy(
+                (*this)[0], that[0], sizeof(T) * m_nmemb * m_batch_count, hipMemcpyDefault);
+
+        return hipSuccess;
+    }
+
     //!
     //! @brief Check if memory exists.
     //! @return hipSuccess if memory exists, hipErrorOutOfMemory otherwise.
@@ -221,6 +234,16 @@ public:
             return hipErrorOutOfMemory;
     }
 
+    //!
+    //! @brief Exchange the device memory with that of a batch vector of the same dimensions.
+    //! @param that The device batch vector.
+    //!
+    void swap_memory(device_batch_vector& that)
+    {
+        std::swap(m_data, that.m_data);
+        std::swap(m_device_data, that.m_device_data);
+    }
+
 private:
     size_t  m_n{};
     int64_t m_inc{};
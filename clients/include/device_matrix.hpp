@@ -142,11 +142,30 @@ public:
                          this->use_HMM ? hipMemcpyHostToHost : hipMemcpyHostToDevice);
     }
 
+    //!
+    //! @brief Transfer data from a device matrix of the same dimensions.
+    //! @param that The device matrix.
+    //! @return the hip error.
+    //!
+    hipError_t transfer_from(const device_matrix& that)
+    {
+        return hipMemcpy(m_data, (const T*)that, this->nmemb() * sizeof(T), hipMemcpyDefault);
+    }
+
     hipError_t memcheck() const
     {
         return !this->nmemb() || m_data ? hipSuccess : hipErrorOutOfMemory;
     }
 
+    //!
+    //! @brief Exchange the device memory with that of a matrix of the same dimensions.
+    //! @param that The device matrix.
+    //!
+    void swap_memory(device_matrix& that)
+    {
+        std::swap(m_data, that.m_data);
+    }
+
 private:
     size_t m_m   = 0;
     size_t m_n   = 0;
@@ -205,6 +205,16 @@ public:
                          this->use_HMM ? hipMemcpyHostToHost : hipMemcpyHostToDevice);
     }
 
+    //!
+    //! @brief Transfer data from a strided batched matrix on device of the same dimensions.
+    //! @param that That strided batched matrix on device.
+    //! @return The hip error.
+    //!
+    hipError_t transfer_from(const device_strided_batch_matrix& that)
+    {
+        return hipMemcpy(this->data(), that.data(), sizeof(T) * this->nmemb(), hipMemcpyDefault);
+    }
+
     //!
     //! @brief Check if memory exists.
     //! @return hipSuccess if memory exists, hipErrorOutOfMemory otherwise.
@@ -217,6 +227,15 @@ public:
             return hipErrorOutOfMemory;
     }
 
+    //!
+    //! @brief Exchange the device memory with that of a matrix of the same dimensions.
+    //! @param that The device strided batch matrix.
+    //!
+    void swap_memory(device_strided_batch_matrix& that)
+    {
+        std::swap(m_data, that.m_data);
+    }
+
 private:
     size_t         m_m{};
     size_t         m_n{};
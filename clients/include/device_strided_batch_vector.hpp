@@ -187,6 +187,16 @@ public:
                          this->use_HMM ? hipMemcpyHostToHost : hipMemcpyHostToDevice);
     }
 
+    //!
+    //! @brief Transfer data from a strided batched vector on device of the same dimensions.
+    //! @param that That strided batched vector on device.
+    //! @return The hip error.
+    //!
+    hipError_t transfer_from(const device_strided_batch_vector& that)
+    {
+        return hipMemcpy(this->data(), that.data(), sizeof(T) * this->nmemb(), hipMemcpyDefault);
+    }
+
     //!
     //! @brief Check if memory exists.
     //! @return hipSuccess if memory exists, hipErrorOutOfMemory otherwise.
@@ -199,6 +209,15 @@ public:
             return hipErrorOutOfMemory;
     }
 
+    //!
+    //! @brief Exchange the device memory with that of a vector of the same dimensions.
+    //! @param that The device strided batch vector.
+    //!
+    void swap_memory(device_strided_batch_vector& that)
+    {
+        std::swap(m_data, that.m_data);
+    }
+
 private:
     size_t         m_n{};
     int64_t        m_inc{};
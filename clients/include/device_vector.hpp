@@ -132,11 +132,30 @@ public:
                          this->use_HMM ? hipMemcpyHostToHost : hipMemcpyHostToDevice);
     }
 
+    //!
+    //! @brief Transfer data from a device vector of the same dimensions.
+    //! @param that The device vector.
+    //! @return the hip error.
+    //!
+    hipError_t transfer_from(const device_vector& that)
+    {
+        return hipMemcpy(m_data, (const T*)that, this->nmemb() * sizeof(T), hipMemcpyDefault);
+    }
+
     hipError_t memcheck() const
     {
         return !this->nmemb() || m_data ? hipSuccess : hipErrorOutOfMemory;
     }
 
+    //!
+    //! @brief Exchange the device memory with that of a vector of the same dimensions.
+    //! @param that The device vector.
+    //!
+    void swap_memory(device_vector& that)
+    {
+        std::swap(m_data, that.m_data);
+    }
+
 private:
     size_t  m_n{};
     int64_t m_inc{};
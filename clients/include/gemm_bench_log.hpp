@@ -0,0 +1,279 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Reading captures of rocblas_layer_mode_log_bench                          *
+ *                                                                           *
+ * Bench logging writes one rocblas-bench command line per call. The GEMM    *
+ * lines of a capture are parsed into rocblas_gemm_bench_call, and repeated  *
+ * calls are counted, so that rocblas-bench --coverage can weigh each        *
+ * distinct problem by how often the application made it. Lines of other     *
+ * functions are skipped.                                                    *
+ *****************************************************************************/
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Datatype name of a rocblas-bench precision, which may be a BLAS letter or a datatype name
+inline std::string rocblas_gemm_bench_type(const std::string& precision)
+{
+    static const std::map<std::string, std::string> letters{
+        {"h", "f16_r"}, {"s", "f32_r"}, {"d", "f64_r"}, {"c", "f32_c"}, {"z", "f64_c"}};
+    auto it = letters.find(precision);
+    return it == letters.end() ? precision : it->second;
+}
+
+// Size in bytes of an element of a GEMM datatype, or 0 if GEMM does not support it
+inline size_t rocblas_gemm_bench_type_size(const std::string& type)
+{
+    static const std::map<std::string, size_t> sizes{{"f16_r", 2},
+                                                     {"bf16_r", 2},
+                                                     {"f32_r", 4},
+                                                     {"f64_r", 8},
+                                                     {"i8_r", 1},
+                                                     {"i32_r", 4},
+                                                     {"f32_c", 8},
+                                                     {"f64_c", 16}};
+    auto it = sizes.find(type);
+    return it == sizes.end() ? 0 : it->second;
+}
+
+struct rocblas_gemm_bench_call
+{
+    std::string function;
+    std::string a_type, b_type, c_type, d_type, compute_type;
+    char        transA = 'N', transB = 'N';
+    int64_t     M = 128, N = 128, K = 128;
+    int64_t     lda = 0, ldb = 0, ldc = 0, ldd = 0;
+    int64_t     stride_a = 0, stride_b = 0, stride_c = 0, stride_d = 0;
+    int64_t     batch_count = 1;
+    double      alpha = 1, alphai = 0, beta = 0, betai = 0;
+    uint32_t    flags = 0;
+
+    // The calls of gemm_batched and gemm_batched_ex use arrays of pointers
+    bool batched() const
+    {
+        return function.find("_batched") != std::string::npos
+               && function.find("_strided_batched") == std::string::npos;
+    }
+
+    // Options of rocblas-bench for the equivalent strided batched call. They are equal for
+    // calls which select the same solution, and can be passed to rocblas-bench or to tuning.
+    std::string options() const
+    {
+        std::ostringstream os;
+        os << "-f gemm_strided_batched_ex --transposeA " << transA << " --transposeB " << transB
+           << " -m " << M << " -n " << N << " -k " << K << " --alpha " << alpha;
+        if(alphai)
+            os << " --alphai " << alphai;
+        os << " --a_type " << a_type << " --lda " << lda << " --stride_a " << stride_a
+           << " --b_type " << b_type << " --ldb " << ldb << " --stride_b " << stride_b
+           << " --beta " << beta;
+        if(betai)
+            os << " --betai " << betai;
+        os << " --c_type " << c_type << " --ldc " << ldc << " --stride_c " << stride_c
+           << " --d_type " << d_type << " --ldd " << ldd << " --stride_d " << stride_d
+           << " --batch_count " << batch_count << " --compute_type " << compute_type
+           << " --flags " << flags;
+        return os.str();
+    }
+};
+
+/*****************************************************************************
+ * Parse a line of a bench log. Returns 1 if it is a GEMM call, 0 if it is   *
+ * not, or -1 if it is a malformed GEMM call, in which case call is          *
+ * unchanged.                                                                *
+ *****************************************************************************/
+inline int rocblas_gemm_bench_parse(const std::string& line, rocblas_gemm_bench_call& call)
+{
+    static const std::map<std::string, std::string> aliases{{"-f", "--function"},
+                                                            {"-r", "--precision"},
+                                                            {"-m", "--sizem"},
+                                                            {"-n", "--sizen"},
+                                                            {"-k", "--sizek"},
+                                                            {"--batch", "--batch_count"}};
+
+    // An option is followed by its value, unless the next token is another option. Negative
+    // numbers, including -nan and -inf, are values.
+    auto is_option = [](const std::string& token) {
+        char* end;
+        std::strtod(token.c_str(), &end);
+        return token.size() > 1 && token[0] == '-' && *end;
+    };
+
+    std::istringstream                 in(line);
+    std::vector<std::string>           tokens{std::istream_iterator<std::string>(in), {}};
+    std::map<std::string, std::string> options;
+    for(size_t i = 0; i < tokens.size(); i++)
+    {
+        if(!is_option(tokens[i]))
+            continue;
+        auto alias = aliases.find(tokens[i]);
+        auto name  = alias == aliases.end() ? tokens[i] : alias->second;
+        if(i + 1 < tokens.size() && !is_option(tokens[i + 1]))
+            options[name] = tokens[++i];
+        else
+            options[name] = "";
+    }
+
+    static const char* functions[] = {"gemm",
+                                      "gemm_batched",
+                                      "gemm_strided_batched",
+                                      "gemm_ex",
+                                      "gemm_batched_ex",
+                                      "gemm_strided_batched_ex"};
+    rocblas_gemm_bench_call parsed;
+    parsed.function = options["--function"];
+    bool gemm       = false;
+    for(auto function : functions)
+        gemm = gemm || parsed.function == function;
+    if(!gemm)
+        return 0;
+
+    // The function decides the types of the calls other than gemm_ex and its batched forms
+    bool ex = parsed.function.find("_ex") != std::string::npos;
+
+    bool valid = true;
+    auto get   = [&](const char* name, auto& value) {
+        auto it = options.find(name);
+        if(it == options.end())
+            return false;
+        char* end;
+        if(std::is_floating_point<std::decay_t<decltype(value)>>{})
+            value = std::strtod(it->second.c_str(), &end);
+        else
+            value = std::strtoll(it->second.c_str(), &end, 10);
+        valid = valid && !it->second.empty() && !*end;
+        return true;
+    };
+    auto get_trans = [&](const char* name, char& trans) {
+        auto it = options.find(name);
+        if(it != options.end())
+        {
+            trans = it->second.size() == 1 ? toupper(it->second[0]) : 0;
+            valid = valid && (trans == 'N' || trans == 'T' || trans == 'C');
+        }
+    };
+    auto get_type = [&](const char* name, std::string& type, const std::string& precision) {
+        auto it = ex ? options.find(name) : options.end();
+        type    = it == options.end() ? precision : rocblas_gemm_bench_type(it->second);
+        valid   = valid && rocblas_gemm_bench_type_size(type);
+    };
+
+    auto precision = rocblas_gemm_bench_type(options.count("--precision") ? options["--precision"]
+                                                                          : "f32_r");
+    get_type("--a_type", parsed.a_type, precision);
+    get_type("--b_type", parsed.b_type, precision);
+    get_type("--c_type", parsed.c_type, precision);
+    get_type("--d_type", parsed.d_type, precision);
+    get_type("--compute_type", parsed.compute_type, precision);
+    get_trans("--transposeA", parsed.transA);
+    get_trans("--transposeB", parsed.transB);
+    get("--sizem", parsed.M);
+    get("--sizen", parsed.N);
+    get("--sizek", parsed.K);
+    get("--alpha", parsed.alpha);
+    get("--alphai", parsed.alphai);
+    get("--beta", parsed.beta);
+    get("--betai", parsed.betai);
+    get("--batch_count", parsed.batch_count);
+    if(ex)
+        get("--flags", parsed.flags);
+
+    int64_t rows_a = parsed.transA == 'N' ? parsed.M : parsed.K;
+    int64_t cols_a = parsed.transA == 'N' ? parsed.K : parsed.M;
+    int64_t rows_b = parsed.transB == 'N' ? parsed.K : parsed.N;
+    int64_t cols_b = parsed.transB == 'N' ? parsed.N : parsed.K;
+    if(!get("--lda", parsed.lda))
+        parsed.lda = rows_a;
+    if(!get("--ldb", parsed.ldb))
+        parsed.ldb = rows_b;
+    if(!get("--ldc", parsed.ldc))
+        parsed.ldc = parsed.M;
+    if(!get("--ldd", parsed.ldd))
+        parsed.ldd = parsed.ldc;
+
+    // Batched calls, and strided ones whose strides are not logged, have packed matrices
+    if(!get("--stride_a", parsed.stride_a) || parsed.batched())
+        parsed.stride_a = parsed.lda * cols_a;
+    if(!get("--stride_b", parsed.stride_b) || parsed.batched())
+        parsed.stride_b = parsed.ldb * cols_b;
+    if(!get("--stride_c", parsed.stride_c) || parsed.batched())
+        parsed.stride_c = parsed.ldc * parsed.N;
+    if(!get("--stride_d", parsed.stride_d) || parsed.batched())
+        parsed.stride_d = parsed.ldd * parsed.N;
+
+    if(!valid || parsed.M < 0 || parsed.N < 0 || parsed.K < 0 || parsed.batch_count < 0
+       || parsed.lda < rows_a || parsed.ldb < rows_b || parsed.ldc < parsed.M
+       || parsed.ldd < parsed.M)
+        return -1;
+
+    call = parsed;
+    return 1;
+}
+
+struct rocblas_gemm_bench_capture
+{
+    std::vector<rocblas_gemm_bench_call> calls; // distinct calls, in order of first appearance
+    std::vector<size_t>                  counts; // number of times each call was captured
+    size_t                               skipped   = 0; // lines of other functions
+    size_t                               malformed = 0; // GEMM lines which could not be parsed
+};
+
+// Add the GEMM calls of a bench log to capture
+inline void rocblas_gemm_bench_read(std::istream& in, rocblas_gemm_bench_capture& capture)
+{
+    std::map<std::string, size_t> index;
+    for(size_t i = 0; i < capture.calls.size(); i++)
+        index.emplace(capture.calls[i].options(), i);
+
+    std::string line;
+    while(std::getline(in, line))
+    {
+        rocblas_gemm_bench_call call;
+        int                     parsed = rocblas_gemm_bench_parse(line, call);
+        if(parsed < 0)
+            capture.malformed++;
+        else if(!parsed)
+            capture.skipped += line.find_first_not_of(" \t\r") != std::string::npos;
+        else
+        {
+            auto found = index.emplace(call.options(), capture.calls.size());
+            if(found.second)
+            {
+                capture.calls.push_back(call);
+                capture.counts.push_back(0);
+            }
+            capture.counts[found.first->second]++;
+        }
+    }
+}
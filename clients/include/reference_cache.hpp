@@ -0,0 +1,279 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Disk-backed cache of host reference results                               *
+ *                                                                           *
+ * The host reference results of a test are a function of its Arguments and *
+ * of the seed of the random data. They can be stored, under a hash of both, *
+ * in a directory of memory-mapped files and loaded instead of recomputed    *
+ * when the same test runs again. Entries which were least recently used are *
+ * removed when the files of the directory exceed the capacity of the cache. *
+ * An entry is written to a temporary file which is then renamed, so several *
+ * processes can share a cache.                                              *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+//! @brief (pointer, bytes) pairs of the host buffers which hold a reference result
+using rocblas_reference_buffers = std::vector<std::pair<void*, size_t>>;
+
+//! @brief 64-bit FNV-1a hash of bytes, continuing from hash
+inline uint64_t
+    rocblas_reference_hash(const void* data, size_t bytes, uint64_t hash = 0xcbf29ce484222325)
+{
+    auto* p = static_cast<const unsigned char*>(data);
+    for(size_t i = 0; i < bytes; i++)
+        hash = (hash ^ p[i]) * 0x100000001b3;
+    return hash;
+}
+
+class rocblas_reference_cache
+{
+    struct header
+    {
+        char     magic[8];
+        uint64_t buffers;
+        uint64_t key;
+    };
+
+    // Identifies entries, including the format version
+    static const char* magic()
+    {
+        return "rbrefc1";
+    }
+
+    std::string m_dir;
+    uint64_t    m_capacity;
+
+    // Offset of the payload, after the header and the size of each buffer
+    static size_t payload_offset(const rocblas_reference_buffers& buffers)
+    {
+        return sizeof(header) + buffers.size() * sizeof(uint64_t);
+    }
+
+    static size_t payload_bytes(const rocblas_reference_buffers& buffers)
+    {
+        size_t bytes = 0;
+        for(auto& buffer : buffers)
+            bytes += buffer.second;
+        return bytes;
+    }
+
+    static bool is_entry(const char* name)
+    {
+        size_t len = strlen(name);
+        return len > 4 && !strcmp(name + len - 4, ".ref");
+    }
+
+    // Temporary files of entries being stored, which are left behind by killed processes
+    static bool is_temp(const char* name)
+    {
+        return strstr(name, ".ref.tmp") != nullptr;
+    }
+
+public:
+    //! @brief A cache in directory dir, which is created if needed, or disabled if dir is empty
+    rocblas_reference_cache(std::string dir, uint64_t capacity)
+        : m_dir(std::move(dir))
+        , m_capacity(capacity)
+    {
+        if(!m_dir.empty())
+            mkdir(m_dir.c_str(), 0755);
+    }
+
+    bool enabled() const
+    {
+        return !m_dir.empty();
+    }
+
+    std::string path(uint64_t key) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.ref", (unsigned long long)key);
+        return m_dir + name;
+    }
+
+    //! @brief Copies the entry of key into the buffers, if it exists with the same buffer sizes
+    bool load(uint64_t key, const rocblas_reference_buffers& buffers) const
+    {
+        if(!enabled())
+            return false;
+
+        std::string file = path(key);
+        int         fd   = open(file.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        bool        found = false;
+        struct stat st;
+        size_t      offset = payload_offset(buffers);
+        if(!fstat(fd, &st) && size_t(st.st_size) == offset + payload_bytes(buffers))
+        {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(map != MAP_FAILED)
+            {
+                auto*  bytes = static_cast<const char*>(map);
+                header h;
+                memcpy(&h, bytes, sizeof(h));
+                found = !memcmp(h.magic, magic(), sizeof(h.magic)) && h.buffers == buffers.size()
+                        && h.key == key;
+                for(size_t i = 0; found && i < buffers.size(); i++)
+                {
+                    uint64_t size;
+                    memcpy(&size, bytes + sizeof(h) + i * sizeof(size), sizeof(size));
+                    found = size == buffers[i].second;
+                }
+                for(size_t i = 0; found && i < buffers.size(); i++)
+                {
+                    memcpy(buffers[i].first, bytes + offset, buffers[i].second);
+                    offset += buffers[i].second;
+                }
+                munmap(map, st.st_size);
+            }
+        }
+        close(fd);
+
+        // The modification time of an entry records when it was last used
+        if(found)
+            utimensat(AT_FDCWD, file.c_str(), nullptr, 0);
+        return found;
+    }
+
+    //! @brief Writes the buffers as the entry of key, then evicts entries above the capacity
+    bool store(uint64_t key, const rocblas_reference_buffers& buffers) const
+    {
+        size_t bytes = payload_offset(buffers) + payload_bytes(buffers);
+        if(!enabled() || bytes > m_capacity)
+            return false;
+
+        std::string file = path(key);
+        std::string temp = file + ".tmp" + std::to_string(getpid());
+        int         fd   = open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0)
+            return false;
+
+        bool written = false;
+        if(!ftruncate(fd, bytes))
+        {
+            void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(map != MAP_FAILED)
+            {
+                auto*  out = static_cast<char*>(map);
+                header h{};
+                memcpy(h.magic, magic(), sizeof(h.magic));
+                h.buffers = buffers.size();
+                h.key     = key;
+                memcpy(out, &h, sizeof(h));
+                out += sizeof(h);
+                for(auto& buffer : buffers)
+                {
+                    uint64_t size = buffer.second;
+                    memcpy(out, &size, sizeof(size));
+                    out += sizeof(size);
+                }
+                for(auto& buffer : buffers)
+                {
+                    memcpy(out, buffer.first, buffer.second);
+                    out += buffer.second;
+                }
+                written = !munmap(map, bytes);
+            }
+        }
+        written = !close(fd) && written && !rename(temp.c_str(), file.c_str());
+        if(!written)
+            unlink(temp.c_str());
+        else
+            evict();
+        return written;
+    }
+
+    //! @brief Total bytes of the entries in the cache
+    uint64_t size() const
+    {
+        uint64_t total = 0;
+        for(auto& entry : entries())
+            total += entry.second;
+        return total;
+    }
+
+    //! @brief Removes least recently used entries until the entries fit in the capacity
+    void evict() const
+    {
+        auto     list  = entries();
+        uint64_t total = 0;
+        for(auto& entry : list)
+            total += entry.second;
+        for(size_t i = 0; total > m_capacity && i < list.size(); i++)
+        {
+            if(!unlink((m_dir + "/" + list[i].first).c_str()))
+                total -= list[i].second;
+        }
+    }
+
+private:
+    // (name, bytes) of the entries, least recently used first. Temporary files which were
+    // not modified for an hour are stale, and are listed with the entries so that they are
+    // counted and evicted.
+    std::vector<std::pair<std::string, uint64_t>> entries() const
+    {
+        const time_t stale_seconds = 3600;
+        const time_t now           = time(nullptr);
+
+        std::vector<std::pair<timespec, std::pair<std::string, uint64_t>>> found;
+        if(DIR* dir = enabled() ? opendir(m_dir.c_str()) : nullptr)
+        {
+            while(dirent* d = readdir(dir))
+            {
+                struct stat st;
+                if((is_entry(d->d_name) || is_temp(d->d_name))
+                   && !stat((m_dir + "/" + d->d_name).c_str(), &st)
+                   && (is_entry(d->d_name) || now - st.st_mtim.tv_sec > stale_seconds))
+                    found.push_back({st.st_mtim, {d->d_name, uint64_t(st.st_size)}});
+            }
+            closedir(dir);
+        }
+        std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+            return a.first.tv_sec != b.first.tv_sec ? a.first.tv_sec < b.first.tv_sec
+                                                    : a.first.tv_nsec < b.first.tv_nsec;
+        });
+
+        std::vector<std::pair<std::string, uint64_t>> list;
+        for(auto& entry : found)
+            list.push_back(entry.second);
+        return list;
+    }
+};
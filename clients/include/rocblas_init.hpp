@@ -27,6 +27,7 @@
 #include "rocblas.h"
 #include "rocblas_math.hpp"
 #include "rocblas_random.hpp"
+#include <algorithm>
 #include <cinttypes>
 #include <iostream>
 #ifdef _OPENMP
@@ -50,6 +51,22 @@ typedef enum rocblas_check_nan_init_
 
 } rocblas_check_nan_init;
 
+// Initialize contiguous elements first, first + 1, ... of a counter-based stream. The values of
+// the integer generator are computed by its vectorized run version, which gives the same data.
+template <typename T>
+inline void
+    rocblas_init_run(T rand_gen(), const rocblas_rng_stream& stream, T* A, size_t n, size_t first)
+{
+    if(rand_gen == random_generator<T>)
+        random_run_generator<T>(stream, A, n, first);
+    else
+        for(size_t i = 0; i < n; ++i)
+        {
+            stream.seek(first + i);
+            A[i] = rand_gen();
+        }
+}
+
 // Initialize matrix so adjacent entries have alternating sign.
 // In gemm if either A or B are initialized with alternating
 // sign the reduction sum will be summing positive
@@ -69,15 +86,17 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
                                           rocblas_stride            stride      = 0,
                                           rocblas_int               batch_count = 1)
 {
+    rocblas_rng_stream stream;
     if(matrix_type == rocblas_client_general_matrix)
     {
         for(size_t b = 0; b < batch_count; b++)
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value                  = rand_gen();
                     A[i + j * lda + b * stride] = (i ^ j) & 1 ? T(value) : T(negate(value));
                 }
@@ -88,9 +107,10 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value
                         = uplo == 'U' ? (j >= i ? rand_gen() : 0) : (j <= i ? rand_gen() : 0);
                     A[i + j * lda + b * stride] = (i ^ j) & 1 ? T(value) : T(negate(value));
@@ -104,21 +124,24 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
                                           T                         rand_gen(),
                                           U&                        hA)
 {
+    rocblas_rng_stream stream;
     for(rocblas_int batch_index = 0; batch_index < hA.batch_count(); ++batch_index)
     {
-        auto* A   = hA[batch_index];
-        auto  M   = hA.m();
-        auto  N   = hA.n();
-        auto  lda = hA.lda();
+        auto*  A   = hA[batch_index];
+        size_t M   = hA.m();
+        size_t N   = hA.n();
+        auto   lda = hA.lda();
+        size_t b   = batch_index;
 
         if(matrix_type == rocblas_client_general_matrix)
         {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value     = rand_gen();
                     A[i + j * lda] = (i ^ j) & 1 ? T(value) : T(negate(value));
                 }
@@ -128,9 +151,10 @@ void rocblas_init_matrix_alternating_sign(rocblas_check_matrix_type matrix_type,
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value
                         = uplo == 'U' ? (j >= i ? rand_gen() : 0) : (j <= i ? rand_gen() : 0);
                     A[i + j * lda] = (i ^ j) & 1 ? T(value) : T(negate(value));
@@ -146,11 +170,13 @@ void rocblas_init_vector_alternating_sign(T rand_gen(), T* x, rocblas_int N, roc
     if(incx < 0)
         x -= (N - 1) * incx;
 
+    rocblas_rng_stream stream;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
     for(rocblas_int j = 0; j < N; ++j)
     {
+        stream.seek(j);
         auto value  = rand_gen();
         x[j * incx] = j & 1 ? T(value) : T(negate(value));
     }
@@ -171,15 +197,15 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
                          rocblas_stride            stride      = 0,
                          rocblas_int               batch_count = 1)
 {
+    rocblas_rng_stream stream;
     if(matrix_type == rocblas_client_general_matrix)
     {
         for(size_t b = 0; b < batch_count; b++)
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
-                    A[i + j * lda + b * stride] = rand_gen();
+            for(size_t j = 0; j < N; ++j)
+                rocblas_init_run(rand_gen, stream, &A[j * lda + b * stride], M, (j + b * N) * M);
     }
     else if(matrix_type == rocblas_client_hermitian_matrix)
     {
@@ -190,6 +216,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
+                    stream.seek(j + (i + b * N) * N);
                     auto value = rand_gen();
                     if(i == j)
                         A[b * stride + j + i * lda] = std::real(value);
@@ -219,6 +246,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
+                    stream.seek(j + (i + b * N) * N);
                     auto value = rand_gen();
                     if(i == j)
                         A[b * stride + j + i * lda] = value;
@@ -245,9 +273,10 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value
                         = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
                     A[i + j * lda + b * stride] = value;
@@ -264,9 +293,10 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
             {
+                stream.seek(i + j * M);
                 auto value
                     = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
                 A[i + j * lda] = value;
@@ -331,20 +361,21 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
                          T                         rand_gen(),
                          U&                        hA)
 {
+    rocblas_rng_stream stream;
     for(rocblas_int batch_index = 0; batch_index < hA.batch_count(); ++batch_index)
     {
-        auto* A   = hA[batch_index];
-        auto  M   = hA.m();
-        auto  N   = hA.n();
-        auto  lda = hA.lda();
+        auto*  A   = hA[batch_index];
+        size_t M   = hA.m();
+        size_t N   = hA.n();
+        auto   lda = hA.lda();
+        size_t b   = batch_index;
         if(matrix_type == rocblas_client_general_matrix)
         {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
-                    A[i + j * lda] = rand_gen();
+            for(size_t j = 0; j < N; ++j)
+                rocblas_init_run(rand_gen, stream, &A[j * lda], M, (j + b * N) * M);
         }
         else if(matrix_type == rocblas_client_hermitian_matrix)
         {
@@ -354,6 +385,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
+                    stream.seek(j + (i + b * N) * N);
                     auto value = rand_gen();
                     if(i == j)
                         A[j + i * lda] = std::real(value);
@@ -382,6 +414,7 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
             for(size_t i = 0; i < N; ++i)
                 for(size_t j = 0; j <= i; ++j)
                 {
+                    stream.seek(j + (i + b * N) * N);
                     auto value = rand_gen();
                     if(i == j)
                         A[j + i * lda] = value;
@@ -407,9 +440,10 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value
                         = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
                     A[i + j * lda] = value;
@@ -426,9 +460,10 @@ void rocblas_init_matrix(rocblas_check_matrix_type matrix_type,
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(size_t i = 0; i < M; ++i)
-                for(size_t j = 0; j < N; ++j)
+            for(size_t j = 0; j < N; ++j)
+                for(size_t i = 0; i < M; ++i)
                 {
+                    stream.seek(i + (j + b * N) * M);
                     auto value
                         = uplo == 'U' ? (j >= i ? rand_gen() : T(0)) : (j <= i ? rand_gen() : T(0));
                     A[i + j * lda] = value;
@@ -497,11 +532,26 @@ void rocblas_init_vector(T rand_gen(), T* x, rocblas_int N, rocblas_stride incx)
     if(incx < 0)
         x -= (N - 1) * incx;
 
+    rocblas_rng_stream stream;
+    if(incx == 1)
+    {
+        constexpr rocblas_int chunk = 4096;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(rocblas_int j = 0; j < N; j += chunk)
+            rocblas_init_run(rand_gen, stream, x + j, std::min(chunk, N - j), j);
+        return;
+    }
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
     for(rocblas_int j = 0; j < N; ++j)
+    {
+        stream.seek(j);
         x[j * incx] = rand_gen();
+    }
 }
 
 /* ============================================================================================ */
@@ -735,19 +785,17 @@ void rocblas_init_vector_trig(T* x, rocblas_int N, rocblas_stride incx, bool see
 template <typename T>
 void rocblas_init(T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    rocblas_rng_stream stream;
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
     {
         size_t b_idx = i_batch * stride;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(size_t j = 0; j < N; ++j)
         {
             size_t col_idx = b_idx + j * lda;
-            if(M > 4)
-                random_run_generator<T>(A + col_idx, M);
-            else
-            {
-                for(size_t i = 0; i < M; ++i)
-                    A[col_idx + i] = random_generator<T>();
-            }
+            random_run_generator<T>(stream, A + col_idx, M, (j + i_batch * N) * M);
         }
     }
 }
@@ -766,25 +814,44 @@ inline void rocblas_init(
 template <typename T>
 void rocblas_init_nan(T* A, size_t N)
 {
+    rocblas_rng_stream stream;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(size_t i = 0; i < N; ++i)
+    {
+        stream.seek(i);
         A[i] = T(rocblas_nan_rng());
+    }
 }
 
 template <typename T>
 void rocblas_init_nan(T* A, size_t start_offset, size_t end_offset)
 {
+    rocblas_rng_stream stream;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(size_t i = start_offset; i < end_offset; ++i)
+    {
+        stream.seek(i);
         A[i] = T(rocblas_nan_rng());
+    }
 }
 
 template <typename T>
 void rocblas_init_nan_tri(
     bool upper, T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    rocblas_rng_stream stream;
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
             {
+                stream.seek(i + (j + i_batch * N) * M);
                 T val                             = upper ? (j >= i ? T(rocblas_nan_rng()) : 0)
                                                           : (j <= i ? T(rocblas_nan_rng()) : 0);
                 A[i + j * lda + i_batch * stride] = val;
@@ -795,10 +862,17 @@ template <typename T>
 void rocblas_init_nan(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    rocblas_rng_stream stream;
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
+            {
+                stream.seek(i + (j + i_batch * N) * M);
                 A[i + j * lda + i_batch * stride] = T(rocblas_nan_rng());
+            }
 }
 
 template <typename T>
@@ -814,25 +888,46 @@ void rocblas_init_nan(
 template <typename T>
 void rocblas_init_inf(T* A, size_t N)
 {
+    rocblas_rng_stream stream;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(size_t i = 0; i < N; ++i)
+    {
+        stream.seek(i);
         A[i] = T(rocblas_inf_rng());
+    }
 }
 
 template <typename T>
 void rocblas_init_inf(T* A, size_t start_offset, size_t end_offset)
 {
+    rocblas_rng_stream stream;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(size_t i = start_offset; i < end_offset; ++i)
+    {
+        stream.seek(i);
         A[i] = T(rocblas_inf_rng());
+    }
 }
 
 template <typename T>
 void rocblas_init_inf(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    rocblas_rng_stream stream;
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
+            {
+                stream.seek(i + (j + i_batch * N) * M);
                 A[i + j * lda + i_batch * stride] = T(rocblas_inf_rng());
+            }
 }
 
 template <typename T>
@@ -849,17 +944,31 @@ template <typename T>
 void rocblas_init_zero(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    rocblas_rng_stream stream;
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
+            {
+                stream.seek(i + (j + i_batch * N) * M);
                 A[i + j * lda + i_batch * stride] = T(rocblas_zero_rng());
+            }
 }
 
 template <typename T>
 void rocblas_init_zero(T* A, size_t start_offset, size_t end_offset)
 {
+    rocblas_rng_stream stream;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(size_t i = start_offset; i < end_offset; ++i)
+    {
+        stream.seek(i);
         A[i] = T(rocblas_zero_rng());
+    }
 }
 
 /* ============================================================================================ */
@@ -869,17 +978,31 @@ template <typename T>
 void rocblas_init_denorm(
     T* A, size_t M, size_t N, size_t lda, size_t stride = 0, size_t batch_count = 1)
 {
+    rocblas_rng_stream stream;
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
+            {
+                stream.seek(i + (j + i_batch * N) * M);
                 A[i + j * lda + i_batch * stride] = T(rocblas_denorm_rng());
+            }
 }
 
 template <typename T>
 void rocblas_init_denorm(T* A, size_t start_offset, size_t end_offset)
 {
+    rocblas_rng_stream stream;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(size_t i = start_offset; i < end_offset; ++i)
+    {
+        stream.seek(i);
         A[i] = T(rocblas_denorm_rng());
+    }
 }
 
 template <typename T, typename U>
@@ -950,8 +1073,11 @@ void rocblas_init_alt_impl_big(
 {
     const rocblas_half ieee_half_large(65280.0);
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
                 A[i + j * lda + i_batch * stride] = T(ieee_half_large);
 }
 
@@ -961,8 +1087,11 @@ inline void rocblas_init_alt_impl_big(
 {
     const rocblas_half ieee_half_large(65280.0);
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
                 A[i + j * lda + i_batch * stride] = T(ieee_half_large);
 }
 
@@ -994,8 +1123,11 @@ void rocblas_init_alt_impl_small(
     //using a rocblas_half sunormal value
     const rocblas_half ieee_half_small(0.0000607967376708984375);
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
                 A[i + j * lda + i_batch * stride] = T(ieee_half_small);
 }
 
@@ -1006,8 +1138,11 @@ void rocblas_init_alt_impl_small(
     //using a rocblas_half sunormal value
     const rocblas_half ieee_half_small(0.0000607967376708984375);
     for(size_t i_batch = 0; i_batch < batch_count; i_batch++)
-        for(size_t i = 0; i < M; ++i)
-            for(size_t j = 0; j < N; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(size_t j = 0; j < N; ++j)
+            for(size_t i = 0; i < M; ++i)
                 A[i + j * lda + i_batch * stride] = T(ieee_half_small);
 }
 
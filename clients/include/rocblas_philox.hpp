@@ -0,0 +1,157 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Counter-based random number generator                                     *
+ *                                                                           *
+ * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2,  *
+ * 3") maps a 128-bit counter and a 64-bit key to four random 32-bit words.  *
+ * The key is the seed, and the counter holds an initialization stream, an   *
+ * element of the stream and the block of draws of the element. The values   *
+ * of an element therefore depend only on where it is, and data initialized  *
+ * by any number of threads, in any order, is identical for a given seed.    *
+ *****************************************************************************/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+using rocblas_philox_block = std::array<uint32_t, 4>;
+
+// Ten rounds of Philox4x32 applied to counter ctr with key (k0, k1)
+inline rocblas_philox_block
+    rocblas_philox4x32_10(rocblas_philox_block ctr, uint32_t k0, uint32_t k1)
+{
+    for(int round = 0; round < 10; round++)
+    {
+        uint64_t p0 = uint64_t(0xD2511F53) * ctr[0];
+        uint64_t p1 = uint64_t(0xCD9E8D57) * ctr[2];
+
+        ctr = {uint32_t(p1 >> 32) ^ ctr[1] ^ k0,
+               uint32_t(p1),
+               uint32_t(p0 >> 32) ^ ctr[3] ^ k1,
+               uint32_t(p0)};
+
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    return ctr;
+}
+
+// Integer in [lo, hi] from a random 32-bit word, without the loops of the std distributions
+inline int rocblas_philox_uniform_int(uint32_t x, int lo, int hi)
+{
+    return lo + int((uint64_t(x) * uint32_t(hi - lo + 1)) >> 32);
+}
+
+/*! \brief  Philox4x32-10 engine, satisfying UniformRandomBitGenerator
+ *
+ *  Until it is positioned with seek(), the engine draws a sequence of its own, which is used by
+ *  code that does not initialize data element by element.
+ */
+class rocblas_philox_rng
+{
+public:
+    using result_type = uint32_t;
+
+    // Stream of the draws made before the first seek()
+    static constexpr uint32_t sequential_stream = std::numeric_limits<uint32_t>::max();
+
+    explicit rocblas_philox_rng(uint64_t seed = 0)
+        : m_seed(seed)
+    {
+        seek(seed, sequential_stream, 0);
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    uint64_t seed() const
+    {
+        return m_seed;
+    }
+
+    // Reserves a stream for one initialization; the streams restart with each seed
+    uint32_t next_stream()
+    {
+        return m_next_stream++;
+    }
+
+    // Positions the engine at the first draw of an element of a stream of the given seed
+    void seek(uint64_t seed, uint32_t stream, uint64_t element)
+    {
+        m_seed = seed;
+        m_ctr  = {0, uint32_t(element), uint32_t(element >> 32), stream};
+        m_idx  = 4;
+    }
+
+    // The first four draws of an element, as a function which vectorizes over elements
+    static rocblas_philox_block first_draws(uint64_t seed, uint32_t stream, uint64_t element)
+    {
+        return rocblas_philox4x32_10(
+            {0, uint32_t(element), uint32_t(element >> 32), stream}, uint32_t(seed), seed >> 32);
+    }
+
+    result_type operator()()
+    {
+        if(m_idx == 4)
+        {
+            m_draws = rocblas_philox4x32_10(m_ctr, key0(), key1());
+            m_idx   = 0;
+            m_ctr[0]++;
+        }
+        return m_draws[m_idx++];
+    }
+
+    void discard(unsigned long long n)
+    {
+        for(; n; n--)
+            (*this)();
+    }
+
+private:
+    uint32_t key0() const
+    {
+        return uint32_t(m_seed);
+    }
+
+    uint32_t key1() const
+    {
+        return uint32_t(m_seed >> 32);
+    }
+
+    uint64_t             m_seed;
+    uint32_t             m_next_stream = 0;
+    rocblas_philox_block m_ctr;
+    rocblas_philox_block m_draws;
+    int                  m_idx;
+};
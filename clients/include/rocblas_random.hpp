@@ -24,6 +24,7 @@
 
 #include "rocblas.h"
 #include "rocblas_math.hpp"
+#include "rocblas_philox.hpp"
 #include <cinttypes>
 #include <random>
 #include <thread>
@@ -31,21 +32,12 @@
 
 /* ============================================================================================ */
 // Random number generator
-using rocblas_rng_t = std::mt19937;
+using rocblas_rng_t = rocblas_philox_rng;
 
 extern rocblas_rng_t   g_rocblas_seed;
 extern std::thread::id g_main_thread_id;
 
 extern thread_local rocblas_rng_t t_rocblas_rng;
-extern thread_local int           t_rocblas_rand_idx;
-
-// optimized helper
-float rocblas_uniform_int_1_10();
-
-void rocblas_uniform_int_1_10_run_float(float* ptr, size_t num);
-void rocblas_uniform_int_1_10_run_double(double* ptr, size_t num);
-void rocblas_uniform_int_1_10_run_float_complex(rocblas_float_complex* ptr, size_t num);
-void rocblas_uniform_int_1_10_run_double_complex(rocblas_double_complex* ptr, size_t num);
 
 // For the main thread, we use g_rocblas_seed; for other threads, we start with a different seed but
 // deterministically based on the thread id's hash function.
@@ -59,10 +51,74 @@ inline rocblas_rng_t get_seed()
 // Reset the seed (mainly to ensure repeatability of failures in a given suite)
 inline void rocblas_seedrand()
 {
-    t_rocblas_rng      = get_seed();
-    t_rocblas_rand_idx = 0;
+    t_rocblas_rng = get_seed();
 }
 
+/*! \brief  Counter-based stream of random values for one initialization
+ *
+ *  Before drawing the values of an element, the thread which initializes it seeks its generator
+ *  to the element, so the data does not depend on how the elements are divided among threads.
+ *  When the stream is destroyed, the generator of the thread which created it continues as if
+ *  no element had been drawn.
+ */
+class rocblas_rng_stream
+{
+    uint32_t      m_id;
+    rocblas_rng_t m_rng;
+
+public:
+    rocblas_rng_stream()
+        : m_id(t_rocblas_rng.next_stream())
+        , m_rng(t_rocblas_rng)
+    {
+    }
+
+    ~rocblas_rng_stream()
+    {
+        t_rocblas_rng = m_rng;
+    }
+
+    rocblas_rng_stream(const rocblas_rng_stream&) = delete;
+    rocblas_rng_stream& operator=(const rocblas_rng_stream&) = delete;
+
+    // Positions the generator of the calling thread at an element
+    void seek(size_t element) const
+    {
+        t_rocblas_rng.seek(m_rng.seed(), m_id, element);
+    }
+
+    uint64_t seed() const
+    {
+        return m_rng.seed();
+    }
+
+    uint32_t id() const
+    {
+        return m_id;
+    }
+};
+
+// optimized helper
+float rocblas_uniform_int_1_10();
+
+// Runs of the values random_generator<T>() gives for elements first, first + 1, ... of a stream
+void rocblas_uniform_int_1_10_run_float(const rocblas_rng_stream& stream,
+                                        float*                    ptr,
+                                        size_t                    num,
+                                        size_t                    first);
+void rocblas_uniform_int_1_10_run_double(const rocblas_rng_stream& stream,
+                                         double*                   ptr,
+                                         size_t                    num,
+                                         size_t                    first);
+void rocblas_uniform_int_1_10_run_float_complex(const rocblas_rng_stream& stream,
+                                                rocblas_float_complex*    ptr,
+                                                size_t                    num,
+                                                size_t                    first);
+void rocblas_uniform_int_1_10_run_double_complex(const rocblas_rng_stream& stream,
+                                                 rocblas_double_complex*   ptr,
+                                                 size_t                    num,
+                                                 size_t                    first);
+
 /* ============================================================================================ */
 /*! \brief  Random number generator which generates NaN values */
 class rocblas_nan_rng
@@ -309,7 +365,7 @@ inline rocblas_double_complex random_generator<rocblas_double_complex>()
 template <>
 inline rocblas_half random_generator<rocblas_half>()
 {
-    return rocblas_half(std::uniform_int_distribution<int>(-2, 2)(t_rocblas_rng));
+    return rocblas_half(rocblas_philox_uniform_int(t_rocblas_rng(), -2, 2));
 };
 
 // for rocblas_bfloat16, generate float, and convert to rocblas_bfloat16
@@ -317,48 +373,61 @@ inline rocblas_half random_generator<rocblas_half>()
 template <>
 inline rocblas_bfloat16 random_generator<rocblas_bfloat16>()
 {
-    return rocblas_bfloat16(std::uniform_int_distribution<int>(-2, 2)(t_rocblas_rng));
+    return rocblas_bfloat16(rocblas_philox_uniform_int(t_rocblas_rng(), -2, 2));
 };
 
 /*! \brief  generate a random number in range [1,2,3] */
 template <>
 inline int8_t random_generator<int8_t>()
 {
-    return static_cast<int8_t>(std::uniform_int_distribution<unsigned short>(1, 3)(t_rocblas_rng));
+    return static_cast<int8_t>(rocblas_philox_uniform_int(t_rocblas_rng(), 1, 3));
 };
 
-/*! \brief  generate a sequence of random number in range [1,2,3,4,5,6,7,8,9,10] */
+/*! \brief  generate random numbers of random_generator<T>() for elements first, first + 1, ... */
 template <typename T>
-inline void random_run_generator(T* ptr, size_t num)
+inline void random_run_generator(const rocblas_rng_stream& stream, T* ptr, size_t num, size_t first)
 {
     for(size_t i = 0; i < num; i++)
     {
+        stream.seek(first + i);
         ptr[i] = random_generator<T>();
     }
 }
 
 template <>
-inline void random_run_generator<float>(float* ptr, size_t num)
+inline void random_run_generator<float>(const rocblas_rng_stream& stream,
+                                        float*                    ptr,
+                                        size_t                    num,
+                                        size_t                    first)
 {
-    rocblas_uniform_int_1_10_run_float(ptr, num);
+    rocblas_uniform_int_1_10_run_float(stream, ptr, num, first);
 };
 
 template <>
-inline void random_run_generator<double>(double* ptr, size_t num)
+inline void random_run_generator<double>(const rocblas_rng_stream& stream,
+                                         double*                   ptr,
+                                         size_t                    num,
+                                         size_t                    first)
 {
-    rocblas_uniform_int_1_10_run_double(ptr, num);
+    rocblas_uniform_int_1_10_run_double(stream, ptr, num, first);
 };
 
 template <>
-inline void random_run_generator<rocblas_float_complex>(rocblas_float_complex* ptr, size_t num)
+inline void random_run_generator<rocblas_float_complex>(const rocblas_rng_stream& stream,
+                                                        rocblas_float_complex*    ptr,
+                                                        size_t                    num,
+                                                        size_t                    first)
 {
-    rocblas_uniform_int_1_10_run_float_complex(ptr, num);
+    rocblas_uniform_int_1_10_run_float_complex(stream, ptr, num, first);
 };
 
 template <>
-inline void random_run_generator<rocblas_double_complex>(rocblas_double_complex* ptr, size_t num)
+inline void random_run_generator<rocblas_double_complex>(const rocblas_rng_stream& stream,
+                                                         rocblas_double_complex*   ptr,
+                                                         size_t                    num,
+                                                         size_t                    first)
 {
-    rocblas_uniform_int_1_10_run_double_complex(ptr, num);
+    rocblas_uniform_int_1_10_run_double_complex(stream, ptr, num, first);
 };
 
 // HPL
@@ -0,0 +1,177 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+#include "bytes.hpp"
+#include "cblas_interface.hpp"
+#include "flops.hpp"
+#include "norm.hpp"
+#include "rocblas.hpp"
+#include "rocblas_init.hpp"
+#include "rocblas_math.hpp"
+#include "rocblas_matrix.hpp"
+#include "rocblas_random.hpp"
+#include "rocblas_test.hpp"
+#include "unit.hpp"
+#include "utility.hpp"
+
+template <typename T>
+void testing_set_get_matrix_strided_batched(const Arguments& arg)
+{
+    rocblas_int rows        = arg.M;
+    rocblas_int cols        = arg.N;
+    rocblas_int lda         = arg.lda;
+    rocblas_int ldb         = arg.ldb;
+    rocblas_int ldc         = arg.ldc;
+    rocblas_int batch_count = arg.batch_count;
+
+    // strides default to matrices which follow each other
+    rocblas_stride stride_a = std::max(arg.stride_a, rocblas_stride(lda) * cols);
+    rocblas_stride stride_b = std::max(arg.stride_b, rocblas_stride(ldb) * cols);
+    rocblas_stride stride_c = std::max(arg.stride_c, rocblas_stride(ldc) * cols);
+
+    // argument sanity check, quick return if input parameters are invalid before allocating invalid
+    // memory
+    bool invalidGPUMatrix = rows < 0 || cols < 0 || ldc <= 0 || ldc < rows || batch_count < 0;
+    bool invalidSet       = invalidGPUMatrix || lda <= 0 || lda < rows;
+    bool invalidGet       = invalidGPUMatrix || ldb <= 0 || ldb < rows;
+
+    if(invalidSet || invalidGet)
+    {
+        EXPECT_ROCBLAS_STATUS(
+            rocblas_set_matrix_strided_batched(
+                rows, cols, sizeof(T), nullptr, lda, stride_a, nullptr, ldc, stride_c, batch_count),
+            invalidSet ? rocblas_status_invalid_size : rocblas_status_invalid_pointer);
+
+        EXPECT_ROCBLAS_STATUS(
+            rocblas_get_matrix_strided_batched(
+                rows, cols, sizeof(T), nullptr, ldc, stride_c, nullptr, ldb, stride_b, batch_count),
+            invalidGet ? rocblas_status_invalid_size : rocblas_status_invalid_pointer);
+
+        return;
+    }
+
+    // quick return without any matrix to transfer
+    if(!rows || !cols || !batch_count)
+    {
+        CHECK_ROCBLAS_ERROR(rocblas_set_matrix_strided_batched(
+            rows, cols, sizeof(T), nullptr, lda, stride_a, nullptr, ldc, stride_c, batch_count));
+        CHECK_ROCBLAS_ERROR(rocblas_get_matrix_strided_batched(
+            rows, cols, sizeof(T), nullptr, ldc, stride_c, nullptr, ldb, stride_b, batch_count));
+        return;
+    }
+
+    // Naming: dK is in GPU (device) memory. hK is in CPU (host) memory
+    host_strided_batch_matrix<T> ha(rows, cols, lda, stride_a, batch_count);
+    host_strided_batch_matrix<T> hb(rows, cols, ldb, stride_b, batch_count);
+    host_strided_batch_matrix<T> hb_gold(rows, cols, ldb, stride_b, batch_count);
+    CHECK_HIP_ERROR(ha.memcheck());
+    CHECK_HIP_ERROR(hb.memcheck());
+    CHECK_HIP_ERROR(hb_gold.memcheck());
+
+    double gpu_time_used, cpu_time_used;
+    double rocblas_error = 0.0;
+
+    // allocate memory on device
+    device_strided_batch_matrix<T> dc(rows, cols, ldc, stride_c, batch_count);
+    CHECK_DEVICE_ALLOCATION(dc.memcheck());
+
+    // Initial Data on CPU
+    rocblas_seedrand();
+    rocblas_init<T>(ha, rows, cols, lda, stride_a, batch_count);
+    rocblas_init<T>(hb, rows, cols, ldb, stride_b, batch_count);
+
+    if(arg.unit_check || arg.norm_check)
+    {
+        // ROCBLAS
+        CHECK_HIP_ERROR(hipMemset(dc, 0, sizeof(T) * stride_c * batch_count));
+
+        CHECK_ROCBLAS_ERROR(rocblas_set_matrix_strided_batched(
+            rows, cols, sizeof(T), ha, lda, stride_a, dc, ldc, stride_c, batch_count));
+        CHECK_ROCBLAS_ERROR(rocblas_get_matrix_strided_batched(
+            rows, cols, sizeof(T), dc, ldc, stride_c, hb, ldb, stride_b, batch_count));
+
+        // reference calculation
+        cpu_time_used = get_time_us_no_sync();
+
+        for(rocblas_int b = 0; b < batch_count; b++)
+            for(size_t i1 = 0; i1 < rows; i1++)
+                for(size_t i2 = 0; i2 < cols; i2++)
+                    *(hb_gold[b] + i1 + i2 * ldb) = *(ha[b] + i1 + i2 * lda);
+
+        cpu_time_used = get_time_us_no_sync() - cpu_time_used;
+
+        if(arg.unit_check)
+        {
+            unit_check_general<T>(rows, cols, ldb, stride_b, hb_gold, hb, batch_count);
+        }
+
+        if(arg.norm_check)
+        {
+            rocblas_error = norm_check_general('F', hb_gold, hb);
+        }
+    }
+
+    if(arg.timing)
+    {
+        int number_cold_calls = arg.cold_iters;
+        int number_hot_calls  = arg.iters;
+
+        for(int iter = 0; iter < number_cold_calls; iter++)
+        {
+            rocblas_set_matrix_strided_batched(
+                rows, cols, sizeof(T), ha, lda, stride_a, dc, ldc, stride_c, batch_count);
+            rocblas_get_matrix_strided_batched(
+                rows, cols, sizeof(T), dc, ldc, stride_c, hb, ldb, stride_b, batch_count);
+        }
+
+        gpu_time_used = get_time_us_sync_device(); // in microseconds
+
+        for(int iter = 0; iter < number_hot_calls; iter++)
+        {
+            rocblas_set_matrix_strided_batched(
+                rows, cols, sizeof(T), ha, lda, stride_a, dc, ldc, stride_c, batch_count);
+            rocblas_get_matrix_strided_batched(
+                rows, cols, sizeof(T), dc, ldc, stride_c, hb, ldb, stride_b, batch_count);
+        }
+
+        gpu_time_used = get_time_us_sync_device() - gpu_time_used;
+
+        ArgumentModel<e_M,
+                      e_N,
+                      e_lda,
+                      e_stride_a,
+                      e_ldb,
+                      e_stride_b,
+                      e_ldc,
+                      e_stride_c,
+                      e_batch_count>{}
+            .log_args<T>(rocblas_cout,
+                         arg,
+                         gpu_time_used,
+                         ArgumentLogging::NA_value,
+                         set_get_matrix_gbyte_count<T>(rows, cols) * batch_count,
+                         cpu_time_used,
+                         rocblas_error);
+    }
+}
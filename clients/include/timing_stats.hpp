@@ -0,0 +1,154 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Statistics of per-iteration benchmark timings                             *
+ *                                                                           *
+ * With rocblas-bench --timing_stats, the hot calls of a benchmark are timed *
+ * one by one. Slow outliers, such as calls which still warm up caches or    *
+ * which are delayed by other work on the device, are rejected using the     *
+ * median absolute deviation. Timings are bounded below by the cost of the   *
+ * call, so fast samples are never rejected. The distribution-free 95%       *
+ * confidence interval of the median of the remaining samples decides when  *
+ * enough iterations have been run.                                          *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct rocblas_timing_options
+{
+    bool enabled = false;
+
+    // Samples above median + outlier_mad * scaled MAD are rejected, unless outlier_mad is 0.
+    // The scaled MAD is taken to be at least mad_floor times the median.
+    double outlier_mad = 5;
+    double mad_floor   = 0.01;
+
+    // Relative half width of the confidence interval to iterate until, unless ci_target is 0,
+    // for at most max_iters hot calls
+    double ci_target = 0;
+    int    max_iters = 1000;
+};
+
+struct rocblas_timing_stats
+{
+    size_t samples  = 0; // samples which were kept
+    size_t rejected = 0; // samples which were rejected as outliers
+    double min = 0, median = 0, p90 = 0, p99 = 0, mean = 0, stddev = 0;
+    double ci_low = 0, ci_high = 0; // 95% confidence interval of the median
+
+    // Half width of the confidence interval, relative to the median
+    double ci_relative() const
+    {
+        return median > 0 ? (ci_high - ci_low) / (2 * median) : 0;
+    }
+};
+
+// Percentile p in [0, 1] of ascending samples, interpolating linearly between ranks
+inline double rocblas_timing_percentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    double pos   = p * (sorted.size() - 1);
+    size_t lower = size_t(pos);
+    if(lower + 1 >= sorted.size())
+        return sorted.back();
+    return sorted[lower] + (pos - lower) * (sorted[lower + 1] - sorted[lower]);
+}
+
+// Statistics of the samples, in the unit of the samples, after rejecting slow outliers
+inline rocblas_timing_stats rocblas_timing_compute(std::vector<double>           samples,
+                                                   const rocblas_timing_options& options)
+{
+    rocblas_timing_stats stats;
+    if(samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    double median = rocblas_timing_percentile(samples, 0.5);
+
+    // 1.4826 * MAD estimates the standard deviation of normally distributed samples
+    std::vector<double> deviations;
+    for(double s : samples)
+        deviations.push_back(std::abs(s - median));
+    std::sort(deviations.begin(), deviations.end());
+    double mad = 1.4826 * rocblas_timing_percentile(deviations, 0.5);
+
+    // Event timings of short calls are quantized and often repeat, so MAD is 0 when more than
+    // half of the samples are equal. The smallest step between distinct samples estimates the
+    // timer resolution, and MAD is taken to be at least that, so that samples a few ticks
+    // slower than the median are kept.
+    double step = 0;
+    for(size_t i = 1; i < samples.size(); i++)
+        if(samples[i] > samples[i - 1] && (!step || samples[i] - samples[i - 1] < step))
+            step = samples[i] - samples[i - 1];
+    mad = std::max({mad, step, options.mad_floor * median});
+
+    if(options.outlier_mad > 0)
+    {
+        double limit   = median + options.outlier_mad * mad;
+        size_t kept    = std::upper_bound(samples.begin(), samples.end(), limit) - samples.begin();
+        stats.rejected = samples.size() - kept;
+        samples.resize(kept);
+    }
+
+    size_t n      = samples.size();
+    stats.samples = n;
+    stats.min     = samples.front();
+    stats.median  = rocblas_timing_percentile(samples, 0.5);
+    stats.p90     = rocblas_timing_percentile(samples, 0.9);
+    stats.p99     = rocblas_timing_percentile(samples, 0.99);
+
+    double sum = 0;
+    for(double s : samples)
+        sum += s;
+    stats.mean = sum / n;
+
+    double squares = 0;
+    for(double s : samples)
+        squares += (s - stats.mean) * (s - stats.mean);
+    stats.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+
+    // The number of samples below the median is binomial(n, 1/2); its normal approximation
+    // gives the ranks which bound the median with 95% confidence
+    double half   = 1.959964 * std::sqrt(double(n)) / 2;
+    double lower  = std::floor(n / 2.0 - half);
+    double upper  = std::ceil(n / 2.0 + half);
+    stats.ci_low  = samples[lower < 0 ? 0 : size_t(lower)];
+    stats.ci_high = samples[upper > n - 1 ? n - 1 : size_t(upper)];
+
+    return stats;
+}
+
+// Whether the timing of a benchmark after iters hot calls is final
+inline bool rocblas_timing_done(const rocblas_timing_stats&   stats,
+                                const rocblas_timing_options& options,
+                                int                           iters)
+{
+    return options.ci_target <= 0 || iters >= options.max_iters
+           || (stats.samples >= 2 && stats.ci_relative() <= options.ci_target);
+}
@@ -25,12 +25,17 @@
 
 #include "../../library/src/include/logging.hpp"
 #include "../../library/src/include/utility.hpp"
+#include "argument_model.hpp"
+#include "reference_cache.hpp"
 #include "rocblas.h"
+#include "rocblas_matrix.hpp"
 #include "rocblas_vector.hpp"
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -175,6 +180,284 @@ double get_time_us_sync(hipStream_t stream);
 /*! \brief  CPU Timer(in microsecond): no GPU synchronization and return wall time */
 double get_time_us_no_sync();
 
+/* ============================================================================================ */
+/*  cache-cold benchmarking: with rocblas-bench --rotating, hot calls read operands which are
+    not in caches of the given size, either by cycling through copies of the operands or, with
+    --flush, by overwriting a flush buffer of that size before each call */
+
+/*! \brief  Set the cache size in bytes to exceed, or 0, and whether to flush instead of rotating */
+void rocblas_set_rotating(size_t bytes, bool flush);
+
+/*! \brief  Cache size in bytes which the operands of consecutive hot calls exceed, or 0 */
+size_t rocblas_get_rotating_bytes();
+
+/*! \brief  Size in bytes of the buffer written before each hot call, or 0 */
+size_t rocblas_get_flush_bytes();
+
+/*! \brief  Number of sets of operands, including the original, which hot calls cycle through
+ *          when the operands of one call take operand_bytes; at most rocblas_rotating_max_sets.
+ */
+size_t rocblas_rotating_sets(size_t operand_bytes);
+
+constexpr size_t rocblas_rotating_max_sets = 1024;
+
+/*! \brief  Size in bytes of device operands */
+inline size_t rocblas_device_bytes()
+{
+    return 0;
+}
+
+template <typename T, typename... Ts>
+size_t rocblas_device_bytes(const d_vector<T>& operand, const Ts&... operands)
+{
+    return operand.nmemb() * sizeof(T) + rocblas_device_bytes(operands...);
+}
+
+/*! \brief  Device operand of the same dimensions as that, without its contents */
+template <typename T>
+std::unique_ptr<device_vector<T>> rocblas_device_like(const device_vector<T>& that)
+{
+    return std::make_unique<device_vector<T>>(that.n(), that.inc(), that.use_HMM);
+}
+
+template <typename T>
+std::unique_ptr<device_matrix<T>> rocblas_device_like(const device_matrix<T>& that)
+{
+    return std::make_unique<device_matrix<T>>(that.m(), that.n(), that.lda(), that.use_HMM);
+}
+
+template <typename T>
+std::unique_ptr<device_batch_vector<T>> rocblas_device_like(const device_batch_vector<T>& that)
+{
+    return std::make_unique<device_batch_vector<T>>(
+        that.n(), that.inc(), that.batch_count(), that.use_HMM);
+}
+
+template <typename T>
+std::unique_ptr<device_batch_matrix<T>> rocblas_device_like(const device_batch_matrix<T>& that)
+{
+    return std::make_unique<device_batch_matrix<T>>(
+        that.m(), that.n(), that.lda(), that.batch_count(), that.use_HMM, that.offset());
+}
+
+template <typename T>
+std::unique_ptr<device_strided_batch_vector<T>>
+    rocblas_device_like(const device_strided_batch_vector<T>& that)
+{
+    return std::make_unique<device_strided_batch_vector<T>>(
+        that.n(), that.inc(), that.stride(), that.batch_count(), that.use_HMM);
+}
+
+template <typename T>
+std::unique_ptr<device_strided_batch_matrix<T>>
+    rocblas_device_like(const device_strided_batch_matrix<T>& that)
+{
+    return std::make_unique<device_strided_batch_matrix<T>>(
+        that.m(), that.n(), that.lda(), that.stride(), that.batch_count(), that.use_HMM);
+}
+
+/*! \brief  A device operand whose memory can be exchanged with that of copies of it */
+class rocblas_rotating_operand
+{
+public:
+    virtual ~rocblas_rotating_operand() = default;
+
+    // Give the operand the memory of set, 0 being its own memory
+    virtual void select(size_t set) = 0;
+};
+
+template <typename D>
+class rocblas_rotating : public rocblas_rotating_operand
+{
+    D&                              m_operand;
+    std::vector<std::unique_ptr<D>> m_copies;
+    size_t                          m_set = 0;
+
+public:
+    rocblas_rotating(D& operand, size_t sets)
+        : m_operand(operand)
+    {
+        for(size_t set = 1; set < sets; set++)
+        {
+            m_copies.push_back(rocblas_device_like(operand));
+            CHECK_DEVICE_ALLOCATION(m_copies.back()->memcheck());
+            CHECK_HIP_ERROR(m_copies.back()->transfer_from(operand));
+        }
+    }
+
+    ~rocblas_rotating() override
+    {
+        select(0);
+    }
+
+    void select(size_t set) override
+    {
+        // The operand holds the memory of m_set, and copy m_set holds the memory of set 0
+        if(m_set)
+            m_operand.swap_memory(*m_copies[m_set - 1]);
+        m_set = set;
+        if(m_set)
+            m_operand.swap_memory(*m_copies[m_set - 1]);
+    }
+};
+
+/*! \brief  The device operands of hot calls, and the copies of them which hot calls cycle
+ *          through with rocblas-bench --rotating. Hot call i uses set i % sets of the copies,
+ *          set 0 being the operands themselves, which have their own memory again afterwards.
+ */
+class rocblas_rotating_operands
+{
+    std::vector<std::unique_ptr<rocblas_rotating_operand>> m_operands;
+    size_t                                                 m_sets;
+
+public:
+    template <typename... Ds>
+    explicit rocblas_rotating_operands(const std::tuple<Ds&...>& operands)
+    {
+        m_sets = rocblas_rotating_sets(std::apply(
+            [](const Ds&... ds) { return rocblas_device_bytes(ds...); }, operands));
+        if(m_sets > 1)
+            std::apply(
+                [this](Ds&... ds) {
+                    (m_operands.push_back(std::make_unique<rocblas_rotating<Ds>>(ds, m_sets)),
+                     ...);
+                },
+                operands);
+    }
+
+    // Give the operands the memory of the set of hot call i
+    void select(size_t i)
+    {
+        for(auto& operand : m_operands)
+            operand->select(i % m_sets);
+    }
+};
+
+/* ============================================================================================ */
+/*  timing of individual hot calls */
+
+/*! \brief  Events which time each of iters hot calls on a stream, excluding cache flushes */
+class rocblas_timing_events
+{
+    hipStream_t             m_stream;
+    std::vector<hipEvent_t> m_start, m_stop;
+    void*                   m_flush       = nullptr;
+    size_t                  m_flush_bytes = 0;
+
+public:
+    rocblas_timing_events(hipStream_t stream, int iters, size_t flush_bytes);
+
+    ~rocblas_timing_events();
+
+    rocblas_timing_events(const rocblas_timing_events&) = delete;
+    rocblas_timing_events& operator=(const rocblas_timing_events&) = delete;
+
+    // Flush caches if requested, and record the event which precedes hot call i
+    void start(int i);
+
+    // Record the event which follows hot call i
+    void stop(int i);
+
+    // Wait for the hot calls and append the time of each of them, in microseconds
+    void append_us(std::vector<double>& samples);
+};
+
+/*! \brief  Make arg.iters hot calls with hot_call() and return their total time in microseconds.
+ *          operands are the device operands of the hot calls, made with std::tie. With
+ *          rocblas-bench --rotating, they are given the memory of copies of them before each call.
+ *          With rocblas-bench --timing_stats, each call is timed with events, and hot calls are
+ *          repeated until the confidence interval target is met. The statistics are then kept
+ *          for ArgumentModel::log_perf, and the returned time is the mean of the samples which
+ *          are not outliers, times arg.iters. With --flush, each call is timed with events so
+ *          that flushing caches is not timed. All benchmarks of rocBLAS functions which run on
+ *          a stream time their hot calls with this function.
+ */
+template <typename... Ds, typename F>
+double rocblas_time_hot_calls(const Arguments&         arg,
+                              hipStream_t              stream,
+                              const std::tuple<Ds&...>& operands,
+                              F&&                      hot_call)
+{
+    const rocblas_timing_options& options     = ArgumentModel_get_timing_options();
+    size_t                        flush_bytes = rocblas_get_flush_bytes();
+    rocblas_rotating_operands     rotating(operands);
+    if((!options.enabled && !flush_bytes) || arg.iters < 1)
+    {
+        double gpu_time_used = get_time_us_sync(stream); // in microseconds
+        for(int i = 0; i < arg.iters; i++)
+        {
+            rotating.select(i);
+            hot_call();
+        }
+        return get_time_us_sync(stream) - gpu_time_used;
+    }
+
+    rocblas_timing_events events(stream, arg.iters, flush_bytes);
+    std::vector<double>   samples;
+    rocblas_timing_stats  stats;
+    do
+    {
+        int calls = int(samples.size());
+        for(int i = 0; i < arg.iters; i++)
+        {
+            rotating.select(calls + i);
+            events.start(i);
+            hot_call();
+            events.stop(i);
+        }
+        events.append_us(samples);
+
+        if(!options.enabled)
+        {
+            double gpu_time_used = 0;
+            for(double us : samples)
+                gpu_time_used += us;
+            return gpu_time_used;
+        }
+
+        stats = rocblas_timing_compute(samples, options);
+    } while(!rocblas_timing_done(stats, options, int(samples.size())));
+
+    ArgumentModel_set_timing_stats(stats);
+    return stats.mean * arg.iters;
+}
+
+/* ============================================================================================ */
+/*  reference result cache: with ROCBLAS_CLIENT_REFERENCE_CACHE naming a directory, host reference
+    results which take long to compute are stored in it, keyed by the Arguments and the seed of
+    the random data, and loaded instead of being recomputed when the same test runs again */
+
+/*! \brief  Load the cached reference result of arg into the buffers, if the cache has it */
+bool rocblas_reference_cache_load(const Arguments& arg, const rocblas_reference_buffers& buffers);
+
+/*! \brief  Store the reference result of arg held in the buffers, if the cache is enabled */
+void rocblas_reference_cache_store(const Arguments& arg, const rocblas_reference_buffers& buffers);
+
+/*! \brief  Host references which take less time than this are recomputed rather than cached */
+constexpr double rocblas_reference_cache_min_us = 10000;
+
+/*! \brief  Compute the reference result held in the host matrix output with reference(),
+ *          unless it is loaded from the reference cache, in which case output is overwritten.
+ *          H is a host_matrix or one of its batched variants. Returns whether the result was
+ *          loaded, in which case the time taken is not that of the reference.
+ */
+template <typename H, typename F>
+bool rocblas_cached_reference(const Arguments& arg, H& output, F&& reference)
+{
+    rocblas_reference_buffers buffers;
+    for(int64_t b = 0; b < output.batch_count(); b++)
+        buffers.emplace_back(output[b], output.n() * output.lda() * sizeof(*output[b]));
+
+    if(rocblas_reference_cache_load(arg, buffers))
+        return true;
+
+    double reference_time = get_time_us_no_sync();
+    reference();
+    if(get_time_us_no_sync() - reference_time >= rocblas_reference_cache_min_us)
+        rocblas_reference_cache_store(arg, buffers);
+    return false;
+}
+
 /* ============================================================================================ */
 // Return path of this executable
 std::string rocblas_exepath();
@@ -267,6 +550,8 @@ inline void regular_to_banded(bool upper, const T& h_A, T& h_AB, rocblas_int k)
     size_t      ldab = h_AB.lda();
     rocblas_int n    = h_AB.n();
 
+    // the random fill of each element depends only on its position, not on the thread
+    rocblas_rng_stream stream;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
@@ -292,14 +577,16 @@ inline void regular_to_banded(bool upper, const T& h_A, T& h_AB, rocblas_int k)
             // fill in bottom with random data to ensure we aren't using it.
             // for !upper, fill in bottom right triangle as well.
             for(int i = min1; i <= max1; i++)
-                rocblas_init(AB + j * ldab + i, 1, 1, 1);
+                random_run_generator(
+                    stream, AB + j * ldab + i, 1, (size_t(batch_index) * n + j) * ldab + i);
 
             // for upper, fill in top left triangle with random data to ensure
             // we aren't using it.
             if(upper)
             {
                 for(int i = 0; i < m; i++)
-                    rocblas_init(AB + j * ldab + i, 1, 1, 1);
+                    random_run_generator(
+                        stream, AB + j * ldab + i, 1, (size_t(batch_index) * n + j) * ldab + i);
             }
         }
     }
@@ -326,6 +326,174 @@ ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_async(rocblas_int rows,
                                                        rocblas_int ldb,
                                                        hipStream_t stream);
 
+/*! \brief Copy a batch of matrices from host to device
+     \details
+    rocblas_set_matrix_batched copies batch_count matrices from host memory to device memory.
+    Unlike the batched BLAS functions, the arrays of pointers are in host memory. Runs of
+    matrices which follow each other contiguously both on the host and on the device are
+    copied together, and small matrices are packed into one staging buffer and scattered
+    to their destinations by a single kernel launch, so that a batch of small matrices
+    takes few transfers.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           host array of pointers to matrices on the host
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of each A_i, lda >= rows
+    @param[out]
+    b           host array of pointers to matrices on the GPU
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of each B_i, ldb >= rows
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_batched(rocblas_int       rows,
+                                                         rocblas_int       cols,
+                                                         rocblas_int       elem_size,
+                                                         const void* const a[],
+                                                         rocblas_int       lda,
+                                                         void* const       b[],
+                                                         rocblas_int       ldb,
+                                                         rocblas_int       batch_count);
+
+/*! \brief Copy a batch of matrices from device to host
+     \details
+    rocblas_get_matrix_batched copies batch_count matrices from device memory to host memory.
+    Unlike the batched BLAS functions, the arrays of pointers are in host memory. Small
+    matrices are gathered into one staging buffer by a single kernel launch and copied to
+    the host together.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           host array of pointers to matrices on the GPU
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of each A_i, lda >= rows
+    @param[out]
+    b           host array of pointers to matrices on the host
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of each B_i, ldb >= rows
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_batched(rocblas_int       rows,
+                                                         rocblas_int       cols,
+                                                         rocblas_int       elem_size,
+                                                         const void* const a[],
+                                                         rocblas_int       lda,
+                                                         void* const       b[],
+                                                         rocblas_int       ldb,
+                                                         rocblas_int       batch_count);
+
+/*! \brief Copy a strided batch of matrices from host to device
+     \details
+    rocblas_set_matrix_strided_batched copies batch_count matrices A_i = a + i * stride_a on
+    the host to B_i = b + i * stride_b on the device, with strides in elements. Batches in
+    which the matrices follow each other on both sides are copied as one matrix.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           pointer to the first matrix on the host
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of each A_i, lda >= rows
+    @param[in]
+    stride_a    [rocblas_stride]
+                stride from the start of one A_i to the next, in elements
+    @param[out]
+    b           pointer to the first matrix on the GPU
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of each B_i, ldb >= rows
+    @param[in]
+    stride_b    [rocblas_stride]
+                stride from the start of one B_i to the next, in elements
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_matrix_strided_batched(rocblas_int    rows,
+                                                                 rocblas_int    cols,
+                                                                 rocblas_int    elem_size,
+                                                                 const void*    a,
+                                                                 rocblas_int    lda,
+                                                                 rocblas_stride stride_a,
+                                                                 void*          b,
+                                                                 rocblas_int    ldb,
+                                                                 rocblas_stride stride_b,
+                                                                 rocblas_int    batch_count);
+
+/*! \brief Copy a strided batch of matrices from device to host
+     \details
+    rocblas_get_matrix_strided_batched copies batch_count matrices A_i = a + i * stride_a on
+    the device to B_i = b + i * stride_b on the host, with strides in elements. Batches in
+    which the matrices follow each other on both sides are copied as one matrix.
+    @param[in]
+    rows        [rocblas_int]
+                number of rows in matrices
+    @param[in]
+    cols        [rocblas_int]
+                number of columns in matrices
+    @param[in]
+    elem_size   [rocblas_int]
+                number of bytes per element in the matrix
+    @param[in]
+    a           pointer to the first matrix on the GPU
+    @param[in]
+    lda         [rocblas_int]
+                specifies the leading dimension of each A_i, lda >= rows
+    @param[in]
+    stride_a    [rocblas_stride]
+                stride from the start of one A_i to the next, in elements
+    @param[out]
+    b           pointer to the first matrix on the host
+    @param[in]
+    ldb         [rocblas_int]
+                specifies the leading dimension of each B_i, ldb >= rows
+    @param[in]
+    stride_b    [rocblas_stride]
+                stride from the start of one B_i to the next, in elements
+    @param[in]
+    batch_count [rocblas_int]
+                number of matrices in the batch
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_matrix_strided_batched(rocblas_int    rows,
+                                                                 rocblas_int    cols,
+                                                                 rocblas_int    elem_size,
+                                                                 const void*    a,
+                                                                 rocblas_int    lda,
+                                                                 rocblas_stride stride_a,
+                                                                 void*          b,
+                                                                 rocblas_int    ldb,
+                                                                 rocblas_stride stride_b,
+                                                                 rocblas_int    batch_count);
+
 /*******************************************************************************
  * Function to set start/stop event handlers (for internal use only)
  ******************************************************************************/
@@ -372,6 +540,135 @@ ROCBLAS_EXPORT rocblas_status rocblas_set_performance_metric(rocblas_handle
 ROCBLAS_EXPORT rocblas_status rocblas_get_performance_metric(rocblas_handle              handle,
                                                              rocblas_performance_metric* metric);
 
+/*! \brief returns statistics of the GEMM solution cache of a handle
+     \details
+    Each handle caches the Tensile solutions selected for the GEMM problems it has solved,
+    so that repeated problems skip solution selection. The cache holds at most
+    ROCBLAS_SOLUTION_CACHE_SIZE entries (default 1024, 0 disables it) and is cleared when
+    the performance metric is changed. Any of the output pointers may be NULL, but not all.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle of device
+    @param[out]
+    hits        [size_t*]
+                number of solution selections served from the cache
+    @param[out]
+    misses      [size_t*]
+                number of solution selections which were not found in the cache
+    @param[out]
+    entries     [size_t*]
+                number of solutions currently held in the cache
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_solution_cache_stats(rocblas_handle handle,
+                                                               size_t*        hits,
+                                                               size_t*        misses,
+                                                               size_t*        entries);
+
+/*! \brief returns statistics of the staging buffer pools of the transfer functions
+     \details
+    rocblas_set_vector, rocblas_get_vector, rocblas_set_matrix and rocblas_get_matrix stage
+    non-contiguous data through buffers of pinned host memory and device memory. Released
+    buffers are kept in process-wide pools, one of pinned memory and one for each device, for
+    reuse by later calls. Each pool keeps at most ROCBLAS_STAGING_POOL_CAP bytes (default
+    64 MiB, 0 disables reuse). The statistics are totals over all pools. Any of the output
+    pointers may be NULL, but not all.
+    @param[out]
+    hits        [size_t*]
+                number of buffers reused from a pool
+    @param[out]
+    misses      [size_t*]
+                number of buffers which were allocated
+    @param[out]
+    cached_bytes [size_t*]
+                number of bytes currently kept in the pools for reuse
+    @param[out]
+    peak_bytes  [size_t*]
+                sum over the pools of the largest number of bytes each held at one time,
+                in use or kept for reuse
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_staging_pool_stats(size_t* hits,
+                                                             size_t* misses,
+                                                             size_t* cached_bytes,
+                                                             size_t* peak_bytes);
+
+/*! \brief sets the number of bytes each staging buffer pool keeps for reuse
+     \details
+    Overrides ROCBLAS_STAGING_POOL_CAP for all staging buffer pools, including pools of
+    devices which have not been used yet. Buffers kept beyond the new cap are freed, so a
+    cap of 0 frees all buffers which are not in use and disables reuse.
+    @param[in]
+    cap         [size_t]
+                maximum number of bytes kept by each pool
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_staging_pool_cap(size_t cap);
+
+/*! \brief reports the pending deferred numeric checks of a handle
+     \details
+    With rocblas_check_numerics_mode_deferred set in ROCBLAS_CHECK_NUMERICS, the numeric
+    checks of the inputs and outputs of rocBLAS calls do not synchronize the stream. Their
+    records are reported as they complete, during later checks with the same handle. This
+    function waits for the pending records of the handle and reports them, as messages or
+    through the function set by rocblas_set_check_numerics_callback.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle whose checks are reported
+    @return rocblas_status_check_numerics_fail if rocblas_check_numerics_mode_fail is set
+    and a record reported since the previous flush has a NaN, infinity or denormal value;
+    rocblas_status_success otherwise
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_check_numerics_flush(rocblas_handle handle);
+
+/*! \brief sets the function which receives the records of deferred numeric checks
+     \details
+    The callback is called on the host thread which reports the records, once for each
+    record which would otherwise be printed by the info or warn modes of check_numerics.
+    The record is only valid during the call. A null callback restores printing.
+    Records are only reported during later checks with the handle, by
+    rocblas_check_numerics_flush and by rocblas_destroy_handle, so the callback of a completed
+    check waits for one of these; synchronizing the stream does not report it.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle whose checks are reported through callback
+    @param[in]
+    callback    [rocblas_check_numerics_callback]
+                function receiving the records, or nullptr
+    @param[in]
+    user_data   [void*]
+                pointer passed to each call of callback
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_set_check_numerics_callback(
+    rocblas_handle handle, rocblas_check_numerics_callback callback, void* user_data);
+
+/*! \brief gets the dynamic ranges of the checked inputs and outputs of a handle
+     \details
+    With rocblas_check_numerics_mode_range set in ROCBLAS_CHECK_NUMERICS, the numeric checks
+    of the inputs and outputs of rocBLAS calls also find the largest and the smallest nonzero
+    magnitude of the values, and a histogram of their binary exponents. The results are
+    accumulated per function, separately for inputs and outputs, until
+    rocblas_reset_check_numerics_ranges is called. Pending deferred checks of the handle are
+    waited for and included.
+    @param[in]
+    handle      [rocblas_handle]
+                the handle whose checks are queried
+    @param[out]
+    ranges      [rocblas_check_numerics_range*]
+                array of *count ranges, in the order in which their functions were first
+                checked, or nullptr to query the number of ranges
+    @param[inout]
+    count       [size_t*]
+                on entry, the length of ranges; on exit, the number of ranges copied, or the
+                number of ranges available if ranges is nullptr
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_check_numerics_ranges(
+    rocblas_handle handle, rocblas_check_numerics_range* ranges, size_t* count);
+
+/*! \brief clears the dynamic ranges of the checked inputs and outputs of a handle
+    @param[in]
+    handle      [rocblas_handle]
+                the handle whose ranges are cleared
+     ********************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_reset_check_numerics_ranges(rocblas_handle handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -547,6 +547,154 @@ ROCBLAS_EXPORT rocblas_status
                                                   rocblas_int*      list_array,
                                                   rocblas_int*      list_size);
 
+/*! \brief How the Tensile logic of the solution selected for a GEMM problem covers it */
+typedef enum rocblas_gemm_coverage_
+{
+    /*! \brief The problem size is an exact-logic entry which was benchmarked when tuning. */
+    rocblas_gemm_coverage_exact = 0,
+    /*! \brief The solution of the nearest benchmarked problem size is used. */
+    rocblas_gemm_coverage_nearest = 1,
+    /*! \brief A fallback solution is used, as no tuned logic matches the problem. */
+    rocblas_gemm_coverage_fallback = 2,
+    /*! \brief No solution can solve the problem. */
+    rocblas_gemm_coverage_none = 3,
+} rocblas_gemm_coverage;
+
+ROCBLAS_DEPRECATED_MSG("rocblas_gemm_strided_batched_ex_get_coverage is a beta feature and is "
+                       "subject to change in future releases")
+/*! @{
+    \brief <b> BLAS BETA API </b>
+
+    \details
+    gemm_strided_batched_ex_get_coverage reports whether the solution which
+    gemm_strided_batched_ex selects for a problem comes from an exact-logic entry of the tuned
+    Tensile logic, from the nearest benchmarked size, or from a fallback. Problems which are not
+    served by exact-logic entries are candidates for tuning.
+
+    No kernel is launched, and the matrices are not accessed. a, b, c and d can be NULL.
+    All other parameters correspond to gemm_strided_batched_ex, with the solution selected as
+    for algo = rocblas_gemm_algo_standard. Calls to gemm_batched_ex are covered by the same logic
+    as the equivalent gemm_strided_batched_ex calls.
+
+    @param[in]
+    handle    [rocblas_handle]
+              handle to the rocblas library context queue.
+    @param[in]
+    transA    [rocblas_operation]
+              specifies the form of op( A ).
+    @param[in]
+    transB    [rocblas_operation]
+              specifies the form of op( B ).
+    @param[in]
+    m         [rocblas_int]
+              matrix dimension m.
+    @param[in]
+    n         [rocblas_int]
+              matrix dimension n.
+    @param[in]
+    k         [rocblas_int]
+              matrix dimension k.
+    @param[in]
+    alpha     [const void *]
+              device pointer or host pointer specifying the scalar alpha. Same datatype as compute_type.
+    @param[in]
+    a         [void *]
+              device pointer pointing to first matrix A_1, or NULL.
+    @param[in]
+    a_type    [rocblas_datatype]
+              specifies the datatype of each matrix A_i.
+    @param[in]
+    lda       [rocblas_int]
+              specifies the leading dimension of each A_i.
+    @param[in]
+    stride_a  [rocblas_stride]
+              specifies stride from start of one A_i matrix to the next A_(i + 1).
+    @param[in]
+    b         [void *]
+              device pointer pointing to first matrix B_1, or NULL.
+    @param[in]
+    b_type    [rocblas_datatype]
+              specifies the datatype of each matrix B_i.
+    @param[in]
+    ldb       [rocblas_int]
+              specifies the leading dimension of each B_i.
+    @param[in]
+    stride_b  [rocblas_stride]
+              specifies stride from start of one B_i matrix to the next B_(i + 1).
+    @param[in]
+    beta      [const void *]
+              device pointer or host pointer specifying the scalar beta. Same datatype as compute_type.
+    @param[in]
+    c         [void *]
+              device pointer pointing to first matrix C_1, or NULL.
+    @param[in]
+    c_type    [rocblas_datatype]
+              specifies the datatype of each matrix C_i.
+    @param[in]
+    ldc       [rocblas_int]
+              specifies the leading dimension of each C_i.
+    @param[in]
+    stride_c  [rocblas_stride]
+              specifies stride from start of one C_i matrix to the next C_(i + 1).
+    @param[in]
+    d         [void *]
+              device pointer pointing to first matrix D_1, or NULL.
+    @param[in]
+    d_type    [rocblas_datatype]
+              specifies the datatype of each matrix D_i.
+    @param[in]
+    ldd       [rocblas_int]
+              specifies the leading dimension of each D_i.
+    @param[in]
+    stride_d  [rocblas_stride]
+              specifies stride from start of one D_i matrix to the next D_(i + 1).
+    @param[in]
+    batch_count
+              [rocblas_int]
+              number of gemm operations in the batch.
+    @param[in]
+    compute_type
+              [rocblas_datatype]
+              specifies the datatype of computation.
+    @param[in]
+    flags     [uint32_t]
+              optional gemm flags.
+    @param[out]
+    coverage  [rocblas_gemm_coverage *]
+              host pointer receiving the coverage of the problem. Quick return cases, such as
+              m == 0, receive rocblas_gemm_coverage_exact as no kernel is needed.
+
+    ********************************************************************/
+ROCBLAS_EXPORT rocblas_status
+    rocblas_gemm_strided_batched_ex_get_coverage(rocblas_handle         handle,
+                                                 rocblas_operation      transA,
+                                                 rocblas_operation      transB,
+                                                 rocblas_int            m,
+                                                 rocblas_int            n,
+                                                 rocblas_int            k,
+                                                 const void*            alpha,
+                                                 const void*            a,
+                                                 rocblas_datatype       a_type,
+                                                 rocblas_int            lda,
+                                                 rocblas_stride         stride_a,
+                                                 const void*            b,
+                                                 rocblas_datatype       b_type,
+                                                 rocblas_int            ldb,
+                                                 rocblas_stride         stride_b,
+                                                 const void*            beta,
+                                                 const void*            c,
+                                                 rocblas_datatype       c_type,
+                                                 rocblas_int            ldc,
+                                                 rocblas_stride         stride_c,
+                                                 void*                  d,
+                                                 rocblas_datatype       d_type,
+                                                 rocblas_int            ldd,
+                                                 rocblas_stride         stride_d,
+                                                 rocblas_int            batch_count,
+                                                 rocblas_datatype       compute_type,
+                                                 uint32_t               flags,
+                                                 rocblas_gemm_coverage* coverage);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17767,6 +17767,65 @@ ROCBLAS_EXPORT rocblas_status rocblas_start_device_memory_size_query(rocblas_han
 ROCBLAS_EXPORT rocblas_status rocblas_stop_device_memory_size_query(rocblas_handle handle,
                                                                     size_t*        size);
 
+/*! \brief
+    \details
+    Gets the device memory requested by each call during the most recent device memory size query.
+    Every call which requested device memory between rocblas_start_device_memory_size_query and
+    rocblas_stop_device_memory_size_query is recorded, in call order, with the name of the rocBLAS
+    API which requested the memory, and the size of each of its buffers (for example, GEMM
+    workspace, trsm inverse and temporary buffers, or reduction partial results).
+    The records are kept until the next query is started.
+    If entries is nullptr, only the number of records is returned in count. Otherwise count is the
+    capacity of entries on input, and on output it is the number of records, of which at most the
+    input count are copied to entries.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if count is nullptr;
+    rocblas_status_size_query_mismatch if a collection is underway; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[inout]
+    count           capacity of entries on input, number of records on output
+    @param[out]
+    entries         array of records, or nullptr
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status
+    rocblas_get_device_memory_query_breakdown(rocblas_handle                     handle,
+                                              size_t*                            count,
+                                              rocblas_device_memory_query_entry* entries);
+
+/*! \brief
+    \details
+    Plans the device memory workspace of a sequence of calls without executing them.
+    Each call is given as a rocblas-bench command line, as printed when the layer mode includes
+    rocblas_layer_mode_log_bench, for example
+    "./rocblas-bench -f trsm -r f32_r --side L --uplo L --transposeA N --diag N -m 512 -n 512 --alpha 1 --lda 512 --ldb 512".
+    Each call is made in device memory size query mode, so no kernels are launched and no operands are accessed.
+    The calls supported are gemm, gemm_strided_batched, trsm, trsm_strided_batched, syrk, gemv, symv, trsv and dot,
+    in precisions f32_r, f64_r, f32_c and f64_c.
+    The workspace of each call is stored in step_sizes, and the largest of them in peak, which is enough for the whole
+    sequence when it runs on one stream. The result can be used with rocblas_set_workspace.
+    The handle must be created on a device of the architecture the sequence will run on, since workspace
+    sizes depend on the GEMM solutions selected for that architecture.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if peak is nullptr, or
+    calls is nullptr and count > 0; rocblas_status_invalid_value if a call is not a rocblas-bench command line;
+    rocblas_status_not_implemented if a call is not supported; rocblas_status_size_query_mismatch if a size query is
+    already underway; the error of a call if its arguments are invalid; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[in]
+    count           number of calls
+    @param[in]
+    calls           array of count rocblas-bench command lines
+    @param[out]
+    step_sizes      array of count workspace sizes in bytes, or nullptr
+    @param[out]
+    peak            largest workspace size in bytes
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_plan_workspace(rocblas_handle     handle,
+                                                     size_t             count,
+                                                     const char* const* calls,
+                                                     size_t*            step_sizes,
+                                                     size_t*            peak);
+
 // Internal functions for managing device memory
 ROCBLAS_EXPORT bool           rocblas_is_device_memory_size_query(rocblas_handle handle);
 ROCBLAS_EXPORT rocblas_status rocblas_set_optimal_device_memory_size_impl(rocblas_handle handle,
@@ -17796,6 +17855,24 @@ ROCBLAS_EXPORT void           rocblas_device_malloc_set_default_memory_size(size
  ******************************************************************************/
 ROCBLAS_EXPORT rocblas_status rocblas_get_device_memory_size(rocblas_handle handle, size_t* size);
 
+/*! \brief
+    \details
+    Gets device memory usage statistics for the handle.
+    The handle's device memory is held in one or more slabs. When rocBLAS-managed memory runs out,
+    a slab is added rather than reallocating memory which is in use.
+    Either output pointer may be nullptr, but not both.
+    Returns rocblas_status_invalid_handle if handle is nullptr; rocblas_status_invalid_pointer if both pointers are nullptr; rocblas_status_success otherwise
+    @param[in]
+    handle          rocblas handle
+    @param[out]
+    high_water_mark largest number of bytes of device memory in use at one time since the handle was created
+    @param[out]
+    slab_count      number of slabs currently holding the handle's device memory
+ ******************************************************************************/
+ROCBLAS_EXPORT rocblas_status rocblas_get_device_memory_stats(rocblas_handle handle,
+                                                              size_t*        high_water_mark,
+                                                              size_t*        slab_count);
+
 /*! \brief
     \details
     Changes the size of allocated device memory at runtime.
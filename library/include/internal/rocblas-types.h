@@ -252,6 +252,10 @@ typedef enum rocblas_layer_mode_
     rocblas_layer_mode_log_bench = 0x2,
     /*! \brief Outputs a YAML description of each rocBLAS function called, along with its arguments and number of times it was called. */
     rocblas_layer_mode_log_profile = 0x4,
+    /*! \brief Combined with log_trace or log_bench, writes fixed-size binary records to the file named by ROCBLAS_LOG_BINARY_PATH instead of text. The records are converted to text with rocblas-log-decode. */
+    rocblas_layer_mode_log_binary = 0x8,
+    /*! \brief Implies log_trace, and writes each call as an event timed on the stream in Chrome trace JSON, which can be viewed with chrome://tracing or Perfetto. Takes precedence over log_binary for trace logging. */
+    rocblas_layer_mode_log_chrome_trace = 0x10,
 } rocblas_layer_mode;
 
 /*! \brief Indicates if layer is active with bitmask*/
@@ -315,6 +319,68 @@ typedef enum rocblas_check_numerics_mode_
     //Return 'rocblas_status_check_numeric_fail' status if there is NaN/Inf/denormal value
     rocblas_check_numerics_mode_fail = 0x4,
 
+    //Do not wait for the results of checks; they are reported when they complete, at the
+    //latest by rocblas_check_numerics_flush, which also returns the 'fail' status
+    rocblas_check_numerics_mode_deferred = 0x8,
+
+    //Accumulate the dynamic range of the checked values, available from
+    //rocblas_get_check_numerics_ranges and printed with 'info'
+    rocblas_check_numerics_mode_range = 0x10,
+
 } rocblas_check_numerics_mode;
 
+/*! \brief Result of one deferred numeric check of an input or output of a rocBLAS call */
+typedef struct rocblas_check_numerics_record_
+{
+    const char* function_name; /**< Name of the rocBLAS function. */
+    uint64_t    call_id; /**< Number of the call among the checked calls of its handle. */
+    int         is_input; /**< 1 if an input was checked, 0 if an output was checked. */
+    int         has_NaN; /**< 1 if the vector or matrix has a NaN. */
+    int         has_zero; /**< 1 if the vector or matrix has a zero. */
+    int         has_Inf; /**< 1 if the vector or matrix has an infinity. */
+    int         has_denorm; /**< 1 if the vector or matrix has a denormal value. */
+} rocblas_check_numerics_record;
+
+/*! \brief Function which receives the records of deferred numeric checks */
+typedef void (*rocblas_check_numerics_callback)(const rocblas_check_numerics_record* record,
+                                                void*                                user_data);
+
+/*! \brief Binary exponent counted by the first bin of rocblas_check_numerics_range histograms */
+#define ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN (-150)
+
+/*! \brief Number of bins of the histograms of rocblas_check_numerics_range */
+#define ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS 280
+
+/*! \brief Dynamic range of the inputs or the outputs of a rocBLAS function over its checked calls
+    \details
+    Real and imaginary parts of complex values are counted as separate values. Bin i of
+    exponent_histogram counts the finite nonzero values whose magnitude is in
+    [2^e, 2^(e+1)), for e = ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN + i; the first and the last
+    bins also count the values with smaller and larger exponents.
+ */
+typedef struct rocblas_check_numerics_range_
+{
+    const char* function_name; /**< Name of the rocBLAS function. */
+    int         is_input; /**< 1 for the inputs, 0 for the outputs. */
+    uint64_t    checks; /**< Number of checked vectors and matrices. */
+    uint64_t    nonzeros; /**< Number of finite nonzero values. */
+    uint64_t    zeros; /**< Number of zeros. */
+    uint64_t    non_finite; /**< Number of NaNs and infinities. */
+    double      abs_max; /**< Largest finite magnitude, or 0 if there is no nonzero value. */
+    double      min_nonzero; /**< Smallest nonzero magnitude, or 0 if there is none. */
+    uint64_t    exponent_histogram[ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS]; /**< Exponents. */
+} rocblas_check_numerics_range;
+
+/*! \brief Maximum number of buffer sizes recorded for one call by a device memory size query */
+#define ROCBLAS_DEVICE_MEMORY_QUERY_MAX_SIZES 8
+
+/*! \brief Device memory requested by one call during a device memory size query */
+typedef struct rocblas_device_memory_query_entry_
+{
+    const char* function; /**< Name of the API which requested the memory. */
+    size_t      total; /**< Total bytes, with each size rounded up to the allocation granularity. */
+    size_t      num_sizes; /**< Number of buffer sizes requested. */
+    size_t      sizes[ROCBLAS_DEVICE_MEMORY_QUERY_MAX_SIZES]; /**< Bytes requested for each buffer. */
+} rocblas_device_memory_query_entry;
+
 #endif /* ROCBLAS_TYPES_H */
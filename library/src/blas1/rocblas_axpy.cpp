@@ -99,6 +99,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status axpy_check_numerics_status
                 = rocblas_axpy_check_numerics(rocblas_axpy_name<T>,
@@ -92,6 +92,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status copy_check_numerics_status
                 = rocblas_copy_check_numerics(rocblas_copy_batched_name<T>,
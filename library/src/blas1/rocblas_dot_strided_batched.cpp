@@ -77,6 +77,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_dot_strided_batched_name<CONJ, T>);
+
         size_t dev_bytes = rocblas_reduction_kernel_workspace_size<NB * WIN, T2>(n, batch_count);
         if(handle->is_device_memory_size_query())
         {
@@ -158,6 +160,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status dot_check_numerics_status
                 = rocblas_dot_check_numerics(rocblas_dot_strided_batched_name<CONJ, T>,
@@ -73,6 +73,7 @@ namespace
         auto check_numerics = handle->check_numerics;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status check_numerics_status
                 = rocblas_internal_check_numerics_vector_template(rocblas_iamax_batched_name<T>,
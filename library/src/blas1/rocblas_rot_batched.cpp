@@ -100,6 +100,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status rot_check_numerics_status
                 = rocblas_rot_check_numerics(rocblas_rot_name<T>,
@@ -74,6 +74,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status rotg_check_numerics_status
                 = rocblas_rotg_check_numerics_template(rocblas_rotg_name<T>,
@@ -93,6 +93,7 @@ namespace
             return rocblas_status_invalid_pointer;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status rotm_check_numerics_status
                 = rocblas_rotm_check_numerics(rocblas_rotm_name<T>,
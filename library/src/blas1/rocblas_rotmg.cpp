@@ -57,6 +57,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status rotmg_check_numerics_status
                 = rocblas_rotmg_check_numerics_template(rocblas_rotmg_name<T>,
@@ -88,6 +88,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status swap_check_numerics_status
                 = rocblas_swap_check_numerics(rocblas_swap_batched_name<T>,
@@ -108,6 +108,7 @@ namespace
             return rocblas_status_invalid_pointer;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status swap_check_numerics_status
                 = rocblas_swap_check_numerics(rocblas_swap_strided_batched_name<T>,
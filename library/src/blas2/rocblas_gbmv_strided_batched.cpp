@@ -174,6 +174,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status gbmv_check_numerics_status
                 = rocblas_gbmv_check_numerics(rocblas_gbmv_name<T>,
@@ -52,6 +52,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_gemv_name<T>);
+
         size_t dev_bytes = rocblas_internal_gemv_kernel_workspace_size<T>(transA, m, n);
         if(handle->is_device_memory_size_query())
             return handle->set_optimal_device_memory_size(dev_bytes);
@@ -127,6 +129,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status gemv_check_numerics_status
                 = rocblas_gemv_check_numerics(rocblas_gemv_name<T>,
@@ -26,7 +26,6 @@
 #include "check_numerics_vector.hpp"
 #include "gemv_device.hpp"
 #include "handle.hpp"
-#include "rocblas_level2_threshold.hpp"
 
 template <typename Ti, typename Tex, typename To>
 inline rocblas_status rocblas_internal_gemv_arg_check(rocblas_handle    handle,
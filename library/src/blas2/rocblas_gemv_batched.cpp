@@ -64,6 +64,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_gemv_name<Ti, To>);
+
         size_t dev_bytes
             = rocblas_internal_gemv_kernel_workspace_size<Tex>(transA, m, n, batch_count);
         if(handle->is_device_memory_size_query())
@@ -197,6 +199,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status gemv_check_numerics_status
                 = rocblas_gemv_check_numerics(rocblas_gemv_name<Ti, To>,
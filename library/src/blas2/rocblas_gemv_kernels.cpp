@@ -24,8 +24,8 @@
 #include "check_numerics_vector.hpp"
 #include "gemv_device.hpp"
 #include "handle.hpp"
+#include "level2_variants.hpp"
 #include "rocblas_gemv.hpp"
-#include "rocblas_level2_threshold.hpp"
 
 // The warpSize * 2 corresponds to the number of x-dimension threads per block optimized for better performance in the double_buffered_kernels.
 constexpr int rocblas_gemv_bx()
@@ -171,12 +171,29 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
               rocblas_double_complex> || std::is_same_v<Ti, rocblas_double_complex const*>;
     const bool is_atomics_allowed = handle->atomics_mode == rocblas_atomics_allowed ? true : false;
 
-    //Identifying the architecture to have an appropriate optimization
-    int  arch_major       = handle->getArchMajor();
-    bool is_arch_10_or_11 = arch_major == 10 || arch_major == 11 ? true : false;
-    bool is_gfx908        = handle->getArch() == 908 ? true : false;
-    bool is_gfx906        = handle->getArch() == 906 ? true : false;
-    bool is_gfx90a        = handle->getArch() == 910 ? true : false;
+    // Select the kernel variant from the rules of the architecture. The double buffered
+    // kernels need atomics, a square matrix whose size is a multiple of their block size,
+    // and a float or double type.
+    static constexpr char precision
+        = rocblas_level2_precision(is_float, is_double, is_complex_float, is_complex_double);
+    const rocblas_level2_op op = transA == rocblas_operation_none ? rocblas_level2_op::gemv_n
+                                 : transA == rocblas_operation_transpose
+                                     ? rocblas_level2_op::gemv_t
+                                     : rocblas_level2_op::gemv_c;
+
+    const rocblas_level2_variant variant = handle->level2_variants->select(
+        op, precision, m, n, batch_count, [&](rocblas_level2_variant v) {
+            switch(v)
+            {
+            case rocblas_level2_variant::sm_mn_batched:
+                return m <= 32 && n <= 32;
+            case rocblas_level2_variant::double_buffered:
+                return is_atomics_allowed && (is_float || is_double) && m == n
+                       && m % rocblas_gemv_bx() == 0;
+            default:
+                return true;
+            }
+        });
 
     if(transA == rocblas_operation_none)
     {
@@ -184,7 +201,7 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
     gemvn_grid, gemvn_threads, 0, rocblas_stream, m, n, alpha_, stride_alpha, A, offseta, lda, \
         strideA, x, shiftx, incx, stridex, beta_, stride_beta, y, shifty, incy, stridey
 
-        if(is_gfx90a && m <= 32 && n <= 32 && batch_count >= 256)
+        if(variant == rocblas_level2_variant::sm_mn_batched)
         {
 #define gemvn_sm_mn_batched_KARGS(alpha_, beta_)                                                 \
     gemvn_sm_mn_batched_grid, gemvn_sm_mn_batched_threads, 0, rocblas_stream, m, n, alpha_,      \
@@ -254,9 +271,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
                                        gemvn_KARGS(*alpha, *beta));
             }
         }
-        //optimized gemvn kernel with double buffered loads for gfx90a.
-        else if(is_atomics_allowed && is_gfx90a && (is_float || is_double) && (m == n)
-                && (m % rocblas_gemv_bx() == 0))
+        //optimized gemvn kernel with double buffered loads.
+        else if(variant == rocblas_level2_variant::double_buffered)
         {
             if constexpr(is_float || is_double)
             {
@@ -331,22 +347,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
             }
 #undef gemvn_double_buffered_KARGS
         }
-        //optimized gemvn kernel for gfx906 and gfx908.
-        else if((is_gfx908
-                 && (((is_float || is_double || is_complex_float) && m <= gemvn_gfx908_threshold
-                      && n <= gemvn_gfx908_threshold)
-                     || (is_complex_double && m <= zgemvn_gfx908_threshold
-                         && n <= zgemvn_gfx908_threshold)))
-
-                || (is_gfx906
-                    && (is_complex_float
-                        || ((is_float || is_double) && m <= gemvn_gfx906_threshold
-                            && n <= gemvn_gfx906_threshold)
-                        || (is_double
-                            && ((m >= dgemvn_gfx906_lower_threshold
-                                 && n >= dgemvn_gfx906_lower_threshold)
-                                || (m <= dgemvn_gfx906_upper_threshold
-                                    && n <= dgemvn_gfx906_upper_threshold))))))
+        //gemvn kernel with 512 threads per block.
+        else if(variant == rocblas_level2_variant::threads_512)
         {
             static constexpr int GEMVN_DIM_X = 32;
             static constexpr int GEMVN_DIM_Y = 16;
@@ -548,11 +550,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
 
 #undef gemvt_sn_KARGS
         }
-        //optimized gemvt kernel with double buffered loads for gfx908.
-        else if(is_atomics_allowed && (m == n) && (m % rocblas_gemv_bx() == 0)
-                && (is_gfx908
-                    && ((is_float && m > sgemvt_gfx908_lower_threshold)
-                        || (is_double && m > dgemvt_gfx908_lower_threshold))))
+        //optimized gemvt kernel with double buffered loads.
+        else if(variant == rocblas_level2_variant::double_buffered)
         {
             if constexpr(is_float || is_double)
             {
@@ -633,12 +632,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
     gemvt_grid, gemvt_threads, 0, rocblas_stream, m, n, alpha_, stride_alpha, A, offseta, lda, \
         strideA, x, shiftx, incx, stridex, beta_, stride_beta, y, shifty, incy, stridey
 
-        //Using kernel code with warp reduction for gfx1030.
-        else if(is_arch_10_or_11
-                && (is_double || is_complex_float
-                    || (is_float
-                        && (m < sgemvt_gfx_arch_10_11_threshold
-                            || n < sgemvt_gfx_arch_10_11_threshold))))
+        //Using kernel code with warp reduction and 256 threads per block.
+        else if(variant == rocblas_level2_variant::warp_reduce_256)
         {
             //Number of threads per block
             static constexpr int NB = 256;
@@ -659,9 +654,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
                                    gemvt_KARGS(*alpha, *beta));
             }
         }
-        //Using kernel code with shared memory reduction for single precision as well as for other precisions when m or n is less than 6000 and for complex double in gfx1030.
-        else if((is_float || m < gemvt_threshold || n < gemvt_threshold)
-                || (is_arch_10_or_11 && is_complex_double))
+        //Using kernel code with shared memory reduction.
+        else if(variant == rocblas_level2_variant::shared_reduce_256)
         {
             //Number of threads per block
             static constexpr int NB = 256;
@@ -837,11 +831,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
 
 #undef gemvt_sn_KARGS
         }
-        //optimized gemvt kernel with double buffered loads for gfx908.
-        else if(is_atomics_allowed && (m == n) && (m % rocblas_gemv_bx() == 0)
-                && (is_gfx908
-                    && ((is_float && m > sgemvt_gfx908_lower_threshold)
-                        || (is_double && m > dgemvt_gfx908_lower_threshold))))
+        //optimized gemvt kernel with double buffered loads.
+        else if(variant == rocblas_level2_variant::double_buffered)
         {
             if constexpr(is_float || is_double)
             {
@@ -921,8 +912,8 @@ rocblas_status rocblas_internal_gemv_template(rocblas_handle    handle,
 #define gemvt_KARGS(alpha_, beta_)                                                             \
     gemvt_grid, gemvt_threads, 0, rocblas_stream, m, n, alpha_, stride_alpha, A, offseta, lda, \
         strideA, x, shiftx, incx, stridex, beta_, stride_beta, y, shifty, incy, stridey
-        //Using kernel code with shared memory reduction for single precision and all other precision when m or n is less than 6000.
-        else if(is_float || m < 6000 || n < 6000)
+        //Using kernel code with shared memory reduction.
+        else if(variant == rocblas_level2_variant::shared_reduce_256)
         {
             //Number of threads per block
             static constexpr int NB = 256;
@@ -137,6 +137,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status ger_check_numerics_status
                 = rocblas_ger_check_numerics(rocblas_ger_batched_name<CONJ, T>,
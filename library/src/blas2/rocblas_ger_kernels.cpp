@@ -23,6 +23,7 @@
 #include "check_numerics_matrix.hpp"
 #include "check_numerics_vector.hpp"
 #include "handle.hpp"
+#include "level2_variants.hpp"
 #include "rocblas_ger.hpp"
 
 template <rocblas_int DIM_X,
@@ -283,15 +284,24 @@ rocblas_status rocblas_internal_ger_template(rocblas_handle handle,
     static constexpr bool is_double        = std::is_same_v<T, double>;
     static constexpr bool is_complex_float = std::is_same_v<T, rocblas_float_complex>;
 
-    bool is_gfx90a = handle->getArch() == 910 ? true : false;
+    // Select the kernel variant from the rules of the architecture. The double buffered
+    // kernel needs a square matrix whose size is a multiple of its block size.
+    static constexpr char precision
+        = rocblas_level2_precision(is_float, is_double, is_complex_float, false);
+    const rocblas_level2_variant variant = handle->level2_variants->select(
+        rocblas_level2_op::ger, precision, m, n, batch_count, [&](rocblas_level2_variant v) {
+            return v != rocblas_level2_variant::double_buffered
+                   || ((m == n)
+                       && ((m % 64 == 0 && (is_double || is_complex_float))
+                           || ((m % 128 == 0) && is_float)));
+        });
 
 #define ger_KARGS(alpha_)                                                                  \
     ger_grid, ger_threads, 0, rocblas_stream, m, n, alpha_, stride_alpha, x, shiftx, incx, \
         stridex, y, shifty, incy, stridey, A, offsetA, lda, strideA
 
-    //optimized double buffered loads kernel for float, double and float_complex precisions in gfx90a
-    if(is_gfx90a && (m > 2000) && (m == n)
-       && ((m % 64 == 0 && (is_double || is_complex_float)) || ((m % 128 == 0) && is_float)))
+    //optimized double buffered loads kernel for float, double and float_complex precisions
+    if(variant == rocblas_level2_variant::double_buffered)
     {
         //The following rocblas_ger_double_buffered_kernel is only valid for the multiples of DIM_X
         static constexpr int DIM_X               = is_float ? 128 : 64;
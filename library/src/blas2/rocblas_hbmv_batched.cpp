@@ -138,6 +138,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status hbmv_check_numerics_status
                 = rocblas_hbmv_check_numerics(rocblas_hbmv_name<T>,
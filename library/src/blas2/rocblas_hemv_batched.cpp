@@ -47,6 +47,8 @@ namespace
     {
         if(!handle)
             return rocblas_status_invalid_handle;
+
+        handle->set_device_memory_query_function(rocblas_hemv_name<T>);
         auto check_numerics = handle->check_numerics;
         if(!handle->is_device_memory_size_query())
         {
@@ -146,6 +148,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status hemv_check_numerics_status
                 = rocblas_hemv_check_numerics(rocblas_hemv_name<T>,
@@ -80,8 +80,8 @@
 #include "check_numerics_matrix.hpp"
 #include "check_numerics_vector.hpp"
 #include "handle.hpp"
+#include "level2_variants.hpp"
 #include "rocblas_hemv_symv.hpp"
-#include "rocblas_level2_threshold.hpp"
 
 constexpr int rocblas_hemv_DIM_X()
 {
@@ -2953,9 +2953,19 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
     const bool is_atomics_allowed = handle->atomics_mode == rocblas_atomics_allowed ? true : false;
 
-    //Identifying the specific architecture to have an appropriate optimization
-    bool is_gfx90a = handle->getArch() == 910 ? true : false;
-    bool is_gfx908 = handle->getArch() == 908 ? true : false;
+    // Select the kernel variant from the rules of the architecture. The double buffered
+    // kernels need atomics and a float or double type.
+    static constexpr char precision = rocblas_level2_precision(is_float, is_double, false, false);
+    const rocblas_level2_variant variant = handle->level2_variants->select(
+        uplo == rocblas_fill_upper ? rocblas_level2_op::symv_upper : rocblas_level2_op::symv_lower,
+        precision,
+        n,
+        n,
+        batch_count,
+        [&](rocblas_level2_variant v) {
+            return v != rocblas_level2_variant::double_buffered
+                   || (is_atomics_allowed && (is_float || is_double));
+        });
 
     static constexpr int HEMV_DIM_X         = rocblas_hemv_DIM_X();
     static constexpr int HEMV_DIM_Y         = 4;
@@ -2978,17 +2988,7 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
 
     if(uplo == rocblas_fill_upper)
     {
-        if(is_atomics_allowed
-           && ((is_gfx90a
-                && ((is_float && n < ssymv_U_gfx908_gfx90a_higher_threshold)
-                    || (is_double && n < dsymv_U_gfx90a_higher_threshold)))
-               || (is_gfx908
-                   && ((is_float && n < ssymv_U_gfx908_gfx90a_higher_threshold)
-                       || (is_double
-                           && (((n % 32 == 0) && n < dsymv_U_gfx908_higher_threshold)
-                               || ((n % 32 != 0)
-                                   && (n < dsymv_U_gfx908_generic_higher_threshold
-                                       || n > dsymv_U_gfx908_generic_lower_threshold))))))))
+        if(variant == rocblas_level2_variant::double_buffered)
         {
             bool host_ptr_mode = handle->pointer_mode == rocblas_pointer_mode_host;
             rocblas_internal_val_ptr<U> alpha_device_host(host_ptr_mode, alpha);
@@ -3197,13 +3197,7 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     }
     else
     {
-        if(is_atomics_allowed
-           && ((is_gfx908 && (is_float || is_double))
-               || (is_gfx90a
-                   && (((is_float && n < ssymv_L_gfx90a_higher_threshold)
-                        || ((n % 32 == 0 && is_double && n < dsymv_L_gfx90a_higher_threshold)
-                            || (n % 32 != 0 && is_double
-                                && n < dsymv_L_gfx90a_generic_higher_threshold)))))))
+        if(variant == rocblas_level2_variant::double_buffered)
         {
             //The following symv_kernel_upper_double_buffered is only valid for the multiples of DIM_X
             static constexpr rocblas_int DIM_X               = 32;
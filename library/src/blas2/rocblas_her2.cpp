@@ -127,6 +127,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status her2_check_numerics_status
                 = rocblas_her2_check_numerics(rocblas_her2_name<T>,
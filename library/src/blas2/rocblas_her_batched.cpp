@@ -132,6 +132,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status her_check_numerics_status
                 = rocblas_her_check_numerics(rocblas_her_batched_name<T>,
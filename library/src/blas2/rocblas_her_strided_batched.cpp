@@ -133,6 +133,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status her_check_numerics_status
                 = rocblas_her_check_numerics(rocblas_her_strided_batched_name<T>,
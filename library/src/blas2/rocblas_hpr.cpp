@@ -100,6 +100,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status hpr_check_numerics_status
                 = rocblas_hpr_check_numerics(rocblas_hpr_name<T>,
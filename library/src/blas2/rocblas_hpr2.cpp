@@ -120,6 +120,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status hpr2_check_numerics_status
                 = rocblas_hpr2_check_numerics(rocblas_hpr2_name<T>,
@@ -113,6 +113,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status hpr_check_numerics_status
                 = rocblas_hpr_check_numerics(rocblas_hpr_batched_name<T>,
@@ -0,0 +1,68 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "handle.hpp"
+#include "level2_variants.hpp"
+#include "utility.hpp"
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+/** The rules of all architectures. The file named by ROCBLAS_LEVEL2_VARIANTS is read once;
+ *  if it is malformed, a warning is printed and only the compiled rules are used.
+ */
+static const std::vector<rocblas_level2_rule>& rocblas_level2_rules()
+{
+    static const std::vector<rocblas_level2_rule> rules = [] {
+        std::vector<rocblas_level2_rule> rules;
+        std::string                      error;
+
+        const char* path = getenv("ROCBLAS_LEVEL2_VARIANTS");
+        if(path && *path)
+        {
+            std::ifstream in(path);
+            error = "cannot be read";
+            if(!in || rocblas_level2_variants_parse(in, rules, error) < 0)
+                rocblas_cerr << "rocBLAS warning: level 2 variants " << path
+                             << " are not used: " << error << std::endl;
+        }
+
+        std::istringstream defaults(rocblas_level2_default_variants);
+        if(rocblas_level2_variants_parse(defaults, rules, error) < 0)
+            rocblas_cerr << "rocBLAS internal error: level 2 variants: " << error << std::endl;
+        return rules;
+    }();
+    return rules;
+}
+
+const rocblas_level2_variant_table& rocblas_internal_level2_variants(const std::string& arch)
+{
+    static std::mutex                                          mutex;
+    static std::map<std::string, rocblas_level2_variant_table> by_arch;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = by_arch.find(arch);
+    if(it == by_arch.end())
+        it = by_arch.try_emplace(arch, rocblas_level2_rules(), arch).first;
+    return it->second;
+}
@@ -141,6 +141,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status sbmv_check_numerics_status
                 = rocblas_sbmv_check_numerics(rocblas_sbmv_batched_name<T>,
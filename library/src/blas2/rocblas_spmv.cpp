@@ -105,6 +105,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status spmv_check_numerics_status
                 = rocblas_spmv_check_numerics(rocblas_spmv_name<T>,
@@ -104,6 +104,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status spr_check_numerics_status
                 = rocblas_spr_check_numerics(rocblas_spr_name<T>,
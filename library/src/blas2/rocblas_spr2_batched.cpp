@@ -125,6 +125,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status spr2_check_numerics_status
                 = rocblas_spr2_check_numerics(rocblas_spr2_batched_name<T>,
@@ -58,6 +58,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_symv_strided_batched_name<T>);
+
         auto check_numerics = handle->check_numerics;
 
         if(!handle->is_device_memory_size_query())
@@ -170,6 +172,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status symv_check_numerics_status
                 = rocblas_symv_check_numerics(rocblas_symv_strided_batched_name<T>,
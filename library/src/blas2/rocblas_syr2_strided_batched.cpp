@@ -155,6 +155,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status syr2_check_numerics_status
                 = rocblas_syr2_check_numerics(rocblas_syr2_strided_batched_name<T>,
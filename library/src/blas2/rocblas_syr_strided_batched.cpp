@@ -123,6 +123,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status syr_check_numerics_status
                 = rocblas_syr_check_numerics(rocblas_syr_strided_batched_name<T>,
@@ -118,6 +118,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status tbsv_check_numerics_status
                 = rocblas_tbsv_check_numerics(rocblas_tbsv_name<T>,
@@ -121,6 +121,7 @@ namespace
         auto check_numerics = handle->check_numerics;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status tpsv_check_numerics_status
                 = rocblas_tpsv_check_numerics(rocblas_tpsv_batched_name<T>,
@@ -153,6 +153,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status gemm_check_numerics_status
                 = rocblas_gemm_check_numerics(rocblas_gemm_name<T>,
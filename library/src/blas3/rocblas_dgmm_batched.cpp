@@ -128,6 +128,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status dgmm_check_numerics_status
                 = rocblas_dgmm_check_numerics(rocblas_dgmm_batched_name<T>,
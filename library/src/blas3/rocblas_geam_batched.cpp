@@ -141,6 +141,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status geam_check_numerics_status
                 = rocblas_geam_check_numerics(rocblas_geam_batched_name<T>,
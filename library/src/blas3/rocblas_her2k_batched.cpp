@@ -162,6 +162,7 @@ namespace
         static constexpr bool Hermetian = true;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status her2k_check_numerics_status
                 = rocblas_her2k_syr2k_check_numerics<Hermetian>(rocblas_her2k_name<T>,
@@ -153,6 +153,7 @@ namespace
         static constexpr bool BATCHED   = false;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status herk_check_numerics_status
                 = rocblas_herk_syrk_check_numerics<Hermetian>(rocblas_herk_name<T>,
@@ -158,6 +158,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status symm_check_numerics_status
                 = rocblas_hemm_symm_check_numerics<HERMITIAN>(rocblas_symm_name<T>,
@@ -183,6 +183,7 @@ namespace
         static constexpr bool Hermetian = false;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status syr2k_check_numerics_status
                 = rocblas_her2k_syr2k_check_numerics<Hermetian>(rocblas_syr2k_name<T>,
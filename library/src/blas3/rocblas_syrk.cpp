@@ -140,6 +140,7 @@ namespace
         static constexpr bool Hermetian = false;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status syrk_check_numerics_status
                 = rocblas_herk_syrk_check_numerics<Hermetian>(rocblas_syrk_name<T>,
@@ -160,6 +160,7 @@ namespace
         static constexpr bool Hermetian = false;
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status syrkx_check_numerics_status
                 = rocblas_her2k_syr2k_check_numerics<Hermetian>(rocblas_syrkx_name<T>,
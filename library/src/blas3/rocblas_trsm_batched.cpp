@@ -65,6 +65,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_trsm_name<T>);
+
         auto check_numerics = handle->check_numerics;
         /////////////
         // LOGGING //
@@ -163,6 +165,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status trsm_check_numerics_status
                 = rocblas_trmm_check_numerics(rocblas_trsm_name<T>,
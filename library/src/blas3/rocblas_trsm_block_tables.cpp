@@ -0,0 +1,212 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "handle.hpp"
+#include "trsm_block_tables.hpp"
+#include "utility.hpp"
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/** Constants for block size of trsm **/
+// clang-format off
+#define TRSM_NUMROWS_REAL 12
+#define TRSM_NUMCOLS_REAL 16
+#define TRSM_INTERVALSROW_REAL                                          \
+    40, 56, 80, 112, 144, 176, 208, 240, 288, 352, 480
+#define TRSM_INTERVALSCOL_REAL                                          \
+    448, 768, 960, 1152, 1408, 1920, 2304, 2816, 3840, 4096, 4736,      \
+    4992, 5888, 7680, 9728
+#define TRSM_BLKSIZES_REAL                                              \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},    \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 24, 24, 24, 16},    \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1, 32, 32, 32, 32, 32, 24, 16},    \
+    {1,  1,  1,  1,  1,  1,  1, 48, 48, 48, 48, 32, 32, 32, 24, 16},    \
+    {1,  1,  1,  1,  1,  1, 64, 64, 64, 48, 48, 32, 32, 32, 24, 16},    \
+    {1,  1,  1,  1,  1, 80, 80, 80, 56, 56, 40, 40, 40, 32, 32, 32},    \
+    {1,  1,  1,  1, 80, 80, 80, 80, 80, 48, 48, 48, 40, 32,  0,  0},    \
+    {1,  1,  1, 80, 80, 80, 80, 80, 56, 56, 32, 32, 32, 32,  0,  0},    \
+    {1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
+    {1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
+    {1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
+    {0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
+
+#define TRSM_NUMROWS_COMPLEX 10
+#define TRSM_NUMCOLS_COMPLEX 12
+#define TRSM_INTERVALSROW_COMPLEX                                       \
+    40, 56, 80, 112, 144, 208, 240, 288, 480
+#define TRSM_INTERVALSCOL_COMPLEX                                       \
+    704, 960, 1344, 1920, 2304, 2816, 3200, 3840, 4864, 5888, 7680
+#define TRSM_BLKSIZES_COMPLEX                                           \
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},                               \
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 24, 24, 24},                            \
+    {1, 1, 1, 1, 1, 1, 1, 1, 32, 32, 32, 32},                           \
+    {1, 1, 1, 1, 1, 72, 72, 56, 48, 32, 32, 32},                        \
+    {1, 1, 1, 1, 64, 64, 64, 64, 48, 32, 32, 32},                       \
+    {1, 1, 1, 80, 80, 80, 64, 64, 48, 32, 32, 32},                      \
+    {1, 1, 80, 80, 80, 80, 64, 64, 40, 40, 32, 32},                     \
+    {1, 1, 72, 72, 64, 64, 64, 64, 32, 32, 32, 0},                      \
+    {1, 80, 80, 80, 80, 80, 64, 64, 48, 40, 32, 0},                     \
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+
+#define TRSM_BATCH_NUMROWS_REAL 11
+#define TRSM_BATCH_NUMCOLS_REAL 17
+#define TRSM_BATCH_INTERVALSROW_REAL                                        \
+    20, 28, 40, 80, 112, 176, 208, 288, 352, 480
+#define TRSM_BATCH_INTERVALSCOL_REAL                                        \
+    6, 10, 12, 22, 28, 30, 36, 42, 46, 50, 60, 96, 432, 928, 960, 1472
+#define TRSM_BATCH_BLKSIZES_REAL                                            \
+    { 1,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
+    { 1,  1,  1,  1, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
+    { 1,  1,  1,  1, 16, 16, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0},   \
+    { 1, 24, 24, 24, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},   \
+    {48, 48, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 16, 16, 16, 16, 16},   \
+    {64, 64, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 24, 24, 24, 24, 24},   \
+    {64, 64, 32, 32, 24, 24, 24, 24, 32, 32, 32, 32, 32, 24, 24, 24, 24},   \
+    {64, 64, 64, 32, 32, 32, 32, 40, 40, 40, 40, 32, 32, 24, 24, 32, 32},   \
+    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32, 32},   \
+    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32,  0},   \
+    {64, 64, 64, 32, 32, 32, 48, 48, 48, 48, 40, 32, 32, 32,  0,  0,  0}
+
+#define TRSM_BATCH_NUMROWS_COMPLEX 10
+#define TRSM_BATCH_NUMCOLS_COMPLEX 16
+#define TRSM_BATCH_INTERVALSROW_COMPLEX                                     \
+    20, 28, 40, 56, 80, 112, 144, 176, 480
+#define TRSM_BATCH_INTERVALSCOL_COMPLEX                                     \
+    4, 12, 16, 28, 32, 40, 48, 50, 60, 72, 88, 176, 232, 400, 464
+#define TRSM_BATCH_BLKSIZES_COMPLEX                                         \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  8,  1,  1,  1,  1,  1,  1,  1},        \
+    {1,  1,  1,  1, 16, 16, 16, 16,  1,  1,  1, 16, 16, 16, 16, 16},        \
+    {1,  1,  1, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},        \
+    {1,  1, 32, 32, 32, 32, 32, 32, 32, 32, 32, 16, 16, 16, 16, 16},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 48, 48, 32},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 32},        \
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 80, 80, 56, 56, 32, 32},        \
+    {1, 64, 32, 32, 32, 64, 48, 32, 32, 32, 32, 32, 32, 32, 32, 32},        \
+    {1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 64, 64, 48, 48, 48}
+// clang-format on
+
+template <size_t ROWS, size_t COLS>
+static rocblas_trsm_block_table
+    rocblas_trsm_compiled_table(const rocblas_int (&row_intervals)[ROWS],
+                                const rocblas_int (&col_intervals)[COLS],
+                                const rocblas_int (&blksizes)[ROWS + 1][COLS + 1])
+{
+    rocblas_trsm_block_table table;
+    table.row_intervals.assign(std::begin(row_intervals), std::end(row_intervals));
+    table.col_intervals.assign(std::begin(col_intervals), std::end(col_intervals));
+    for(auto& row : blksizes)
+        table.blksizes.insert(table.blksizes.end(), std::begin(row), std::end(row));
+    return table;
+}
+
+/** The tables compiled into the library, which are used where a data file does not replace them.
+ *  The block sizes and logic is taken directly from rocSOLVER.
+ */
+static const rocblas_trsm_block_tables& rocblas_trsm_compiled_block_tables()
+{
+    static const rocblas_trsm_block_tables compiled = [] {
+        static constexpr rocblas_int real_row[]                    = {TRSM_INTERVALSROW_REAL};
+        static constexpr rocblas_int real_col[]                    = {TRSM_INTERVALSCOL_REAL};
+        static constexpr rocblas_int real_blk[][TRSM_NUMCOLS_REAL] = {TRSM_BLKSIZES_REAL};
+
+        static constexpr rocblas_int real_batch_row[] = {TRSM_BATCH_INTERVALSROW_REAL};
+        static constexpr rocblas_int real_batch_col[] = {TRSM_BATCH_INTERVALSCOL_REAL};
+        static constexpr rocblas_int real_batch_blk[][TRSM_BATCH_NUMCOLS_REAL]
+            = {TRSM_BATCH_BLKSIZES_REAL};
+
+        static constexpr rocblas_int complex_row[] = {TRSM_INTERVALSROW_COMPLEX};
+        static constexpr rocblas_int complex_col[] = {TRSM_INTERVALSCOL_COMPLEX};
+        static constexpr rocblas_int complex_blk[][TRSM_NUMCOLS_COMPLEX]
+            = {TRSM_BLKSIZES_COMPLEX};
+
+        static constexpr rocblas_int complex_batch_row[] = {TRSM_BATCH_INTERVALSROW_COMPLEX};
+        static constexpr rocblas_int complex_batch_col[] = {TRSM_BATCH_INTERVALSCOL_COMPLEX};
+        static constexpr rocblas_int complex_batch_blk[][TRSM_BATCH_NUMCOLS_COMPLEX]
+            = {TRSM_BATCH_BLKSIZES_COMPLEX};
+
+        rocblas_trsm_block_tables tables;
+        tables.tables[rocblas_trsm_block_tables::real]
+            = rocblas_trsm_compiled_table(real_row, real_col, real_blk);
+        tables.tables[rocblas_trsm_block_tables::real_batched]
+            = rocblas_trsm_compiled_table(real_batch_row, real_batch_col, real_batch_blk);
+        tables.tables[rocblas_trsm_block_tables::complex]
+            = rocblas_trsm_compiled_table(complex_row, complex_col, complex_blk);
+        tables.tables[rocblas_trsm_block_tables::complex_batched]
+            = rocblas_trsm_compiled_table(complex_batch_row, complex_batch_col, complex_batch_blk);
+        return tables;
+    }();
+    return compiled;
+}
+
+/** The tables of an architecture. The data file named by ROCBLAS_TRSM_BLOCK_TABLES is read once
+ *  per architecture; if it is malformed, a warning is printed and the compiled tables are used.
+ */
+static const rocblas_trsm_block_tables& rocblas_trsm_arch_block_tables(const std::string& arch)
+{
+    static std::mutex                                       mutex;
+    static std::map<std::string, rocblas_trsm_block_tables> by_arch;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = by_arch.find(arch);
+    if(it != by_arch.end())
+        return it->second;
+
+    rocblas_trsm_block_tables& tables = by_arch[arch] = rocblas_trsm_compiled_block_tables();
+
+    const char* path = getenv("ROCBLAS_TRSM_BLOCK_TABLES");
+    if(path && *path)
+    {
+        std::ifstream in(path);
+        std::string   error = "cannot be read";
+        if(!in || rocblas_trsm_block_tables_parse(in, arch, tables, error) < 0)
+            rocblas_cerr << "rocBLAS warning: trsm block tables " << path
+                         << " are not used: " << error << std::endl;
+    }
+    return tables;
+}
+
+const rocblas_trsm_block_tables& rocblas_internal_trsm_block_tables()
+{
+    // The tables of each device are looked up by architecture on first use
+    static const int device_count = [] {
+        int count;
+        return hipGetDeviceCount(&count) == hipSuccess ? count : 0;
+    }();
+    static const auto device_tables
+        = std::make_unique<std::atomic<const rocblas_trsm_block_tables*>[]>(device_count);
+
+    int device;
+    if(hipGetDevice(&device) != hipSuccess || device < 0 || device >= device_count)
+        return rocblas_trsm_compiled_block_tables();
+
+    auto* tables = device_tables[device].load(std::memory_order_acquire);
+    if(!tables)
+    {
+        tables = &rocblas_trsm_arch_block_tables(rocblas_internal_get_arch_name());
+        device_tables[device].store(tables, std::memory_order_release);
+    }
+    return *tables;
+}
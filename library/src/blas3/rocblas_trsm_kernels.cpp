@@ -27,105 +27,9 @@
 #include "Tensile/gemm.hpp"
 #include "rocblas_block_sizes.h"
 #include "rocblas_trsm.hpp"
+#include "trsm_block_tables.hpp"
 #include "trtri_trsm.hpp"
 
-/** Constants for block size of trsm **/
-// clang-format off
-#define TRSM_NUMROWS_REAL 12
-#define TRSM_NUMCOLS_REAL 16
-#define TRSM_INTERVALSROW_REAL                                          \
-    40, 56, 80, 112, 144, 176, 208, 240, 288, 352, 480
-#define TRSM_INTERVALSCOL_REAL                                          \
-    448, 768, 960, 1152, 1408, 1920, 2304, 2816, 3840, 4096, 4736,      \
-    4992, 5888, 7680, 9728
-#define TRSM_BLKSIZES_REAL                                              \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},    \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 24, 24, 24, 16},    \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1, 32, 32, 32, 32, 32, 24, 16},    \
-    {1,  1,  1,  1,  1,  1,  1, 48, 48, 48, 48, 32, 32, 32, 24, 16},    \
-    {1,  1,  1,  1,  1,  1, 64, 64, 64, 48, 48, 32, 32, 32, 24, 16},    \
-    {1,  1,  1,  1,  1, 80, 80, 80, 56, 56, 40, 40, 40, 32, 32, 32},    \
-    {1,  1,  1,  1, 80, 80, 80, 80, 80, 48, 48, 48, 40, 32,  0,  0},    \
-    {1,  1,  1, 80, 80, 80, 80, 80, 56, 56, 32, 32, 32, 32,  0,  0},    \
-    {1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
-    {1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
-    {1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},    \
-    {0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0}
-
-#define TRSM_NUMROWS_COMPLEX 10
-#define TRSM_NUMCOLS_COMPLEX 12
-#define TRSM_INTERVALSROW_COMPLEX                                       \
-    40, 56, 80, 112, 144, 208, 240, 288, 480
-#define TRSM_INTERVALSCOL_COMPLEX                                       \
-    704, 960, 1344, 1920, 2304, 2816, 3200, 3840, 4864, 5888, 7680
-#define TRSM_BLKSIZES_COMPLEX                                           \
-    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},                               \
-    {1, 1, 1, 1, 1, 1, 1, 1, 1, 24, 24, 24},                            \
-    {1, 1, 1, 1, 1, 1, 1, 1, 32, 32, 32, 32},                           \
-    {1, 1, 1, 1, 1, 72, 72, 56, 48, 32, 32, 32},                        \
-    {1, 1, 1, 1, 64, 64, 64, 64, 48, 32, 32, 32},                       \
-    {1, 1, 1, 80, 80, 80, 64, 64, 48, 32, 32, 32},                      \
-    {1, 1, 80, 80, 80, 80, 64, 64, 40, 40, 32, 32},                     \
-    {1, 1, 72, 72, 64, 64, 64, 64, 32, 32, 32, 0},                      \
-    {1, 80, 80, 80, 80, 80, 64, 64, 48, 40, 32, 0},                     \
-    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
-
-#define TRSM_BATCH_NUMROWS_REAL 11
-#define TRSM_BATCH_NUMCOLS_REAL 17
-#define TRSM_BATCH_INTERVALSROW_REAL                                        \
-    20, 28, 40, 80, 112, 176, 208, 288, 352, 480
-#define TRSM_BATCH_INTERVALSCOL_REAL                                        \
-    6, 10, 12, 22, 28, 30, 36, 42, 46, 50, 60, 96, 432, 928, 960, 1472
-#define TRSM_BATCH_BLKSIZES_REAL                                            \
-    { 1,  1,  1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
-    { 1,  1,  1,  1, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},   \
-    { 1,  1,  1,  1, 16, 16, 16, 16, 16,  0,  0,  0,  0,  0,  0,  0,  0},   \
-    { 1, 24, 24, 24, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},   \
-    {48, 48, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 16, 16, 16, 16, 16},   \
-    {64, 64, 32, 32, 24, 24, 16, 16, 16, 32, 32, 32, 24, 24, 24, 24, 24},   \
-    {64, 64, 32, 32, 24, 24, 24, 24, 32, 32, 32, 32, 32, 24, 24, 24, 24},   \
-    {64, 64, 64, 32, 32, 32, 32, 40, 40, 40, 40, 32, 32, 24, 24, 32, 32},   \
-    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32, 32},   \
-    {64, 64, 64, 32, 32, 32, 32, 40, 48, 48, 40, 32, 32, 32, 32, 32,  0},   \
-    {64, 64, 64, 32, 32, 32, 48, 48, 48, 48, 40, 32, 32, 32,  0,  0,  0}
-
-#define TRSM_BATCH_NUMROWS_COMPLEX 10
-#define TRSM_BATCH_NUMCOLS_COMPLEX 16
-#define TRSM_BATCH_INTERVALSROW_COMPLEX                                     \
-    20, 28, 40, 56, 80, 112, 144, 176, 480
-#define TRSM_BATCH_INTERVALSCOL_COMPLEX                                     \
-    4, 12, 16, 28, 32, 40, 48, 50, 60, 72, 88, 176, 232, 400, 464
-#define TRSM_BATCH_BLKSIZES_COMPLEX                                         \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  8,  1,  1,  1,  1,  1,  1,  1},        \
-    {1,  1,  1,  1, 16, 16, 16, 16,  1,  1,  1, 16, 16, 16, 16, 16},        \
-    {1,  1,  1, 24, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16},        \
-    {1,  1, 32, 32, 32, 32, 32, 32, 32, 32, 32, 16, 16, 16, 16, 16},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 48, 48, 32},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 32},        \
-    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 80, 80, 56, 56, 32, 32},        \
-    {1, 64, 32, 32, 32, 64, 48, 32, 32, 32, 32, 32, 32, 32, 32, 32},        \
-    {1,  1,  1,  1,  1,  1, 64, 64, 64, 64, 64, 64, 64, 48, 48, 48}
-// clang-format on
-
-static constexpr rocblas_int trsm_intervals_row_real_batch[] = {TRSM_BATCH_INTERVALSROW_REAL};
-static constexpr rocblas_int trsm_intervals_col_real_batch[] = {TRSM_BATCH_INTERVALSCOL_REAL};
-static constexpr rocblas_int trsm_blksizes_real_batch[][TRSM_BATCH_NUMCOLS_REAL]
-    = {TRSM_BATCH_BLKSIZES_REAL};
-static constexpr rocblas_int trsm_intervals_row_real_nonbatch[] = {TRSM_INTERVALSROW_REAL};
-static constexpr rocblas_int trsm_intervals_col_real_nonbatch[] = {TRSM_INTERVALSCOL_REAL};
-static constexpr rocblas_int trsm_blksizes_real_nonbatch[][TRSM_NUMCOLS_REAL]
-    = {TRSM_BLKSIZES_REAL};
-
-static constexpr rocblas_int trsm_intervals_row_complex_batch[] = {TRSM_BATCH_INTERVALSROW_COMPLEX};
-static constexpr rocblas_int trsm_intervals_col_complex_batch[] = {TRSM_BATCH_INTERVALSCOL_COMPLEX};
-static constexpr rocblas_int trsm_blksizes_complex_batch[][TRSM_BATCH_NUMCOLS_COMPLEX]
-    = {TRSM_BATCH_BLKSIZES_COMPLEX};
-static constexpr rocblas_int trsm_intervals_row_complex_nonbatch[] = {TRSM_INTERVALSROW_COMPLEX};
-static constexpr rocblas_int trsm_intervals_col_complex_nonbatch[] = {TRSM_INTERVALSCOL_COMPLEX};
-static constexpr rocblas_int trsm_blksizes_complex_nonbatch[][TRSM_NUMCOLS_COMPLEX]
-    = {TRSM_BLKSIZES_COMPLEX};
-
 template <typename T>
 static const T alpha_negative_one = T(-1);
 template <typename T>
@@ -1534,62 +1438,15 @@ inline bool rocblas_internal_trsm_use_substitution(rocblas_side side,
            && ((n <= 32 && batch_count >= 16 && m < 512) || (n > 32 && n <= 128 && m <= 340));
 }
 
-inline rocblas_int get_index(const rocblas_int* intervals, rocblas_int max, rocblas_int dim)
-{
-    rocblas_int i;
-
-    for(i = 0; i < max; ++i)
-    {
-        if(dim <= intervals[i])
-            break;
-    }
-
-    return i;
-}
-
 /** This function returns the block size for the internal blocked trsm implementation.
- *  The block sizes and logic is taken directly from rocSOLVER.
+ *  The block sizes are looked up in the tables of the current device, which are the
+ *  tables compiled into the library unless ROCBLAS_TRSM_BLOCK_TABLES replaces them.
  */
 template <bool BATCHED, typename T>
 rocblas_int rocblas_trsm_blksize(rocblas_int m, rocblas_int n)
 {
-    rocblas_int blk = 0;
-
-    if(BATCHED)
-    {
-        if constexpr(rocblas_is_complex<T>)
-        {
-            rocblas_int M = TRSM_BATCH_NUMROWS_COMPLEX - 1;
-            rocblas_int N = TRSM_BATCH_NUMCOLS_COMPLEX - 1;
-            blk = trsm_blksizes_complex_batch[get_index(trsm_intervals_row_complex_batch, M, m)]
-                                             [get_index(trsm_intervals_col_complex_batch, N, n)];
-        }
-        else
-        {
-            rocblas_int M = TRSM_BATCH_NUMROWS_REAL - 1;
-            rocblas_int N = TRSM_BATCH_NUMCOLS_REAL - 1;
-            blk           = trsm_blksizes_real_batch[get_index(trsm_intervals_row_real_batch, M, m)]
-                                          [get_index(trsm_intervals_col_real_batch, N, n)];
-        }
-    }
-    else
-    {
-        if constexpr(rocblas_is_complex<T>)
-        {
-            rocblas_int M = TRSM_NUMROWS_COMPLEX - 1;
-            rocblas_int N = TRSM_NUMCOLS_COMPLEX - 1;
-            blk           = trsm_blksizes_complex_nonbatch
-                [get_index(trsm_intervals_row_complex_nonbatch, M, m)]
-                [get_index(trsm_intervals_col_complex_nonbatch, N, n)];
-        }
-        else
-        {
-            rocblas_int M = TRSM_NUMROWS_REAL - 1;
-            rocblas_int N = TRSM_NUMCOLS_REAL - 1;
-            blk = trsm_blksizes_real_nonbatch[get_index(trsm_intervals_row_real_nonbatch, M, m)]
-                                             [get_index(trsm_intervals_col_real_nonbatch, N, n)];
-        }
-    }
+    rocblas_int blk
+        = rocblas_internal_trsm_block_tables().get(rocblas_is_complex<T>, BATCHED).lookup(m, n);
 
     if(blk == 1)
         blk = std::min(m, 512);
@@ -51,6 +51,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_trtri_name<T>);
+
         size_t size = rocblas_internal_trtri_temp_elements(n, 1) * sizeof(T);
         if(handle->is_device_memory_size_query())
         {
@@ -90,6 +92,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status trtri_check_numerics_status
                 = rocblas_trtri_check_numerics(rocblas_trtri_name<T>,
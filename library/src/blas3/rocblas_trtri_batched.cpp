@@ -53,6 +53,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function(rocblas_trtri_name<T>);
+
         // Compute the optimal size for temporary device memory
         size_t els   = rocblas_internal_trtri_temp_elements(n, 1);
         size_t size  = els * batch_count * sizeof(T);
@@ -113,6 +115,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status trtri_check_numerics_status
                 = rocblas_trtri_check_numerics(rocblas_trtri_name<T>,
@@ -58,6 +58,7 @@ rocblas_status rocblas_axpy_ex_typecasting(const char*    name,
         //Checking input batched vectors for numerical abnormalities
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status axpy_ex_check_numerics_status
                 = rocblas_axpy_check_numerics(name,
@@ -123,6 +124,7 @@ rocblas_status rocblas_axpy_ex_typecasting(const char*    name,
         //Checking input vectors for numerical abnormalities
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status axpy_ex_check_numerics_status
                 = rocblas_axpy_check_numerics(name,
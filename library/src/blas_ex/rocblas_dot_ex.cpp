@@ -49,6 +49,8 @@ namespace
             return rocblas_status_invalid_handle;
         }
 
+        handle->set_device_memory_query_function(name);
+
         size_t dev_bytes = rocblas_reduction_kernel_workspace_size<NB>(n, 1, execution_type);
         if(handle->is_device_memory_size_query())
         {
@@ -53,6 +53,7 @@ rocblas_status rocblas_dot_ex_typecasting(rocblas_handle __restrict__ handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status dot_ex_check_numerics_status
                 = rocblas_dot_check_numerics("rocblas_dot_batched_ex",
@@ -213,6 +213,7 @@ rocblas_status rocblas_geam_ex_typecasting(rocblas_handle            handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             auto check_numerics_string
                 = stride_A ? "rocblas_geam_strided_batched_ex" : "rocblas_geam_ex";
             bool           is_input = true;
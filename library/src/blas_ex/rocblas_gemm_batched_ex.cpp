@@ -63,6 +63,8 @@ try
     if(!handle)
         return rocblas_status_invalid_handle;
 
+    handle->set_device_memory_query_function("rocblas_gemm_batched_ex");
+
     const bool HPA = compute_type == rocblas_datatype_f32_r
                      && (a_type == rocblas_datatype_f16_r || a_type == rocblas_datatype_bf16_r);
 
@@ -348,6 +348,7 @@ rocblas_status gemm_ex_typecasting(rocblas_handle     handle,
         // over batches either way
         if(check_numerics && !std::is_same_v<Ti, signed char>)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status gemm_ex_check_numerics_status
                 = rocblas_gemm_check_numerics("rocblas_gemm_batched_ex",
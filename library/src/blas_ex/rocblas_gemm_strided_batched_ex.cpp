@@ -66,6 +66,8 @@ try
     if(!handle)
         return rocblas_status_invalid_handle;
 
+    handle->set_device_memory_query_function("rocblas_gemm_strided_batched_ex");
+
     const bool HPA = compute_type == rocblas_datatype_f32_r
                      && (a_type == rocblas_datatype_f16_r || a_type == rocblas_datatype_bf16_r);
 
@@ -442,3 +444,109 @@ extern "C" rocblas_status
         return exception_to_rocblas_status();
     }
 }
+
+extern "C" rocblas_status
+    rocblas_gemm_strided_batched_ex_get_coverage(rocblas_handle         handle,
+                                                 rocblas_operation      trans_a,
+                                                 rocblas_operation      trans_b,
+                                                 rocblas_int            m,
+                                                 rocblas_int            n,
+                                                 rocblas_int            k,
+                                                 const void*            alpha,
+                                                 const void*            a,
+                                                 rocblas_datatype       a_type,
+                                                 rocblas_int            lda,
+                                                 rocblas_stride         stride_a,
+                                                 const void*            b,
+                                                 rocblas_datatype       b_type,
+                                                 rocblas_int            ldb,
+                                                 rocblas_stride         stride_b,
+                                                 const void*            beta,
+                                                 const void*            c,
+                                                 rocblas_datatype       c_type,
+                                                 rocblas_int            ldc,
+                                                 rocblas_stride         stride_c,
+                                                 void*                  d,
+                                                 rocblas_datatype       d_type,
+                                                 rocblas_int            ldd,
+                                                 rocblas_stride         stride_d,
+                                                 rocblas_int            batch_count,
+                                                 rocblas_datatype       compute_type,
+                                                 uint32_t               flags,
+                                                 rocblas_gemm_coverage* coverage)
+{
+    try
+    {
+#ifdef BUILD_WITH_TENSILE
+        if(!handle)
+            return rocblas_status_invalid_handle;
+
+        RETURN_ZERO_DEVICE_MEMORY_SIZE_IF_QUERIED(handle);
+
+        if(m < 0 || n < 0 || k < 0 || batch_count < 0 || ldc < m || ldd < m
+           || lda < (trans_a == rocblas_operation_none ? m : k)
+           || ldb < (trans_b == rocblas_operation_none ? k : n))
+            return rocblas_status_invalid_size;
+
+        // Only the scalars are needed, as solution selection depends on alpha == 0 and beta == 0
+        if(!coverage || (k && !alpha) || !beta)
+            return rocblas_status_invalid_pointer;
+
+        // Quick return cases do not need a kernel
+        *coverage = rocblas_gemm_coverage_exact;
+
+        rocblas_union_t alpha_h, beta_h;
+        RETURN_IF_ROCBLAS_ERROR(rocblas_copy_alpha_beta_to_host_if_on_device(
+            handle, alpha, beta, alpha_h, beta_h, k, compute_type));
+        auto saved_pointer_mode = handle->push_pointer_mode(rocblas_pointer_mode_host);
+
+        rocblas_int    value = rocblas_gemm_coverage_none, size = 0;
+        rocblas_status status
+            = rocblas_gemm_ex_get_solutions_template<false>(handle,
+                                                            trans_a,
+                                                            trans_b,
+                                                            m,
+                                                            n,
+                                                            k,
+                                                            alpha,
+                                                            a,
+                                                            a_type,
+                                                            0,
+                                                            lda,
+                                                            stride_a,
+                                                            b,
+                                                            b_type,
+                                                            0,
+                                                            ldb,
+                                                            stride_b,
+                                                            beta,
+                                                            c,
+                                                            c_type,
+                                                            0,
+                                                            ldc,
+                                                            stride_c,
+                                                            d,
+                                                            d_type,
+                                                            0,
+                                                            ldd,
+                                                            stride_d,
+                                                            batch_count,
+                                                            compute_type,
+                                                            flags,
+                                                            COVERAGE,
+                                                            &value,
+                                                            &size);
+        if(size)
+            *coverage = rocblas_gemm_coverage(value);
+        else if(status != rocblas_status_success)
+            *coverage = rocblas_gemm_coverage_none;
+        return status;
+#else
+        return rocblas_status_excluded_from_build;
+#endif
+    }
+    catch(...)
+    {
+        return exception_to_rocblas_status();
+    }
+}
@@ -43,6 +43,8 @@ namespace
             return rocblas_status_invalid_handle;
         }
 
+        handle->set_device_memory_query_function("rocblas_nrm2_batched_ex");
+
         size_t dev_bytes
             = rocblas_reduction_kernel_workspace_size<NB>(n, batch_count, execution_type);
 
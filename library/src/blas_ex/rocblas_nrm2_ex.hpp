@@ -45,6 +45,7 @@ rocblas_status rocblas_nrm2_ex_typecasting(rocblas_handle handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status nrm2_ex_check_numerics_status
                 = rocblas_internal_check_numerics_vector_template("rocblas_nrm2_batched_ex",
@@ -95,6 +96,7 @@ rocblas_status rocblas_nrm2_ex_typecasting(rocblas_handle handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status nrm2_ex_check_numerics_status
                 = rocblas_internal_check_numerics_vector_template(
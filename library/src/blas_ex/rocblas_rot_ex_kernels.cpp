@@ -53,6 +53,7 @@ rocblas_status rocblas_rot_ex_typecasting(rocblas_handle handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status rot_ex_check_numerics_status
                 = rocblas_rot_check_numerics("rocblas_rot_batched_ex",
@@ -58,6 +58,7 @@ rocblas_status rocblas_scal_ex_typecasting(rocblas_handle handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status scal_ex_check_numerics_status
                 = rocblas_internal_check_numerics_vector_template("rocblas_scal_batched_ex",
@@ -102,6 +103,7 @@ rocblas_status rocblas_scal_ex_typecasting(rocblas_handle handle,
     {
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status scal_ex_check_numerics_status
                 = rocblas_internal_check_numerics_vector_template(
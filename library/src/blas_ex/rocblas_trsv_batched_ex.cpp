@@ -48,6 +48,8 @@ namespace
         if(!handle)
             return rocblas_status_invalid_handle;
 
+        handle->set_device_memory_query_function("rocblas_trsv_batched_ex");
+
         if(!handle->is_device_memory_size_query())
         {
             auto layer_mode = handle->layer_mode;
@@ -154,6 +156,7 @@ namespace
 
         if(check_numerics)
         {
+            handle->start_check_numerics_call();
             bool           is_input = true;
             rocblas_status trsv_check_numerics_status
                 = rocblas_internal_trsv_ex_check_numerics("rocblas_trsv_batched_ex",
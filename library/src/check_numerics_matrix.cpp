@@ -71,18 +71,6 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     if(!m || !n || !batch_count || !A)
         return rocblas_status_success;
 
-    //Creating structure host object
-    rocblas_check_numerics_t h_abnormal;
-
-    //Allocating memory for device structure
-    auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
-
-    //Transferring the rocblas_check_numerics_t structure from host to the device
-    RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                  &h_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyHostToDevice));
-
     //Checking trans_a to transpose a matrix 'A'
     rocblas_int num_rows_a = trans_a == rocblas_operation_none ? m : n;
     rocblas_int num_cols_a = trans_a == rocblas_operation_none ? n : m;
@@ -96,44 +84,100 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     dim3 blocks(blocks_X, blocks_Y, batch_count);
     dim3 threads(DIM_X, DIM_Y);
 
-    if(matrix_type == rocblas_client_general_matrix)
-    {
-        hipLaunchKernelGGL((rocblas_check_numerics_ge_matrix_kernel<DIM_X, DIM_Y>),
-                           blocks,
-                           threads,
-                           0,
-                           rocblas_stream,
-                           num_rows_a,
-                           num_cols_a,
-                           A,
-                           offset_a,
-                           lda,
-                           stride_a,
-                           (rocblas_check_numerics_t*)d_abnormal);
-    }
-    else if(matrix_type == rocblas_client_symmetric_matrix
-            || matrix_type == rocblas_client_hermitian_matrix
-            || matrix_type == rocblas_client_triangular_matrix)
+    //The range is only reduced by the kernels launched with RANGE, if a record is given
+    auto check = [&](rocblas_check_numerics_t* abnormal, rocblas_check_numerics_range_t* range) {
+        auto launch = [&](auto range_mode) {
+            constexpr bool RANGE = decltype(range_mode)::value;
+            if(matrix_type == rocblas_client_general_matrix)
+            {
+                hipLaunchKernelGGL((rocblas_check_numerics_ge_matrix_kernel<DIM_X, DIM_Y, RANGE>),
+                                   blocks,
+                                   threads,
+                                   0,
+                                   rocblas_stream,
+                                   num_rows_a,
+                                   num_cols_a,
+                                   A,
+                                   offset_a,
+                                   lda,
+                                   stride_a,
+                                   abnormal,
+                                   range);
+            }
+            else if(matrix_type == rocblas_client_symmetric_matrix
+                    || matrix_type == rocblas_client_hermitian_matrix
+                    || matrix_type == rocblas_client_triangular_matrix)
+            {
+                hipLaunchKernelGGL(
+                    (rocblas_check_numerics_sym_herm_tri_matrix_kernel<DIM_X, DIM_Y, RANGE>),
+                    blocks,
+                    threads,
+                    0,
+                    rocblas_stream,
+                    uplo == rocblas_fill_upper,
+                    n,
+                    A,
+                    offset_a,
+                    lda,
+                    stride_a,
+                    abnormal,
+                    range);
+            }
+        };
+        if(range)
+            launch(std::true_type{});
+        else
+            launch(std::false_type{});
+    };
+
+    //In deferred mode the kernel writes to a record of the handle, which is reported later
+    if(check_numerics & rocblas_check_numerics_mode_deferred)
     {
-        hipLaunchKernelGGL((rocblas_check_numerics_sym_herm_tri_matrix_kernel<DIM_X, DIM_Y>),
-                           blocks,
-                           threads,
-                           0,
-                           rocblas_stream,
-                           uplo == rocblas_fill_upper,
-                           n,
-                           A,
-                           offset_a,
-                           lda,
-                           stride_a,
-                           (rocblas_check_numerics_t*)d_abnormal);
+        rocblas_check_numerics_range_t* d_range_record = nullptr;
+        rocblas_check_numerics_t*       d_record
+            = handle->begin_deferred_check(
+                function_name, handle->check_numerics_call, is_input, &d_range_record);
+        if(d_record)
+        {
+            check(d_record, d_range_record);
+            handle->end_deferred_check();
+            return rocblas_status_success;
+        }
     }
 
+    //Creating structure host object
+    rocblas_check_numerics_t h_abnormal;
+
+    //Allocating memory for device structures; the range record is only allocated in range mode
+    bool range      = check_numerics & rocblas_check_numerics_mode_range;
+    auto d_mem      = handle->device_malloc(sizeof(rocblas_check_numerics_t),
+                                            range ? sizeof(rocblas_check_numerics_range_t) : 0);
+    auto d_abnormal = static_cast<rocblas_check_numerics_t*>(d_mem[0]);
+    auto d_range    = static_cast<rocblas_check_numerics_range_t*>(d_mem[1]);
+    if(!d_mem)
+        return rocblas_status_memory_error;
+
+    //Transferring the rocblas_check_numerics_t structure from host to the device
+    RETURN_IF_HIP_ERROR(hipMemcpy(
+        d_abnormal, &h_abnormal, sizeof(rocblas_check_numerics_t), hipMemcpyHostToDevice));
+
+    //A zeroed range record is empty
+    if(d_range)
+        RETURN_IF_HIP_ERROR(hipMemset(d_range, 0, sizeof(rocblas_check_numerics_range_t)));
+
+    check(d_abnormal, d_range);
+
     //Transferring the rocblas_check_numerics_t structure from device to the host
-    RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                  (rocblas_check_numerics_t*)d_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyDeviceToHost));
+    RETURN_IF_HIP_ERROR(hipMemcpy(
+        &h_abnormal, d_abnormal, sizeof(rocblas_check_numerics_t), hipMemcpyDeviceToHost));
+
+    if(d_range)
+    {
+        rocblas_check_numerics_range_t h_range;
+        RETURN_IF_HIP_ERROR(hipMemcpy(
+            &h_range, d_range, sizeof(rocblas_check_numerics_range_t), hipMemcpyDeviceToHost));
+        handle->report_check_numerics_range(function_name, is_input, h_range);
+    }
 
     return rocblas_check_numerics_abnormal_struct(
         function_name, check_numerics, is_input, &h_abnormal);
@@ -25,11 +25,12 @@
 
 /**
   *
-  * rocblas_check_numerics_vector_kernel(n, xa, offset_x, inc_x, stride_x, abnormal)
+  * rocblas_check_numerics_vector_kernel<DIM_X, RANGE>(n, xa, offset_x, inc_x, stride_x, abnormal, range)
   *
   * Info about rocblas_check_numerics_vector_kernel function:
   *
   *    It is the kernel function which checks a vector for numerical abnormalities such as NaN/zero/Inf/denormal values and updates the rocblas_check_numerics_t structure.
+  *    If RANGE is true, it also adds the dynamic range of the values to the rocblas_check_numerics_range_t record.
   *
   * Parameters   : n            : Total number of elements in the vector
   *                xa           : Pointer to the vector which is under consideration for numerical abnormalities
@@ -37,19 +38,21 @@
   *                inc_x        : Stride between consecutive values of vector 'xa'
   *                stride_x     : Specifies the pointer increment between one vector 'x_i' and the next one (xa_i+1) (where (xa_i) is the i-th instance of the batch)
   *                abnormal     : Device pointer to the rocblas_check_numerics_t structure
+  *                range        : Device pointer to the rocblas_check_numerics_range_t record, used if RANGE is true
   *
   * Return Value : Nothing --
   *
 **/
 
-template <int DIM_X, typename T>
+template <int DIM_X, bool RANGE, typename T>
 ROCBLAS_KERNEL(DIM_X)
-rocblas_check_numerics_vector_kernel(rocblas_int               n,
-                                     T                         xa,
-                                     rocblas_stride            offset_x,
-                                     int64_t                   inc_x,
-                                     rocblas_stride            stride_x,
-                                     rocblas_check_numerics_t* abnormal)
+rocblas_check_numerics_vector_kernel(rocblas_int                     n,
+                                     T                               xa,
+                                     rocblas_stride                  offset_x,
+                                     int64_t                         inc_x,
+                                     rocblas_stride                  stride_x,
+                                     rocblas_check_numerics_t*       abnormal,
+                                     rocblas_check_numerics_range_t* range)
 {
     auto*   x   = load_ptr_batch(xa, blockIdx.y, offset_x, stride_x);
     int64_t tid = blockIdx.x * blockDim.x + threadIdx.x;
@@ -67,6 +70,10 @@ rocblas_check_numerics_vector_kernel(rocblas_int               n,
         if(!abnormal->has_denorm && rocblas_isdenorm(value))
             abnormal->has_denorm = true;
     }
+
+    //Reduce the values checked by the block to their dynamic range
+    if constexpr(RANGE)
+        rocblas_check_numerics_add_range<DIM_X>(tid < n ? x + tid * inc_x : nullptr, range);
 }
 
 /**
@@ -171,40 +178,82 @@ ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
         return rocblas_status_success;
     }
 
+    hipStream_t           rocblas_stream = handle->get_stream();
+    constexpr rocblas_int NB             = 256;
+    dim3                  blocks((n - 1) / NB + 1, batch_count);
+    dim3                  threads(NB);
+
+    //The range is only reduced by the kernels launched with RANGE, if a record is given
+    auto check = [&](rocblas_check_numerics_t* abnormal, rocblas_check_numerics_range_t* range) {
+        auto launch = [&](auto range_mode) {
+            constexpr bool RANGE = decltype(range_mode)::value;
+            hipLaunchKernelGGL((rocblas_check_numerics_vector_kernel<NB, RANGE>),
+                               blocks,
+                               threads,
+                               0,
+                               rocblas_stream,
+                               n,
+                               x,
+                               offset_x,
+                               inc_x,
+                               stride_x,
+                               abnormal,
+                               range);
+        };
+        if(range)
+            launch(std::true_type{});
+        else
+            launch(std::false_type{});
+    };
+
+    //In deferred mode the kernel writes to a record of the handle, which is reported later
+    if(check_numerics & rocblas_check_numerics_mode_deferred)
+    {
+        rocblas_check_numerics_range_t* d_range_record = nullptr;
+        rocblas_check_numerics_t*       d_record
+            = handle->begin_deferred_check(
+                function_name, handle->check_numerics_call, is_input, &d_range_record);
+        if(d_record)
+        {
+            check(d_record, d_range_record);
+            handle->end_deferred_check();
+            return rocblas_status_success;
+        }
+    }
+
     //Creating structure host object
     rocblas_check_numerics_t h_abnormal;
 
-    //Allocating memory for device structure
-    auto d_abnormal = handle->device_malloc(sizeof(rocblas_check_numerics_t));
+    //Allocating memory for device structures; the range record is only allocated in range mode
+    bool range      = check_numerics & rocblas_check_numerics_mode_range;
+    auto d_mem      = handle->device_malloc(sizeof(rocblas_check_numerics_t),
+                                            range ? sizeof(rocblas_check_numerics_range_t) : 0);
+    auto d_abnormal = static_cast<rocblas_check_numerics_t*>(d_mem[0]);
+    auto d_range    = static_cast<rocblas_check_numerics_range_t*>(d_mem[1]);
+    if(!d_mem)
+        return rocblas_status_memory_error;
 
     //Transferring the rocblas_check_numerics_t structure from host to the device
-    RETURN_IF_HIP_ERROR(hipMemcpy((rocblas_check_numerics_t*)d_abnormal,
-                                  &h_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyHostToDevice));
+    RETURN_IF_HIP_ERROR(hipMemcpy(
+        d_abnormal, &h_abnormal, sizeof(rocblas_check_numerics_t), hipMemcpyHostToDevice));
 
-    hipStream_t           rocblas_stream = handle->get_stream();
-    constexpr rocblas_int NB             = 256;
-    dim3                  blocks((n - 1) / NB + 1, batch_count);
-    dim3                  threads(NB);
+    //A zeroed range record is empty
+    if(d_range)
+        RETURN_IF_HIP_ERROR(hipMemset(d_range, 0, sizeof(rocblas_check_numerics_range_t)));
 
-    hipLaunchKernelGGL((rocblas_check_numerics_vector_kernel<NB>),
-                       blocks,
-                       threads,
-                       0,
-                       rocblas_stream,
-                       n,
-                       x,
-                       offset_x,
-                       inc_x,
-                       stride_x,
-                       (rocblas_check_numerics_t*)d_abnormal);
+    check(d_abnormal, d_range);
 
     //Transferring the rocblas_check_numerics_t structure from device to the host
-    RETURN_IF_HIP_ERROR(hipMemcpy(&h_abnormal,
-                                  (rocblas_check_numerics_t*)d_abnormal,
-                                  sizeof(rocblas_check_numerics_t),
-                                  hipMemcpyDeviceToHost));
+    RETURN_IF_HIP_ERROR(hipMemcpy(
+        &h_abnormal, d_abnormal, sizeof(rocblas_check_numerics_t), hipMemcpyDeviceToHost));
+
+    if(d_range)
+    {
+        rocblas_check_numerics_range_t h_range;
+        RETURN_IF_HIP_ERROR(hipMemcpy(
+            &h_range, d_range, sizeof(rocblas_check_numerics_range_t), hipMemcpyDeviceToHost));
+        handle->report_check_numerics_range(function_name, is_input, h_range);
+    }
 
     return rocblas_check_numerics_abnormal_struct(
         function_name, check_numerics, is_input, &h_abnormal);
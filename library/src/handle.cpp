@@ -20,13 +20,21 @@
  *
  * ************************************************************************ */
 #include "handle.hpp"
+#include "binary_log.hpp"
+#include "chrome_trace.hpp"
+#include "sharded_profile.hpp"
+#include "trsm_block_tables.hpp"
+#include <algorithm>
 #include <cstdarg>
 #include <limits>
+#include <map>
+#include <mutex>
 #ifdef WIN32
 #include <windows.h>
 #endif
 
 #if BUILD_WITH_TENSILE
+#include "tensile_host.hpp"
 #else
 // see TensileHost.cpp for normal rocblas_initialize definition
 // it isn't compiled if not BUILD_WITH_TENSILE so defining here
@@ -36,6 +44,9 @@ extern "C" void rocblas_initialize() {}
 // forcing early cleanup
 extern "C" void rocblas_shutdown()
 {
+#if BUILD_WITH_TENSILE
+    rocblas_save_persistent_solution_caches();
+#endif
     rocblas_internal_ostream::clear_workers();
 }
 
@@ -98,8 +109,19 @@ _rocblas_handle::_rocblas_handle()
         stream_order_alloc             = stream_order_alloc_env_val ? true : false;
     }
 
+    // Solution cache capacity (0 disables the cache)
+    const char* solution_cache_env = read_env("ROCBLAS_SOLUTION_CACHE_SIZE");
+    if(solution_cache_env)
+        solution_cache.set_capacity(strtoul(solution_cache_env, nullptr, 0));
+
+    // Read the trsm block tables of the architecture now, rather than in the first trsm call
+    rocblas_internal_trsm_block_tables();
+
+    level2_variants = &rocblas_internal_level2_variants(rocblas_internal_get_arch_name());
+
     // Device memory size
-    const char* env = read_env("ROCBLAS_DEVICE_MEMORY_SIZE");
+    size_t      device_memory_size = 0;
+    const char* env                = read_env("ROCBLAS_DEVICE_MEMORY_SIZE");
     if(env)
         device_memory_size = strtoul(env, nullptr, 0);
 
@@ -127,8 +149,8 @@ _rocblas_handle::_rocblas_handle()
 
     if(!stream_order_alloc)
     { // Allocate device memory
-        if(device_memory_size)
-            THROW_IF_HIP_ERROR((hipMalloc)(&device_memory, device_memory_size));
+        if(device_memory_size && !device_memory.add_slab(device_memory_size))
+            THROW_IF_HIP_ERROR(device_memory.backend().last_error);
     }
     else
     {
@@ -138,11 +160,11 @@ _rocblas_handle::_rocblas_handle()
         // The following allocation & free of device memory using hipMallocAsync/hipFreeAsync will allocate memory from
         // the OS and release it to default memory pool. Further allocation of memory using hipMallocAsync
         // will be from the memory pool and it will be faster.
-        THROW_IF_HIP_ERROR((hipMallocAsync)(&device_memory, device_memory_size, stream));
+        void* pool_memory = nullptr;
 
-        THROW_IF_HIP_ERROR((hipFreeAsync)(device_memory, stream));
+        THROW_IF_HIP_ERROR((hipMallocAsync)(&pool_memory, device_memory_size, stream));
 
-        device_memory = nullptr;
+        THROW_IF_HIP_ERROR((hipFreeAsync)(pool_memory, stream));
 #else
         rocblas_cerr
             << "rocBLAS internal error: Stream order allocation is supported on ROCm 5.3 and above."
@@ -163,90 +185,480 @@ _rocblas_handle::_rocblas_handle()
  ******************************************************************************/
 _rocblas_handle::~_rocblas_handle()
 {
-    if(device_memory_in_use)
+    // Report the pending deferred numeric checks; their events return to the profile events
+    if(check_numerics_ring)
+    {
+        // cppcheck-suppress unreadVariable
+        auto saved_device_id = push_device_id();
+        collect_deferred_checks(true);
+        (hipFree)(check_numerics_device);
+        hipHostFree(check_numerics_host);
+        (hipFree)(check_numerics_range_device);
+        hipHostFree(check_numerics_range_host);
+    }
+
+    // Write the pending Chrome trace events, and close the JSON array if no other handle
+    // writes to the log
+    if(chrome_trace_log_open)
+    {
+        // cppcheck-suppress unreadVariable
+        auto saved_device_id = push_device_id();
+        end_chrome_trace_call();
+        collect_chrome_trace(true);
+        if(chrome_trace_origin)
+            profile_events.push_back(chrome_trace_origin);
+        close_chrome_trace_stream(*log_trace_os, chrome_trace_log);
+    }
+
+    // Add the latencies of profiled calls before their events are destroyed
+    if(!profile_timings.empty() || !profile_events.empty())
+    {
+        // cppcheck-suppress unreadVariable
+        auto saved_device_id = push_device_id();
+        end_profile_timing();
+        collect_profile_timings(true);
+        for(hipEvent_t event : profile_events)
+            hipEventDestroy(event);
+    }
+
+#if BUILD_WITH_TENSILE
+    // Persist the solution selections made since the last handle was destroyed
+    rocblas_save_persistent_solution_caches();
+#endif
+
+    if(device_memory.in_use())
     {
         rocblas_cerr
             << "rocBLAS internal error: Handle object destroyed while device memory still in use."
             << std::endl;
         rocblas_abort();
     }
-    // Free device memory unless it's user-owned
-    if(device_memory_owner != rocblas_device_memory_ownership::user_owned)
+
+    // Free device memory slabs; user-owned memory is not freed by the allocator
+    if(!device_memory.release())
+    {
+        rocblas_cerr << "rocBLAS error during freeing of allocated memory in handle destructor: "
+                     << rocblas_status_to_string(
+                            get_rocblas_status_for_hip_status(device_memory.backend().last_error))
+                     << std::endl;
+        rocblas_abort();
+    }
+
+// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
+// Support for default stream added in hip version 5.3.0
+#if HIP_VERSION >= 50300000
+    if(stream_order_alloc && device_memory_owner != rocblas_device_memory_ownership::user_owned)
+    {
+        hipMemPool_t mem_pool;
+        int          device;
+        hipGetDevice(&device);
+        hipDeviceGetDefaultMemPool(&mem_pool, device);
+
+        //Releases device memory back to OS
+        hipMemPoolTrimTo(mem_pool, 0);
+    }
+#endif
+}
+
+/*******************************************************************************
+ * GPU timing of profiled calls
+ ******************************************************************************/
+hipEvent_t _rocblas_handle::acquire_profile_event()
+{
+    hipEvent_t event = nullptr;
+    if(!profile_events.empty())
+    {
+        event = profile_events.back();
+        profile_events.pop_back();
+    }
+    else if(hipEventCreate(&event) != hipSuccess)
+        event = nullptr;
+    return event;
+}
+
+void _rocblas_handle::start_profile_timing(rocblas_latency_histogram* latency)
+{
+    // The previous call ends where this one starts
+    end_profile_timing();
+
+    // Events cannot be timed while a graph is captured, and calls are not
+    // timed if the GPU is too far behind
+    if(is_stream_in_capture_mode())
+        return;
+    if(profile_timings.size() >= MAX_PROFILE_TIMINGS)
+    {
+        collect_profile_timings(false);
+        if(profile_timings.size() >= MAX_PROFILE_TIMINGS)
+            return;
+    }
+
+    hipEvent_t start = acquire_profile_event();
+    if(start && hipEventRecord(start, stream) == hipSuccess)
+        profile_timings.push_back({start, nullptr, latency, stream});
+    else if(start)
+        profile_events.push_back(start);
+    collect_profile_timings(false);
+}
+
+void _rocblas_handle::end_profile_timing()
+{
+    if(profile_timings.empty() || profile_timings.back().stop)
+        return;
+
+    // The call is not timed if its stream is now captured into a graph
+    profile_timing&        timing  = profile_timings.back();
+    hipStreamCaptureStatus capture = hipStreamCaptureStatusNone;
+    hipEvent_t             stop    = acquire_profile_event();
+    if(stop && hipStreamIsCapturing(timing.stream, &capture) == hipSuccess
+       && capture != hipStreamCaptureStatusActive
+       && hipEventRecord(stop, timing.stream) == hipSuccess)
+        timing.stop = stop;
+    else
+    {
+        profile_events.push_back(timing.start);
+        if(stop)
+            profile_events.push_back(stop);
+        profile_timings.pop_back();
+    }
+}
+
+void _rocblas_handle::collect_profile_timings(bool wait)
+{
+    while(!profile_timings.empty() && profile_timings.front().stop)
+    {
+        profile_timing& timing = profile_timings.front();
+        hipError_t status = wait ? hipEventSynchronize(timing.stop) : hipEventQuery(timing.stop);
+        if(status == hipErrorNotReady)
+            break;
+
+        float ms;
+        if(status == hipSuccess && hipEventElapsedTime(&ms, timing.start, timing.stop) == hipSuccess)
+            timing.latency->add(ms * 1000.0);
+
+        profile_events.push_back(timing.start);
+        profile_events.push_back(timing.stop);
+        profile_timings.pop_front();
+    }
+}
+
+/*******************************************************************************
+ * Chrome trace events of logged calls
+ ******************************************************************************/
+static void write_chrome_trace_event(rocblas_internal_ostream&         os,
+                                     const rocblas_chrome_trace_event& event)
+{
+    std::string json;
+    event.write(json);
+    os << json << std::endl;
+}
+
+void _rocblas_handle::trace_chrome_call(rocblas_chrome_trace_event&& event)
+{
+    // The previous call ends where this one starts
+    end_chrome_trace_call();
+    if(chrome_trace_calls.size() >= MAX_PROFILE_TIMINGS)
+        collect_chrome_trace(false);
+
+    // Events cannot be timed while a graph is captured, or if the GPU is too far behind
+    hipEvent_t start = nullptr;
+    if(!is_stream_in_capture_mode() && chrome_trace_calls.size() < MAX_PROFILE_TIMINGS)
     {
-        hipError_t hipStatus;
-        if(!stream_order_alloc)
+        // The stream's clock is mapped onto the host clock when the first call is traced
+        if(!chrome_trace_origin)
         {
-            hipStatus = (hipFree)(device_memory);
-            if(hipStatus != hipSuccess)
+            hipEvent_t origin = acquire_profile_event();
+            if(origin && hipEventRecord(origin, stream) == hipSuccess
+               && hipEventSynchronize(origin) == hipSuccess)
             {
-                rocblas_cerr
-                    << "rocBLAS error during freeing of allocated memory in handle destructor: "
-                    << rocblas_status_to_string(get_rocblas_status_for_hip_status(hipStatus))
-                    << std::endl;
-                rocblas_abort();
-            };
+                chrome_trace_origin    = origin;
+                chrome_trace_origin_ts = rocblas_chrome_trace_event::now();
+            }
+            else if(origin)
+                profile_events.push_back(origin);
         }
-        else
+
+        if(chrome_trace_origin)
         {
-// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
-// Support for default stream added in hip version 5.3.0
-#if HIP_VERSION >= 50300000
-            hipStatus = (device_memory) ? (hipFreeAsync)(device_memory, stream) : hipSuccess;
-            if(hipStatus != hipSuccess)
+            start = acquire_profile_event();
+            if(start && hipEventRecord(start, stream) != hipSuccess)
             {
-                rocblas_cerr << "rocBLAS error during freeing of allocated memory in handle "
-                                "destructor (stream order allocation): "
-                             << rocblas_status_to_string(
-                                    get_rocblas_status_for_hip_status(hipStatus))
-                             << std::endl;
-                rocblas_abort();
-            };
+                profile_events.push_back(start);
+                start = nullptr;
+            }
+        }
+    }
 
-            hipMemPool_t mem_pool;
-            int          device;
-            hipGetDevice(&device);
-            hipDeviceGetDefaultMemPool(&mem_pool, device);
+    // A call which cannot be timed is written now, at its host entry time and with no duration
+    if(!start)
+    {
+        event.ts = rocblas_chrome_trace_event::now();
+        write_chrome_trace_event(*log_trace_os, event);
+        return;
+    }
 
-            //Releases device memory back to OS
-            hipMemPoolTrimTo(mem_pool, 0);
-#endif
-        }
+    chrome_trace_calls.push_back({std::move(event), start, nullptr, stream});
+    collect_chrome_trace(false);
+}
+
+void _rocblas_handle::end_chrome_trace_call()
+{
+    if(chrome_trace_calls.empty() || chrome_trace_calls.back().stop)
+        return;
+
+    // Without a stop event, such as when the call's stream is now captured into a graph, the
+    // call is written with no duration
+    chrome_trace_call&     call    = chrome_trace_calls.back();
+    hipStreamCaptureStatus capture = hipStreamCaptureStatusNone;
+    hipEvent_t             stop    = acquire_profile_event();
+    if(stop
+       && (hipStreamIsCapturing(call.stream, &capture) != hipSuccess
+           || capture == hipStreamCaptureStatusActive
+           || hipEventRecord(stop, call.stream) != hipSuccess))
+    {
+        profile_events.push_back(stop);
+        stop = nullptr;
+    }
+    call.stop = stop ? stop : call.start;
+}
+
+void _rocblas_handle::collect_chrome_trace(bool wait)
+{
+    while(!chrome_trace_calls.empty() && chrome_trace_calls.front().stop)
+    {
+        chrome_trace_call& call = chrome_trace_calls.front();
+        hipError_t status = wait ? hipEventSynchronize(call.stop) : hipEventQuery(call.stop);
+        if(status == hipErrorNotReady)
+            break;
+
+        float start_ms = 0, ms = 0;
+        hipEventElapsedTime(&start_ms, chrome_trace_origin, call.start);
+        if(call.stop != call.start)
+            hipEventElapsedTime(&ms, call.start, call.stop);
+        call.event.ts  = chrome_trace_origin_ts + start_ms * 1000.0;
+        call.event.dur = ms * 1000.0;
+        write_chrome_trace_event(*log_trace_os, call.event);
+
+        profile_events.push_back(call.start);
+        if(call.stop != call.start)
+            profile_events.push_back(call.stop);
+        chrome_trace_calls.pop_front();
     }
 }
 
 /*******************************************************************************
- * helper for allocating device memory
+ * Deferred numeric checks
  ******************************************************************************/
-#if ROCBLAS_REALLOC_ON_DEMAND
-bool _rocblas_handle::device_allocator(size_t size)
+rocblas_check_numerics_t*
+    _rocblas_handle::begin_deferred_check(const char*                      function_name,
+                                          uint64_t                         call_id,
+                                          bool                             is_input,
+                                          rocblas_check_numerics_range_t** range)
 {
-    bool success = size <= device_memory_size - device_memory_in_use;
-    if(!success && device_memory_owner == rocblas_device_memory_ownership::rocblas_managed)
+    *range = nullptr;
+
+    // Records cannot be collected from a captured graph, so its checks are not deferred
+    if(is_stream_in_capture_mode())
+        return nullptr;
+
+    if(!check_numerics_ring)
     {
-        if(device_memory_in_use)
+        size_t      capacity = rocblas_check_numerics_ring::DEFAULT_CAPACITY;
+        const char* env      = read_env("ROCBLAS_CHECK_NUMERICS_RING");
+        if(env && strtoul(env, nullptr, 0))
+            capacity = strtoul(env, nullptr, 0);
+
+        void*  device = nullptr;
+        void*  host   = nullptr;
+        size_t bytes  = capacity * sizeof(rocblas_check_numerics_t);
+        if((hipMalloc)(&device, bytes) != hipSuccess)
+            return nullptr;
+        if(hipHostMalloc(&host, bytes) != hipSuccess)
         {
-            rocblas_cerr << "rocBLAS internal error: Cannot reallocate device memory while it is "
-                            "already in use.";
-            rocblas_abort();
+            (hipFree)(device);
+            return nullptr;
         }
+        check_numerics_device = static_cast<rocblas_check_numerics_t*>(device);
+        check_numerics_host   = static_cast<rocblas_check_numerics_t*>(host);
+        check_numerics_ring   = std::make_unique<rocblas_check_numerics_ring>(capacity);
+    }
 
-        // Temporarily change the thread's default device ID to the handle's device ID
-        // cppcheck-suppress unreadVariable
-        auto saved_device_id = push_device_id();
+    // Without range records, range statistics are not reduced, but the checks are still deferred
+    if((check_numerics & rocblas_check_numerics_mode_range) && !check_numerics_range_device)
+    {
+        void*  device = nullptr;
+        void*  host   = nullptr;
+        size_t bytes  = check_numerics_ring->capacity() * sizeof(rocblas_check_numerics_range_t);
+        if((hipMalloc)(&device, bytes) == hipSuccess)
+        {
+            if(hipHostMalloc(&host, bytes) == hipSuccess)
+            {
+                check_numerics_range_device = static_cast<rocblas_check_numerics_range_t*>(device);
+                check_numerics_range_host   = static_cast<rocblas_check_numerics_range_t*>(host);
+            }
+            else
+                (hipFree)(device);
+        }
+    }
+
+    // The oldest slot is reused once its record has been reported
+    if(check_numerics_ring->full())
+    {
+        auto oldest = static_cast<hipEvent_t>(check_numerics_ring->front().event);
+        collect_deferred_checks(!oldest || hipEventSynchronize(oldest) != hipSuccess);
+    }
+
+    size_t slot   = check_numerics_ring->push(function_name, call_id, is_input, stream);
+    auto   record = check_numerics_device + slot;
+    if(hipMemsetAsync(record, 0, sizeof(*record), stream) != hipSuccess)
+    {
+        check_numerics_ring->pop_back();
+        return nullptr;
+    }
+
+    // A zeroed range record is empty
+    if((check_numerics & rocblas_check_numerics_mode_range) && check_numerics_range_device
+       && hipMemsetAsync(check_numerics_range_device + slot,
+                         0,
+                         sizeof(rocblas_check_numerics_range_t),
+                         stream)
+              == hipSuccess)
+    {
+        check_numerics_ring->back().has_range = true;
+        *range                                = check_numerics_range_device + slot;
+    }
+    return record;
+}
+
+void _rocblas_handle::end_deferred_check()
+{
+    auto& entry = check_numerics_ring->back();
+    PRINT_IF_HIP_ERROR(hipMemcpyAsync(check_numerics_host + entry.slot,
+                                      check_numerics_device + entry.slot,
+                                      sizeof(rocblas_check_numerics_t),
+                                      hipMemcpyDeviceToHost,
+                                      stream));
+    if(entry.has_range)
+        PRINT_IF_HIP_ERROR(hipMemcpyAsync(check_numerics_range_host + entry.slot,
+                                          check_numerics_range_device + entry.slot,
+                                          sizeof(rocblas_check_numerics_range_t),
+                                          hipMemcpyDeviceToHost,
+                                          stream));
+
+    // Without an event, the record is collected by synchronizing the stream of the check
+    hipEvent_t event = acquire_profile_event();
+    if(event && hipEventRecord(event, stream) != hipSuccess)
+    {
+        profile_events.push_back(event);
+        event = nullptr;
+    }
+    entry.event = event;
+
+    collect_deferred_checks(false);
+}
 
-        device_memory_size = 0;
-        if(!device_memory || (hipFree)(device_memory) == hipSuccess)
+void _rocblas_handle::collect_deferred_checks(bool wait)
+{
+    if(!check_numerics_ring)
+        return;
+
+    check_numerics_ring->collect([&](rocblas_check_numerics_ring::entry& entry) {
+        auto       event  = static_cast<hipEvent_t>(entry.event);
+        auto       check  = static_cast<hipStream_t>(entry.stream);
+        hipError_t status = !event ? (wait ? hipStreamSynchronize(check) : hipErrorNotReady)
+                            : wait ? hipEventSynchronize(event)
+                                   : hipEventQuery(event);
+        if(status == hipErrorNotReady)
+            return false;
+        if(event)
+            profile_events.push_back(event);
+
+        if(entry.has_range)
+            report_check_numerics_range(
+                entry.function_name, entry.is_input, check_numerics_range_host[entry.slot]);
+
+        const rocblas_check_numerics_t& flags = check_numerics_host[entry.slot];
+        bool is_abnormal = flags.has_NaN || flags.has_Inf || flags.has_denorm;
+        if(is_abnormal)
+            check_numerics_abnormal++;
+
+        if((check_numerics & rocblas_check_numerics_mode_info)
+           || ((check_numerics & rocblas_check_numerics_mode_warn) && is_abnormal))
         {
-            success = (hipMalloc)(&device_memory, size) == hipSuccess;
-            if(success)
-                device_memory_size = size;
+            if(check_numerics_callback)
+            {
+                rocblas_check_numerics_record record{entry.function_name,
+                                                     entry.call_id,
+                                                     entry.is_input,
+                                                     flags.has_NaN,
+                                                     flags.has_zero,
+                                                     flags.has_Inf,
+                                                     flags.has_denorm};
+                check_numerics_callback(&record, check_numerics_callback_data);
+            }
             else
-                device_memory = nullptr;
+                rocblas_cerr << rocblas_check_numerics_message(entry.function_name,
+                                                               entry.call_id,
+                                                               entry.is_input,
+                                                               flags.has_NaN,
+                                                               flags.has_zero,
+                                                               flags.has_Inf,
+                                                               flags.has_denorm)
+                             << std::endl;
         }
+        return true;
+    });
+}
+
+void _rocblas_handle::report_check_numerics_range(
+    const char* function_name, bool is_input, const rocblas_check_numerics_range_t& record)
+{
+    auto range = rocblas_check_numerics_range_summary(function_name, is_input, record);
+    check_numerics_ranges.add(range);
+    if(check_numerics & rocblas_check_numerics_mode_info)
+        rocblas_cerr << rocblas_check_numerics_range_message(range) << std::endl;
+}
+
+/*******************************************************************************
+ * backend for allocating device memory slabs
+ ******************************************************************************/
+bool _rocblas_handle::device_memory_backend::allocate(void** ptr, size_t size)
+{
+    // Temporarily change the thread's default device ID to the handle's device ID
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = handle->push_device_id();
+
+    if(!handle->stream_order_alloc)
+        last_error = (hipMalloc)(ptr, size);
+    else
+    {
+// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
+// Support for default stream added in hip version 5.3.0
+#if HIP_VERSION >= 50300000
+        last_error = (hipMallocAsync)(ptr, size, handle->stream);
+#else
+        last_error = hipErrorNotSupported;
+#endif
     }
-    return success;
+    return last_error == hipSuccess;
 }
+
+bool _rocblas_handle::device_memory_backend::deallocate(void* ptr)
+{
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = handle->push_device_id();
+
+    if(!handle->stream_order_alloc)
+        last_error = (hipFree)(ptr);
+    else
+    {
+#if HIP_VERSION >= 50300000
+        last_error = (hipFreeAsync)(ptr, handle->stream);
+#else
+        last_error = hipErrorNotSupported;
 #endif
+    }
+    return last_error == hipSuccess;
+}
 
 /*******************************************************************************
  * start device memory size queries
@@ -258,8 +670,10 @@ try
         return rocblas_status_invalid_handle;
     if(handle->device_memory_size_query)
         return rocblas_status_size_query_mismatch;
-    handle->device_memory_size_query = true;
-    handle->device_memory_query_size = 0;
+    handle->device_memory_size_query     = true;
+    handle->device_memory_query_size     = 0;
+    handle->device_memory_query_function = "unknown";
+    handle->device_memory_query_entries.clear();
     return rocblas_status_success;
 }
 catch(...)
@@ -288,6 +702,33 @@ catch(...)
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ * get the per-call breakdown of the last device memory size query
+ ******************************************************************************/
+extern "C" rocblas_status
+    rocblas_get_device_memory_query_breakdown(rocblas_handle                     handle,
+                                              size_t*                            count,
+                                              rocblas_device_memory_query_entry* entries)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(handle->device_memory_size_query)
+        return rocblas_status_size_query_mismatch;
+    if(!count)
+        return rocblas_status_invalid_pointer;
+
+    const auto& records = handle->device_memory_query_entries;
+    if(entries)
+        std::copy_n(records.begin(), std::min(*count, records.size()), entries);
+    *count = records.size();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  * Get the device memory size
  ******************************************************************************/
@@ -298,7 +739,30 @@ try
         return rocblas_status_invalid_handle;
     if(!size)
         return rocblas_status_invalid_pointer;
-    *size = handle->device_memory_size;
+    *size = handle->device_memory.capacity();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get device memory usage statistics
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_device_memory_stats(rocblas_handle handle,
+                                                          size_t*        high_water_mark,
+                                                          size_t*        slab_count)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!high_water_mark && !slab_count)
+        return rocblas_status_invalid_pointer;
+    if(high_water_mark)
+        *high_water_mark = handle->device_memory.high_water_mark();
+    if(slab_count)
+        *slab_count = handle->device_memory.slab_count();
     return rocblas_status_success;
 }
 catch(...)
@@ -315,26 +779,14 @@ static rocblas_status free_existing_device_memory(rocblas_handle handle)
     // Cannot change memory allocation when a device_malloc object is alive and
     // using device memory. This should never happen unless this function is
     // called from inside library code which borrows allocated device memory.
-    if(handle->device_memory_in_use)
+    if(handle->device_memory.in_use())
         return rocblas_status_internal_error;
 
-    // Free existing device memory in handle, unless owned by user
-    if(handle->device_memory
-       && handle->device_memory_owner != rocblas_device_memory_ownership::user_owned)
-    {
-        if(!handle->stream_order_alloc)
-            RETURN_IF_HIP_ERROR((hipFree)(handle->device_memory));
-// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
-// Support for default stream added in hip version 5.3.0
-#if HIP_VERSION >= 50300000
-        else
-            RETURN_IF_HIP_ERROR((hipFreeAsync)(handle->device_memory, handle->stream));
-#endif
-    }
+    // Free existing device memory slabs in handle, unless owned by user
+    if(!handle->device_memory.release())
+        return get_rocblas_status_for_hip_status(handle->device_memory.backend().last_error);
 
-    // Clear the memory size and address, and set the memory to be rocBLAS-managed
-    handle->device_memory_size  = 0;
-    handle->device_memory       = nullptr;
+    // Set the memory to be rocBLAS-managed
     handle->device_memory_owner = rocblas_device_memory_ownership::rocblas_managed;
 
     return rocblas_status_success;
@@ -365,27 +817,15 @@ try
     // Allocate size rounded up to MIN_CHUNK_SIZE
     size = roundup_device_memory_size(size);
 
-    hipError_t hipStatus;
-    if(!handle->stream_order_alloc)
-        hipStatus = (hipMalloc)(&handle->device_memory, size);
-// hipMallocAsync and hipFreeAsync are defined in hip version 5.2.0
-// Support for default stream added in hip version 5.3.0
-#if HIP_VERSION >= 50300000
-    else
-        hipStatus = (hipMallocAsync)(&handle->device_memory, size, handle->stream);
-#endif
-
-    if(hipStatus != hipSuccess)
+    if(!handle->device_memory.add_slab(size))
     {
-        // If allocation fails, nullify device memory address and return error
+        // If allocation fails, return error
         // Leave the memory under rocBLAS management for future calls
-        handle->device_memory = nullptr;
-        return get_rocblas_status_for_hip_status(hipStatus);
+        return get_rocblas_status_for_hip_status(handle->device_memory.backend().last_error);
     }
     else
     {
-        // If allocation succeeds, set size, mark it under user-management, and return success
-        handle->device_memory_size  = size;
+        // If allocation succeeds, mark it under user-management, and return success
         handle->device_memory_owner = rocblas_device_memory_ownership::user_managed;
         return rocblas_status_success;
     }
@@ -418,8 +858,7 @@ try
     if(size && addr)
     {
         handle->device_memory_owner = rocblas_device_memory_ownership::user_owned;
-        handle->device_memory_size  = size;
-        handle->device_memory       = addr;
+        handle->device_memory.adopt(addr, size);
     }
 
     return rocblas_status_success;
@@ -490,6 +929,9 @@ extern "C" rocblas_status
     va_start(ap, count);
     size_t total = va_total_device_memory_size(count, ap);
     va_end(ap);
+
+    // Attribute the size to the external library calling this function
+    handle->set_device_memory_query_function("rocblas_set_optimal_device_memory_size");
     return handle->set_optimal_device_memory_size(total);
 }
 
@@ -656,6 +1098,49 @@ static auto open_log_stream(const char* environment_variable_name)
                    : std::make_unique<rocblas_internal_ostream>(STDERR_FILENO);
 }
 
+/*******************************************************************************
+ * Open and close the trace log stream for Chrome trace events. Handles which
+ * write to the same log share it; the first handle opens the JSON array, and
+ * the last one closes it. Opening a log file truncates it, so the array is
+ * also opened each time a file is opened.
+ ******************************************************************************/
+static std::mutex& chrome_trace_logs_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::map<std::string, size_t>& chrome_trace_logs()
+{
+    static std::map<std::string, size_t> logs;
+    return logs;
+}
+
+static auto open_chrome_trace_stream(std::string& log)
+{
+    auto        os      = open_log_stream("ROCBLAS_LOG_TRACE_PATH");
+    const char* logfile = read_env("ROCBLAS_LOG_TRACE_PATH");
+    if(!logfile)
+        logfile = read_env("ROCBLAS_LOG_PATH");
+    log = logfile ? logfile : "";
+
+    std::lock_guard<std::mutex> lock(chrome_trace_logs_mutex());
+    if(!chrome_trace_logs()[log]++ || logfile)
+        *os << rocblas_chrome_trace_event::HEADER << std::endl;
+    return os;
+}
+
+static void close_chrome_trace_stream(rocblas_internal_ostream& os, const std::string& log)
+{
+    std::lock_guard<std::mutex> lock(chrome_trace_logs_mutex());
+    auto                        users = chrome_trace_logs().find(log);
+    if(users != chrome_trace_logs().end() && !--users->second)
+    {
+        chrome_trace_logs().erase(users);
+        os << rocblas_chrome_trace_event::footer() << std::endl;
+    }
+}
+
 /*******************************************************************************
  * Logging initialization
  ******************************************************************************/
@@ -667,17 +1152,85 @@ void _rocblas_handle::init_logging()
     {
         layer_mode = static_cast<rocblas_layer_mode>(strtol(str_layer_mode, 0, 0));
 
+        // Chrome trace logging writes trace logging as JSON events. It takes precedence over
+        // binary logging for trace logging, so binary logging then only applies to bench logging.
+        if(layer_mode & rocblas_layer_mode_log_chrome_trace)
+        {
+            layer_mode = rocblas_layer_mode(layer_mode | rocblas_layer_mode_log_trace);
+            if(layer_mode & rocblas_layer_mode_log_binary)
+            {
+                rocblas_cerr << "rocBLAS warning: ROCBLAS_LAYER combines Chrome trace and binary "
+                                "logging; trace logging is written as Chrome trace events"
+                             << std::endl;
+                if(!(layer_mode & rocblas_layer_mode_log_bench))
+                    layer_mode = rocblas_layer_mode(layer_mode & ~rocblas_layer_mode_log_binary);
+            }
+        }
+
+        // open binary log file, shared by all handles; fall back to text logging if it fails
+        if(layer_mode & rocblas_layer_mode_log_binary)
+        {
+            const char* logfile = read_env("ROCBLAS_LOG_BINARY_PATH");
+            if(!logfile || !rocblas_binary_logger::instance().open(logfile))
+            {
+                rocblas_cerr << "rocBLAS warning: ROCBLAS_LOG_BINARY_PATH "
+                             << (logfile ? "cannot be opened" : "is not set")
+                             << "; using text logging" << std::endl;
+                layer_mode = rocblas_layer_mode(layer_mode & ~rocblas_layer_mode_log_binary);
+            }
+        }
+        bool log_text = !(layer_mode & rocblas_layer_mode_log_binary);
+
         // open log_trace file
-        if(layer_mode & rocblas_layer_mode_log_trace)
+        if(layer_mode & rocblas_layer_mode_log_chrome_trace)
+        {
+            log_trace_os          = open_chrome_trace_stream(chrome_trace_log);
+            chrome_trace_log_open = true;
+        }
+        else if(log_text && (layer_mode & rocblas_layer_mode_log_trace))
             log_trace_os = open_log_stream("ROCBLAS_LOG_TRACE_PATH");
 
         // open log_bench file
-        if(layer_mode & rocblas_layer_mode_log_bench)
+        if(log_text && (layer_mode & rocblas_layer_mode_log_bench))
             log_bench_os = open_log_stream("ROCBLAS_LOG_BENCH_PATH");
 
-        // open log_profile file
+        // open log_profile file, and start periodic snapshots of the profile to
+        // rotating files if ROCBLAS_LOG_PROFILE_INTERVAL is set
         if(layer_mode & rocblas_layer_mode_log_profile)
+        {
             log_profile_os = open_log_stream("ROCBLAS_LOG_PROFILE_PATH");
+
+            // time calls on the GPU if ROCBLAS_LOG_PROFILE_LATENCY is nonzero
+            const char* latency = read_env("ROCBLAS_LOG_PROFILE_LATENCY");
+            profile_latency     = latency && strtol(latency, nullptr, 0);
+
+            const char* interval = read_env("ROCBLAS_LOG_PROFILE_INTERVAL");
+            if(interval)
+            {
+                const char* path   = read_env("ROCBLAS_LOG_PROFILE_PATH");
+                const char* rotate = read_env("ROCBLAS_LOG_PROFILE_ROTATE");
+                if(!rocblas_profile_snapshots::instance().start(
+                       path ? path : "",
+                       strtod(interval, nullptr),
+                       rotate ? strtoul(rotate, nullptr, 0) : 4))
+                    rocblas_cerr << "rocBLAS warning: ROCBLAS_LOG_PROFILE_INTERVAL requires "
+                                    "ROCBLAS_LOG_PROFILE_PATH and a positive interval"
+                                 << std::endl;
+            }
+        }
+
+        // sample trace and bench logging, 1 in ROCBLAS_LOG_SAMPLE_RATE calls and
+        // at most ROCBLAS_LOG_RATE_LIMIT records per second per function
+        if(layer_mode & (rocblas_layer_mode_log_trace | rocblas_layer_mode_log_bench))
+        {
+            const char* sample_rate = read_env("ROCBLAS_LOG_SAMPLE_RATE");
+            const char* rate_limit  = read_env("ROCBLAS_LOG_RATE_LIMIT");
+            auto        sampler     = std::make_unique<rocblas_log_sampler>(
+                sample_rate ? strtoull(sample_rate, nullptr, 0) : 0,
+                rate_limit ? std::max(strtod(rate_limit, nullptr), 0.0) : 0);
+            if(sampler->enabled())
+                log_sampler = std::move(sampler);
+        }
     }
 }
 
@@ -703,6 +1256,10 @@ extern "C" rocblas_status rocblas_set_performance_metric(rocblas_handle
     if(!handle)
         return rocblas_status_invalid_handle;
 
+    // Cached solutions were selected using the previous metric
+    if(handle->performance_metric != metric)
+        handle->solution_cache.clear();
+
     handle->performance_metric = metric;
     return rocblas_status_success;
 }
@@ -721,6 +1278,27 @@ extern "C" rocblas_status rocblas_get_performance_metric(rocblas_handle
         return rocblas_status_invalid_pointer;
 }
 
+/*******************************************************************************
+ * Query the solution cache statistics of a handle
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_solution_cache_stats(rocblas_handle handle,
+                                                           size_t*        hits,
+                                                           size_t*        misses,
+                                                           size_t*        entries)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!hits && !misses && !entries)
+        return rocblas_status_invalid_pointer;
+    handle->solution_cache.get_stats(hits, misses, entries);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 /*******************************************************************************
  * Numeric_check initialization
  ******************************************************************************/
@@ -734,3 +1312,92 @@ void _rocblas_handle::init_check_numerics()
             = static_cast<rocblas_check_numerics_mode>(strtol(str_check_numerics_mode, 0, 0));
     }
 }
+
+/*******************************************************************************
+ * Report the pending deferred numeric checks of a handle
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_check_numerics_flush(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = handle->push_device_id();
+    handle->collect_deferred_checks(true);
+
+    size_t abnormal                 = handle->check_numerics_abnormal;
+    handle->check_numerics_abnormal = 0;
+    if(abnormal && (handle->check_numerics & rocblas_check_numerics_mode_fail))
+        return rocblas_status_check_numerics_fail;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the function which receives the records of deferred numeric checks
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_check_numerics_callback(
+    rocblas_handle handle, rocblas_check_numerics_callback callback, void* user_data)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    handle->check_numerics_callback      = callback;
+    handle->check_numerics_callback_data = user_data;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Get the dynamic ranges of the checked inputs and outputs of a handle
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_check_numerics_ranges(rocblas_handle                handle,
+                                                            rocblas_check_numerics_range* ranges,
+                                                            size_t*                       count)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(!count)
+        return rocblas_status_invalid_pointer;
+
+    // Ranges of deferred checks are added as their records are reported
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = handle->push_device_id();
+    handle->collect_deferred_checks(true);
+
+    handle->check_numerics_ranges.get(ranges, count);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Clear the dynamic ranges of the checked inputs and outputs of a handle
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_reset_check_numerics_ranges(rocblas_handle handle)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+
+    // cppcheck-suppress unreadVariable
+    auto saved_device_id = handle->push_device_id();
+    handle->collect_deferred_checks(true);
+
+    handle->check_numerics_ranges.clear();
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
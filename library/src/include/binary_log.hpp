@@ -0,0 +1,769 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Binary logging writes each log_trace or log_bench call as a fixed-size    *
+ * record, instead of formatting its arguments as text. Each thread writes   *
+ * records to its own lock-free ring buffer, which a background thread       *
+ * drains to the log file. Records are rendered in the text formats of       *
+ * log_trace and log_bench by rocblas_binary_log_decode(), which is used by  *
+ * the offline decoder tool rocblas-log-decode.                              *
+ *                                                                           *
+ * Function names and other static strings are written to the log once, as   *
+ * symbol records, and arguments refer to them by a numeric id. Scalars are  *
+ * stored as the raw bits of their type, and are only formatted when the log *
+ * is decoded.                                                               *
+ *                                                                           *
+ * If a ring buffer is full, records are dropped rather than blocking the    *
+ * caller, and the number of dropped records is written to the log.         *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Kinds of records
+enum rocblas_binary_log_kind : uint16_t
+{
+    rocblas_binary_log_kind_trace   = 1, // A log_trace call
+    rocblas_binary_log_kind_bench   = 2, // A log_bench call
+    rocblas_binary_log_kind_dropped = 3, // Count of records dropped because a ring was full
+    rocblas_binary_log_kind_symbol  = 4, // Id of a symbol as a uint, then its string
+};
+
+// Tags of encoded arguments, each followed by its payload
+enum rocblas_binary_log_tag : uint8_t
+{
+    rocblas_binary_log_tag_string = 1,   // uint8_t length, then characters
+    rocblas_binary_log_tag_char,         // char
+    rocblas_binary_log_tag_int,          // int64_t
+    rocblas_binary_log_tag_uint,         // uint64_t
+    rocblas_binary_log_tag_real,         // double
+    rocblas_binary_log_tag_pointer,      // uint64_t address
+    rocblas_binary_log_tag_complex,      // double real part, double imaginary part
+    rocblas_binary_log_tag_symbol,       // uint32_t id of a symbol
+    rocblas_binary_log_tag_scalar,       // rocblas_binary_log_scalar, then the bits of the value
+    rocblas_binary_log_tag_bench_scalar, // uint32_t id of the name, then as a scalar
+};
+
+// Types of scalars, which are rendered as by LOG_TRACE_SCALAR_VALUE and LOG_BENCH_SCALAR_VALUE
+enum rocblas_binary_log_scalar : uint8_t
+{
+    rocblas_binary_log_scalar_half = 1,
+    rocblas_binary_log_scalar_bfloat16,
+    rocblas_binary_log_scalar_float,
+    rocblas_binary_log_scalar_double,
+    rocblas_binary_log_scalar_float_complex,
+    rocblas_binary_log_scalar_double_complex,
+    rocblas_binary_log_scalar_null = 0x80, // Flag of a null pointer, whose value is not stored
+};
+
+// Bytes of the value of a scalar type, or 0 if the type is unknown
+inline size_t rocblas_binary_log_scalar_size(uint8_t type)
+{
+    switch(type)
+    {
+    case rocblas_binary_log_scalar_half:
+    case rocblas_binary_log_scalar_bfloat16:
+        return 2;
+    case rocblas_binary_log_scalar_float:
+        return 4;
+    case rocblas_binary_log_scalar_double:
+    case rocblas_binary_log_scalar_float_complex:
+        return 8;
+    case rocblas_binary_log_scalar_double_complex:
+        return 16;
+    }
+    return 0;
+}
+
+// Names of the symbols of a log, by id
+using rocblas_binary_log_symbols = std::unordered_map<uint32_t, std::string>;
+
+/*****************************************************************************
+ * A record holds a timestamp, the thread, and a sequence of tagged          *
+ * arguments. Arguments which do not fit are omitted, and the record is      *
+ * marked as truncated.                                                      *
+ *****************************************************************************/
+struct rocblas_binary_log_record
+{
+    static constexpr size_t SIZE = 512;
+
+    uint64_t timestamp; // Nanoseconds since the epoch of the system clock
+    uint64_t thread_id;
+    uint16_t kind;
+    uint16_t size; // Bytes of data used
+    uint16_t nargs;
+    uint16_t truncated;
+    uint8_t  data[SIZE - 24];
+
+    void begin(uint16_t record_kind, uint64_t thread)
+    {
+        timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+        thread_id = thread;
+        kind      = record_kind;
+        size      = 0;
+        nargs     = 0;
+        truncated = 0;
+    }
+
+    void put_string(const char* s, size_t len)
+    {
+        len = std::min<size_t>(len, UINT8_MAX);
+        if(reserve(rocblas_binary_log_tag_string, 1 + len))
+        {
+            data[size++] = uint8_t(len);
+            memcpy(data + size, s, len);
+            size += len;
+        }
+    }
+
+    void put_string(const char* s)
+    {
+        put_string(s ? s : "", s ? strlen(s) : 0);
+    }
+
+    void put_char(char c)
+    {
+        put(rocblas_binary_log_tag_char, c);
+    }
+
+    void put_int(int64_t x)
+    {
+        put(rocblas_binary_log_tag_int, x);
+    }
+
+    void put_uint(uint64_t x)
+    {
+        put(rocblas_binary_log_tag_uint, x);
+    }
+
+    void put_real(double x)
+    {
+        put(rocblas_binary_log_tag_real, x);
+    }
+
+    void put_pointer(const void* p)
+    {
+        put(rocblas_binary_log_tag_pointer, uint64_t(reinterpret_cast<uintptr_t>(p)));
+    }
+
+    void put_complex(double re, double im)
+    {
+        if(reserve(rocblas_binary_log_tag_complex, 2 * sizeof(double)))
+        {
+            memcpy(data + size, &re, sizeof(re));
+            memcpy(data + size + sizeof(re), &im, sizeof(im));
+            size += 2 * sizeof(double);
+        }
+    }
+
+    void put_symbol(uint32_t id)
+    {
+        put(rocblas_binary_log_tag_symbol, id);
+    }
+
+    // The value of a scalar of a type, or a null pointer if value is nullptr
+    void put_scalar(uint8_t type, const void* value)
+    {
+        size_t bytes = value ? rocblas_binary_log_scalar_size(type) : 0;
+        if(reserve(rocblas_binary_log_tag_scalar, 1 + bytes))
+            put_scalar_value(type, value, bytes);
+    }
+
+    // A scalar of rocblas-bench, named by the symbol name_id
+    void put_bench_scalar(uint32_t name_id, uint8_t type, const void* value)
+    {
+        size_t bytes = value ? rocblas_binary_log_scalar_size(type) : 0;
+        if(reserve(rocblas_binary_log_tag_bench_scalar, sizeof(name_id) + 1 + bytes))
+        {
+            memcpy(data + size, &name_id, sizeof(name_id));
+            size += sizeof(name_id);
+            put_scalar_value(type, value, bytes);
+        }
+    }
+
+    // Get the id and string of a symbol record
+    bool get_symbol(uint32_t& id, std::string& name) const
+    {
+        if(kind != rocblas_binary_log_kind_symbol || nargs != 2
+           || data[0] != rocblas_binary_log_tag_uint
+           || data[1 + sizeof(uint64_t)] != rocblas_binary_log_tag_string)
+            return false;
+        size_t pos = 1;
+        id         = uint32_t(get<uint64_t>(pos));
+        size_t len = data[++pos];
+        name.assign(reinterpret_cast<const char*>(data + pos + 1), len);
+        return true;
+    }
+
+    // Render the record in the text format of log_trace or log_bench,
+    // without the terminating newline
+    std::string render(const rocblas_binary_log_symbols& symbols = {}) const
+    {
+        std::ostringstream os;
+        const char*        sep = kind == rocblas_binary_log_kind_trace ? "," : " ";
+        size_t             pos = 0;
+        for(uint16_t i = 0; i < nargs && pos < size; ++i)
+        {
+            if(i)
+                os << sep;
+            switch(data[pos++])
+            {
+            case rocblas_binary_log_tag_string:
+            {
+                size_t len = data[pos++];
+                os.write(reinterpret_cast<const char*>(data + pos), len);
+                pos += len;
+                break;
+            }
+            case rocblas_binary_log_tag_char:
+                os << char(data[pos++]);
+                break;
+            case rocblas_binary_log_tag_int:
+                os << get<int64_t>(pos);
+                break;
+            case rocblas_binary_log_tag_uint:
+                os << get<uint64_t>(pos);
+                break;
+            case rocblas_binary_log_tag_real:
+                os << get<double>(pos);
+                break;
+            case rocblas_binary_log_tag_pointer:
+                os << reinterpret_cast<const void*>(uintptr_t(get<uint64_t>(pos)));
+                break;
+            case rocblas_binary_log_tag_complex:
+            {
+                double re = get<double>(pos);
+                double im = get<double>(pos);
+                os << '(' << re << ',' << im << ')';
+                break;
+            }
+            case rocblas_binary_log_tag_symbol:
+                os << symbol(symbols, get<uint32_t>(pos));
+                break;
+            case rocblas_binary_log_tag_scalar:
+            {
+                // As log_trace_scalar_value, where a null pointer is NaN
+                double re, im;
+                bool   complex;
+                if(!get_scalar(pos, re, im, complex))
+                    return os.str();
+                if(complex)
+                    os << '(' << re << ',' << im << ')';
+                else
+                    os << re;
+                break;
+            }
+            case rocblas_binary_log_tag_bench_scalar:
+            {
+                // As log_bench_scalar_value, where the imaginary part is only
+                // given if it is nonzero
+                std::string name = symbol(symbols, get<uint32_t>(pos));
+                double      re, im;
+                bool        complex;
+                if(!get_scalar(pos, re, im, complex))
+                    return os.str();
+                os << "--" << name << ' ' << re;
+                if(complex && im == im && im)
+                    os << " --" << name << "i " << im;
+                break;
+            }
+            default:
+                return os.str();
+            }
+        }
+        return os.str();
+    }
+
+private:
+    // Reserve room for a tag and its payload, returning false if it does not fit
+    bool reserve(uint8_t tag, size_t payload)
+    {
+        if(truncated || size + 1 + payload > sizeof(data))
+        {
+            truncated = 1;
+            return false;
+        }
+        data[size++] = tag;
+        ++nargs;
+        return true;
+    }
+
+    template <typename T>
+    void put(uint8_t tag, T x)
+    {
+        if(reserve(tag, sizeof(x)))
+        {
+            memcpy(data + size, &x, sizeof(x));
+            size += sizeof(x);
+        }
+    }
+
+    template <typename T>
+    T get(size_t& pos) const
+    {
+        T x;
+        memcpy(&x, data + pos, sizeof(x));
+        pos += sizeof(x);
+        return x;
+    }
+
+    // The string of a symbol, or a placeholder if it is not defined in the log
+    static std::string symbol(const rocblas_binary_log_symbols& symbols, uint32_t id)
+    {
+        auto it = symbols.find(id);
+        return it != symbols.end() ? it->second : "<symbol " + std::to_string(id) + ">";
+    }
+
+    void put_scalar_value(uint8_t type, const void* value, size_t bytes)
+    {
+        data[size++] = value ? type : type | rocblas_binary_log_scalar_null;
+        memcpy(data + size, value, bytes);
+        size += bytes;
+    }
+
+    // IEEE half precision bits as a float
+    static float half_to_float(uint16_t h)
+    {
+        int   exponent = (h >> 10) & 0x1f;
+        int   mantissa = h & 0x3ff;
+        float x        = exponent == 0    ? std::ldexp(float(mantissa), -24)
+                         : exponent == 31 ? (mantissa ? std::numeric_limits<float>::quiet_NaN()
+                                                      : std::numeric_limits<float>::infinity())
+                                          : std::ldexp(float(mantissa | 0x400), exponent - 25);
+        return h & 0x8000 ? -x : x;
+    }
+
+    // bfloat16 bits as a float
+    static float bfloat16_to_float(uint16_t b)
+    {
+        uint32_t bits = uint32_t(b) << 16;
+        float    x;
+        memcpy(&x, &bits, sizeof(x));
+        return x;
+    }
+
+    // Get a scalar, returning false if its type is unknown. A null pointer is NaN.
+    bool get_scalar(size_t& pos, double& re, double& im, bool& complex) const
+    {
+        uint8_t type = data[pos++];
+        uint8_t base = type & ~rocblas_binary_log_scalar_null;
+        complex      = base == rocblas_binary_log_scalar_float_complex
+                  || base == rocblas_binary_log_scalar_double_complex;
+        re = im = std::numeric_limits<double>::quiet_NaN();
+        if(!rocblas_binary_log_scalar_size(base))
+            return false;
+        if(type & rocblas_binary_log_scalar_null)
+            return true;
+
+        switch(base)
+        {
+        case rocblas_binary_log_scalar_half:
+            re = half_to_float(get<uint16_t>(pos));
+            break;
+        case rocblas_binary_log_scalar_bfloat16:
+            re = bfloat16_to_float(get<uint16_t>(pos));
+            break;
+        case rocblas_binary_log_scalar_float:
+            re = get<float>(pos);
+            break;
+        case rocblas_binary_log_scalar_double:
+            re = get<double>(pos);
+            break;
+        case rocblas_binary_log_scalar_float_complex:
+            re = get<float>(pos);
+            im = get<float>(pos);
+            break;
+        case rocblas_binary_log_scalar_double_complex:
+            re = get<double>(pos);
+            im = get<double>(pos);
+            break;
+        }
+        return true;
+    }
+};
+
+static_assert(sizeof(rocblas_binary_log_record) == rocblas_binary_log_record::SIZE,
+              "rocblas_binary_log_record must not contain padding");
+
+// Header at the start of a binary log file
+struct rocblas_binary_log_header
+{
+    static constexpr char     MAGIC[8] = "RBBLOG1";
+    static constexpr uint32_t VERSION  = 2;
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+/*****************************************************************************
+ * Single-producer, single-consumer ring of records. The producer is the     *
+ * thread which owns the ring, and the consumer is the drain thread.         *
+ *****************************************************************************/
+class rocblas_binary_log_ring
+{
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    explicit rocblas_binary_log_ring(uint64_t thread_id)
+        : m_records(new rocblas_binary_log_record[CAPACITY])
+        , m_thread_id(thread_id)
+    {
+    }
+
+    // Return a record to fill, or nullptr if the ring is full
+    rocblas_binary_log_record* reserve()
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if(head - m_tail.load(std::memory_order_acquire) >= CAPACITY)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &m_records[head % CAPACITY];
+    }
+
+    // Publish the record returned by reserve()
+    void commit()
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consume all published records with func(record), returning how many were consumed
+    template <typename FUNC>
+    size_t drain(FUNC&& func)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        for(size_t i = tail; i != head; ++i)
+            func(m_records[i % CAPACITY]);
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+    }
+
+    // Return and reset the number of dropped records
+    size_t take_dropped()
+    {
+        return m_dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+    uint64_t thread_id() const
+    {
+        return m_thread_id;
+    }
+
+private:
+    std::unique_ptr<rocblas_binary_log_record[]> m_records;
+    uint64_t                                     m_thread_id;
+    std::atomic<size_t>                          m_head{0};
+    std::atomic<size_t>                          m_tail{0};
+    std::atomic<size_t>                          m_dropped{0};
+};
+
+/*****************************************************************************
+ * rocblas_binary_logger owns the log file and the drain thread. Producers  *
+ * only take a lock the first time each thread logs, to register its ring.   *
+ *****************************************************************************/
+class rocblas_binary_logger
+{
+public:
+    // Drain interval of the background thread
+    static constexpr std::chrono::milliseconds DRAIN_INTERVAL{10};
+
+    // Implemented as singleton to avoid the static initialization order fiasco
+    static rocblas_binary_logger& instance()
+    {
+        static rocblas_binary_logger logger;
+        return logger;
+    }
+
+    rocblas_binary_logger(const rocblas_binary_logger&) = delete;
+    rocblas_binary_logger& operator=(const rocblas_binary_logger&) = delete;
+
+    ~rocblas_binary_logger()
+    {
+        close();
+    }
+
+    // Open the log file and start the drain thread. Returns true if the log
+    // is open, including if it was already open.
+    bool open(const char* path)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_file)
+            return true;
+
+        m_file = fopen(path, "wb");
+        if(!m_file)
+            return false;
+
+        m_symbol_ids.clear();
+        m_new_symbols.clear();
+        m_generation.fetch_add(1, std::memory_order_release);
+
+        rocblas_binary_log_header header{};
+        memcpy(header.magic, rocblas_binary_log_header::MAGIC, sizeof(header.magic));
+        header.version     = rocblas_binary_log_header::VERSION;
+        header.record_size = rocblas_binary_log_record::SIZE;
+        fwrite(&header, sizeof(header), 1, m_file);
+
+        m_stop   = false;
+        m_thread = std::thread([this] { thread_function(); });
+        m_open.store(true, std::memory_order_release);
+        return true;
+    }
+
+    bool is_open() const
+    {
+        return m_open.load(std::memory_order_acquire);
+    }
+
+    // Stop the drain thread, write the remaining records, and close the file
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_file || m_stop)
+                return;
+            m_open.store(false, std::memory_order_release);
+            m_stop = true;
+        }
+        m_cond.notify_one();
+        m_thread.join();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        drain();
+        fclose(m_file);
+        m_file = nullptr;
+    }
+
+    // Log a record of a kind, whose arguments are added by fill(record)
+    template <typename FILL>
+    void log(uint16_t kind, FILL&& fill)
+    {
+        if(!is_open())
+            return;
+        rocblas_binary_log_ring& ring   = local_ring();
+        rocblas_binary_log_record* record = ring.reserve();
+        if(record)
+        {
+            record->begin(kind, ring.thread_id());
+            fill(*record);
+            ring.commit();
+        }
+    }
+
+    // Return the id of a string, such as a function name, which is written to the
+    // log as a symbol record the first time it is seen. Strings are identified by
+    // their address, so s must be a string literal or otherwise never change.
+    uint32_t intern(const char* s)
+    {
+        // Ids seen by this thread, valid while the log has not been reopened
+        thread_local uint64_t                                 t_generation = 0;
+        thread_local std::unordered_map<const char*, uint32_t> t_ids;
+
+        if(t_generation == m_generation.load(std::memory_order_acquire))
+        {
+            auto it = t_ids.find(s);
+            if(it != t_ids.end())
+                return it->second;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t                    generation = m_generation.load(std::memory_order_relaxed);
+        if(t_generation != generation)
+        {
+            t_ids.clear();
+            t_generation = generation;
+        }
+        auto ins = m_symbol_ids.emplace(s, uint32_t(m_symbol_ids.size()));
+        if(ins.second)
+            m_new_symbols.emplace_back(ins.first->second, s);
+        return t_ids[s] = ins.first->second;
+    }
+
+private:
+    rocblas_binary_logger() = default;
+
+    std::mutex                                            m_mutex; // Guards members below
+    std::vector<std::shared_ptr<rocblas_binary_log_ring>> m_rings;
+    FILE*                                                 m_file = nullptr;
+    std::thread                                           m_thread;
+    std::condition_variable                               m_cond;
+    bool                                                  m_stop = false;
+    std::atomic<bool>                                     m_open{false};
+    std::unordered_map<const char*, uint32_t>             m_symbol_ids;
+    std::vector<std::pair<uint32_t, std::string>>         m_new_symbols; // Not yet written
+    std::atomic<uint64_t>                                 m_generation{0}; // Times opened
+
+    // The ring of the calling thread, registered on first use. The ring is kept
+    // alive by the logger after the thread exits, until it has been drained.
+    rocblas_binary_log_ring& local_ring()
+    {
+        thread_local std::shared_ptr<rocblas_binary_log_ring> t_ring = [this] {
+            auto ring = std::make_shared<rocblas_binary_log_ring>(
+                std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_rings.push_back(ring);
+            return ring;
+        }();
+        return *t_ring;
+    }
+
+    // Write all published records to the file. m_mutex must be held.
+    void drain()
+    {
+        // Symbols are written before the records which may refer to them
+        for(auto& new_symbol : m_new_symbols)
+        {
+            rocblas_binary_log_record record;
+            record.begin(rocblas_binary_log_kind_symbol, 0);
+            record.put_uint(new_symbol.first);
+            record.put_string(new_symbol.second.c_str());
+            fwrite(&record, sizeof(record), 1, m_file);
+        }
+        m_new_symbols.clear();
+
+        for(auto& ring : m_rings)
+        {
+            ring->drain([this](const rocblas_binary_log_record& record) {
+                fwrite(&record, sizeof(record), 1, m_file);
+            });
+
+            if(size_t dropped = ring->take_dropped())
+            {
+                rocblas_binary_log_record record;
+                record.begin(rocblas_binary_log_kind_dropped, ring->thread_id());
+                record.put_uint(dropped);
+                fwrite(&record, sizeof(record), 1, m_file);
+            }
+        }
+
+        // Forget rings of threads which have exited, once they are empty
+        m_rings.erase(std::remove_if(m_rings.begin(),
+                                     m_rings.end(),
+                                     [](auto& ring) {
+                                         return ring.use_count() == 1 && ring->empty();
+                                     }),
+                      m_rings.end());
+        fflush(m_file);
+    }
+
+    void thread_function()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(!m_stop)
+        {
+            m_cond.wait_for(lock, DRAIN_INTERVAL);
+            drain();
+        }
+    }
+};
+
+/*****************************************************************************
+ * Decode a binary log, writing the records whose kind is in kinds (a mask   *
+ * of 1 << rocblas_binary_log_kind) as text, one per line, in timestamp      *
+ * order. If timestamps is true, each line is prefixed with its timestamp    *
+ * and thread. The number of dropped records is stored in dropped, if it is  *
+ * not nullptr. Returns false if in is not a binary log.                     *
+ *****************************************************************************/
+inline bool rocblas_binary_log_decode(std::istream& in,
+                                      std::ostream& out,
+                                      unsigned      kinds      = ~0u,
+                                      bool          timestamps = false,
+                                      size_t*       dropped    = nullptr)
+{
+    rocblas_binary_log_header header;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+       || memcmp(header.magic, rocblas_binary_log_header::MAGIC, sizeof(header.magic))
+       || header.version != rocblas_binary_log_header::VERSION
+       || header.record_size != rocblas_binary_log_record::SIZE)
+        return false;
+
+    std::vector<rocblas_binary_log_record> records;
+    rocblas_binary_log_record              record;
+    while(in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        records.push_back(record);
+
+    // The drain thread writes the records of one ring after another, so records
+    // of different threads are not in time order
+    std::stable_sort(records.begin(), records.end(), [](auto& a, auto& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    rocblas_binary_log_symbols symbols;
+    for(auto& r : records)
+    {
+        uint32_t    id;
+        std::string name;
+        if(r.get_symbol(id, name))
+            symbols[id] = std::move(name);
+    }
+
+    size_t total_dropped = 0;
+    for(auto& r : records)
+    {
+        if(r.kind == rocblas_binary_log_kind_dropped)
+        {
+            uint64_t count;
+            memcpy(&count, r.data + 1, sizeof(count));
+            total_dropped += count;
+        }
+        else if(r.kind < 32 && (kinds & (1u << r.kind)))
+        {
+            if(timestamps)
+                out << r.timestamp << ' ' << std::hex << r.thread_id << std::dec << ' ';
+            out << r.render(symbols) << '\n';
+        }
+    }
+
+    if(dropped)
+        *dropped = total_dropped;
+    return true;
+}
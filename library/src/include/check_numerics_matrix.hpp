@@ -28,11 +28,12 @@
 
 /**
   *
-  * rocblas_check_numerics_ge_matrix_kernel(m, n, Aa, offset_a, lda, stride_a, abnormal)
+  * rocblas_check_numerics_ge_matrix_kernel<DIM_X, DIM_Y, RANGE>(m, n, Aa, offset_a, lda, stride_a, abnormal, range)
   *
   * Info about rocblas_check_numerics_ge_matrix_kernel function:
   *
   *    It is the kernel function which checks a matrix for numerical abnormalities such as NaN/zero/Inf/denormal values and updates the rocblas_check_numerics_t structure.
+  *    If RANGE is true, it also adds the dynamic range of the values to the rocblas_check_numerics_range_t record.
   *    ge in rocblas_check_numerics_ge_matrix_kernel refers to general.
   *
   * Parameters   : m            : number of rows of matrix 'A'
@@ -42,29 +43,32 @@
   *                lda          : specifies the leading dimension of matrix 'Aa'
   *                stride_a     : Specifies the pointer increment between one matrix 'A_i' and the next one (Aa_i+1) (where (Aa_i) is the i-th instance of the batch)
   *                abnormal     : Device pointer to the rocblas_check_numerics_t structure
+  *                range        : Device pointer to the rocblas_check_numerics_range_t record, used if RANGE is true
   *
   * Return Value : Nothing --
   *
 **/
 
-template <int DIM_X, int DIM_Y, typename T>
+template <int DIM_X, int DIM_Y, bool RANGE, typename T>
 ROCBLAS_KERNEL(DIM_X* DIM_Y)
-rocblas_check_numerics_ge_matrix_kernel(rocblas_int               m,
-                                        rocblas_int               n,
-                                        T                         Aa,
-                                        rocblas_stride            offset_a,
-                                        int64_t                   lda,
-                                        rocblas_stride            stride_a,
-                                        rocblas_check_numerics_t* abnormal)
+rocblas_check_numerics_ge_matrix_kernel(rocblas_int                     m,
+                                        rocblas_int                     n,
+                                        T                               Aa,
+                                        rocblas_stride                  offset_a,
+                                        int64_t                         lda,
+                                        rocblas_stride                  stride_a,
+                                        rocblas_check_numerics_t*       abnormal,
+                                        rocblas_check_numerics_range_t* range)
 {
     rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
     rocblas_int ty = blockIdx.y * blockDim.y + threadIdx.y;
 
+    auto* A       = load_ptr_batch(Aa, blockIdx.z, offset_a, stride_a);
+    bool  checked = tx < m && ty < n;
+
     //Check every element of the A matrix for a NaN/zero/Inf/denormal value
-    if(tx < m && ty < n)
+    if(checked)
     {
-        auto* A = load_ptr_batch(Aa, blockIdx.z, offset_a, stride_a);
-
         int64_t tid   = tx + lda * ty;
         auto    value = A[tid];
         if(!abnormal->has_zero && rocblas_iszero(value))
@@ -76,16 +80,22 @@ rocblas_check_numerics_ge_matrix_kernel(rocblas_int               m,
         if(!abnormal->has_denorm && rocblas_isdenorm(value))
             abnormal->has_denorm = true;
     }
+
+    //Reduce the values checked by the block to their dynamic range
+    if constexpr(RANGE)
+        rocblas_check_numerics_add_range<DIM_X * DIM_Y>(checked ? A + tx + lda * ty : nullptr,
+                                                        range);
 }
 
 /**
   *
-  * rocblas_check_numerics_sym_herm_tri_matrix_kernel(is_upper, n, Aa, offset_a, lda, stride_a, abnormal)
+  * rocblas_check_numerics_sym_herm_tri_matrix_kernel<DIM_X, DIM_Y, RANGE>(is_upper, n, Aa, offset_a, lda, stride_a, abnormal, range)
   *
   * Info about rocblas_check_numerics_sym_herm_tri_matrix_kernel function:
   *
   *    It is the kernel function which checks symmetric, hermitian and triangular matrices for numerical abnormalities such as NaN/zero/Inf/denormal values
   *    and updates the rocblas_check_numerics_t structure.
+  *    If RANGE is true, it also adds the dynamic range of the values to the rocblas_check_numerics_range_t record.
   *    sym_herm_tri in rocblas_check_numerics_sym_herm_tri_matrix_kernel refers to symmetric, hermitian and triangular matrices.
   *
   * Parameters   : is_upper     : Boolean which is true when the rocblas_fill is rocblas_fill_upper and false when it is rocblas_fill_lower
@@ -95,29 +105,32 @@ rocblas_check_numerics_ge_matrix_kernel(rocblas_int               m,
   *                lda          : specifies the leading dimension of matrix 'Aa'
   *                stride_a     : Specifies the pointer increment between one matrix 'A_i' and the next one (Aa_i+1) (where (Aa_i) is the i-th instance of the batch)
   *                abnormal     : Device pointer to the rocblas_check_numerics_t structure
+  *                range        : Device pointer to the rocblas_check_numerics_range_t record, used if RANGE is true
   *
   * Return Value : Nothing --
   *
 **/
 
-template <int DIM_X, int DIM_Y, typename T>
+template <int DIM_X, int DIM_Y, bool RANGE, typename T>
 ROCBLAS_KERNEL(DIM_X* DIM_Y)
-rocblas_check_numerics_sym_herm_tri_matrix_kernel(bool                      is_upper,
-                                                  rocblas_int               n,
-                                                  T                         Aa,
-                                                  rocblas_stride            offset_a,
-                                                  int64_t                   lda,
-                                                  rocblas_stride            stride_a,
-                                                  rocblas_check_numerics_t* abnormal)
+rocblas_check_numerics_sym_herm_tri_matrix_kernel(bool                            is_upper,
+                                                  rocblas_int                     n,
+                                                  T                               Aa,
+                                                  rocblas_stride                  offset_a,
+                                                  int64_t                         lda,
+                                                  rocblas_stride                  stride_a,
+                                                  rocblas_check_numerics_t*       abnormal,
+                                                  rocblas_check_numerics_range_t* range)
 {
     rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
     rocblas_int ty = blockIdx.y * blockDim.y + threadIdx.y;
 
+    auto* A       = load_ptr_batch(Aa, blockIdx.z, offset_a, stride_a);
+    bool  checked = is_upper ? ty < n && tx <= ty : tx < n && ty <= tx;
+
     //Check every element of the A matrix for a NaN/zero/Inf/denormal value
-    if(is_upper ? ty < n && tx <= ty : tx < n && ty <= tx)
+    if(checked)
     {
-        auto* A = load_ptr_batch(Aa, blockIdx.z, offset_a, stride_a);
-
         int64_t tid   = tx + lda * ty;
         auto    value = A[tid];
         if(!abnormal->has_zero && rocblas_iszero(value))
@@ -129,6 +142,11 @@ rocblas_check_numerics_sym_herm_tri_matrix_kernel(bool                      is_u
         if(!abnormal->has_denorm && rocblas_isdenorm(value))
             abnormal->has_denorm = true;
     }
+
+    //Reduce the values checked by the block to their dynamic range
+    if constexpr(RANGE)
+        rocblas_check_numerics_add_range<DIM_X * DIM_Y>(checked ? A + tx + lda * ty : nullptr,
+                                                        range);
 }
 
 template <typename T>
@@ -0,0 +1,206 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Dynamic range statistics of checked vectors and matrices                  *
+ *                                                                           *
+ * With rocblas_check_numerics_mode_range, the check kernels also reduce the *
+ * values they visit to a rocblas_check_numerics_range_t record: the largest *
+ * and the smallest nonzero magnitude, and a histogram of binary exponents.  *
+ * The records of the checks are summarized as rocblas_check_numerics_range  *
+ * and accumulated per function and argument kind in a table of the handle,  *
+ * which rocblas_get_check_numerics_ranges returns.                          *
+ *****************************************************************************/
+
+#include "rocblas.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Histogram bin of a binary exponent; the first and the last bins also count
+// the exponents below and above the range of the histogram
+constexpr int rocblas_check_numerics_exponent_bin(int exponent)
+{
+    return exponent < ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN ? 0
+           : exponent >= ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN + ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS
+               ? ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS - 1
+               : exponent - ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN;
+}
+
+/*****************************************************************************
+ * rocblas_check_numerics_range_t is the record which the check kernels      *
+ * reduce to with atomics. Magnitudes are kept as the bits of doubles, which *
+ * order like unsigned integers for non-negative values. The smallest        *
+ * magnitude is kept complemented, so that both are reduced with a maximum   *
+ * and a zeroed record is empty. Real and imaginary parts of complex values  *
+ * are counted as separate values.                                           *
+ *****************************************************************************/
+struct rocblas_check_numerics_range_t
+{
+    // unsigned long long is the operand type of the 64-bit device atomics
+    unsigned long long abs_max_bits;
+    unsigned long long min_nonzero_inv_bits;
+    unsigned long long nonzeros;
+    unsigned long long zeros;
+    unsigned long long non_finite;
+    unsigned long long exponent_histogram[ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS];
+};
+
+// Add a value to a record, as the check kernels do
+inline void rocblas_check_numerics_range_add(rocblas_check_numerics_range_t& record, double value)
+{
+    double magnitude = std::fabs(value);
+    if(!std::isfinite(magnitude))
+        record.non_finite++;
+    else if(magnitude == 0)
+        record.zeros++;
+    else
+    {
+        unsigned long long bits;
+        memcpy(&bits, &magnitude, sizeof(bits));
+        record.nonzeros++;
+        record.abs_max_bits         = std::max(record.abs_max_bits, bits);
+        record.min_nonzero_inv_bits = std::max(record.min_nonzero_inv_bits, ~bits);
+        record.exponent_histogram[rocblas_check_numerics_exponent_bin(std::ilogb(magnitude))]++;
+    }
+}
+
+// Summary of the record of one check
+inline rocblas_check_numerics_range rocblas_check_numerics_range_summary(
+    const char* function_name, bool is_input, const rocblas_check_numerics_range_t& record)
+{
+    rocblas_check_numerics_range range{};
+    range.function_name = function_name;
+    range.is_input      = is_input;
+    range.checks        = 1;
+    range.nonzeros      = record.nonzeros;
+    range.zeros         = record.zeros;
+    range.non_finite    = record.non_finite;
+    if(record.nonzeros)
+    {
+        unsigned long long min_bits = ~record.min_nonzero_inv_bits;
+        memcpy(&range.abs_max, &record.abs_max_bits, sizeof(range.abs_max));
+        memcpy(&range.min_nonzero, &min_bits, sizeof(range.min_nonzero));
+    }
+    std::copy(std::begin(record.exponent_histogram),
+              std::end(record.exponent_histogram),
+              range.exponent_histogram);
+    return range;
+}
+
+// Merge the summary src into dst, both of the same function and argument kind
+inline void rocblas_check_numerics_range_merge(rocblas_check_numerics_range&       dst,
+                                               const rocblas_check_numerics_range& src)
+{
+    if(src.nonzeros)
+    {
+        dst.abs_max     = dst.nonzeros ? std::max(dst.abs_max, src.abs_max) : src.abs_max;
+        dst.min_nonzero = dst.nonzeros ? std::min(dst.min_nonzero, src.min_nonzero)
+                                       : src.min_nonzero;
+    }
+    dst.checks += src.checks;
+    dst.nonzeros += src.nonzeros;
+    dst.zeros += src.zeros;
+    dst.non_finite += src.non_finite;
+    for(int i = 0; i < ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS; i++)
+        dst.exponent_histogram[i] += src.exponent_histogram[i];
+}
+
+// Message for a summary, in the format of the messages of numeric checks, with
+// the nonempty bins of the histogram as exponent:count pairs
+inline std::string rocblas_check_numerics_range_message(const rocblas_check_numerics_range& range)
+{
+    std::ostringstream msg;
+    msg << "Funtion name:\t" << range.function_name << " :- "
+        << (range.is_input ? "Input" : "Output") << " :\t"
+        << " nonzeros " << range.nonzeros << " zeros " << range.zeros << " non_finite "
+        << range.non_finite << " abs_max " << range.abs_max << " min_nonzero "
+        << range.min_nonzero << " exponents";
+    for(int i = 0; i < ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS; i++)
+        if(range.exponent_histogram[i])
+            msg << ' ' << ROCBLAS_CHECK_NUMERICS_EXPONENT_MIN + i << ':'
+                << range.exponent_histogram[i];
+    return msg.str();
+}
+
+/*****************************************************************************
+ * rocblas_check_numerics_range_table accumulates summaries per function     *
+ * name and argument kind, in the order in which they were first added.     *
+ *****************************************************************************/
+class rocblas_check_numerics_range_table
+{
+public:
+    void add(const rocblas_check_numerics_range& range)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto key = std::make_pair(std::string(range.function_name), bool(range.is_input));
+        auto it  = m_index.find(key);
+        if(it == m_index.end())
+        {
+            m_index.emplace(std::move(key), m_ranges.size());
+            m_ranges.push_back(range);
+        }
+        else
+            rocblas_check_numerics_range_merge(m_ranges[it->second], range);
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_ranges.size();
+    }
+
+    // Copy at most *count summaries to ranges and set *count to the number copied,
+    // or set *count to the number of summaries if ranges is nullptr
+    void get(rocblas_check_numerics_range* ranges, size_t* count) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(ranges)
+        {
+            *count = std::min(*count, m_ranges.size());
+            std::copy_n(m_ranges.begin(), *count, ranges);
+        }
+        else
+            *count = m_ranges.size();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_index.clear();
+        m_ranges.clear();
+    }
+
+private:
+    mutable std::mutex                             m_mutex;
+    std::vector<rocblas_check_numerics_range>      m_ranges;
+    std::map<std::pair<std::string, bool>, size_t> m_index;
+};
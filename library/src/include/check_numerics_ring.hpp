@@ -0,0 +1,145 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Bookkeeping of deferred numeric checks                                    *
+ *                                                                           *
+ * With rocblas_check_numerics_mode_deferred, each check of an input or      *
+ * output writes its abnormal flags to a slot of a ring of records in device *
+ * memory, and the record is copied back to the host asynchronously. The     *
+ * ring tracks which slots are in flight, and which function, call and       *
+ * argument each belongs to, so that the records can be reported once their  *
+ * copies have completed, without stalling the stream after each check.     *
+ *****************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <sstream>
+#include <string>
+
+class rocblas_check_numerics_ring
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    // A check whose record has not been reported yet
+    struct entry
+    {
+        const char* function_name;
+        uint64_t    call_id;
+        bool        is_input;
+        size_t      slot;
+        void*       stream; // the stream the check ran on
+        void*       event;
+        bool        has_range; // the slot of the range records is also in flight
+    };
+
+    explicit rocblas_check_numerics_ring(size_t capacity = DEFAULT_CAPACITY)
+        : m_capacity(capacity ? capacity : 1)
+    {
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    size_t pending() const
+    {
+        return m_pending.size();
+    }
+
+    // All slots are in flight; the oldest must be collected before the next push
+    bool full() const
+    {
+        return m_pending.size() >= m_capacity;
+    }
+
+    // Add a check of the call numbered call_id, run on stream, and return the
+    // slot of its record
+    size_t push(const char* function_name, uint64_t call_id, bool is_input, void* stream)
+    {
+        size_t slot = m_next++ % m_capacity;
+        m_pending.push_back({function_name, call_id, is_input, slot, stream, nullptr, false});
+        return slot;
+    }
+
+    // The oldest pending check
+    entry& front()
+    {
+        return m_pending.front();
+    }
+
+    // The most recently pushed check
+    entry& back()
+    {
+        return m_pending.back();
+    }
+
+    // Remove the most recently pushed check, if its record could not be issued
+    void pop_back()
+    {
+        m_pending.pop_back();
+        --m_next;
+    }
+
+    // Apply collect(entry) to the pending checks from the oldest, removing each
+    // for which it returns true and stopping at the first for which it returns
+    // false. Returns the number of checks collected.
+    template <typename COLLECT>
+    size_t collect(COLLECT&& collect)
+    {
+        size_t count = 0;
+        while(!m_pending.empty() && collect(m_pending.front()))
+        {
+            m_pending.pop_front();
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    size_t            m_capacity;
+    size_t            m_next = 0;
+    std::deque<entry> m_pending;
+};
+
+// Message for the record of a deferred check, in the format of the messages
+// of synchronous checks, with the number of the call
+inline std::string rocblas_check_numerics_message(const char* function_name,
+                                                  uint64_t    call_id,
+                                                  bool        is_input,
+                                                  bool        has_NaN,
+                                                  bool        has_zero,
+                                                  bool        has_Inf,
+                                                  bool        has_denorm)
+{
+    std::ostringstream msg;
+    msg << "Funtion name:\t" << function_name << " (call " << call_id << ") :- "
+        << (is_input ? "Input" : "Output") << " :\t"
+        << " has_NaN " << has_NaN << " has_zero " << has_zero << " has_Inf " << has_Inf
+        << " has_denorm " << has_denorm;
+    return msg.str();
+}
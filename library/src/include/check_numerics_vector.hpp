@@ -24,6 +24,7 @@
 
 #include "rocblas.h"
 
+#include "check_numerics_range.hpp"
 #include "handle.hpp"
 
 rocblas_status rocblas_check_numerics_abnormal_struct(const char*               function_name,
@@ -31,6 +32,95 @@ rocblas_status rocblas_check_numerics_abnormal_struct(const char*
                                                       bool                      is_input,
                                                       rocblas_check_numerics_t* h_abnormal);
 
+// Magnitude of a real value as a double, which represents all values of the checked types
+template <typename T>
+__device__ inline double rocblas_check_numerics_magnitude(T value)
+{
+    if constexpr(std::is_same<T, double>{})
+        return fabs(value);
+    else
+        return fabs(double(float(value)));
+}
+
+/**
+  *
+  * rocblas_check_numerics_add_range<NB>(value, range)
+  *
+  * Info about rocblas_check_numerics_add_range function:
+  *
+  *    It is the device function which reduces the values checked by the threads of a block to their dynamic range in shared memory,
+  *    and adds the result to the rocblas_check_numerics_range_t record. It must be called by all NB threads of the block.
+  *
+  * Parameters   : value        : Pointer to the value checked by the thread, or nullptr if the thread checks no value
+  *                range        : Device pointer to the rocblas_check_numerics_range_t record
+  *
+  * Return Value : Nothing --
+  *
+**/
+
+template <int NB, typename T>
+__device__ void rocblas_check_numerics_add_range(const T*                        value,
+                                                 rocblas_check_numerics_range_t* range)
+{
+    __shared__ unsigned long long abs_max_bits, min_nonzero_inv_bits;
+    __shared__ unsigned int       nonzeros, zeros, non_finite;
+    __shared__ unsigned int       histogram[ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS];
+
+    int tid = threadIdx.x + threadIdx.y * blockDim.x;
+    for(int i = tid; i < ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS; i += NB)
+        histogram[i] = 0;
+    if(tid == 0)
+    {
+        abs_max_bits = min_nonzero_inv_bits = 0;
+        nonzeros = zeros = non_finite = 0;
+    }
+    __syncthreads();
+
+    auto add = [&](double magnitude) {
+        if(!isfinite(magnitude))
+            atomicAdd(&non_finite, 1u);
+        else if(magnitude == 0)
+            atomicAdd(&zeros, 1u);
+        else
+        {
+            unsigned long long bits = __double_as_longlong(magnitude);
+            atomicAdd(&nonzeros, 1u);
+            atomicMax(&abs_max_bits, bits);
+            atomicMax(&min_nonzero_inv_bits, ~bits);
+            atomicAdd(&histogram[rocblas_check_numerics_exponent_bin(ilogb(magnitude))], 1u);
+        }
+    };
+
+    if(value)
+    {
+        if constexpr(rocblas_is_complex<T>)
+        {
+            add(rocblas_check_numerics_magnitude(std::real(*value)));
+            add(rocblas_check_numerics_magnitude(std::imag(*value)));
+        }
+        else
+            add(rocblas_check_numerics_magnitude(*value));
+    }
+    __syncthreads();
+
+    for(int i = tid; i < ROCBLAS_CHECK_NUMERICS_EXPONENT_BINS; i += NB)
+        if(histogram[i])
+            atomicAdd(&range->exponent_histogram[i], (unsigned long long)histogram[i]);
+    if(tid == 0)
+    {
+        if(nonzeros)
+        {
+            atomicAdd(&range->nonzeros, (unsigned long long)nonzeros);
+            atomicMax(&range->abs_max_bits, abs_max_bits);
+            atomicMax(&range->min_nonzero_inv_bits, min_nonzero_inv_bits);
+        }
+        if(zeros)
+            atomicAdd(&range->zeros, (unsigned long long)zeros);
+        if(non_finite)
+            atomicAdd(&range->non_finite, (unsigned long long)non_finite);
+    }
+}
+
 template <typename T>
 ROCBLAS_INTERNAL_EXPORT_NOINLINE rocblas_status
     rocblas_internal_check_numerics_vector_template(const char*    function_name,
@@ -0,0 +1,170 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Chrome trace events for rocblas_layer_mode_log_chrome_trace.              *
+ *                                                                           *
+ * Each logged rocBLAS call is written as a complete ("X") event in the      *
+ * Chrome trace JSON array format, which is read by chrome://tracing and     *
+ * Perfetto. The array is opened with HEADER and closed with footer() when   *
+ * the last handle writing to the log is destroyed.                          *
+ *                                                                           *
+ * Timestamps are microseconds of the host's monotonic clock, so that the    *
+ * events line up with other traces of the same process taken with that     *
+ * clock.                                                                    *
+ *****************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef WIN32
+#include <process.h>
+#else
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct rocblas_chrome_trace_event
+{
+    // Opens the JSON array of events at the start of a trace file
+    static constexpr const char* HEADER = "[";
+
+    std::string              name;
+    double                   ts  = 0; // Start of the call on the stream, in microseconds
+    double                   dur = 0; // Time until the next logged call, in microseconds
+    uint64_t                 pid = 0;
+    uint64_t                 tid = 0;
+    std::string              stream;
+    std::vector<std::string> args; // Arguments, formatted as in trace logging
+
+    // Closes the JSON array with a metadata event naming the process, since an
+    // event may not be followed by a comma in strict JSON
+    static std::string footer()
+    {
+        return "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + std::to_string(process_id())
+               + ",\"args\":{\"name\":\"rocBLAS\"}}]";
+    }
+
+    // Current host time, in microseconds
+    static double now()
+    {
+        return std::chrono::duration<double, std::micro>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    static uint64_t process_id()
+    {
+#ifdef WIN32
+        return uint64_t(_getpid());
+#else
+        return uint64_t(getpid());
+#endif
+    }
+
+    // The operating system's thread ID where available, so that events line
+    // up with the threads of other traces
+    static uint64_t thread_id()
+    {
+#if defined(__linux__)
+        static thread_local uint64_t tid = uint64_t(syscall(SYS_gettid));
+        return tid;
+#else
+        return uint64_t(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+    }
+
+    // Append s to out as a quoted JSON string
+    static void escape(std::string& out, const std::string& s)
+    {
+        out += '"';
+        for(unsigned char c : s)
+        {
+            switch(c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if(c < 0x20)
+                {
+                    char buf[8];
+                    snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                }
+                else
+                    out += char(c);
+            }
+        }
+        out += '"';
+    }
+
+    // Append the event to out as one element of the JSON array, including the
+    // trailing comma which separates it from the next event
+    void write(std::string& out) const
+    {
+        char buf[96];
+        out += "{\"name\":";
+        escape(out, name);
+        snprintf(buf,
+                 sizeof(buf),
+                 ",\"cat\":\"rocblas\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+                 ts,
+                 dur < 0 ? 0 : dur);
+        out += buf;
+        snprintf(buf,
+                 sizeof(buf),
+                 ",\"pid\":%llu,\"tid\":%llu",
+                 (unsigned long long)pid,
+                 (unsigned long long)tid);
+        out += buf;
+        out += ",\"args\":{\"stream\":";
+        escape(out, stream);
+        out += ",\"arguments\":[";
+        for(size_t i = 0; i < args.size(); ++i)
+        {
+            if(i)
+                out += ',';
+            escape(out, args[i]);
+        }
+        out += "]}},";
+    }
+};
@@ -0,0 +1,55 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_gemm_solution_coverage classifies how the Tensile logic of the    *
+ * selected solution covers a GEMM problem, from the fitness which           *
+ * findBestSolution reports for it.                                          *
+ *                                                                           *
+ * In Tensile, ProblemMatchingLibrary::findBestSolution in                   *
+ * MatchingLibrary.hpp passes the fitness to                                 *
+ * DistanceMatchingTable::findBestMatch in PropertyMatching.hpp, which sets  *
+ * it to the distance from the problem to the key of the selected entry: 0   *
+ * when the problem size is a key of the exact logic, and greater than 0 for *
+ * the nearest key otherwise. Libraries which select a solution without a    *
+ * matching table, such as the fallback libraries of an architecture, do not *
+ * write the fitness, which then keeps the value it was initialized with.    *
+ *****************************************************************************/
+
+#include "rocblas.h"
+#include <cmath>
+#include <limits>
+
+// Value the fitness is initialized with before findBestSolution
+constexpr double rocblas_gemm_fitness_unset = std::numeric_limits<double>::lowest();
+
+inline rocblas_gemm_coverage rocblas_gemm_solution_coverage(bool found, double fitness)
+{
+    if(!found)
+        return rocblas_gemm_coverage_none;
+    if(!std::isfinite(fitness) || fitness == rocblas_gemm_fitness_unset
+       || fitness == std::numeric_limits<double>::max())
+        return rocblas_gemm_coverage_fallback;
+    return fitness == 0 ? rocblas_gemm_coverage_exact : rocblas_gemm_coverage_nearest;
+}
@@ -22,16 +22,26 @@
 
 #pragma once
 
+#include "check_numerics_range.hpp"
+#include "chrome_trace.hpp"
+#include "check_numerics_ring.hpp"
+#include "latency_histogram.hpp"
+#include "level2_variants.hpp"
+#include "log_sampler.hpp"
 #include "macros.hpp"
 #include "rocblas.h"
 #include "rocblas_ostream.hpp"
+#include "slab_allocator.hpp"
+#include "solution_cache.hpp"
 #include "utility.hpp"
 #include <array>
 #include <cstddef>
+#include <deque>
 #include <hip/hip_runtime.h>
 #include <memory>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 #ifdef WIN32
 #include <stdio.h>
 #define STDOUT_FILENO _fileno(stdout)
@@ -44,9 +54,9 @@
 // forcing early cleanup
 extern "C" ROCBLAS_EXPORT void rocblas_shutdown();
 
-// Whether rocBLAS can reallocate device memory on demand, at the cost of only
-// allowing one allocation at a time, and at the cost of potential synchronization.
-// If this is 0, then stack-like allocation is allowed, but reallocation on demand
+// Whether rocBLAS can grow device memory on demand, by adding slabs of device
+// memory, at the cost of potential synchronization in hipMalloc. Stack-like
+// allocation is allowed in either case. If this is 0, then growth on demand
 // does not occur.
 #define ROCBLAS_REALLOC_ON_DEMAND 1
 
@@ -222,17 +232,101 @@ public:
     // default check_numerics_mode is no numeric_check
     rocblas_check_numerics_mode check_numerics = rocblas_check_numerics_mode_no_check;
 
+    // Checks of rocblas_check_numerics_mode_deferred whose records have not been reported,
+    // with the records in device memory and their copies in pinned host memory
+    std::unique_ptr<rocblas_check_numerics_ring> check_numerics_ring;
+    rocblas_check_numerics_t*                    check_numerics_device = nullptr;
+    rocblas_check_numerics_t*                    check_numerics_host   = nullptr;
+
+    // Range records of the slots of the ring, allocated by the first deferred check in range mode
+    rocblas_check_numerics_range_t* check_numerics_range_device = nullptr;
+    rocblas_check_numerics_range_t* check_numerics_range_host   = nullptr;
+
+    // Dynamic ranges of the checked inputs and outputs, accumulated per function
+    rocblas_check_numerics_range_table check_numerics_ranges;
+
+    // Receives the reported records instead of rocblas_cerr, if set
+    rocblas_check_numerics_callback check_numerics_callback      = nullptr;
+    void*                           check_numerics_callback_data = nullptr;
+
+    // Number of abnormal deferred checks reported since the last rocblas_check_numerics_flush
+    size_t check_numerics_abnormal = 0;
+
+    // Number of the last API call which checked its inputs, counting from 1
+    uint64_t check_numerics_call = 0;
+
+    // Number the checks of the next call; API functions call it before checking their inputs
+    void start_check_numerics_call()
+    {
+        ++check_numerics_call;
+    }
+
+    // Return the device record for a deferred check of the call numbered call_id, after
+    // clearing it on the stream, or nullptr if the check cannot be deferred. In range mode,
+    // *range is set to the device range record of the check, or nullptr if it could not be
+    // allocated.
+    rocblas_check_numerics_t* begin_deferred_check(const char*                      function_name,
+                                                   uint64_t                         call_id,
+                                                   bool                             is_input,
+                                                   rocblas_check_numerics_range_t** range);
+
+    // Copy the record of the deferred check begun last to the host, after its kernel
+    void end_deferred_check();
+
+    // Report the deferred checks which completed, waiting for all checks if wait is true
+    void collect_deferred_checks(bool wait);
+
+    // Add the range record of a check to check_numerics_ranges, and print it in info mode
+    void report_check_numerics_range(const char*                           function_name,
+                                     bool                                  is_input,
+                                     const rocblas_check_numerics_range_t& record);
+
+    // Tensile problems and solutions selected for GEMM-like problems on this
+    // handle, to avoid repeating their construction for the same problem
+    rocblas_solution_cache<std::shared_ptr<void>> solution_cache;
+
+    // Rules selecting the kernel variants of level 2 functions on the handle's architecture
+    const rocblas_level2_variant_table* level2_variants = nullptr;
+
     // logging streams
     std::unique_ptr<rocblas_internal_ostream> log_trace_os;
     std::unique_ptr<rocblas_internal_ostream> log_bench_os;
     std::unique_ptr<rocblas_internal_ostream> log_profile_os;
-    void                                      init_logging();
-    void                                      init_check_numerics();
+
+    // Sampling of trace and bench logging, or nullptr if every call is logged
+    std::unique_ptr<rocblas_log_sampler> log_sampler;
+
+    // Trace log which the handle writes Chrome trace events to, with "" for standard error
+    bool        chrome_trace_log_open = false;
+    std::string chrome_trace_log;
+
+    // Write the Chrome trace event of a logged call, timed on the stream from its start to
+    // the start of the next logged call, once its events have completed
+    void trace_chrome_call(rocblas_chrome_trace_event&& event);
+
+    // Write the Chrome trace events of completed calls, waiting for all calls if wait is true
+    void collect_chrome_trace(bool wait);
+
+    // Whether log_profile records the GPU latencies of profiled calls
+    bool profile_latency = false;
+
+    // Start timing a profiled call on the stream, whose latency is added to latency once the
+    // next profiled call has started and the events have completed
+    void start_profile_timing(rocblas_latency_histogram* latency);
+
+    // Add the latencies of completed calls, waiting for all calls if wait is true
+    void collect_profile_timings(bool wait);
+
+    void init_logging();
+    void init_check_numerics();
 
     // C interfaces for manipulating device memory
     friend rocblas_status(::rocblas_start_device_memory_size_query)(_rocblas_handle*);
     friend rocblas_status(::rocblas_stop_device_memory_size_query)(_rocblas_handle*, size_t*);
+    friend rocblas_status(::rocblas_get_device_memory_query_breakdown)(
+        _rocblas_handle*, size_t*, rocblas_device_memory_query_entry*);
     friend rocblas_status(::rocblas_get_device_memory_size)(_rocblas_handle*, size_t*);
+    friend rocblas_status(::rocblas_get_device_memory_stats)(_rocblas_handle*, size_t*, size_t*);
     friend rocblas_status(::rocblas_set_device_memory_size)(_rocblas_handle*, size_t);
     friend rocblas_status(::free_existing_device_memory)(rocblas_handle);
     friend rocblas_status(::rocblas_set_workspace)(_rocblas_handle*, void*, size_t);
@@ -253,9 +347,17 @@ public:
         return device_memory_size_query;
     }
 
+    // Names the API whose device memory sizes a size query records next.
+    // Entry points which can request device memory call it first, since the
+    // sizes are often set by internal functions shared by several APIs.
+    void set_device_memory_query_function(const char* function)
+    {
+        device_memory_query_function = function;
+    }
+
     size_t get_available_workspace()
     {
-        return (device_memory_size - device_memory_in_use);
+        return device_memory.available();
     }
 
     // Get the solution fitness query
@@ -265,7 +367,8 @@ public:
     }
 
     // Sets the optimal size(s) of device memory for a kernel call
-    // Maximum size is accumulated in device_memory_query_size
+    // Maximum size is accumulated in device_memory_query_size, and each call
+    // is recorded in device_memory_query_entries
     // Returns rocblas_status_size_increased or rocblas_status_size_unchanged
     template <typename... Ss,
               std::enable_if_t<sizeof...(Ss) && conjunction<std::is_convertible<Ss, size_t>...>{},
@@ -283,6 +386,11 @@ public:
         auto   dummy = {total += roundup_device_memory_size(sizes)...};
 #endif
 
+        static_assert(sizeof...(Ss) <= ROCBLAS_DEVICE_MEMORY_QUERY_MAX_SIZES,
+                      "Too many device memory sizes for a query entry");
+        device_memory_query_entries.push_back(
+            {device_memory_query_function, total, sizeof...(Ss), {size_t(sizes)...}});
+
         return total > device_memory_query_size ? device_memory_query_size = total,
                                                   rocblas_status_size_increased
                                                 : rocblas_status_size_unchanged;
@@ -294,6 +402,18 @@ public:
         return _pushed_state<rocblas_pointer_mode>(pointer_mode, mode);
     }
 
+    // Temporarily change layer mode, returning object which restores old mode when destroyed
+    auto push_layer_mode(rocblas_layer_mode mode)
+    {
+        return _pushed_state<rocblas_layer_mode>(layer_mode, mode);
+    }
+
+    // Temporarily change check numerics mode, returning object which restores old mode when destroyed
+    auto push_check_numerics(rocblas_check_numerics_mode mode)
+    {
+        return _pushed_state<rocblas_check_numerics_mode>(check_numerics, mode);
+    }
+
     // Whether to use any_order scheduling in Tensile calls
     bool any_order = false;
 
@@ -325,14 +445,31 @@ private:
     // device memory work buffer
     static constexpr size_t DEFAULT_DEVICE_MEMORY_SIZE = 32 * 1024 * 1024;
 
+    // Backend for the device memory slabs, which allocates them on the handle's
+    // device, and with hipMallocAsync if stream-ordered allocation is enabled
+    struct device_memory_backend
+    {
+        _rocblas_handle* handle;
+        hipError_t       last_error = hipSuccess;
+
+        bool allocate(void** ptr, size_t size);
+        bool deallocate(void* ptr);
+    };
+
+    // Device memory work buffers
+    rocblas_slab_allocator<device_memory_backend> device_memory{device_memory_backend{this},
+                                                                DEFAULT_DEVICE_MEMORY_SIZE};
+    using device_memory_block = decltype(device_memory)::block;
+
     // Variables holding state of device memory allocation
-    void*                           device_memory              = nullptr;
-    size_t                          device_memory_size         = 0;
-    size_t                          device_memory_in_use       = 0;
     bool                            device_memory_size_query   = false;
     bool                            alpha_beta_memcpy_complete = false;
     rocblas_device_memory_ownership device_memory_owner;
     size_t                          device_memory_query_size;
+    const char*                     device_memory_query_function = "unknown";
+
+    // Device memory requested by each call during the last size query
+    std::vector<rocblas_device_memory_query_entry> device_memory_query_entries;
 
     bool stream_order_alloc = false;
 
@@ -342,10 +479,49 @@ private:
     // rocblas by default take the system default stream 0 users cannot create
     hipStream_t stream = 0;
 
+    // Profiled calls whose stop events have not completed, and events for reuse. The last
+    // call is open, with no stop event, until the next profiled call starts.
+    struct profile_timing
+    {
+        hipEvent_t                 start;
+        hipEvent_t                 stop;
+        rocblas_latency_histogram* latency;
+        hipStream_t                stream;
+    };
+    std::deque<profile_timing> profile_timings;
+    std::vector<hipEvent_t>    profile_events;
+    hipEvent_t                 acquire_profile_event();
+    void                       end_profile_timing();
+
+    // Maximum number of pending profiled calls; calls are not timed beyond this
+    static constexpr size_t MAX_PROFILE_TIMINGS = 4096;
+
+    // Chrome trace events of logged calls whose events have not completed. The last call is
+    // open, with no stop event, until the next logged call starts. The origin event maps
+    // the times of the stream onto the host clock.
+    struct chrome_trace_call
+    {
+        rocblas_chrome_trace_event event;
+        hipEvent_t                 start;
+        hipEvent_t                 stop;
+        hipStream_t                stream;
+    };
+    std::deque<chrome_trace_call> chrome_trace_calls;
+    hipEvent_t                    chrome_trace_origin    = nullptr;
+    double                        chrome_trace_origin_ts = 0;
+    void                          end_chrome_trace_call();
+
+    // Helper for device memory allocator, which grows the device memory if
+    // it is rocBLAS-managed. Returns nullptr on failure.
+    void* device_allocator(size_t size, device_memory_block& block)
+    {
 #if ROCBLAS_REALLOC_ON_DEMAND
-    // Helper for device memory allocator
-    bool device_allocator(size_t size);
+        bool grow = device_memory_owner == rocblas_device_memory_ownership::rocblas_managed;
+#else
+        bool grow = false;
 #endif
+        return device_memory.allocate(size, block, grow);
+    }
 
     // Device ID is created at handle creation time and remains in effect for the life of the handle.
     const int device;
@@ -360,12 +536,12 @@ private:
     {
     protected:
         // Order is important (pointers member declared last):
-        rocblas_handle handle;
-        size_t         prev_device_memory_in_use;
-        size_t         size;
-        void*          dev_mem = nullptr;
-        hipStream_t    stream_in_use;
-        bool           success;
+        rocblas_handle      handle;
+        device_memory_block block;
+        size_t              size;
+        void*               dev_mem = nullptr;
+        hipStream_t         stream_in_use;
+        bool                success;
 
     private:
         std::vector<void*> pointers; // Important: must come last
@@ -403,19 +579,17 @@ private:
             }
             else
             {
-    #if ROCBLAS_REALLOC_ON_DEMAND
-                success = handle->device_allocator(size);
-    #else
-                success = size <= handle->device_memory_size - handle->device_memory_in_use;
-    #endif
-                // If allocation failed, return an array of nullptr's
                 // If total size is 0, return an array of nullptr's, but leave it marked as successful
-                if(!success || !size)
+                if(!size)
                     return decltype(pointers)(sizeof...(sizes));
 
                 // We allocate the total amount needed, taking it from the available device memory.
-                addr = static_cast<char*>(handle->device_memory) + handle->device_memory_in_use;
-                handle->device_memory_in_use += size;
+                addr    = static_cast<char*>(handle->device_allocator(size, block));
+                success = addr != nullptr;
+
+                // If allocation failed, return an array of nullptr's
+                if(!success)
+                    return decltype(pointers)(sizeof...(sizes));
             }
             // An array of pointers to all of the allocated arrays is formed.
             // If a size is 0, the corresponding pointer is nullptr
@@ -429,7 +603,6 @@ private:
         template <typename... Ss>
         explicit _device_malloc(rocblas_handle handle, Ss... sizes)
             : handle(handle)
-            , prev_device_memory_in_use(handle->device_memory_in_use)
             , size(0)
             , stream_in_use(handle->stream)
             , success(true)
@@ -441,7 +614,6 @@ private:
         // Constructor for allocating count pointers of a certain total size
         explicit _device_malloc(rocblas_handle handle, std::nullptr_t, size_t count, size_t total)
             : handle(handle)
-            , prev_device_memory_in_use(handle->device_memory_in_use)
             , size(roundup_device_memory_size(total))
             , stream_in_use(handle->stream)
             , success(true)
@@ -460,18 +632,11 @@ private:
             }
             else
             {
-#if ROCBLAS_REALLOC_ON_DEMAND
-            success = handle->device_allocator(size);
-#else
-            success = size <= handle->device_memory_size - handle->device_memory_in_use;
-#endif
-            for(auto i= 0 ; i < count ; i++)
-            {    pointers.push_back(success ? static_cast<char*>(handle->device_memory)
-                                         + handle->device_memory_in_use : nullptr);
-            }
+                void* addr = size ? handle->device_allocator(size, block) : nullptr;
+                success    = !size || addr;
 
-            if(success)
-                handle->device_memory_in_use += size;
+                for(auto i= 0 ; i < count ; i++)
+                    pointers.push_back(addr);
             }
         }
 
@@ -484,7 +649,7 @@ private:
         // moves to, or the LIFO ordering will be violated and flagged.
         _device_malloc(_device_malloc&& other) noexcept
             : handle(other.handle)
-            , prev_device_memory_in_use(other.prev_device_memory_in_use)
+            , block(other.block)
             , size(other.size)
             , dev_mem(other.dev_mem)
             , stream_in_use(other.stream_in_use)
@@ -534,9 +699,9 @@ private:
                 }
                 else
                 {
-                    // Subtract size from the handle's device_memory_in_use, making sure
-                    // it matches the device_memory_in_use when this object was created.
-                    if((handle->device_memory_in_use -= size) != prev_device_memory_in_use)
+                    // Return the block to the handle's device memory, making sure
+                    // it is the most recent allocation which is still alive.
+                    if(!handle->device_memory.deallocate(block))
                     {
                         rocblas_cerr
                             << "rocBLAS internal error: device_malloc() RAII object not "
@@ -0,0 +1,134 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_latency_histogram records call latencies in log-scale buckets,    *
+ * with SUB_BUCKETS buckets per power of 2, so that quantiles such as the    *
+ * median and 99th percentile can be estimated within about 9% from a fixed  *
+ * amount of memory. Latencies are added with relaxed atomics, so that one   *
+ * thread may add to a histogram while another reads it.                     *
+ *****************************************************************************/
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+class rocblas_latency_histogram
+{
+public:
+    static constexpr int SUB_BUCKETS = 4; // Buckets per power of 2
+    static constexpr int MIN_EXP     = -4; // Smallest bucket starts at 2^-4 us
+    static constexpr int MAX_EXP     = 30; // Largest bucket starts at 2^30 us
+
+    // Buckets between 2^MIN_EXP and 2^MAX_EXP us, with an underflow and overflow bucket
+    static constexpr int NUM_BUCKETS = (MAX_EXP - MIN_EXP) * SUB_BUCKETS + 2;
+
+    rocblas_latency_histogram() = default;
+
+    rocblas_latency_histogram(const rocblas_latency_histogram&) = delete;
+    rocblas_latency_histogram& operator=(const rocblas_latency_histogram&) = delete;
+
+    // Bucket of a latency in microseconds
+    static int bucket(double us)
+    {
+        if(!(us >= std::ldexp(1.0, MIN_EXP)))
+            return 0;
+        if(us >= std::ldexp(1.0, MAX_EXP))
+            return NUM_BUCKETS - 1;
+        int b = 1 + int(std::floor((std::log2(us) - MIN_EXP) * SUB_BUCKETS));
+        return b < 1 ? 1 : b > NUM_BUCKETS - 2 ? NUM_BUCKETS - 2 : b;
+    }
+
+    // Representative latency of a bucket: the geometric midpoint of its range,
+    // or the bound of the underflow or overflow bucket
+    static double bucket_value(int b)
+    {
+        if(b <= 0)
+            return std::ldexp(1.0, MIN_EXP);
+        if(b >= NUM_BUCKETS - 1)
+            return std::ldexp(1.0, MAX_EXP);
+        return std::exp2(MIN_EXP + (b - 0.5) / SUB_BUCKETS);
+    }
+
+    // Add a latency in microseconds
+    void add(double us)
+    {
+        m_buckets[bucket(us)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_total_ns.fetch_add(us > 0 ? uint64_t(us * 1000 + 0.5) : 0, std::memory_order_relaxed);
+    }
+
+    // Add the latencies of another histogram
+    void add(const rocblas_latency_histogram& other)
+    {
+        for(int b = 0; b < NUM_BUCKETS; ++b)
+            m_buckets[b].fetch_add(other.m_buckets[b].load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+        m_count.fetch_add(other.count(), std::memory_order_relaxed);
+        m_total_ns.fetch_add(other.m_total_ns.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    }
+
+    // Number of latencies added
+    uint64_t count() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    // Sum of the latencies in microseconds
+    double total() const
+    {
+        return m_total_ns.load(std::memory_order_relaxed) / 1000.0;
+    }
+
+    // Estimate the q-quantile (0 < q <= 1) in microseconds, or 0 if there are no latencies
+    double quantile(double q) const
+    {
+        uint64_t n = 0;
+        for(int b = 0; b < NUM_BUCKETS; ++b)
+            n += m_buckets[b].load(std::memory_order_relaxed);
+        if(!n)
+            return 0;
+
+        // The rank of the quantile, counting from 1
+        uint64_t rank = uint64_t(std::ceil(q * n));
+        if(rank < 1)
+            rank = 1;
+
+        uint64_t cumulative = 0;
+        for(int b = 0; b < NUM_BUCKETS; ++b)
+        {
+            cumulative += m_buckets[b].load(std::memory_order_relaxed);
+            if(cumulative >= rank)
+                return bucket_value(b);
+        }
+        return bucket_value(NUM_BUCKETS - 1);
+    }
+
+private:
+    std::atomic<uint32_t> m_buckets[NUM_BUCKETS]{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_total_ns{0};
+};
@@ -0,0 +1,365 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Kernel variant selection of level 2 functions                             *
+ *                                                                           *
+ * gemv, symv and ger have several kernels for an operation, whose relative *
+ * performance depends on the architecture, the precision and the size of    *
+ * the problem. The choice is made by a list of rules, one per line:         *
+ *                                                                           *
+ *   rocblas_level2_variants 1                                               *
+ *   gfx908 gemv_n sdc - 15000 - 15000 - - - threads_512                     *
+ *                                                                           *
+ * The fields of a rule are the arch, the op, the precisions, the minimum    *
+ * and maximum of m, of n and of the batch count, n_multiple and the         *
+ * variant. The arch is a name such as gfx90a, a prefix followed by * such   *
+ * as gfx10*, or * for all architectures. The precisions are letters of      *
+ * sdcz, or * for all types. The bounds are inclusive and - leaves them      *
+ * open; the rule applies if n is a multiple of n_multiple, where - means    *
+ * any n. # starts a comment.                                                *
+ *                                                                           *
+ * The first rule of the op which matches the problem and whose variant can  *
+ * run it selects the variant; if none does, the generic variant is used.    *
+ * The rules of the file named by ROCBLAS_LEVEL2_VARIANTS are tried before   *
+ * the rules compiled into the library.                                      *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Version of the rules file format
+constexpr int ROCBLAS_LEVEL2_VARIANTS_VERSION = 1;
+
+enum class rocblas_level2_op : int
+{
+    gemv_n,
+    gemv_t,
+    gemv_c,
+    symv_upper,
+    symv_lower,
+    ger,
+    count
+};
+
+enum class rocblas_level2_variant : int
+{
+    // gemv_n: 1024 threads per block; gemv_t and gemv_c: warp reduction with 1024 threads;
+    // symv and ger: the kernels without double buffering
+    generic,
+
+    // gemv_n: matrices of at most 32 x 32, several per block
+    sm_mn_batched,
+
+    // Double buffered loads, for some types only; gemv and ger also need m == n and m to be
+    // a multiple of the block size, and gemv and symv need atomics
+    double_buffered,
+
+    // gemv_n: 512 threads per block
+    threads_512,
+
+    // gemv_t: warp reduction with 256 threads per block
+    warp_reduce_256,
+
+    // gemv_t and gemv_c: shared memory reduction with 256 threads per block
+    shared_reduce_256,
+
+    count
+};
+
+constexpr const char* rocblas_level2_op_names[]
+    = {"gemv_n", "gemv_t", "gemv_c", "symv_upper", "symv_lower", "ger"};
+
+constexpr const char* rocblas_level2_variant_names[] = {"generic",         "sm_mn_batched",
+                                                        "double_buffered", "threads_512",
+                                                        "warp_reduce_256", "shared_reduce_256"};
+
+// Whether op has a kernel of the variant
+constexpr bool rocblas_level2_op_has_variant(rocblas_level2_op op, rocblas_level2_variant variant)
+{
+    using V = rocblas_level2_variant;
+    switch(op)
+    {
+    case rocblas_level2_op::gemv_n:
+        return variant == V::generic || variant == V::sm_mn_batched
+               || variant == V::double_buffered || variant == V::threads_512;
+    case rocblas_level2_op::gemv_t:
+        return variant == V::generic || variant == V::double_buffered
+               || variant == V::warp_reduce_256 || variant == V::shared_reduce_256;
+    case rocblas_level2_op::gemv_c:
+        return variant == V::generic || variant == V::double_buffered
+               || variant == V::shared_reduce_256;
+    default:
+        return variant == V::generic || variant == V::double_buffered;
+    }
+}
+
+// Precision letter of a type for the rules, given whether it is float, double,
+// float complex or double complex; other types only match rules of all types
+constexpr char rocblas_level2_precision(bool is_float,
+                                        bool is_double,
+                                        bool is_complex_float,
+                                        bool is_complex_double)
+{
+    return is_float ? 's' : is_double ? 'd' : is_complex_float ? 'c' : is_complex_double ? 'z' : 0;
+}
+
+// Whether the arch of a rule, which may end in *, matches the name of an architecture
+inline bool rocblas_level2_arch_matches(const std::string& pattern, const std::string& arch)
+{
+    if(!pattern.empty() && pattern.back() == '*')
+        return !arch.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1);
+    return pattern == arch;
+}
+
+struct rocblas_level2_rule
+{
+    static constexpr int64_t unbounded = std::numeric_limits<int64_t>::max();
+
+    std::string            arch;
+    rocblas_level2_op      op;
+    std::string            precisions; // letters of sdcz, or * for all types
+    int64_t                m_min = 0, m_max = unbounded;
+    int64_t                n_min = 0, n_max = unbounded;
+    int64_t                batch_min = 0, batch_max = unbounded;
+    int64_t                n_multiple = 1;
+    rocblas_level2_variant variant;
+
+    bool matches(char precision, int64_t m, int64_t n, int64_t batch_count) const
+    {
+        return (precisions == "*" || (precision && precisions.find(precision) != std::string::npos))
+               && m >= m_min && m <= m_max && n >= n_min && n <= n_max && batch_count >= batch_min
+               && batch_count <= batch_max && n % n_multiple == 0;
+    }
+};
+
+/*****************************************************************************
+ * Append the rules read from in to rules. Returns the number of rules read, *
+ * or -1 with a message in error if the file is malformed, in which case     *
+ * rules is unchanged.                                                       *
+ *****************************************************************************/
+inline int rocblas_level2_variants_parse(std::istream&                     in,
+                                         std::vector<rocblas_level2_rule>& rules,
+                                         std::string&                      error)
+{
+    std::vector<rocblas_level2_rule> parsed;
+    bool                             header = false;
+    int                              line_number = 0;
+
+    for(std::string line; std::getline(in, line);)
+    {
+        line_number++;
+        std::istringstream       words(line.substr(0, line.find('#')));
+        std::vector<std::string> fields;
+        for(std::string word; words >> word;)
+            fields.push_back(word);
+        if(fields.empty())
+            continue;
+
+        auto fail = [&](const std::string& message) {
+            error = "line " + std::to_string(line_number) + ": " + message;
+            return -1;
+        };
+
+        if(!header)
+        {
+            if(fields[0] != "rocblas_level2_variants")
+                return fail("not a rocblas_level2_variants file");
+            if(fields.size() != 2 || fields[1] != std::to_string(ROCBLAS_LEVEL2_VARIANTS_VERSION))
+                return fail("unsupported version");
+            header = true;
+            continue;
+        }
+
+        if(fields.size() != 11)
+            return fail("expected 11 fields in rule");
+
+        rocblas_level2_rule rule;
+        rule.arch = fields[0];
+
+        auto op = std::find(std::begin(rocblas_level2_op_names),
+                            std::end(rocblas_level2_op_names),
+                            fields[1]);
+        if(op == std::end(rocblas_level2_op_names))
+            return fail("unknown op " + fields[1]);
+        rule.op = rocblas_level2_op(op - std::begin(rocblas_level2_op_names));
+
+        rule.precisions = fields[2];
+        if(rule.precisions != "*" && rule.precisions.find_first_not_of("sdcz") != std::string::npos)
+            return fail("unknown precisions " + rule.precisions);
+
+        // Bounds are - or non-negative integers
+        int64_t* values[] = {&rule.m_min,
+                             &rule.m_max,
+                             &rule.n_min,
+                             &rule.n_max,
+                             &rule.batch_min,
+                             &rule.batch_max,
+                             &rule.n_multiple};
+        for(int i = 0; i < 7; i++)
+        {
+            const std::string& field = fields[3 + i];
+            if(field == "-")
+                continue;
+            char* end;
+            *values[i] = strtoll(field.c_str(), &end, 10);
+            if(*end || *values[i] < (i == 6 ? 1 : 0))
+                return fail("invalid bound " + field);
+        }
+        if(rule.m_min > rule.m_max || rule.n_min > rule.n_max || rule.batch_min > rule.batch_max)
+            return fail("empty range");
+
+        auto variant = std::find(std::begin(rocblas_level2_variant_names),
+                                 std::end(rocblas_level2_variant_names),
+                                 fields[10]);
+        if(variant == std::end(rocblas_level2_variant_names))
+            return fail("unknown variant " + fields[10]);
+        rule.variant = rocblas_level2_variant(variant - std::begin(rocblas_level2_variant_names));
+        if(!rocblas_level2_op_has_variant(rule.op, rule.variant))
+            return fail(fields[10] + " is not a variant of " + fields[1]);
+
+        parsed.push_back(std::move(rule));
+    }
+
+    if(!header)
+    {
+        error = "not a rocblas_level2_variants file";
+        return -1;
+    }
+
+    rules.insert(rules.end(), parsed.begin(), parsed.end());
+    return int(parsed.size());
+}
+
+/*****************************************************************************
+ * The rules which apply to one architecture, grouped by op                  *
+ *****************************************************************************/
+class rocblas_level2_variant_table
+{
+public:
+    rocblas_level2_variant_table() = default;
+
+    rocblas_level2_variant_table(const std::vector<rocblas_level2_rule>& rules,
+                                 const std::string&                      arch)
+    {
+        for(const auto& rule : rules)
+            if(rocblas_level2_arch_matches(rule.arch, arch))
+                m_rules[int(rule.op)].push_back(rule);
+    }
+
+    // Select the variant of the first matching rule for which feasible(variant) is true,
+    // or the generic variant
+    template <typename FEASIBLE>
+    rocblas_level2_variant select(rocblas_level2_op op,
+                                  char              precision,
+                                  int64_t           m,
+                                  int64_t           n,
+                                  int64_t           batch_count,
+                                  FEASIBLE&&        feasible) const
+    {
+        for(const auto& rule : m_rules[int(op)])
+            if(rule.matches(precision, m, n, batch_count) && feasible(rule.variant))
+                return rule.variant;
+        return rocblas_level2_variant::generic;
+    }
+
+    rocblas_level2_variant select(
+        rocblas_level2_op op, char precision, int64_t m, int64_t n, int64_t batch_count) const
+    {
+        return select(op, precision, m, n, batch_count, [](rocblas_level2_variant) {
+            return true;
+        });
+    }
+
+    size_t size(rocblas_level2_op op) const
+    {
+        return m_rules[int(op)].size();
+    }
+
+private:
+    std::vector<rocblas_level2_rule> m_rules[int(rocblas_level2_op::count)];
+};
+
+// clang-format off
+// The rules compiled into the library, which were tuned on gfx906, gfx908, gfx90a, gfx10 and
+// gfx11. The kernels skip rules whose variant cannot run the problem.
+constexpr const char* rocblas_level2_default_variants = R"(
+rocblas_level2_variants 1
+# arch  op          prec  m_min m_max n_min n_max batch_min batch_max n_multiple variant
+gfx90a  gemv_n      *     -     32    -     32    256       -         -          sm_mn_batched
+gfx90a  gemv_n      sd    -     -     -     -     -         -         -          double_buffered
+gfx908  gemv_n      sdc   -     15000 -     15000 -         -         -          threads_512
+gfx908  gemv_n      z     -     18000 -     18000 -         -         -          threads_512
+gfx906  gemv_n      c     -     -     -     -     -         -         -          threads_512
+gfx906  gemv_n      sd    -     6000  -     6000  -         -         -          threads_512
+gfx906  gemv_n      d     15000 -     15000 -     -         -         -          threads_512
+gfx906  gemv_n      d     -     24000 -     24000 -         -         -          threads_512
+
+gfx908  gemv_t      s     7001  -     -     -     -         -         -          double_buffered
+gfx908  gemv_t      d     3001  -     -     -     -         -         -          double_buffered
+gfx10*  gemv_t      dc    -     -     -     -     -         -         -          warp_reduce_256
+gfx11*  gemv_t      dc    -     -     -     -     -         -         -          warp_reduce_256
+gfx10*  gemv_t      s     -     3999  -     -     -         -         -          warp_reduce_256
+gfx11*  gemv_t      s     -     3999  -     -     -         -         -          warp_reduce_256
+gfx10*  gemv_t      s     -     -     -     3999  -         -         -          warp_reduce_256
+gfx11*  gemv_t      s     -     -     -     3999  -         -         -          warp_reduce_256
+gfx10*  gemv_t      z     -     -     -     -     -         -         -          shared_reduce_256
+gfx11*  gemv_t      z     -     -     -     -     -         -         -          shared_reduce_256
+*       gemv_t      s     -     -     -     -     -         -         -          shared_reduce_256
+*       gemv_t      *     -     5999  -     -     -         -         -          shared_reduce_256
+*       gemv_t      *     -     -     -     5999  -         -         -          shared_reduce_256
+
+gfx908  gemv_c      s     7001  -     -     -     -         -         -          double_buffered
+gfx908  gemv_c      d     3001  -     -     -     -         -         -          double_buffered
+*       gemv_c      s     -     -     -     -     -         -         -          shared_reduce_256
+*       gemv_c      *     -     5999  -     -     -         -         -          shared_reduce_256
+*       gemv_c      *     -     -     -     5999  -         -         -          shared_reduce_256
+
+gfx90a  symv_upper  s     -     -     -     21999 -         -         -          double_buffered
+gfx90a  symv_upper  d     -     -     -     15999 -         -         -          double_buffered
+gfx908  symv_upper  s     -     -     -     21999 -         -         -          double_buffered
+gfx908  symv_upper  d     -     -     -     22999 -         -         32         double_buffered
+gfx908  symv_upper  d     -     -     -     -     -         -         32         generic
+gfx908  symv_upper  d     -     -     -     13999 -         -         -          double_buffered
+gfx908  symv_upper  d     -     -     19001 -     -         -         -          double_buffered
+
+gfx908  symv_lower  sd    -     -     -     -     -         -         -          double_buffered
+gfx90a  symv_lower  s     -     -     -     28999 -         -         -          double_buffered
+gfx90a  symv_lower  d     -     -     -     19999 -         -         32         double_buffered
+gfx90a  symv_lower  d     -     -     -     -     -         -         32         generic
+gfx90a  symv_lower  d     -     -     -     25999 -         -         -          double_buffered
+
+gfx90a  ger         sdc   2001  -     -     -     -         -         -          double_buffered
+)";
+// clang-format on
+
+// Rules of an architecture: those of the file named by ROCBLAS_LEVEL2_VARIANTS, followed by
+// rocblas_level2_default_variants. The table is built once per architecture.
+const rocblas_level2_variant_table& rocblas_internal_level2_variants(const std::string& arch);
@@ -0,0 +1,151 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * The log sampler decides whether a trace or bench logging call is logged,  *
+ * so that logging can be left enabled with bounded overhead. A call can be  *
+ * sampled 1 in N times, and each function can be limited to K records per  *
+ * second. The decision is made before any arguments are formatted.         *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+class rocblas_log_sampler
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Logging streams which are sampled independently
+    enum stream
+    {
+        trace,
+        bench,
+        num_streams,
+    };
+
+    // Log 1 in sample_rate calls (0 or 1 logs every call), and at most
+    // rate_limit records per second per function (0 is unlimited)
+    rocblas_log_sampler(uint64_t sample_rate, double rate_limit)
+        : m_sample_rate(sample_rate)
+        , m_rate_limit(rate_limit)
+    {
+    }
+
+    rocblas_log_sampler(const rocblas_log_sampler&) = delete;
+    rocblas_log_sampler& operator=(const rocblas_log_sampler&) = delete;
+
+    // Whether the sampler can skip any calls
+    bool enabled() const
+    {
+        return m_sample_rate > 1 || m_rate_limit > 0;
+    }
+
+    static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325;
+
+    // Hash of a function name, or of several strings identifying a function
+    // when seed is the hash of the preceding strings
+    static uint64_t hash(const char* s, uint64_t seed = HASH_SEED)
+    {
+        // FNV-1a, with a separator so that "ab","c" and "a","bc" differ
+        for(; s && *s; ++s)
+            seed = (seed ^ uint8_t(*s)) * 0x100000001b3;
+        return (seed ^ uint8_t(' ')) * 0x100000001b3;
+    }
+
+    // Return whether a call of the function with hash() function should be
+    // logged to stream s
+    bool sample(stream s, uint64_t function)
+    {
+        return sample(s, function, m_rate_limit > 0 ? clock::now() : clock::time_point{});
+    }
+
+    bool sample(stream s, uint64_t function, clock::time_point now)
+    {
+        if(m_sample_rate > 1 && m_calls[s].fetch_add(1, std::memory_order_relaxed) % m_sample_rate)
+            return skip();
+
+        if(m_rate_limit > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // A function starts with a full bucket, allowing a burst of rate_limit records
+            auto    it = m_buckets[s].emplace(function, bucket{burst(), now}).first;
+            bucket& b  = it->second;
+            b.tokens   = std::min(burst(),
+                                b.tokens
+                                    + m_rate_limit
+                                          * std::chrono::duration<double>(now - b.time).count());
+            b.time     = now;
+            if(b.tokens < 1)
+                return skip();
+            b.tokens -= 1;
+        }
+
+        m_logged.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Get the number of calls logged and skipped
+    void get_stats(size_t* logged, size_t* skipped) const
+    {
+        if(logged)
+            *logged = m_logged.load(std::memory_order_relaxed);
+        if(skipped)
+            *skipped = m_skipped.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct bucket
+    {
+        double            tokens;
+        clock::time_point time;
+    };
+
+    const uint64_t m_sample_rate;
+    const double   m_rate_limit;
+
+    std::atomic<uint64_t> m_calls[num_streams]{};
+    std::atomic<size_t>   m_logged{0};
+    std::atomic<size_t>   m_skipped{0};
+
+    std::mutex                           m_mutex; // Guards m_buckets
+    std::unordered_map<uint64_t, bucket> m_buckets[num_streams];
+
+    bool skip()
+    {
+        m_skipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    double burst() const
+    {
+        return std::max(m_rate_limit, 1.0);
+    }
+};
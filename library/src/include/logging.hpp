@@ -22,8 +22,11 @@
 
 #pragma once
 
+#include "binary_log.hpp"
+#include "chrome_trace.hpp"
 #include "handle.hpp"
 #include "rocblas_ostream.hpp"
+#include "sharded_profile.hpp"
 #include "tuple_helper.hpp"
 #include <cmath>
 #include <cstdlib>
@@ -33,7 +36,6 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -44,51 +46,25 @@
  * Profile kernel arguments
  ************************************************************************************/
 template <typename TUP>
-class argument_profile
+class argument_profile : rocblas_profile_source
 {
     // Output stream
     mutable rocblas_internal_ostream os;
 
-    // Mutex for multithreaded access to table
-    mutable std::shared_timed_mutex mutex;
-
-    // Table mapping argument tuples into counts
-    // size_t is used for the map target type since atomic types are not movable, and
-    // the map elements will only be moved when we hold an exclusive lock to the map.
-    std::unordered_map<TUP,
-                       size_t,
-                       typename tuple_helper::hash_t<TUP>,
-                       typename tuple_helper::equal_t<TUP>>
-        map;
+    // Counts of each argument tuple, kept separately by each thread
+    rocblas_sharded_counter<TUP,
+                            typename tuple_helper::hash_t<TUP>,
+                            typename tuple_helper::equal_t<TUP>>
+        counts;
 
 public:
-    // A tuple of arguments is looked up in an unordered map.
+    // A tuple of arguments is looked up in the calling thread's table.
     // A count of the number of calls with these arguments is kept.
     // arg is assumed to be an rvalue for efficiency
-    void operator()(TUP&& arg)
+    // If timed is true, returns the histogram for the latency of the call.
+    rocblas_latency_histogram* operator()(TUP&& arg, bool timed = false)
     {
-        { // Acquire a shared lock for reading map
-            std::shared_lock<std::shared_timed_mutex> lock(mutex);
-
-            // Look up the tuple in the map
-            auto p = map.find(arg);
-
-            // If tuple already exists, atomically increment count and return
-            if(p != map.end())
-            {
-                __atomic_fetch_add(&p->second, 1, __ATOMIC_SEQ_CST);
-                return;
-            }
-        } // Release shared lock
-
-        { // Acquire an exclusive lock for modifying map
-            std::lock_guard<std::shared_timed_mutex> lock(mutex);
-
-            // If doesn't already exist, insert tuple by moving arg and initializing count to 0.
-            // Increment the count after searching for tuple and returning old or new match.
-            // We hold a lock to the map, so we don't have to increment the count atomically.
-            map.emplace(std::move(arg), 0).first->second++;
-        } // Release exclusive lock
+        return counts.add(std::move(arg), timed);
     }
 
     // Constructor
@@ -96,33 +72,63 @@ public:
     explicit argument_profile(rocblas_internal_ostream& os)
         : os(os.dup())
     {
+        rocblas_profile_snapshots::instance().add(this);
+    }
+
+    // Print the tuples of all threads, with their total counts
+    void dump(rocblas_internal_ostream& out) const
+    {
+        for(const auto& p : counts.merge())
+        {
+            const rocblas_profile_count& count = p.second;
+            out << "- ";
+            if(count.latency && count.latency->count())
+            {
+                const rocblas_latency_histogram& latency = *count.latency;
+
+                auto pairs = std::make_tuple("call_count",
+                                             count.calls,
+                                             "gpu_time_calls",
+                                             latency.count(),
+                                             "gpu_time_us_total",
+                                             latency.total(),
+                                             "gpu_time_us_p50",
+                                             latency.quantile(0.5),
+                                             "gpu_time_us_p99",
+                                             latency.quantile(0.99));
+                tuple_helper::print_tuple_pairs(out, std::tuple_cat(p.first, pairs));
+            }
+            else
+                tuple_helper::print_tuple_pairs(
+                    out, std::tuple_cat(p.first, std::make_tuple("call_count", count.calls)));
+        }
     }
 
     // Dump the current profile
     void dump() const
     {
-        // Acquire an exclusive lock to use map
-        std::lock_guard<std::shared_timed_mutex> lock(mutex);
-
         // Clear the output buffer
         os.clear();
 
-        // Print all of the tuples in the map
-        for(const auto& p : map)
-        {
-            os << "- ";
-            tuple_helper::print_tuple_pairs(
-                os, std::tuple_cat(p.first, std::make_tuple("call_count", p.second)));
-        }
+        dump(os);
 
         // Flush out the dump
         os.flush();
     }
 
+    // Append the current profile to a periodic snapshot
+    void snapshot(std::string& out) const override
+    {
+        rocblas_internal_ostream ss;
+        dump(ss);
+        out += ss.str();
+    }
+
     // Cleanup handler which dumps profile at destruction
     ~argument_profile()
     try
     {
+        rocblas_profile_snapshots::instance().remove(this);
         dump();
     }
     catch(...)
@@ -148,8 +154,10 @@ void log_profile(rocblas_handle handle, const char* func, Ts&&... xs)
     // Add at_quick_exit handler in case the program exits early
     static int aqe = at_quick_exit([] { profile.~argument_profile(); });
 
-    // Profile the tuple
-    profile(std::move(tup));
+    // Profile the tuple, and time the call on the stream until the next profiled call starts
+    rocblas_latency_histogram* latency = profile(std::move(tup), handle->profile_latency);
+    if(latency)
+        handle->start_profile_timing(latency);
 }
 
 /********************************************
@@ -165,13 +173,231 @@ void log_arguments(rocblas_internal_ostream& os, const char* sep, H&& head, Ts&&
     os << std::endl;
 }
 
+/********************************************************************
+ * Log values as binary records (for rocblas_layer_mode_log_binary) *
+ * Each argument is encoded so that rocblas_binary_log_decode()     *
+ * renders it the same as rocblas_internal_ostream would.           *
+ ********************************************************************/
+// The const char* arguments of logging calls are string literals or static
+// names, such as rocblas_gemm_name<T>, so they are logged as symbols
+inline void log_binary_argument(rocblas_binary_log_record& record, const char* s)
+{
+    if(s)
+        record.put_symbol(rocblas_binary_logger::instance().intern(s));
+    else
+        record.put_string("");
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, const std::string& s)
+{
+    record.put_string(s.data(), s.size());
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, char c)
+{
+    record.put_char(c);
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, bool b)
+{
+    record.put_int(b);
+}
+
+template <typename T,
+          std::enable_if_t<std::is_integral<T>{} && std::is_signed<T>{} && !std::is_same<T, char>{},
+                           int> = 0>
+inline void log_binary_argument(rocblas_binary_log_record& record, T x)
+{
+    record.put_int(x);
+}
+
+template <typename T,
+          std::enable_if_t<std::is_integral<T>{} && std::is_unsigned<T>{}
+                               && !std::is_same<T, bool>{},
+                           int> = 0>
+inline void log_binary_argument(rocblas_binary_log_record& record, T x)
+{
+    record.put_uint(x);
+}
+
+template <typename T, std::enable_if_t<std::is_floating_point<T>{}, int> = 0>
+inline void log_binary_argument(rocblas_binary_log_record& record, T x)
+{
+    record.put_real(x);
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_half x)
+{
+    record.put_real(float(x));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_bfloat16 x)
+{
+    record.put_real(float(x));
+}
+
+template <typename T>
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_complex_num<T> x)
+{
+    record.put_complex(std::real(x), std::imag(x));
+}
+
+template <typename T, std::enable_if_t<!std::is_same<std::remove_cv_t<T>, char>{}, int> = 0>
+inline void log_binary_argument(rocblas_binary_log_record& record, T* p)
+{
+    record.put_pointer(p);
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_operation trans)
+{
+    record.put_char(rocblas_transpose_letter(trans));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_fill fill)
+{
+    record.put_char(rocblas_fill_letter(fill));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_diagonal diag)
+{
+    record.put_char(rocblas_diag_letter(diag));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_side side)
+{
+    record.put_char(rocblas_side_letter(side));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_datatype d)
+{
+    record.put_string(rocblas_datatype_string(d));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_status status)
+{
+    record.put_string(rocblas_status_to_string(status));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_atomics_mode mode)
+{
+    record.put_string(rocblas_atomics_mode_to_string(mode));
+}
+
+inline void log_binary_argument(rocblas_binary_log_record& record, rocblas_gemm_flags flags)
+{
+    record.put_string(rocblas_gemm_flags_to_string(flags));
+}
+
+// Other enumerations are logged as their underlying integer
+template <typename T, std::enable_if_t<std::is_enum<T>{}, int> = 0>
+inline void log_binary_argument(rocblas_binary_log_record& record, T x)
+{
+    log_binary_argument(record, std::underlying_type_t<T>(x));
+}
+
+// Types of scalars logged with LOG_TRACE_SCALAR_VALUE and LOG_BENCH_SCALAR_VALUE
+template <typename T>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type = rocblas_binary_log_scalar(0);
+
+template <>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type<rocblas_half>
+    = rocblas_binary_log_scalar_half;
+
+template <>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type<rocblas_bfloat16>
+    = rocblas_binary_log_scalar_bfloat16;
+
+template <>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type<float> = rocblas_binary_log_scalar_float;
+
+template <>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type<double>
+    = rocblas_binary_log_scalar_double;
+
+template <>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type<rocblas_float_complex>
+    = rocblas_binary_log_scalar_float_complex;
+
+template <>
+constexpr rocblas_binary_log_scalar log_binary_scalar_type<rocblas_double_complex>
+    = rocblas_binary_log_scalar_double_complex;
+
+template <typename... Ts>
+void log_binary(rocblas_binary_log_kind kind, Ts&&... xs)
+{
+    rocblas_binary_logger::instance().log(kind, [&](rocblas_binary_log_record& record) {
+        (log_binary_argument(record, xs), ...);
+    });
+}
+
+/**********************************************************************
+ * Sampling of log_trace and log_bench, decided before any formatting *
+ * The leading string arguments, such as the function name or the     *
+ * rocblas-bench command prefix, identify the function.               *
+ **********************************************************************/
+inline uint64_t log_sample_function(uint64_t seed)
+{
+    return seed;
+}
+
+template <typename H, typename... Ts>
+uint64_t log_sample_function(uint64_t seed, const H& head, const Ts&... xs)
+{
+    if constexpr(std::is_convertible<const H&, const char*>{})
+        return log_sample_function(rocblas_log_sampler::hash(head, seed), xs...);
+    else
+        return seed;
+}
+
+template <typename... Ts>
+bool log_sample(rocblas_handle handle, rocblas_log_sampler::stream s, const Ts&... xs)
+{
+    return !handle->log_sampler
+           || handle->log_sampler->sample(
+               s, log_sample_function(rocblas_log_sampler::HASH_SEED, xs...));
+}
+
+/*****************************************************************
+ * Log a call as a Chrome trace event. The first argument is the *
+ * function name; the others are formatted as in trace logging.  *
+ *****************************************************************/
+template <typename T>
+inline std::string log_chrome_trace_argument(T&& x)
+{
+    rocblas_internal_ostream os;
+    os << std::forward<T>(x);
+    return os.str();
+}
+
+template <typename H, typename... Ts>
+void log_chrome_trace(rocblas_handle handle, H&& name, Ts&&... xs)
+{
+    rocblas_chrome_trace_event event;
+    event.name   = log_chrome_trace_argument(std::forward<H>(name));
+    event.pid    = rocblas_chrome_trace_event::process_id();
+    event.tid    = rocblas_chrome_trace_event::thread_id();
+    event.stream = log_chrome_trace_argument(handle->get_stream());
+    event.args   = {log_chrome_trace_argument(std::forward<Ts>(xs))...};
+
+    // The event is timed on the stream, and written once the next logged call has started
+    handle->trace_chrome_call(std::move(event));
+}
+
 // if trace logging is turned on with
 // (handle->layer_mode & rocblas_layer_mode_log_trace) != 0
 // log_function will call log_arguments to log arguments with a comma separator
 template <typename... Ts>
 void log_trace(rocblas_handle handle, Ts&&... xs)
 {
-    log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
+    if(!log_sample(handle, rocblas_log_sampler::trace, xs...))
+        return;
+
+    if(handle->layer_mode & rocblas_layer_mode_log_chrome_trace)
+        log_chrome_trace(handle, std::forward<Ts>(xs)..., handle->atomics_mode);
+    else if(handle->layer_mode & rocblas_layer_mode_log_binary)
+        log_binary(rocblas_binary_log_kind_trace, xs..., handle->atomics_mode);
+    else
+        log_arguments(*handle->log_trace_os, ",", std::forward<Ts>(xs)..., handle->atomics_mode);
 }
 
 // if bench logging is turned on with
@@ -181,7 +407,17 @@ void log_trace(rocblas_handle handle, Ts&&... xs)
 template <typename... Ts>
 void log_bench(rocblas_handle handle, Ts&&... xs)
 {
-    if(handle->atomics_mode == rocblas_atomics_not_allowed)
+    if(!log_sample(handle, rocblas_log_sampler::bench, xs...))
+        return;
+
+    if(handle->layer_mode & rocblas_layer_mode_log_binary)
+    {
+        if(handle->atomics_mode == rocblas_atomics_not_allowed)
+            log_binary(rocblas_binary_log_kind_bench, xs..., "--atomics_not_allowed");
+        else
+            log_binary(rocblas_binary_log_kind_bench, xs...);
+    }
+    else if(handle->atomics_mode == rocblas_atomics_not_allowed)
         log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)..., "--atomics_not_allowed");
     else
         log_arguments(*handle->log_bench_os, " ", std::forward<Ts>(xs)...);
@@ -209,21 +445,57 @@ inline T log_trace_scalar_value(const T* value)
                      std::numeric_limits<typename T::value_type>::quiet_NaN()};
 }
 
+// Return a host pointer to a logged scalar, copying it to host if it is on the device
 template <typename T>
-std::string log_trace_scalar_value(rocblas_handle handle, const T* value)
+const T* log_scalar_host_pointer(rocblas_handle handle, const T* value, T& host)
 {
-    rocblas_internal_ostream os;
-    T                        host;
     if(value && handle->pointer_mode == rocblas_pointer_mode_device)
     {
         hipMemcpy(&host, value, sizeof(host), hipMemcpyDeviceToHost);
         value = &host;
     }
-    os << log_trace_scalar_value(value);
+    return value;
+}
+
+template <typename T>
+std::string log_trace_scalar_value(rocblas_handle handle, const T* value)
+{
+    rocblas_internal_ostream os;
+    T                        host;
+    os << log_trace_scalar_value(log_scalar_host_pointer(handle, value, host));
     return os.str();
 }
 
-#define LOG_TRACE_SCALAR_VALUE(handle, value) log_trace_scalar_value(handle, value)
+// The value is only copied from the device and formatted when the argument is
+// output, so that calls which are not logged because of sampling do not pay for it
+template <typename T>
+struct log_trace_scalar
+{
+    rocblas_handle handle;
+    const T*       value;
+
+    friend std::ostream& operator<<(std::ostream& os, const log_trace_scalar& x)
+    {
+        return os << log_trace_scalar_value(x.handle, x.value);
+    }
+
+    // The bits of the value are logged, and formatted by the decoder
+    friend void log_binary_argument(rocblas_binary_log_record& record, const log_trace_scalar& x)
+    {
+        static_assert(log_binary_scalar_type<T>, "scalar type has no binary log encoding");
+        T host;
+        record.put_scalar(log_binary_scalar_type<T>,
+                          log_scalar_host_pointer(x.handle, x.value, host));
+    }
+};
+
+template <typename T>
+inline log_trace_scalar<T> make_log_trace_scalar(rocblas_handle handle, const T* value)
+{
+    return {handle, value};
+}
+
+#define LOG_TRACE_SCALAR_VALUE(handle, value) make_log_trace_scalar(handle, value)
 
 /*************************************************
  * Bench log scalar values pointed to by pointer *
@@ -258,15 +530,40 @@ template <typename T>
 std::string log_bench_scalar_value(rocblas_handle handle, const char* name, const T* value)
 {
     T host;
-    if(value && handle->pointer_mode == rocblas_pointer_mode_device)
+    return log_bench_scalar_value(name, log_scalar_host_pointer(handle, value, host));
+}
+
+// Deferred like LOG_TRACE_SCALAR_VALUE
+template <typename T>
+struct log_bench_scalar
+{
+    rocblas_handle handle;
+    const char*    name;
+    const T*       value;
+
+    friend std::ostream& operator<<(std::ostream& os, const log_bench_scalar& x)
     {
-        hipMemcpy(&host, value, sizeof(host), hipMemcpyDeviceToHost);
-        value = &host;
+        return os << log_bench_scalar_value(x.handle, x.name, x.value);
+    }
+
+    friend void log_binary_argument(rocblas_binary_log_record& record, const log_bench_scalar& x)
+    {
+        static_assert(log_binary_scalar_type<T>, "scalar type has no binary log encoding");
+        T host;
+        record.put_bench_scalar(rocblas_binary_logger::instance().intern(x.name),
+                                log_binary_scalar_type<T>,
+                                log_scalar_host_pointer(x.handle, x.value, host));
     }
-    return log_bench_scalar_value(name, value);
+};
+
+template <typename T>
+inline log_bench_scalar<T>
+    make_log_bench_scalar(rocblas_handle handle, const char* name, const T* value)
+{
+    return {handle, name, value};
 }
 
-#define LOG_BENCH_SCALAR_VALUE(handle, name) log_bench_scalar_value(handle, #name, name)
+#define LOG_BENCH_SCALAR_VALUE(handle, name) make_log_bench_scalar(handle, #name, name)
 
 /******************************************************
  * Bench log precision for mixed precision scal calls *
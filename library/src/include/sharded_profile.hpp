@@ -0,0 +1,294 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Profile logging counts the calls made with each distinct set of           *
+ * arguments, and optionally their GPU latencies. rocblas_sharded_counter    *
+ * keeps the counts of each thread in its own shard, so that threads calling *
+ * rocBLAS concurrently do not contend on a shared table. Shards are merged  *
+ * when the profile is dumped.                                               *
+ *                                                                           *
+ * rocblas_profile_snapshots periodically writes all profiles to a set of    *
+ * rotating files, so that profiles of long-running processes are available *
+ * before they exit.                                                         *
+ *****************************************************************************/
+
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Calls counted for a key, with the latencies of calls which were timed
+struct rocblas_profile_count
+{
+    size_t                                     calls = 0;
+    std::unique_ptr<rocblas_latency_histogram> latency; // nullptr if no calls were timed
+};
+
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class rocblas_sharded_counter
+{
+public:
+    using map_type = std::unordered_map<Key, rocblas_profile_count, Hash, Equal>;
+
+    rocblas_sharded_counter()
+        : m_id(next_id())
+    {
+    }
+
+    rocblas_sharded_counter(const rocblas_sharded_counter&) = delete;
+    rocblas_sharded_counter& operator=(const rocblas_sharded_counter&) = delete;
+
+    // Count a call with key. Only the shard of the calling thread is locked,
+    // which is uncontended except while the counter is being merged. If timed
+    // is true, returns the histogram to which the latency of the call should be
+    // added; it remains valid for the lifetime of the counter.
+    rocblas_latency_histogram* add(Key&& key, bool timed = false)
+    {
+        shard&                      s = local_shard();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        // Look up the key before inserting it, to avoid allocating a node
+        auto p = s.map.find(key);
+        if(p == s.map.end())
+            p = s.map.emplace(std::move(key), rocblas_profile_count{}).first;
+
+        rocblas_profile_count& count = p->second;
+        ++count.calls;
+        if(!timed)
+            return nullptr;
+        if(!count.latency)
+            count.latency = std::make_unique<rocblas_latency_histogram>();
+        return count.latency.get();
+    }
+
+    // Return the counts and latencies of all threads
+    map_type merge() const
+    {
+        map_type                    merged;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(const auto& s : m_shards)
+        {
+            std::lock_guard<std::mutex> shard_lock(s->mutex);
+            for(const auto& p : s->map)
+            {
+                rocblas_profile_count& count = merged[p.first];
+                count.calls += p.second.calls;
+                if(p.second.latency)
+                {
+                    if(!count.latency)
+                        count.latency = std::make_unique<rocblas_latency_histogram>();
+                    count.latency->add(*p.second.latency);
+                }
+            }
+        }
+        return merged;
+    }
+
+    // Number of threads which have added keys
+    size_t shard_count() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_shards.size();
+    }
+
+private:
+    struct shard
+    {
+        std::mutex mutex; // Guards map
+        map_type   map;
+    };
+
+    const uint64_t                      m_id; // Distinguishes counters of the same type
+    mutable std::mutex                  m_mutex; // Guards m_shards
+    std::vector<std::shared_ptr<shard>> m_shards;
+
+    static uint64_t next_id()
+    {
+        static std::atomic<uint64_t> id{0};
+        return ++id;
+    }
+
+    // The shard of the calling thread, created on first use. Threads keep
+    // shards of each counter of this type that they have used.
+    shard& local_shard()
+    {
+        thread_local std::vector<std::pair<uint64_t, std::shared_ptr<shard>>> t_shards;
+        for(auto& p : t_shards)
+            if(p.first == m_id)
+                return *p.second;
+
+        auto s = std::make_shared<shard>();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shards.push_back(s);
+        }
+        t_shards.emplace_back(m_id, s);
+        return *s;
+    }
+};
+
+// A profile which can write a snapshot of itself
+class rocblas_profile_source
+{
+public:
+    virtual void snapshot(std::string& out) const = 0;
+
+protected:
+    ~rocblas_profile_source() = default;
+};
+
+class rocblas_profile_snapshots
+{
+public:
+    // Implemented as singleton to avoid the static initialization order fiasco
+    static rocblas_profile_snapshots& instance()
+    {
+        static rocblas_profile_snapshots snapshots;
+        return snapshots;
+    }
+
+    rocblas_profile_snapshots() = default;
+
+    rocblas_profile_snapshots(const rocblas_profile_snapshots&) = delete;
+    rocblas_profile_snapshots& operator=(const rocblas_profile_snapshots&) = delete;
+
+    ~rocblas_profile_snapshots()
+    {
+        stop();
+    }
+
+    void add(const rocblas_profile_source* source)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sources.push_back(source);
+    }
+
+    void remove(const rocblas_profile_source* source)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sources.erase(std::remove(m_sources.begin(), m_sources.end(), source), m_sources.end());
+    }
+
+    // Start writing snapshots every interval seconds. The newest snapshot is
+    // path.0, and older ones are path.1 to path.(count-1). Returns true if
+    // snapshots are being written, including if they were already started.
+    bool start(const std::string& path, double interval, size_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_thread.joinable())
+            return true;
+        if(path.empty() || !(interval > 0) || !count)
+            return false;
+
+        m_path     = path;
+        m_interval = std::chrono::duration<double>(interval);
+        m_count    = count;
+        m_stop     = false;
+        m_thread   = std::thread([this] { thread_function(); });
+        return true;
+    }
+
+    // Stop writing snapshots. The final profile is written by each profile at exit.
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_thread.joinable() || m_stop)
+                return;
+            m_stop = true;
+        }
+        m_cond.notify_one();
+        m_thread.join();
+    }
+
+private:
+    std::mutex                                 m_mutex; // Guards members below
+    std::vector<const rocblas_profile_source*> m_sources;
+    std::string                                m_path;
+    std::chrono::duration<double>              m_interval{0};
+    size_t                                     m_count = 0;
+    std::thread                                m_thread;
+    std::condition_variable                    m_cond;
+    bool                                       m_stop = false;
+
+    std::string rotated_path(size_t i) const
+    {
+        return m_path + "." + std::to_string(i);
+    }
+
+public:
+    // Write a snapshot of all profiles now, rotating older snapshots
+    void write_now()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_path.empty())
+            write();
+    }
+
+private:
+    // Write a snapshot of all profiles, rotating older snapshots. m_mutex must be held.
+    void write()
+    {
+        std::string out;
+        for(auto source : m_sources)
+            source->snapshot(out);
+
+        // Write to a temporary file, so that readers never see a partial snapshot
+        std::string tmp  = m_path + ".tmp";
+        FILE*       file = fopen(tmp.c_str(), "w");
+        if(!file)
+            return;
+        bool ok = fwrite(out.data(), 1, out.size(), file) == out.size();
+        ok      = !fclose(file) && ok;
+        if(!ok)
+        {
+            ::remove(tmp.c_str());
+            return;
+        }
+
+        for(size_t i = m_count - 1; i > 0; --i)
+            rename(rotated_path(i - 1).c_str(), rotated_path(i).c_str());
+        rename(tmp.c_str(), rotated_path(0).c_str());
+    }
+
+    void thread_function()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(!m_cond.wait_for(lock, m_interval, [this] { return m_stop; }))
+            write();
+    }
+};
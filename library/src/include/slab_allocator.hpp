@@ -0,0 +1,230 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_slab_allocator manages the temporary device memory of a handle.   *
+ *                                                                           *
+ * Memory is held in one or more slabs. Allocations are made with stack      *
+ * (LIFO) semantics, and each slab is a bump allocator whose top is rewound  *
+ * when its most recent allocation is freed. Since allocations are freed in  *
+ * reverse order, nested allocations may be placed in any slab with enough  *
+ * room, so when memory runs out the allocator grows by adding a slab rather *
+ * than freeing and reallocating the existing memory, which would require    *
+ * synchronization and could not be done while memory is in use. Slabs are   *
+ * kept after their allocations are freed, and are reused as a pool. Growth  *
+ * while nothing is in use replaces the slabs with a single larger slab.     *
+ *                                                                           *
+ * The Backend performs the actual allocation of slabs:                      *
+ *   bool Backend::allocate(void** ptr, size_t size)                         *
+ *   bool Backend::deallocate(void* ptr)                                     *
+ * so that the bookkeeping can be tested with host memory.                   *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+template <typename Backend>
+class rocblas_slab_allocator
+{
+public:
+    // A live allocation, returned by allocate() and passed back to deallocate()
+    struct block
+    {
+        size_t slab   = 0;
+        size_t offset = 0;
+        size_t size   = 0;
+
+        bool operator==(const block& other) const
+        {
+            return slab == other.slab && offset == other.offset && size == other.size;
+        }
+    };
+
+    // Slabs added for growth are at least min_slab_size bytes
+    explicit rocblas_slab_allocator(Backend backend = Backend{}, size_t min_slab_size = 0)
+        : m_backend(std::move(backend))
+        , m_min_slab_size(min_slab_size)
+    {
+    }
+
+    rocblas_slab_allocator(const rocblas_slab_allocator&) = delete;
+    rocblas_slab_allocator& operator=(const rocblas_slab_allocator&) = delete;
+
+    // Owned slabs must be released by the owner with release(), since
+    // failures of the backend need to be reported
+    ~rocblas_slab_allocator() = default;
+
+    Backend& backend()
+    {
+        return m_backend;
+    }
+
+    // Allocate size bytes, returning nullptr on failure. If no slab has
+    // enough room and grow is true, a new slab is added.
+    void* allocate(size_t size, block& blk, bool grow)
+    {
+        // Best fit: the slab with the least room which is still enough
+        size_t best = m_slabs.size();
+        for(size_t i = 0; i < m_slabs.size(); ++i)
+        {
+            size_t room = m_slabs[i].size - m_slabs[i].used;
+            if(room >= size
+               && (best == m_slabs.size() || room < m_slabs[best].size - m_slabs[best].used))
+                best = i;
+        }
+
+        if(best == m_slabs.size())
+        {
+            if(!grow)
+                return nullptr;
+
+            // If nothing is in use, the owned slabs are replaced by a single slab
+            // instead of adding to them, so that memory does not fragment
+            if(m_stack.empty()
+               && std::all_of(m_slabs.begin(), m_slabs.end(), [](auto& s) { return s.owned; }))
+                release();
+
+            if(!add_slab(std::max(size, m_min_slab_size)))
+                return nullptr;
+            best = m_slabs.size() - 1;
+        }
+
+        auto& slab = m_slabs[best];
+        blk        = {best, slab.used, size};
+        slab.used += size;
+        m_stack.push_back(blk);
+
+        m_in_use += size;
+        m_high_water_mark = std::max(m_high_water_mark, m_in_use);
+
+        return static_cast<char*>(slab.addr) + blk.offset;
+    }
+
+    // Free an allocation. Returns false if it is not the most recent live
+    // allocation, in which case nothing is freed.
+    bool deallocate(const block& blk)
+    {
+        if(m_stack.empty() || !(m_stack.back() == blk))
+            return false;
+        m_stack.pop_back();
+        m_slabs[blk.slab].used = blk.offset;
+        m_in_use -= blk.size;
+        return true;
+    }
+
+    // Add an owned slab of exactly size bytes
+    bool add_slab(size_t size)
+    {
+        void* addr = nullptr;
+        if(!size || !m_backend.allocate(&addr, size))
+            return false;
+        m_slabs.push_back({addr, size, 0, true});
+        m_max_capacity = std::max(m_max_capacity, capacity());
+        return true;
+    }
+
+    // Add memory which is not owned by the allocator, such as a user-owned workspace
+    void adopt(void* addr, size_t size)
+    {
+        if(addr && size)
+        {
+            m_slabs.push_back({addr, size, 0, false});
+            m_max_capacity = std::max(m_max_capacity, capacity());
+        }
+    }
+
+    // Release all slabs, freeing the owned ones. Memory must not be in use.
+    // Returns false if the backend failed to free a slab.
+    bool release()
+    {
+        if(!m_stack.empty())
+            return false;
+        bool success = true;
+        for(auto& slab : m_slabs)
+            if(slab.owned && !m_backend.deallocate(slab.addr))
+                success = false;
+        m_slabs.clear();
+        return success;
+    }
+
+    // Total number of bytes in all slabs
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for(auto& slab : m_slabs)
+            total += slab.size;
+        return total;
+    }
+
+    // Largest allocation which can be made without growing
+    size_t available() const
+    {
+        size_t room = 0;
+        for(auto& slab : m_slabs)
+            room = std::max(room, slab.size - slab.used);
+        return room;
+    }
+
+    // Number of bytes in live allocations
+    size_t in_use() const
+    {
+        return m_in_use;
+    }
+
+    // Largest number of bytes in live allocations at one time
+    size_t high_water_mark() const
+    {
+        return m_high_water_mark;
+    }
+
+    // Largest capacity at one time
+    size_t max_capacity() const
+    {
+        return m_max_capacity;
+    }
+
+    size_t slab_count() const
+    {
+        return m_slabs.size();
+    }
+
+private:
+    struct slab
+    {
+        void*  addr;
+        size_t size;
+        size_t used;
+        bool   owned;
+    };
+
+    Backend            m_backend;
+    size_t             m_min_slab_size;
+    std::vector<slab>  m_slabs;
+    std::vector<block> m_stack;
+    size_t             m_in_use          = 0;
+    size_t             m_high_water_mark = 0;
+    size_t             m_max_capacity    = 0;
+};
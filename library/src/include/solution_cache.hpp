@@ -0,0 +1,250 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * The solution cache remembers which solution was selected for a GEMM-like  *
+ * contraction problem, so that repeated calls with the same problem shape   *
+ * do not have to evaluate the solution library's predicates again.          *
+ *****************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+/*****************************************************************************
+ * rocblas_solution_cache_key holds every field of a contraction problem     *
+ * from which the Tensile problem is constructed, so that a cache hit can    *
+ * reuse the Tensile problem as well as the selected solution. Pointers are  *
+ * not part of the key. All members are fixed-width integers without         *
+ * padding, so that keys can be compared and hashed bytewise.                *
+ *****************************************************************************/
+struct rocblas_solution_cache_key
+{
+    // Data types are stored as rocblas_datatype values
+    uint32_t a_type;
+    uint32_t c_type;
+    uint32_t compute_type;
+    uint32_t trans_a;
+    uint32_t trans_b;
+    uint32_t flags;
+    uint32_t atomics_mode;
+    uint32_t performance_metric;
+
+    // Scalar categories as computed by value_category(): 0, 1, -1 or 2 (other)
+    int32_t  alpha_category;
+    int32_t  beta_category;
+    uint32_t strided_batch;
+    uint32_t c_equals_d;
+
+    uint64_t m;
+    uint64_t n;
+    uint64_t k;
+    uint64_t batch_count;
+    uint64_t col_stride_a;
+    uint64_t batch_stride_a;
+    uint64_t col_stride_b;
+    uint64_t batch_stride_b;
+    uint64_t col_stride_c;
+    uint64_t batch_stride_c;
+    uint64_t col_stride_d;
+    uint64_t batch_stride_d;
+    uint64_t row_stride_a;
+    uint64_t row_stride_b;
+    uint64_t row_stride_c;
+    uint64_t row_stride_d;
+    uint64_t buffer_offset_a;
+    uint64_t buffer_offset_b;
+    uint64_t buffer_offset_c;
+    uint64_t buffer_offset_d;
+
+    // Workspace available to the solution, which selects GSU variants
+    uint64_t workspace_size;
+
+    bool operator==(const rocblas_solution_cache_key& other) const
+    {
+        return !memcmp(this, &other, sizeof(*this));
+    }
+
+    bool operator!=(const rocblas_solution_cache_key& other) const
+    {
+        return !(*this == other);
+    }
+
+    // FNV-1a hash over the bytes of the key
+    struct hash
+    {
+        size_t operator()(const rocblas_solution_cache_key& key) const
+        {
+            size_t seed = 0xcbf29ce484222325;
+            auto*  p    = reinterpret_cast<const unsigned char*>(&key);
+            for(size_t i = 0; i < sizeof(key); ++i)
+                seed = (seed ^ p[i]) * 0x100000001b3;
+            return seed;
+        }
+    };
+};
+
+static_assert(std::is_trivially_copyable<rocblas_solution_cache_key>{}
+                  && std::has_unique_object_representations_v<rocblas_solution_cache_key>,
+              "rocblas_solution_cache_key must not contain padding");
+
+/*****************************************************************************
+ * rocblas_solution_cache is a bounded, thread-safe LRU map from problem key *
+ * to the solution selected for it. Value must be default constructible and *
+ * contextually convertible to bool; false values (no solution found) are   *
+ * never cached. A capacity of 0 disables caching.                           *
+ *****************************************************************************/
+template <typename Value>
+class rocblas_solution_cache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    explicit rocblas_solution_cache(size_t capacity = DEFAULT_CAPACITY)
+        : m_capacity(capacity)
+    {
+    }
+
+    rocblas_solution_cache(const rocblas_solution_cache&) = delete;
+    rocblas_solution_cache& operator=(const rocblas_solution_cache&) = delete;
+
+    // Return the cached value for key, or call lookup() and cache its result.
+    // lookup() is called without holding the lock, so that a slow selection
+    // does not serialize other threads using the cache.
+    template <typename Lookup>
+    Value find_or_insert(const rocblas_solution_cache_key& key, Lookup&& lookup)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(m_capacity)
+            {
+                auto it = m_map.find(key);
+                if(it != m_map.end())
+                {
+                    // Move the entry to the front of the LRU list
+                    m_lru.splice(m_lru.begin(), m_lru, it->second);
+                    ++m_hits;
+                    return it->second->second;
+                }
+            }
+            ++m_misses;
+        }
+
+        Value value = lookup();
+        if(value)
+            insert(key, value);
+        return value;
+    }
+
+    // Insert or replace the value for key, evicting the least recently used
+    // entry if the cache is full
+    void insert(const rocblas_solution_cache_key& key, const Value& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_capacity)
+            return;
+
+        auto it = m_map.find(key);
+        if(it != m_map.end())
+        {
+            it->second->second = value;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return;
+        }
+
+        while(m_map.size() >= m_capacity)
+        {
+            m_map.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+
+        m_lru.emplace_front(key, value);
+        m_map.emplace(key, m_lru.begin());
+    }
+
+    // Remove all entries; the hit and miss counters are preserved
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_map.clear();
+        m_lru.clear();
+    }
+
+    // Change the capacity, evicting least recently used entries if needed
+    void set_capacity(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        while(m_map.size() > m_capacity)
+        {
+            m_map.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+    }
+
+    size_t capacity() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+    // Get the number of hits, misses and entries in one consistent snapshot
+    void get_stats(size_t* hits, size_t* misses, size_t* entries) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(hits)
+            *hits = m_hits;
+        if(misses)
+            *misses = m_misses;
+        if(entries)
+            *entries = m_map.size();
+    }
+
+    // Apply func(key, value) to each entry, from most to least recently used
+    template <typename FUNC>
+    void for_each(FUNC&& func) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(const auto& entry : m_lru)
+            func(entry.first, entry.second);
+    }
+
+private:
+    using lru_list = std::list<std::pair<rocblas_solution_cache_key, Value>>;
+
+    mutable std::mutex m_mutex;
+    size_t             m_capacity;
+    size_t             m_hits   = 0;
+    size_t             m_misses = 0;
+    lru_list           m_lru;
+    std::unordered_map<rocblas_solution_cache_key,
+                       typename lru_list::iterator,
+                       rocblas_solution_cache_key::hash>
+        m_map;
+};
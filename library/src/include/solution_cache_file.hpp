@@ -0,0 +1,357 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_solution_cache_file persists solution selections across process   *
+ * runs. The file maps (arch, problem key) to the index of the solution in   *
+ * the Tensile library. It is memory-mapped when loaded, and its entries are *
+ * sorted by key so that lookups are a binary search in the mapped file.     *
+ *                                                                           *
+ * The header records the architecture name and a hash identifying the      *
+ * Tensile library and any override file applied to it, and a file whose    *
+ * header does not match is ignored, since solution indices and selections   *
+ * are only meaningful for one library and architecture.                     *
+ *                                                                           *
+ * Like solution_cache.hpp, this header does not reference HIP or Tensile.   *
+ *****************************************************************************/
+
+#include "solution_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class rocblas_solution_cache_file
+{
+public:
+    static constexpr char     MAGIC[8]      = "RBSOLCF";
+    static constexpr uint32_t VERSION       = 1;
+    static constexpr size_t   ARCH_NAME_MAX = 64;
+
+    struct header
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t key_size;
+        uint64_t library_hash;
+        uint64_t count;
+        char     arch[ARCH_NAME_MAX];
+    };
+
+    struct entry
+    {
+        rocblas_solution_cache_key key;
+        int32_t                    solution_index;
+        uint32_t                   reserved;
+    };
+
+    rocblas_solution_cache_file() = default;
+
+    rocblas_solution_cache_file(const rocblas_solution_cache_file&) = delete;
+    rocblas_solution_cache_file& operator=(const rocblas_solution_cache_file&) = delete;
+
+    ~rocblas_solution_cache_file()
+    {
+        unmap();
+    }
+
+    // FNV-1a hash of a file's contents, continuing from seed, used to identify a Tensile
+    // library and its override files. Returns seed if the file cannot be read.
+    static uint64_t hash_file(const std::string& path, uint64_t seed = 0xcbf29ce484222325)
+    {
+        std::ifstream is(path, std::ios::binary);
+        if(!is)
+            return seed;
+
+        std::vector<char> buf(1 << 20);
+        while(is.read(buf.data(), buf.size()) || is.gcount())
+        {
+            for(std::streamsize i = 0; i < is.gcount(); ++i)
+                seed = (seed ^ static_cast<unsigned char>(buf[i])) * 0x100000001b3;
+        }
+        return seed;
+    }
+
+    // Set the identity of the library which solution indices refer to, and
+    // map the file at path if it exists and matches that identity. Returns
+    // whether entries were loaded. The path is remembered for save().
+    bool load(const std::string& path, uint64_t library_hash, const std::string& arch)
+    {
+        unmap();
+        m_path         = path;
+        m_library_hash = library_hash;
+        m_arch         = arch.substr(0, ARCH_NAME_MAX - 1);
+
+#ifdef WIN32
+        std::ifstream is(path, std::ios::binary | std::ios::ate);
+        if(!is)
+            return false;
+        m_buffer.resize(size_t(is.tellg()));
+        is.seekg(0);
+        if(!is.read(m_buffer.data(), m_buffer.size()))
+            return false;
+        const char* addr = m_buffer.data();
+        size_t      size = m_buffer.size();
+#else
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd == -1)
+            return false;
+        struct stat st;
+        void*       addr = MAP_FAILED;
+        size_t      size = 0;
+        if(!fstat(fd, &st) && st.st_size >= off_t(sizeof(header)))
+        {
+            size = size_t(st.st_size);
+            addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if(addr == MAP_FAILED)
+            return false;
+        m_map_addr = addr;
+        m_map_size = size;
+#endif
+
+        auto* hdr = static_cast<const header*>(static_cast<const void*>(addr));
+        if(!matches(hdr, size))
+        {
+            unmap();
+            return false;
+        }
+
+        m_entries = reinterpret_cast<const entry*>(hdr + 1);
+        m_count   = hdr->count;
+        m_loaded.store(true, std::memory_order_release);
+        return true;
+    }
+
+    // Return the solution index recorded for key, or -1 if there is none
+    int32_t find(const rocblas_solution_cache_key& key) const
+    {
+        if(!m_loaded.load(std::memory_order_acquire))
+            return -1;
+        auto* end = m_entries + m_count;
+        auto* it  = std::lower_bound(m_entries, end, key, [](const entry& e, const auto& k) {
+            return memcmp(&e.key, &k, sizeof(k)) < 0;
+        });
+        return it != end && it->key == key ? it->solution_index : -1;
+    }
+
+    // Record a selection made in this process, to be written by save()
+    void record(const rocblas_solution_cache_key& key, int32_t solution_index)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_recorded[key] = solution_index;
+    }
+
+    // Whether there are selections which are not yet in the file
+    bool dirty() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !m_recorded.empty();
+    }
+
+    // Write the recorded entries to the path given to load(), merged with the entries
+    // currently in the file and the loaded entries, in that order of precedence. Saves
+    // of processes sharing the file are serialized by a lock file, so that each keeps
+    // the entries of the others. The file is written to a temporary name unique to the
+    // process and renamed, so that readers never see a partially written file. The
+    // recorded entries are cleared once they are written.
+    bool save()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_path.empty())
+            return false;
+
+        file_lock save_lock(m_path + ".lock");
+
+        // The file may have been replaced by another process since it was loaded
+        std::vector<char> current;
+        {
+            std::ifstream is(m_path, std::ios::binary | std::ios::ate);
+            if(is && is.tellg() > 0)
+            {
+                current.resize(size_t(is.tellg()));
+                is.seekg(0);
+                if(!is.read(current.data(), current.size()))
+                    current.clear();
+            }
+        }
+        const void*  current_addr    = current.data();
+        auto*        current_hdr     = static_cast<const header*>(current_addr);
+        const entry* current_entries = nullptr;
+        size_t       current_count   = 0;
+        if(matches(current_hdr, current.size()))
+        {
+            current_entries = reinterpret_cast<const entry*>(current_hdr + 1);
+            current_count   = current_hdr->count;
+        }
+
+        std::vector<entry> entries;
+        entries.reserve(m_recorded.size() + current_count + m_count);
+        for(const auto& r : m_recorded)
+            entries.push_back({r.first, r.second, 0});
+        entries.insert(entries.end(), current_entries, current_entries + current_count);
+        entries.insert(entries.end(), m_entries, m_entries + m_count);
+
+        // Keep the first of the entries with equal keys
+        std::stable_sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+            return memcmp(&a.key, &b.key, sizeof(a.key)) < 0;
+        });
+        entries.erase(std::unique(entries.begin(),
+                                  entries.end(),
+                                  [](const entry& a, const entry& b) { return a.key == b.key; }),
+                      entries.end());
+
+        header hdr{};
+        memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+        hdr.version      = VERSION;
+        hdr.key_size     = sizeof(rocblas_solution_cache_key);
+        hdr.library_hash = m_library_hash;
+        hdr.count        = entries.size();
+        strncpy(hdr.arch, m_arch.c_str(), ARCH_NAME_MAX - 1);
+
+#ifdef WIN32
+        std::string tmp = m_path + ".tmp" + std::to_string(_getpid());
+#else
+        std::string tmp = m_path + ".tmp" + std::to_string(getpid());
+#endif
+        {
+            std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+            if(!os)
+                return false;
+            os.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+            os.write(reinterpret_cast<const char*>(entries.data()),
+                     entries.size() * sizeof(entry));
+            if(!os)
+            {
+                os.close();
+                std::remove(tmp.c_str());
+                return false;
+            }
+        }
+#ifdef WIN32
+        std::remove(m_path.c_str());
+#endif
+        if(std::rename(tmp.c_str(), m_path.c_str()))
+            return false;
+        m_recorded.clear();
+        return true;
+    }
+
+    size_t size() const
+    {
+        return m_count;
+    }
+
+    const std::string& path() const
+    {
+        return m_path;
+    }
+
+private:
+    // Exclusive lock on a lock file, held for the lifetime of the object. Locking is
+    // best effort: saves proceed unlocked if the lock file cannot be created.
+    class file_lock
+    {
+#ifndef WIN32
+        int m_fd;
+
+    public:
+        explicit file_lock(const std::string& path)
+            : m_fd(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644))
+        {
+            if(m_fd != -1)
+                ::flock(m_fd, LOCK_EX);
+        }
+
+        ~file_lock()
+        {
+            if(m_fd != -1)
+                close(m_fd);
+        }
+#else
+    public:
+        explicit file_lock(const std::string&) {}
+#endif
+        file_lock(const file_lock&) = delete;
+        file_lock& operator=(const file_lock&) = delete;
+    };
+
+    // Whether size bytes at hdr are a complete file for this library and architecture.
+    // Files which are truncated, from another version, or stale do not match.
+    bool matches(const header* hdr, size_t size) const
+    {
+        return size >= sizeof(header) && !memcmp(hdr->magic, MAGIC, sizeof(MAGIC))
+               && hdr->version == VERSION && hdr->key_size == sizeof(rocblas_solution_cache_key)
+               && hdr->library_hash == m_library_hash
+               && !strncmp(hdr->arch, m_arch.c_str(), ARCH_NAME_MAX)
+               && hdr->count <= (size - sizeof(header)) / sizeof(entry);
+    }
+
+    void unmap()
+    {
+        m_loaded.store(false, std::memory_order_release);
+        m_entries = nullptr;
+        m_count   = 0;
+#ifdef WIN32
+        m_buffer.clear();
+#else
+        if(m_map_addr)
+            munmap(m_map_addr, m_map_size);
+        m_map_addr = nullptr;
+        m_map_size = 0;
+#endif
+    }
+
+#ifdef WIN32
+    std::vector<char> m_buffer;
+#else
+    void*  m_map_addr = nullptr;
+    size_t m_map_size = 0;
+#endif
+
+    std::atomic<bool> m_loaded{false};
+    const entry*      m_entries      = nullptr;
+    size_t            m_count        = 0;
+    uint64_t          m_library_hash = 0;
+    std::string       m_path;
+    std::string       m_arch;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<rocblas_solution_cache_key, int32_t, rocblas_solution_cache_key::hash>
+        m_recorded;
+};
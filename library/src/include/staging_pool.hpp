@@ -0,0 +1,276 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * rocblas_staging_pool caches the staging buffers of the auxiliary transfer *
+ * functions, such as rocblas_set_matrix, so that repeated calls reuse them  *
+ * instead of allocating and freeing pinned host or device memory each time.*
+ *                                                                           *
+ * Buffers are rounded up to power-of-two size classes, and a released       *
+ * buffer is kept on the free list of its class, unless the bytes kept by    *
+ * the pool would exceed its cap, in which case it is freed. A cap of 0      *
+ * disables caching. If the backend fails to allocate, the cached buffers    *
+ * are freed and the allocation is retried. The pool is thread-safe; the     *
+ * backend is only called without the lock held.                             *
+ *                                                                           *
+ * The Backend performs the actual allocation of buffers:                    *
+ *   bool Backend::allocate(void** ptr, size_t size)                         *
+ *   bool Backend::deallocate(void* ptr)                                     *
+ * so that the bookkeeping can be tested with host memory.                   *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+template <typename Backend>
+class rocblas_staging_pool
+{
+public:
+    // The smallest size class, so that small tiles share buffers
+    static constexpr size_t MIN_CLASS_BYTES = 4096;
+
+    struct stats
+    {
+        size_t hits         = 0; // Acquisitions served from a free list
+        size_t misses       = 0; // Acquisitions which allocated from the backend
+        size_t frees        = 0; // Buffers freed because of the cap, trim() or failures
+        size_t cached_bytes = 0; // Bytes in free lists
+        size_t in_use_bytes = 0; // Bytes in acquired buffers
+        size_t peak_bytes   = 0; // Largest cached_bytes + in_use_bytes at one time
+    };
+
+    // A buffer acquired from the pool, which is released when destroyed
+    class buffer
+    {
+    public:
+        buffer() = default;
+
+        buffer(buffer&& other) noexcept
+            : m_pool(std::exchange(other.m_pool, nullptr))
+            , m_ptr(std::exchange(other.m_ptr, nullptr))
+            , m_size(other.m_size)
+        {
+        }
+
+        buffer& operator=(buffer&& other) noexcept
+        {
+            if(this != &other)
+            {
+                reset();
+                m_pool = std::exchange(other.m_pool, nullptr);
+                m_ptr  = std::exchange(other.m_ptr, nullptr);
+                m_size = other.m_size;
+            }
+            return *this;
+        }
+
+        ~buffer()
+        {
+            reset();
+        }
+
+        void reset()
+        {
+            if(m_ptr)
+                m_pool->release(m_ptr, m_size);
+            m_ptr = nullptr;
+        }
+
+        void* get() const
+        {
+            return m_ptr;
+        }
+
+        // Usable size, which is the size of the buffer's class
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        explicit operator bool() const
+        {
+            return m_ptr != nullptr;
+        }
+
+    private:
+        friend class rocblas_staging_pool;
+
+        buffer(rocblas_staging_pool* pool, void* ptr, size_t size)
+            : m_pool(pool)
+            , m_ptr(ptr)
+            , m_size(size)
+        {
+        }
+
+        rocblas_staging_pool* m_pool = nullptr;
+        void*                 m_ptr  = nullptr;
+        size_t                m_size = 0;
+    };
+
+    explicit rocblas_staging_pool(size_t cap, Backend backend = Backend{})
+        : m_backend(std::move(backend))
+        , m_cap(cap)
+    {
+    }
+
+    rocblas_staging_pool(const rocblas_staging_pool&) = delete;
+    rocblas_staging_pool& operator=(const rocblas_staging_pool&) = delete;
+
+    // Buffers must have been released
+    ~rocblas_staging_pool()
+    {
+        trim();
+    }
+
+    // Size class of a request
+    static size_t class_size(size_t size)
+    {
+        size_t bytes = MIN_CLASS_BYTES;
+        while(bytes < size)
+            bytes *= 2;
+        return bytes;
+    }
+
+    // Acquire a buffer of at least size bytes; the buffer is empty if the
+    // backend cannot allocate it
+    buffer acquire(size_t size)
+    {
+        size_t bytes = class_size(size);
+        int    c     = class_index(bytes);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_free[c].empty())
+            {
+                void* ptr = m_free[c].back();
+                m_free[c].pop_back();
+                m_stats.cached_bytes -= bytes;
+                m_stats.in_use_bytes += bytes;
+                ++m_stats.hits;
+                return {this, ptr, bytes};
+            }
+            ++m_stats.misses;
+        }
+
+        // Allocate without holding the lock, freeing the cached buffers and
+        // retrying if the backend fails
+        void* ptr = nullptr;
+        if(!m_backend.allocate(&ptr, bytes))
+        {
+            trim();
+            if(!m_backend.allocate(&ptr, bytes))
+                return {};
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.in_use_bytes += bytes;
+        m_stats.peak_bytes
+            = std::max(m_stats.peak_bytes, m_stats.in_use_bytes + m_stats.cached_bytes);
+        return {this, ptr, bytes};
+    }
+
+    // Free all cached buffers
+    void trim()
+    {
+        std::vector<void*> freed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for(auto& list : m_free)
+            {
+                freed.insert(freed.end(), list.begin(), list.end());
+                list.clear();
+            }
+            m_stats.cached_bytes = 0;
+            m_stats.frees += freed.size();
+        }
+        for(void* ptr : freed)
+            m_backend.deallocate(ptr);
+    }
+
+    // Change the cap, freeing cached buffers if the pool holds more than the new cap
+    void set_cap(size_t cap)
+    {
+        bool over;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cap = cap;
+            over  = m_stats.cached_bytes > cap;
+        }
+        if(over)
+            trim();
+    }
+
+    size_t cap() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cap;
+    }
+
+    stats get_stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    Backend& backend()
+    {
+        return m_backend;
+    }
+
+private:
+    static constexpr int NUM_CLASSES = 64;
+
+    static int class_index(size_t bytes)
+    {
+        int c = 0;
+        while((MIN_CLASS_BYTES << c) < bytes)
+            ++c;
+        return c;
+    }
+
+    // Return a buffer to its free list, or free it if the pool would exceed its cap
+    void release(void* ptr, size_t bytes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.in_use_bytes -= bytes;
+            if(m_stats.cached_bytes + bytes <= m_cap)
+            {
+                m_free[class_index(bytes)].push_back(ptr);
+                m_stats.cached_bytes += bytes;
+                return;
+            }
+            ++m_stats.frees;
+        }
+        m_backend.deallocate(ptr);
+    }
+
+    Backend            m_backend;
+    mutable std::mutex m_mutex;
+    size_t             m_cap;
+    stats              m_stats;
+    std::vector<void*> m_free[NUM_CLASSES];
+};
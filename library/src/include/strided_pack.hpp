@@ -0,0 +1,382 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Host packing of strided data for the transfer functions, such as          *
+ * rocblas_set_vector and rocblas_set_matrix.                                *
+ *                                                                           *
+ * rocblas_pack_columns gathers cols columns of col_bytes bytes each, spaced *
+ * ld_bytes apart, into a contiguous buffer; rocblas_unpack_columns scatters *
+ * them back. Vectors with non-unit increments are matrices with one row,   *
+ * so their columns are single elements. Elements of 2, 4, 8 and 16 bytes   *
+ * (half, float, double and double complex) are copied with fixed-size      *
+ * loads and stores instead of a memcpy of runtime size, and 4 and 8 byte    *
+ * elements are gathered with AVX2 when the CPU supports it. Large packs are *
+ * split across a pool of threads.                                           *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(__HIP_DEVICE_COMPILE__)
+#define ROCBLAS_PACK_AVX2 1
+#include <immintrin.h>
+#else
+#define ROCBLAS_PACK_AVX2 0
+#endif
+
+/*****************************************************************************
+ * rocblas_pack_thread_pool runs the tasks of a parallel pack on a fixed set *
+ * of worker threads, with the calling thread taking part. One pack runs at  *
+ * a time; a pack started while the pool is busy runs on its calling thread *
+ * alone. ROCBLAS_PACK_THREADS sets the number of threads, including the     *
+ * caller (default: the number of hardware threads, at most 8; 1 disables    *
+ * the workers).                                                             *
+ *****************************************************************************/
+class rocblas_pack_thread_pool
+{
+public:
+    static constexpr size_t MAX_DEFAULT_THREADS = 8;
+
+    explicit rocblas_pack_thread_pool(size_t threads)
+    {
+        for(size_t i = 1; i < threads; ++i)
+            m_workers.emplace_back([this] { work(); });
+    }
+
+    ~rocblas_pack_thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for(auto& worker : m_workers)
+            worker.join();
+    }
+
+    rocblas_pack_thread_pool(const rocblas_pack_thread_pool&) = delete;
+    rocblas_pack_thread_pool& operator=(const rocblas_pack_thread_pool&) = delete;
+
+    static rocblas_pack_thread_pool& instance()
+    {
+        static rocblas_pack_thread_pool pool(default_threads());
+        return pool;
+    }
+
+    static size_t default_threads()
+    {
+        const char* env = getenv("ROCBLAS_PACK_THREADS");
+        if(env)
+            return std::max<size_t>(strtoul(env, nullptr, 0), 1);
+        return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_DEFAULT_THREADS);
+    }
+
+    // Number of threads which run tasks, including the caller
+    size_t threads() const
+    {
+        return m_workers.size() + 1;
+    }
+
+    // Run task(0) ... task(count - 1), returning when all have completed
+    void run(size_t count, const std::function<void(size_t)>& task)
+    {
+        std::unique_lock<std::mutex> busy(m_busy, std::try_to_lock);
+        if(!busy || m_workers.empty() || count < 2)
+        {
+            for(size_t i = 0; i < count; ++i)
+                task(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task    = &task;
+            m_count   = count;
+            m_pending = count;
+            m_next    = 0;
+            ++m_generation;
+        }
+        m_start.notify_all();
+
+        run_tasks();
+
+        // Wait for the tasks, and for the workers to stop using this pack
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return m_pending == 0 && m_active == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    // Claim and run tasks of the current pack until none are left
+    void run_tasks()
+    {
+        for(size_t i; (i = m_next++) < m_count;)
+        {
+            (*m_task)(i);
+            if(--m_pending == 0)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done.notify_all();
+            }
+        }
+    }
+
+    void work()
+    {
+        size_t                       generation = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+            if(m_stop)
+                return;
+            generation = m_generation;
+
+            // A pack which has already completed is skipped
+            if(!m_task)
+                continue;
+
+            ++m_active;
+            lock.unlock();
+            run_tasks();
+            lock.lock();
+            if(--m_active == 0)
+                m_done.notify_all();
+        }
+    }
+
+    std::vector<std::thread>           m_workers;
+    std::mutex                         m_busy;
+    std::mutex                         m_mutex;
+    std::condition_variable            m_start;
+    std::condition_variable            m_done;
+    const std::function<void(size_t)>* m_task       = nullptr;
+    size_t                             m_count      = 0;
+    size_t                             m_generation = 0;
+    size_t                             m_active     = 0;
+    std::atomic<size_t>                m_next{0};
+    std::atomic<size_t>                m_pending{0};
+    bool                               m_stop = false;
+};
+
+/*****************************************************************************
+ * Serial gathers and scatters of n elements of type T, spaced stride bytes  *
+ * apart. Elements are copied with memcpy of a constant size, which compiles *
+ * to a single load or store and allows unaligned data.                      *
+ *****************************************************************************/
+struct rocblas_pack_16_bytes
+{
+    uint64_t x[2];
+};
+
+template <typename T>
+inline void rocblas_gather_elements(char* dst, const char* src, size_t n, size_t stride)
+{
+    for(size_t i = 0; i < n; ++i)
+        memcpy(dst + i * sizeof(T), src + i * stride, sizeof(T));
+}
+
+template <typename T>
+inline void rocblas_scatter_elements(char* dst, size_t stride, const char* src, size_t n)
+{
+    for(size_t i = 0; i < n; ++i)
+        memcpy(dst + i * stride, src + i * sizeof(T), sizeof(T));
+}
+
+#if ROCBLAS_PACK_AVX2
+inline bool rocblas_pack_has_avx2()
+{
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+// Gather 4 elements at a time with 64-bit byte offsets
+__attribute__((target("avx2"))) inline void
+    rocblas_gather_avx2_4(char* dst, const char* src, size_t n, size_t stride)
+{
+    const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+    size_t        i       = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm256_i64gather_epi32((const int*)(src + i * stride), offsets, 1);
+        _mm_storeu_si128((__m128i*)(dst + i * 4), x);
+    }
+    rocblas_gather_elements<uint32_t>(dst + i * 4, src + i * stride, n - i, stride);
+}
+
+__attribute__((target("avx2"))) inline void
+    rocblas_gather_avx2_8(char* dst, const char* src, size_t n, size_t stride)
+{
+    const __m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+    size_t        i       = 0;
+    for(; i + 4 <= n; i += 4)
+    {
+        __m256i x = _mm256_i64gather_epi64((const long long*)(src + i * stride), offsets, 1);
+        _mm256_storeu_si256((__m256i*)(dst + i * 8), x);
+    }
+    rocblas_gather_elements<uint64_t>(dst + i * 8, src + i * stride, n - i, stride);
+}
+#endif
+
+// Serial pack of cols columns, choosing the copy by column size
+inline void rocblas_pack_columns_serial(
+    void* t, const void* a, size_t col_bytes, size_t cols, size_t lda_bytes)
+{
+    char*       dst = static_cast<char*>(t);
+    const char* src = static_cast<const char*>(a);
+    if(lda_bytes == col_bytes)
+        memcpy(dst, src, col_bytes * cols);
+    else
+        switch(col_bytes)
+        {
+        case 2:
+            rocblas_gather_elements<uint16_t>(dst, src, cols, lda_bytes);
+            break;
+        case 4:
+#if ROCBLAS_PACK_AVX2
+            if(rocblas_pack_has_avx2())
+                rocblas_gather_avx2_4(dst, src, cols, lda_bytes);
+            else
+#endif
+                rocblas_gather_elements<uint32_t>(dst, src, cols, lda_bytes);
+            break;
+        case 8:
+#if ROCBLAS_PACK_AVX2
+            if(rocblas_pack_has_avx2())
+                rocblas_gather_avx2_8(dst, src, cols, lda_bytes);
+            else
+#endif
+                rocblas_gather_elements<uint64_t>(dst, src, cols, lda_bytes);
+            break;
+        case 16:
+            rocblas_gather_elements<rocblas_pack_16_bytes>(dst, src, cols, lda_bytes);
+            break;
+        default:
+            for(size_t j = 0; j < cols; j++)
+                memcpy(dst + j * col_bytes, src + j * lda_bytes, col_bytes);
+        }
+}
+
+inline void rocblas_unpack_columns_serial(
+    void* b, size_t ldb_bytes, const void* t, size_t col_bytes, size_t cols)
+{
+    char*       dst = static_cast<char*>(b);
+    const char* src = static_cast<const char*>(t);
+    if(ldb_bytes == col_bytes)
+        memcpy(dst, src, col_bytes * cols);
+    else
+        switch(col_bytes)
+        {
+        case 2:
+            rocblas_scatter_elements<uint16_t>(dst, ldb_bytes, src, cols);
+            break;
+        case 4:
+            rocblas_scatter_elements<uint32_t>(dst, ldb_bytes, src, cols);
+            break;
+        case 8:
+            rocblas_scatter_elements<uint64_t>(dst, ldb_bytes, src, cols);
+            break;
+        case 16:
+            rocblas_scatter_elements<rocblas_pack_16_bytes>(dst, ldb_bytes, src, cols);
+            break;
+        default:
+            for(size_t j = 0; j < cols; j++)
+                memcpy(dst + j * ldb_bytes, src + j * col_bytes, col_bytes);
+        }
+}
+
+/*****************************************************************************
+ * Parallel packs. Packs of at least PACK_PARALLEL_MIN_BYTES are split into  *
+ * one range of columns per thread, each of at least PACK_TASK_MIN_BYTES.    *
+ *****************************************************************************/
+constexpr size_t PACK_PARALLEL_MIN_BYTES = 1 << 20;
+constexpr size_t PACK_TASK_MIN_BYTES     = 256 << 10;
+
+template <typename PACK>
+inline void rocblas_pack_parallel(size_t                    col_bytes,
+                                  size_t                    cols,
+                                  rocblas_pack_thread_pool& pool,
+                                  PACK&&                    pack)
+{
+    size_t bytes = col_bytes * cols;
+    size_t tasks = 1;
+    if(bytes >= PACK_PARALLEL_MIN_BYTES)
+        tasks = std::min({pool.threads(), bytes / PACK_TASK_MIN_BYTES, cols});
+
+    if(tasks <= 1)
+        pack(0, cols);
+    else
+        pool.run(tasks, [&](size_t task) {
+            size_t begin = cols * task / tasks;
+            size_t end   = cols * (task + 1) / tasks;
+            pack(begin, end - begin);
+        });
+}
+
+// Copy cols columns of col_bytes bytes each, between a matrix with leading
+// dimension ld_bytes bytes on the host and a contiguous buffer
+inline void rocblas_pack_columns(void*                     t,
+                                 const void*               a,
+                                 size_t                    col_bytes,
+                                 size_t                    cols,
+                                 size_t                    lda_bytes,
+                                 rocblas_pack_thread_pool& pool
+                                 = rocblas_pack_thread_pool::instance())
+{
+    rocblas_pack_parallel(col_bytes, cols, pool, [&](size_t j, size_t n) {
+        rocblas_pack_columns_serial(static_cast<char*>(t) + j * col_bytes,
+                                    static_cast<const char*>(a) + j * lda_bytes,
+                                    col_bytes,
+                                    n,
+                                    lda_bytes);
+    });
+}
+
+inline void rocblas_unpack_columns(void*                     b,
+                                   size_t                    ldb_bytes,
+                                   const void*               t,
+                                   size_t                    col_bytes,
+                                   size_t                    cols,
+                                   rocblas_pack_thread_pool& pool
+                                   = rocblas_pack_thread_pool::instance())
+{
+    rocblas_pack_parallel(col_bytes, cols, pool, [&](size_t j, size_t n) {
+        rocblas_unpack_columns_serial(static_cast<char*>(b) + j * ldb_bytes,
+                                      ldb_bytes,
+                                      static_cast<const char*>(t) + j * col_bytes,
+                                      col_bytes,
+                                      n);
+    });
+}
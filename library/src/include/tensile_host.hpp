@@ -50,6 +50,7 @@ typedef enum
 {
     CAN_SOLVE,
     MATCHES_TYPE,
+    COVERAGE, // list_array[0] receives the rocblas_gemm_coverage of the selected solution
 } rocblas_tensile_get_solution_option;
 
 /********************************************************************
@@ -328,6 +329,11 @@ rocblas_status getAllSolutions(const RocblasContractionProblem<Ti, To, Tc>& prob
  ***********************************************************************************/
 ROCBLAS_INTERNAL_EXPORT std::atomic_bool& rocblas_internal_tensile_is_initialized();
 
+/***********************************************************************************
+ * Write the persisted solution selections made since they were last saved         *
+ ***********************************************************************************/
+void rocblas_save_persistent_solution_caches();
+
 /***********************************************************************************
  * Whether rocblas_initialize() is invoked to load all tensile kernels at startup  *
  ***********************************************************************************/
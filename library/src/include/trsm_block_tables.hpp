@@ -0,0 +1,260 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Block size tables of the blocked trsm implementation                      *
+ *                                                                           *
+ * rocblas_trsm_blksize selects the block size of the substitution method    *
+ * from a table indexed by intervals of the two dimensions of the problem.   *
+ * The compiled tables can be replaced per GPU architecture by a data file   *
+ * named by ROCBLAS_TRSM_BLOCK_TABLES, which is read for a device when the   *
+ * first handle on it is created. The file is a sequence of tokens separated *
+ * by whitespace, where # starts a comment which extends to the end of line: *
+ *                                                                           *
+ *   rocblas_trsm_block_tables 1                                             *
+ *   arch gfx90a                                                             *
+ *   table real_batched                                                      *
+ *   rows 20 28 40                                                           *
+ *   cols 6 10                                                               *
+ *   blksizes 1 1 1  16 16 16  24 24 16  64 32 32                            *
+ *                                                                           *
+ * The first line names the format and its version. Each table of an arch   *
+ * section lists the upper bounds of the row and column intervals, and the   *
+ * (rows + 1) x (cols + 1) block sizes in row-major order. Tables which are  *
+ * not given for an arch keep their compiled values.                         *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Version of the data file format written by rocblas_trsm_block_tables_write
+constexpr int ROCBLAS_TRSM_BLOCK_TABLES_VERSION = 1;
+
+struct rocblas_trsm_block_table
+{
+    // Ascending upper bounds of the intervals of the rows and the columns
+    std::vector<int> row_intervals;
+    std::vector<int> col_intervals;
+
+    // (row_intervals.size() + 1) x (col_intervals.size() + 1) block sizes in row-major
+    // order. A block size of 1 selects min(m, 512), and 0 disables the substitution method.
+    // The substitution kernels run blocks of NBX x (1024 / NBX) threads, so NBX is at most 512.
+    std::vector<int> blksizes;
+
+    // Index of the first interval whose upper bound is not below dim, or the number of
+    // bounds if dim is above all of them
+    static size_t interval(const std::vector<int>& bounds, int dim)
+    {
+        return std::lower_bound(bounds.begin(), bounds.end(), dim) - bounds.begin();
+    }
+
+    int lookup(int m, int n) const
+    {
+        return blksizes[interval(row_intervals, m) * (col_intervals.size() + 1)
+                        + interval(col_intervals, n)];
+    }
+
+    // Check the shape of the table and the ordering of its bounds, setting error if invalid
+    bool valid(std::string& error) const
+    {
+        auto ascending = [](const std::vector<int>& bounds) {
+            return std::adjacent_find(bounds.begin(), bounds.end(), std::greater_equal<>{})
+                   == bounds.end();
+        };
+
+        if(blksizes.size() != (row_intervals.size() + 1) * (col_intervals.size() + 1))
+            error = "expected (rows + 1) x (cols + 1) block sizes";
+        else if(!ascending(row_intervals) || !ascending(col_intervals))
+            error = "interval bounds are not ascending";
+        else if(std::any_of(blksizes.begin(), blksizes.end(), [](int blk) {
+                    return blk < 0 || blk > 512;
+                }))
+            error = "block size outside 0 to 512";
+        else
+            return true;
+        return false;
+    }
+};
+
+struct rocblas_trsm_block_tables
+{
+    // Tables for real and complex types, for non-batched and batched problems
+    enum kind
+    {
+        real,
+        real_batched,
+        complex,
+        complex_batched,
+        kinds
+    };
+
+    static constexpr const char* names[kinds]
+        = {"real", "real_batched", "complex", "complex_batched"};
+
+    rocblas_trsm_block_table tables[kinds];
+
+    const rocblas_trsm_block_table& get(bool is_complex, bool batched) const
+    {
+        return tables[(is_complex ? complex : real) + batched];
+    }
+
+    // Kind of the table with the given name, or kinds if there is none
+    static int find(const std::string& name)
+    {
+        return std::find(std::begin(names), std::end(names), name) - std::begin(names);
+    }
+};
+
+/*****************************************************************************
+ * Replace tables with the tables given for arch in the data file read from  *
+ * in. Returns the number of tables replaced, or -1 with a message in error  *
+ * if the file is malformed, in which case tables is unchanged.              *
+ *****************************************************************************/
+inline int rocblas_trsm_block_tables_parse(std::istream&              in,
+                                           const std::string&         arch,
+                                           rocblas_trsm_block_tables& tables,
+                                           std::string&               error)
+{
+    // Split the file into tokens, dropping comments
+    std::vector<std::string> tokens;
+    for(std::string line; std::getline(in, line);)
+    {
+        std::istringstream words(line.substr(0, line.find('#')));
+        for(std::string word; words >> word;)
+            tokens.push_back(word);
+    }
+
+    auto is_int = [](const std::string& token) {
+        char* end;
+        strtol(token.c_str(), &end, 10);
+        return !token.empty() && !*end;
+    };
+
+    size_t pos  = 0;
+    auto   ints = [&](std::vector<int>& values) {
+        values.clear();
+        while(pos < tokens.size() && is_int(tokens[pos]))
+            values.push_back(atoi(tokens[pos++].c_str()));
+    };
+
+    if(tokens.size() < 2 || tokens[0] != "rocblas_trsm_block_tables")
+    {
+        error = "not a rocblas_trsm_block_tables file";
+        return -1;
+    }
+    if(tokens[1] != std::to_string(ROCBLAS_TRSM_BLOCK_TABLES_VERSION))
+    {
+        error = "unsupported version " + tokens[1];
+        return -1;
+    }
+
+    rocblas_trsm_block_tables parsed   = tables;
+    int                       replaced = 0;
+    bool                      selected = false;
+    for(pos = 2; pos < tokens.size();)
+    {
+        const std::string& keyword = tokens[pos++];
+        if(keyword == "arch" && pos < tokens.size())
+        {
+            selected = tokens[pos++] == arch;
+        }
+        else if(keyword == "table" && pos < tokens.size())
+        {
+            const std::string& name = tokens[pos++];
+            int                kind = rocblas_trsm_block_tables::find(name);
+            if(kind == rocblas_trsm_block_tables::kinds)
+            {
+                error = "unknown table " + name;
+                return -1;
+            }
+
+            rocblas_trsm_block_table table;
+            for(auto [field, values] : {std::make_pair("rows", &table.row_intervals),
+                                        std::make_pair("cols", &table.col_intervals),
+                                        std::make_pair("blksizes", &table.blksizes)})
+            {
+                if(pos >= tokens.size() || tokens[pos] != field)
+                {
+                    error = "expected " + std::string(field) + " in table " + name;
+                    return -1;
+                }
+                pos++;
+                ints(*values);
+            }
+            if(!table.valid(error))
+            {
+                error = "table " + name + ": " + error;
+                return -1;
+            }
+            if(selected)
+            {
+                parsed.tables[kind] = std::move(table);
+                replaced++;
+            }
+        }
+        else
+        {
+            error = "unexpected " + keyword;
+            return -1;
+        }
+    }
+
+    tables = std::move(parsed);
+    return replaced;
+}
+
+// Write all tables as the section of arch of a data file
+inline void rocblas_trsm_block_tables_write(std::ostream&                    out,
+                                            const std::string&               arch,
+                                            const rocblas_trsm_block_tables& tables)
+{
+    out << "rocblas_trsm_block_tables " << ROCBLAS_TRSM_BLOCK_TABLES_VERSION << "\narch " << arch
+        << "\n";
+    for(int kind = 0; kind < rocblas_trsm_block_tables::kinds; kind++)
+    {
+        const rocblas_trsm_block_table& table = tables.tables[kind];
+        out << "\ntable " << rocblas_trsm_block_tables::names[kind] << "\nrows";
+        for(int bound : table.row_intervals)
+            out << ' ' << bound;
+        out << "\ncols";
+        for(int bound : table.col_intervals)
+            out << ' ' << bound;
+        out << "\nblksizes";
+        size_t cols = table.col_intervals.size() + 1;
+        for(size_t i = 0; i < table.blksizes.size(); i++)
+            out << (i % cols ? " " : "\n") << table.blksizes[i];
+        out << "\n";
+    }
+}
+
+// Tables of the current device: those compiled into the library, with the tables given for
+// the architecture of the device in the file named by ROCBLAS_TRSM_BLOCK_TABLES
+const rocblas_trsm_block_tables& rocblas_internal_trsm_block_tables();
@@ -0,0 +1,192 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+
+/*****************************************************************************
+ * Workspace planning computes the device memory needed by each call in a    *
+ * recorded sequence of rocBLAS calls, without executing them. Calls are     *
+ * given as rocblas-bench command lines, as printed when the layer mode      *
+ * includes rocblas_layer_mode_log_bench.                                    *
+ *                                                                           *
+ * The workspace of each call is obtained from a rocblas_workspace_query.    *
+ * The library's query runs the call in device memory size query mode on a   *
+ * handle, where GEMM based calls ask Tensile for their workspace, so it     *
+ * needs a device. Host tests plan with a stubbed query and no device.       *
+ *****************************************************************************/
+
+#include "rocblas.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+
+/*****************************************************************************
+ * rocblas_bench_call holds the function, precision and options of one       *
+ * rocblas-bench command line. Options are stored without their leading      *
+ * dashes, so "--lda 64" is found as get_int("lda").                         *
+ *****************************************************************************/
+class rocblas_bench_call
+{
+public:
+    // Parse a rocblas-bench command line, returning false if it is not one.
+    // Anything before the rocblas-bench command, such as a log prefix, is ignored.
+    bool parse(const std::string& line)
+    {
+        m_function.clear();
+        m_precision.clear();
+        m_args.clear();
+
+        std::istringstream is(line);
+        std::string        token;
+        bool               found = false;
+        while(!found && is >> token)
+            found = token.size() >= 13
+                    && token.compare(token.size() - 13, 13, "rocblas-bench") == 0;
+        if(!found)
+            return false;
+
+        std::string option;
+        while(is >> token)
+        {
+            if(is_option(token))
+            {
+                // An option without a value, such as a flag, is stored as "1"
+                if(!option.empty())
+                    m_args[option] = "1";
+                option = token.substr(token.find_first_not_of('-'));
+            }
+            else if(!option.empty())
+            {
+                m_args[option] = token;
+                option.clear();
+            }
+        }
+        if(!option.empty())
+            m_args[option] = "1";
+
+        auto f = m_args.find("f");
+        auto r = m_args.find("r");
+        if(f != m_args.end())
+            m_function = f->second;
+        if(r != m_args.end())
+            m_precision = r->second;
+        return !m_function.empty();
+    }
+
+    const std::string& function() const
+    {
+        return m_function;
+    }
+
+    // The precision given with -r, such as "f32_r"
+    const std::string& precision() const
+    {
+        return m_precision;
+    }
+
+    bool has(const std::string& option) const
+    {
+        return m_args.count(option) != 0;
+    }
+
+    int64_t get_int(const std::string& option, int64_t default_value = 0) const
+    {
+        auto it = m_args.find(option);
+        return it == m_args.end() ? default_value : strtoll(it->second.c_str(), nullptr, 10);
+    }
+
+    double get_double(const std::string& option, double default_value = 0) const
+    {
+        auto it = m_args.find(option);
+        return it == m_args.end() ? default_value : strtod(it->second.c_str(), nullptr);
+    }
+
+    // The first character of an option's value, such as 'N' for --transposeA N
+    char get_char(const std::string& option, char default_value) const
+    {
+        auto it = m_args.find(option);
+        return it == m_args.end() || it->second.empty() ? default_value : it->second[0];
+    }
+
+private:
+    // Options start with a dash, but negative numbers such as "--incx -1" are values
+    static bool is_option(const std::string& token)
+    {
+        return token.size() > 1 && token[0] == '-'
+               && !(isdigit(static_cast<unsigned char>(token[1])) || token[1] == '.');
+    }
+
+    std::string                        m_function;
+    std::string                        m_precision;
+    std::map<std::string, std::string> m_args;
+};
+
+/*****************************************************************************
+ * rocblas_workspace_query is the source of the workspace of planned calls.  *
+ * workspace(call, size) sets size to the device memory needed by call,      *
+ * returning rocblas_status_success or an error, which stops planning.       *
+ *****************************************************************************/
+class rocblas_workspace_query
+{
+public:
+    virtual ~rocblas_workspace_query() = default;
+
+    virtual rocblas_status workspace(const rocblas_bench_call& call, size_t& size) = 0;
+};
+
+/*****************************************************************************
+ * Plan the workspace of a sequence of count calls with query. Each call's   *
+ * workspace is stored in step_sizes (if not nullptr), and the largest of    *
+ * them in peak, which is enough for all of the calls when they run in order *
+ * on one stream.                                                            *
+ *****************************************************************************/
+inline rocblas_status rocblas_plan_workspace_sequence(size_t                   count,
+                                                      const char* const*       calls,
+                                                      rocblas_workspace_query& query,
+                                                      size_t*                  step_sizes,
+                                                      size_t*                  peak)
+{
+    if((count && !calls) || !peak)
+        return rocblas_status_invalid_pointer;
+
+    *peak = 0;
+    for(size_t i = 0; i < count; ++i)
+    {
+        rocblas_bench_call call;
+        if(!calls[i] || !call.parse(calls[i]))
+            return rocblas_status_invalid_value;
+
+        size_t         size   = 0;
+        rocblas_status status = query.workspace(call, size);
+        if(status != rocblas_status_success)
+            return status;
+
+        if(step_sizes)
+            step_sizes[i] = size;
+        *peak = std::max(*peak, size);
+    }
+    return rocblas_status_success;
+}
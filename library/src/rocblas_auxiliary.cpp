@@ -23,10 +23,17 @@
 #include "handle.hpp"
 #include "logging.hpp"
 #include "rocblas-auxiliary.h"
+#include "staging_pool.hpp"
+#include "strided_pack.hpp"
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <vector>
 
 /* ============================================================================================ */
 
@@ -223,9 +230,7 @@ catch(...)
  *! \brief  Non-unit stride vector copy on device. Vectors are void pointers
      with element size elem_size
  ******************************************************************************/
-// arbitrarily assign max buffer size to 1Mb
-constexpr size_t      VEC_BUFF_MAX_BYTES = 1048576;
-constexpr rocblas_int NB_X               = 256;
+constexpr rocblas_int NB_X = 256;
 
 template <rocblas_int NB>
 ROCBLAS_KERNEL(NB)
@@ -244,29 +249,684 @@ rocblas_copy_void_ptr_vector_kernel(rocblas_int n,
     }
 }
 
-/* ============================================================================================ */
-// TODO: Need to replace this with new device memory allocation system
+/*******************************************************************************
+ *! \brief  Matrix copy on device. Matrices are void pointers with element
+     size elem_size
+ ******************************************************************************/
+constexpr rocblas_int MATRIX_DIM_X = 128;
+constexpr rocblas_int MATRIX_DIM_Y = 8;
+
+template <rocblas_int DIM_X, rocblas_int DIM_Y>
+ROCBLAS_KERNEL(DIM_X* DIM_Y)
+rocblas_copy_void_ptr_matrix_kernel(rocblas_int rows,
+                                    rocblas_int cols,
+                                    size_t      elem_size_u64,
+                                    const void* a,
+                                    rocblas_int lda,
+                                    void*       b,
+                                    rocblas_int ldb)
+{
+    rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
+    rocblas_int ty = blockIdx.y * blockDim.y + threadIdx.y;
+
+    if(tx < rows && ty < cols)
+        memcpy((char*)b + (tx + size_t(ldb) * ty) * elem_size_u64,
+               (const char*)a + (tx + size_t(lda) * ty) * elem_size_u64,
+               elem_size_u64);
+}
+
+// Copy a matrix on device, using the vector kernel for a matrix with one row
+static void rocblas_copy_void_ptr_matrix(rocblas_int rows,
+                                         rocblas_int cols,
+                                         size_t      elem_size_u64,
+                                         const void* a,
+                                         rocblas_int lda,
+                                         void*       b,
+                                         rocblas_int ldb,
+                                         hipStream_t stream)
+{
+    if(rows == 1)
+    {
+        hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
+                           dim3((cols - 1) / NB_X + 1),
+                           dim3(NB_X),
+                           0,
+                           stream,
+                           cols,
+                           rocblas_int(elem_size_u64),
+                           a,
+                           lda,
+                           b,
+                           ldb);
+    }
+    else
+    {
+        hipLaunchKernelGGL((rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
+                           dim3((rows - 1) / MATRIX_DIM_X + 1, (cols - 1) / MATRIX_DIM_Y + 1),
+                           dim3(MATRIX_DIM_X, MATRIX_DIM_Y),
+                           0,
+                           stream,
+                           rows,
+                           cols,
+                           elem_size_u64,
+                           a,
+                           lda,
+                           b,
+                           ldb);
+    }
+}
+
+/*******************************************************************************
+ *! \brief  Copy between a batch of matrices on device and a packed buffer on
+     device, which holds the matrices contiguously one after the other. The
+     matrices are scattered from the buffer if SCATTER is true, and gathered
+     into the buffer otherwise. blockIdx.z is the index in the batch.
+ ******************************************************************************/
+template <rocblas_int DIM_X, rocblas_int DIM_Y, bool SCATTER>
+ROCBLAS_KERNEL(DIM_X* DIM_Y)
+rocblas_copy_void_ptr_matrix_batched_kernel(rocblas_int  rows,
+                                            rocblas_int  cols,
+                                            size_t       elem_size_u64,
+                                            void*        packed,
+                                            void* const* matrices,
+                                            rocblas_int  ld)
+{
+    rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
+    rocblas_int ty = blockIdx.y * blockDim.y + threadIdx.y;
+
+    if(tx < rows && ty < cols)
+    {
+        char* p = (char*)packed + ((blockIdx.z * size_t(cols) + ty) * rows + tx) * elem_size_u64;
+        char* m = (char*)matrices[blockIdx.z] + (tx + size_t(ld) * ty) * elem_size_u64;
+        if(SCATTER)
+            memcpy(m, p, elem_size_u64);
+        else
+            memcpy(p, m, elem_size_u64);
+    }
+}
+
+// Largest batch of one launch of the batched copy kernel, the limit of gridDim.z
+constexpr rocblas_int MATRIX_BATCH_MAX = 65535;
+
+// Scatter (or gather) batch_count matrices from (or into) a packed device buffer
+template <bool SCATTER>
+static void rocblas_copy_void_ptr_matrix_batched(rocblas_int  rows,
+                                                 rocblas_int  cols,
+                                                 size_t       elem_size_u64,
+                                                 void*        packed,
+                                                 void* const* matrices,
+                                                 rocblas_int  ld,
+                                                 rocblas_int  batch_count,
+                                                 hipStream_t  stream)
+{
+    dim3 grid((rows - 1) / MATRIX_DIM_X + 1, (cols - 1) / MATRIX_DIM_Y + 1, batch_count);
+    dim3 threads(MATRIX_DIM_X, MATRIX_DIM_Y);
+    hipLaunchKernelGGL(
+        (rocblas_copy_void_ptr_matrix_batched_kernel<MATRIX_DIM_X, MATRIX_DIM_Y, SCATTER>),
+        grid,
+        threads,
+        0,
+        stream,
+        rows,
+        cols,
+        elem_size_u64,
+        packed,
+        matrices,
+        ld);
+}
+
+/*******************************************************************************
+ * Pipelined transfers of non-contiguous matrices and vectors
+ *
+ * A column-major matrix of which the host copy, the device copy or both are
+ * not contiguous is transferred in chunks of columns, through
+ * NUM_STAGING_BUFFERS staging buffers on the host and, if the device copy is
+ * not contiguous, on the device. The host buffers are pinned, so transfers are
+ * asynchronous, and the host packs the next chunk (set) or unpacks the
+ * previous chunk (get) while a chunk is being transferred, with the packers
+ * of strided_pack.hpp. Non-contiguous columns on the device are packed or
+ * unpacked by a kernel on the device.
+ *
+ * Vectors are transferred as matrices with one row, whose leading dimension
+ * is the increment.
+ ******************************************************************************/
+constexpr int    NUM_STAGING_BUFFERS = 2;
+constexpr size_t STAGING_BUFF_BYTES  = 4 * 1048576;
+
+// Staging buffers are kept for reuse in process-wide pools, one of pinned host
+// memory and one of device memory for each device. Each pool keeps at most
+// ROCBLAS_STAGING_POOL_CAP bytes of released buffers.
+constexpr size_t STAGING_POOL_DEFAULT_CAP = 64 * 1048576;
+
+struct rocblas_pinned_staging_backend
+{
+    bool allocate(void** ptr, size_t size)
+    {
+        return hipHostMalloc(ptr, size) == hipSuccess;
+    }
+
+    bool deallocate(void* ptr)
+    {
+        return hipHostFree(ptr) == hipSuccess;
+    }
+};
+
+struct rocblas_device_staging_backend
+{
+    bool allocate(void** ptr, size_t size)
+    {
+        return hipMalloc(ptr, size) == hipSuccess;
+    }
+
+    bool deallocate(void* ptr)
+    {
+        return hipFree(ptr) == hipSuccess;
+    }
+};
+
+using rocblas_pinned_staging_pool = rocblas_staging_pool<rocblas_pinned_staging_backend>;
+using rocblas_device_staging_pool = rocblas_staging_pool<rocblas_device_staging_backend>;
+
+class rocblas_staging_pools
+{
+public:
+    // The pools are never destroyed, since freeing their memory during static
+    // destruction could follow the shutdown of the HIP runtime
+    static rocblas_staging_pools& instance()
+    {
+        static auto* pools = new rocblas_staging_pools;
+        return *pools;
+    }
+
+    rocblas_pinned_staging_pool& pinned()
+    {
+        return m_pinned;
+    }
+
+    // The device pool of the current device
+    rocblas_device_staging_pool& device()
+    {
+        int device = 0;
+        PRINT_IF_HIP_ERROR(hipGetDevice(&device));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_device.size() <= size_t(device))
+            m_device.resize(device + 1);
+        if(!m_device[device])
+            m_device[device] = std::make_unique<rocblas_device_staging_pool>(m_cap);
+        return *m_device[device];
+    }
+
+    // Apply func to each pool
+    template <typename FUNC>
+    void for_each(FUNC&& func)
+    {
+        func(m_pinned);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(auto& pool : m_device)
+            if(pool)
+                func(*pool);
+    }
+
+    void set_cap(size_t cap)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cap = cap;
+        }
+        for_each([=](auto& pool) { pool.set_cap(cap); });
+    }
+
+private:
+    rocblas_staging_pools()
+        : m_cap(default_cap())
+        , m_pinned(m_cap)
+    {
+    }
+
+    static size_t default_cap()
+    {
+        const char* cap = std::getenv("ROCBLAS_STAGING_POOL_CAP");
+        return cap ? strtoull(cap, nullptr, 0) : STAGING_POOL_DEFAULT_CAP;
+    }
+
+    std::mutex                                                m_mutex;
+    size_t                                                    m_cap;
+    rocblas_pinned_staging_pool                               m_pinned;
+    std::vector<std::unique_ptr<rocblas_device_staging_pool>> m_device;
+};
+
+class rocblas_staging_buffers
+{
+public:
+    // Buffers of size bytes are acquired on the host and, if device is true, on
+    // the device. Events order the reuse of the buffers if pipelined is true.
+    // Without pipelining, the host buffer is only pinned if the pinned pool
+    // caches buffers, since pinning memory for a single transfer costs more
+    // than the transfer saves.
+    rocblas_staging_buffers(size_t bytes, bool pipelined, bool device)
+    {
+        auto& pools  = rocblas_staging_pools::instance();
+        bool  pinned = pipelined || pools.pinned().cap();
+        int   count  = pipelined ? NUM_STAGING_BUFFERS : 1;
+        for(int i = 0; i < count; ++i)
+        {
+            if(pinned)
+            {
+                m_pinned[i] = pools.pinned().acquire(bytes);
+                m_host[i]   = m_pinned[i].get();
+            }
+            else
+            {
+                m_pageable[i].reset(new(std::nothrow) char[bytes]);
+                m_host[i] = m_pageable[i].get();
+            }
+            if(!m_host[i])
+                return;
+            if(device)
+            {
+                m_device[i] = pools.device().acquire(bytes);
+                if(!m_device[i])
+                    return;
+            }
+            if(pipelined
+               && hipEventCreateWithFlags(&m_event[i], hipEventDisableTiming) != hipSuccess)
+                return;
+        }
+        m_ok = true;
+    }
+
+    // Wait for transfers in flight before the buffers are released
+    ~rocblas_staging_buffers()
+    {
+        PRINT_IF_HIP_ERROR(hipStreamSynchronize(m_stream));
+        for(int i = 0; i < NUM_STAGING_BUFFERS; ++i)
+            if(m_event[i])
+                PRINT_IF_HIP_ERROR(hipEventDestroy(m_event[i]));
+    }
+
+    rocblas_staging_buffers(const rocblas_staging_buffers&) = delete;
+    rocblas_staging_buffers& operator=(const rocblas_staging_buffers&) = delete;
+
+    explicit operator bool() const
+    {
+        return m_ok;
+    }
+
+    hipStream_t stream() const
+    {
+        return m_stream;
+    }
+
+    void* host(int i) const
+    {
+        return m_host[i];
+    }
+
+    void* device(int i) const
+    {
+        return m_device[i].get();
+    }
+
+    // Record the completion of the transfer which uses buffer i
+    void record(int i)
+    {
+        if(m_event[i])
+            PRINT_IF_HIP_ERROR(hipEventRecord(m_event[i], m_stream));
+    }
+
+    // Wait for the transfer which last used buffer i to complete
+    void wait(int i)
+    {
+        PRINT_IF_HIP_ERROR(m_event[i] ? hipEventSynchronize(m_event[i])
+                                      : hipStreamSynchronize(m_stream));
+    }
+
+private:
+    bool                                m_ok     = false;
+    hipStream_t                         m_stream = 0;
+    void*                               m_host[NUM_STAGING_BUFFERS]  = {};
+    rocblas_pinned_staging_pool::buffer m_pinned[NUM_STAGING_BUFFERS];
+    std::unique_ptr<char[]>             m_pageable[NUM_STAGING_BUFFERS];
+    rocblas_device_staging_pool::buffer m_device[NUM_STAGING_BUFFERS];
+    hipEvent_t                          m_event[NUM_STAGING_BUFFERS] = {};
+};
+
+// Number of columns in each chunk of a pipelined transfer
+static size_t rocblas_staging_chunk_cols(rocblas_int rows, rocblas_int cols, size_t elem_size_u64)
+{
+    size_t chunk_cols = std::max(STAGING_BUFF_BYTES / (elem_size_u64 * rows), size_t(1));
+    return std::min(chunk_cols, size_t(cols));
+}
 
-// device_malloc wraps hipMalloc and provides same API as malloc
-static void* device_malloc(size_t byte_size)
+// Copy matrix a_h on host to matrix b_d on device, where lda != rows or ldb != rows
+static rocblas_status rocblas_set_matrix_pipelined(rocblas_int rows,
+                                                   rocblas_int cols,
+                                                   size_t      elem_size_u64,
+                                                   const void* a_h,
+                                                   rocblas_int lda,
+                                                   void*       b_d,
+                                                   rocblas_int ldb)
 {
-    void* pointer = nullptr;
-    PRINT_IF_HIP_ERROR((hipMalloc)(&pointer, byte_size));
-    return pointer;
+    size_t col_bytes  = elem_size_u64 * rows;
+    size_t chunk_cols = rocblas_staging_chunk_cols(rows, cols, elem_size_u64);
+
+    rocblas_staging_buffers buffers(chunk_cols * col_bytes, chunk_cols < size_t(cols), ldb != rows);
+    if(!buffers)
+        return rocblas_status_memory_error;
+    hipStream_t stream = buffers.stream();
+
+    for(size_t j = 0, k = 0; j < size_t(cols); j += chunk_cols, k++)
+    {
+        int         i          = k % NUM_STAGING_BUFFERS;
+        size_t      n_cols     = std::min(chunk_cols, cols - j);
+        const void* a_h_start  = (const char*)a_h + j * lda * elem_size_u64;
+        void*       b_d_start  = (char*)b_d + j * ldb * elem_size_u64;
+        void*       t_h        = buffers.host(i);
+        void*       t_d        = buffers.device(i);
+        size_t      chunk_size = n_cols * col_bytes;
+
+        // wait until the transfer which last used this buffer has completed
+        if(k >= NUM_STAGING_BUFFERS)
+            buffers.wait(i);
+
+        // host matrix -> host buffer, while the previous chunk is transferred
+        rocblas_pack_columns(t_h, a_h_start, col_bytes, n_cols, lda * elem_size_u64);
+
+        // host buffer -> contiguous device matrix or device buffer
+        PRINT_IF_HIP_ERROR(hipMemcpyAsync(
+            ldb == rows ? b_d_start : t_d, t_h, chunk_size, hipMemcpyHostToDevice, stream));
+        buffers.record(i);
+
+        // device buffer -> non-contiguous device matrix
+        if(ldb != rows)
+            rocblas_copy_void_ptr_matrix(
+                rows, n_cols, elem_size_u64, t_d, rows, b_d_start, ldb, stream);
+    }
+
+    PRINT_IF_HIP_ERROR(hipStreamSynchronize(stream));
+    return rocblas_status_success;
 }
 
-// device_free wraps hipFree and provides same API as free
-static void device_free(void* ptr)
+// Copy matrix a_d on device to matrix b_h on host, where lda != rows or ldb != rows
+static rocblas_status rocblas_get_matrix_pipelined(rocblas_int rows,
+                                                   rocblas_int cols,
+                                                   size_t      elem_size_u64,
+                                                   const void* a_d,
+                                                   rocblas_int lda,
+                                                   void*       b_h,
+                                                   rocblas_int ldb)
 {
-    PRINT_IF_HIP_ERROR((hipFree)(ptr));
+    size_t col_bytes  = elem_size_u64 * rows;
+    size_t chunk_cols = rocblas_staging_chunk_cols(rows, cols, elem_size_u64);
+
+    rocblas_staging_buffers buffers(chunk_cols * col_bytes, chunk_cols < size_t(cols), lda != rows);
+    if(!buffers)
+        return rocblas_status_memory_error;
+    hipStream_t stream = buffers.stream();
+
+    // host buffer -> host matrix, after the transfer into the buffer completes
+    auto unpack = [&](size_t j, int i) {
+        buffers.wait(i);
+        rocblas_unpack_columns((char*)b_h + j * ldb * elem_size_u64,
+                               ldb * elem_size_u64,
+                               buffers.host(i),
+                               col_bytes,
+                               std::min(chunk_cols, cols - j));
+    };
+
+    for(size_t j = 0, k = 0; j < size_t(cols); j += chunk_cols, k++)
+    {
+        int         i          = k % NUM_STAGING_BUFFERS;
+        size_t      n_cols     = std::min(chunk_cols, cols - j);
+        const void* a_d_start  = (const char*)a_d + j * lda * elem_size_u64;
+        void*       t_h        = buffers.host(i);
+        void*       t_d        = buffers.device(i);
+        size_t      chunk_size = n_cols * col_bytes;
+
+        // non-contiguous device matrix -> device buffer
+        if(lda != rows)
+            rocblas_copy_void_ptr_matrix(
+                rows, n_cols, elem_size_u64, a_d_start, lda, t_d, rows, stream);
+
+        // contiguous device matrix or device buffer -> host buffer; the host
+        // buffer was last used by a chunk which has already been unpacked
+        PRINT_IF_HIP_ERROR(hipMemcpyAsync(
+            t_h, lda == rows ? a_d_start : t_d, chunk_size, hipMemcpyDeviceToHost, stream));
+        buffers.record(i);
+
+        // unpack the previous chunk while this one is transferred
+        if(k)
+            unpack(j - chunk_cols, (k - 1) % NUM_STAGING_BUFFERS);
+    }
+
+    // unpack the last chunk
+    size_t n_chunks = (cols - 1) / chunk_cols + 1;
+    unpack((n_chunks - 1) * chunk_cols, (n_chunks - 1) % NUM_STAGING_BUFFERS);
+
+    return rocblas_status_success;
+}
+
+/*******************************************************************************
+ * Batched transfers of matrices
+ *
+ * The arrays of matrix pointers are in host memory. Runs of contiguous
+ * matrices which follow each other both on the host and on the device are
+ * transferred with one copy per run, and matrices of at least
+ * BATCH_DIRECT_MIN_BYTES are transferred by themselves. The other matrices are
+ * staged in chunks: a staging buffer holds the array of device pointers of a
+ * chunk followed by its packed matrices, so that a chunk takes one copy
+ * between host and device and one launch of the batched copy kernel. Chunks
+ * are pipelined like the chunks of columns above.
+ ******************************************************************************/
+constexpr size_t BATCH_DIRECT_MIN_BYTES = 1048576;
+
+// Bytes at the start of a staging buffer which hold n device pointers, rounded
+// up so that the matrices which follow are aligned
+static size_t rocblas_batch_pointer_bytes(size_t n)
+{
+    return (n * sizeof(void*) + 255) / 256 * 256;
+}
+
+// Issue direct(b, e) for each run [b, e) of matrices which is large enough to
+// be transferred without staging, and collect the indices of the others.
+// Contiguous matrices form runs while they follow each other in x and y.
+template <typename DIRECT>
+static rocblas_status rocblas_batch_direct_runs(bool                      contiguous,
+                                                size_t                    matrix_bytes,
+                                                const void* const*        x,
+                                                const void* const*        y,
+                                                rocblas_int               batch_count,
+                                                std::vector<rocblas_int>& staged,
+                                                DIRECT                    direct)
+{
+    for(rocblas_int b = 0, e; b < batch_count; b = e)
+    {
+        e = b + 1;
+        while(contiguous && e < batch_count
+              && (const char*)x[e] == (const char*)x[e - 1] + matrix_bytes
+              && (const char*)y[e] == (const char*)y[e - 1] + matrix_bytes)
+            e++;
+
+        if((e - b) * matrix_bytes >= BATCH_DIRECT_MIN_BYTES)
+        {
+            rocblas_status status = direct(b, e);
+            if(status != rocblas_status_success)
+                return status;
+        }
+        else
+        {
+            for(rocblas_int i = b; i < e; i++)
+                staged.push_back(i);
+        }
+    }
+    return rocblas_status_success;
+}
+
+// Number of matrices in each chunk of a staged batched transfer
+static size_t rocblas_batch_chunk_count(size_t matrix_bytes, size_t n_staged)
+{
+    size_t chunk = std::max(STAGING_BUFF_BYTES / (matrix_bytes + sizeof(void*)), size_t(1));
+    return std::min({chunk, n_staged, size_t(MATRIX_BATCH_MAX)});
+}
+
+// Copy matrices a_h[i] on host to matrices b_d[i] on device
+static rocblas_status rocblas_set_matrix_batched_staged(rocblas_int        rows,
+                                                        rocblas_int        cols,
+                                                        rocblas_int        elem_size,
+                                                        const void* const* a_h,
+                                                        rocblas_int        lda,
+                                                        void* const*       b_d,
+                                                        rocblas_int        ldb,
+                                                        rocblas_int        batch_count)
+{
+    size_t elem_size_u64 = size_t(elem_size);
+    size_t col_bytes     = elem_size_u64 * rows;
+    size_t matrix_bytes  = col_bytes * cols;
+    bool   contiguous    = lda == rows && ldb == rows;
+
+    std::vector<rocblas_int> staged;
+    rocblas_status           status = rocblas_batch_direct_runs(
+        contiguous, matrix_bytes, a_h, b_d, batch_count, staged, [&](rocblas_int b, rocblas_int e) {
+            if(!contiguous)
+                return rocblas_set_matrix(rows, cols, elem_size, a_h[b], lda, b_d[b], ldb);
+            PRINT_IF_HIP_ERROR(
+                hipMemcpy(b_d[b], a_h[b], (e - b) * matrix_bytes, hipMemcpyHostToDevice));
+            return rocblas_status_success;
+        });
+    if(status != rocblas_status_success || staged.empty())
+        return status;
+
+    size_t n_staged  = staged.size();
+    size_t chunk     = rocblas_batch_chunk_count(matrix_bytes, n_staged);
+    size_t ptr_bytes = rocblas_batch_pointer_bytes(chunk);
+
+    rocblas_staging_buffers buffers(ptr_bytes + chunk * matrix_bytes, chunk < n_staged, true);
+    if(!buffers)
+        return rocblas_status_memory_error;
+    hipStream_t stream = buffers.stream();
+
+    for(size_t s = 0, k = 0; s < n_staged; s += chunk, k++)
+    {
+        int    i      = k % NUM_STAGING_BUFFERS;
+        size_t n      = std::min(chunk, n_staged - s);
+        void** ptrs_h = (void**)buffers.host(i);
+        char*  t_h    = (char*)buffers.host(i) + ptr_bytes;
+        char*  t_d    = (char*)buffers.device(i) + ptr_bytes;
+
+        // wait until the transfer which last used this buffer has completed
+        if(k >= NUM_STAGING_BUFFERS)
+            buffers.wait(i);
+
+        // host matrices -> host buffer, while the previous chunk is transferred
+        for(size_t m = 0; m < n; m++)
+        {
+            rocblas_int b = staged[s + m];
+            ptrs_h[m]     = b_d[b];
+            rocblas_pack_columns(
+                t_h + m * matrix_bytes, a_h[b], col_bytes, cols, lda * elem_size_u64);
+        }
+
+        // host buffer -> device buffer, pointers and matrices in one copy
+        PRINT_IF_HIP_ERROR(hipMemcpyAsync(buffers.device(i),
+                                          buffers.host(i),
+                                          ptr_bytes + n * matrix_bytes,
+                                          hipMemcpyHostToDevice,
+                                          stream));
+        buffers.record(i);
+
+        // device buffer -> device matrices
+        rocblas_copy_void_ptr_matrix_batched<true>(
+            rows, cols, elem_size_u64, t_d, (void* const*)buffers.device(i), ldb, n, stream);
+    }
+
+    PRINT_IF_HIP_ERROR(hipStreamSynchronize(stream));
+    return rocblas_status_success;
 }
 
-using rocblas_unique_ptr = std::unique_ptr<void, void (*)(void*)>;
+// Copy matrices a_d[i] on device to matrices b_h[i] on host
+static rocblas_status rocblas_get_matrix_batched_staged(rocblas_int        rows,
+                                                        rocblas_int        cols,
+                                                        rocblas_int        elem_size,
+                                                        const void* const* a_d,
+                                                        rocblas_int        lda,
+                                                        void* const*       b_h,
+                                                        rocblas_int        ldb,
+                                                        rocblas_int        batch_count)
+{
+    size_t elem_size_u64 = size_t(elem_size);
+    size_t col_bytes     = elem_size_u64 * rows;
+    size_t matrix_bytes  = col_bytes * cols;
+    bool   contiguous    = lda == rows && ldb == rows;
+
+    std::vector<rocblas_int> staged;
+    rocblas_status           status = rocblas_batch_direct_runs(
+        contiguous, matrix_bytes, a_d, b_h, batch_count, staged, [&](rocblas_int b, rocblas_int e) {
+            if(!contiguous)
+                return rocblas_get_matrix(rows, cols, elem_size, a_d[b], lda, b_h[b], ldb);
+            PRINT_IF_HIP_ERROR(
+                hipMemcpy(b_h[b], a_d[b], (e - b) * matrix_bytes, hipMemcpyDeviceToHost));
+            return rocblas_status_success;
+        });
+    if(status != rocblas_status_success || staged.empty())
+        return status;
+
+    size_t n_staged  = staged.size();
+    size_t chunk     = rocblas_batch_chunk_count(matrix_bytes, n_staged);
+    size_t ptr_bytes = rocblas_batch_pointer_bytes(chunk);
+
+    rocblas_staging_buffers buffers(ptr_bytes + chunk * matrix_bytes, chunk < n_staged, true);
+    if(!buffers)
+        return rocblas_status_memory_error;
+    hipStream_t stream = buffers.stream();
+
+    // host buffer -> host matrices, after the transfer into the buffer completes
+    auto unpack = [&](size_t s, int i) {
+        buffers.wait(i);
+        const char* t_h = (const char*)buffers.host(i) + ptr_bytes;
+        for(size_t m = 0, n = std::min(chunk, n_staged - s); m < n; m++)
+            rocblas_unpack_columns(
+                b_h[staged[s + m]], ldb * elem_size_u64, t_h + m * matrix_bytes, col_bytes, cols);
+    };
+
+    for(size_t s = 0, k = 0; s < n_staged; s += chunk, k++)
+    {
+        int    i      = k % NUM_STAGING_BUFFERS;
+        size_t n      = std::min(chunk, n_staged - s);
+        void** ptrs_h = (void**)buffers.host(i);
+        char*  t_h    = (char*)buffers.host(i) + ptr_bytes;
+        char*  t_d    = (char*)buffers.device(i) + ptr_bytes;
+
+        // the host buffer was last used by a chunk which has already been unpacked
+        for(size_t m = 0; m < n; m++)
+            ptrs_h[m] = const_cast<void*>(a_d[staged[s + m]]);
+        PRINT_IF_HIP_ERROR(hipMemcpyAsync(
+            buffers.device(i), ptrs_h, n * sizeof(void*), hipMemcpyHostToDevice, stream));
+
+        // device matrices -> device buffer
+        rocblas_copy_void_ptr_matrix_batched<false>(
+            rows, cols, elem_size_u64, t_d, (void* const*)buffers.device(i), lda, n, stream);
+
+        // device buffer -> host buffer
+        PRINT_IF_HIP_ERROR(
+            hipMemcpyAsync(t_h, t_d, n * matrix_bytes, hipMemcpyDeviceToHost, stream));
+        buffers.record(i);
+
+        // unpack the previous chunk while this one is transferred
+        if(k)
+            unpack(s - chunk, (k - 1) % NUM_STAGING_BUFFERS);
+    }
+
+    // unpack the last chunk
+    size_t n_chunks = (n_staged - 1) / chunk + 1;
+    unpack((n_chunks - 1) * chunk, (n_chunks - 1) % NUM_STAGING_BUFFERS);
+
+    return rocblas_status_success;
+}
 
 /*******************************************************************************
  *! \brief   copies void* vector x with stride incx on host to void* vector
      y with stride incy on device. Vectors have n elements of size elem_size.
-  TODO: Need to replace device memory allocation with new system
  ******************************************************************************/
 extern "C" rocblas_status rocblas_set_vector(rocblas_int n,
                                              rocblas_int elem_size,
@@ -291,101 +951,8 @@ try
     }
     else // either non-contiguous host vector or non-contiguous device vector
     {
-        size_t bytes_to_copy = elem_size_u64 * n;
-        size_t temp_byte_size
-            = bytes_to_copy < VEC_BUFF_MAX_BYTES ? bytes_to_copy : VEC_BUFF_MAX_BYTES;
-        int n_elem = temp_byte_size / elem_size; // number of elements in buffer
-        int n_copy = ((n - 1) / n_elem) + 1; // number of times buffer is copied
-
-        int  blocks = (n_elem - 1) / NB_X + 1; // parameters for device kernel
-        dim3 grid(blocks);
-        dim3 threads(NB_X);
-
-        size_t x_h_byte_stride = elem_size_u64 * incx;
-        size_t y_d_byte_stride = elem_size_u64 * incy;
-        size_t t_h_byte_stride = elem_size_u64;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            int         i_start     = i_copy * n_elem;
-            int         n_elem_max  = n - i_start < n_elem ? n - i_start : n_elem;
-            size_t      contig_size = n_elem_max * elem_size_u64;
-            void*       y_d_start   = (char*)y_d + i_start * y_d_byte_stride;
-            const void* x_h_start   = (const char*)x_h + i_start * x_h_byte_stride;
-
-            if((incx != 1) && (incy != 1))
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size_u64);
-                }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   t_d,
-                                   1,
-                                   y_d_start,
-                                   incy);
-            }
-            else if(incx == 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host vector -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, x_h_start, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device vector
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   t_d,
-                                   1,
-                                   y_d_start,
-                                   incy);
-            }
-            else if(incx != 1 && incy == 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host vector -> host buffer
-                for(size_t i_b = 0, i_x = i_start; i_b < n_elem_max; i_b++, i_x++)
-                {
-                    memcpy((char*)t_h + i_b * t_h_byte_stride,
-                           (const char*)x_h + i_x * x_h_byte_stride,
-                           elem_size);
-                }
-                // host buffer -> contiguous device vector
-                PRINT_IF_HIP_ERROR(hipMemcpy(y_d_start, t_h, contig_size, hipMemcpyHostToDevice));
-            }
-        }
+        // copy as a matrix with one row, whose leading dimensions are the increments
+        return rocblas_set_matrix_pipelined(1, n, elem_size_u64, x_h, incx, y_d, incy);
     }
     return rocblas_status_success;
 }
@@ -421,102 +988,8 @@ try
     }
     else // either device or host vector is non-contiguous
     {
-        size_t bytes_to_copy = elem_size_u64 * n;
-        size_t temp_byte_size
-            = bytes_to_copy < VEC_BUFF_MAX_BYTES ? bytes_to_copy : VEC_BUFF_MAX_BYTES;
-        int n_elem = temp_byte_size / elem_size; // number elements in buffer
-        int n_copy = ((n - 1) / n_elem) + 1; // number of times buffer is copied
-
-        int  blocks = (n_elem - 1) / NB_X + 1; // parameters for device kernel
-        dim3 grid(blocks);
-        dim3 threads(NB_X);
-
-        size_t x_d_byte_stride = elem_size_u64 * incx;
-        size_t y_h_byte_stride = elem_size_u64 * incy;
-        size_t t_h_byte_stride = elem_size_u64;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            int    i_start        = i_copy * n_elem;
-            int    n_elem_max     = n - (n_elem * i_copy) < n_elem ? n - (n_elem * i_copy) : n_elem;
-            size_t contig_size    = elem_size_u64 * n_elem_max;
-            const void* x_d_start = (const char*)x_d + i_start * x_d_byte_stride;
-            void*       y_h_start = (char*)y_h + i_start * y_h_byte_stride;
-
-            if(incx != 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   x_d_start,
-                                   incx,
-                                   t_d,
-                                   1);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
-            }
-            else if(incx == 1 && incy != 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device vector -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, x_d_start, contig_size, hipMemcpyDeviceToHost));
-
-                // host buffer -> non-contiguous host vector
-                for(size_t i_b = 0, i_y = i_start; i_b < n_elem_max; i_b++, i_y++)
-                {
-                    memcpy((char*)y_h + i_y * y_h_byte_stride,
-                           (const char*)t_h + i_b * t_h_byte_stride,
-                           elem_size);
-                }
-            }
-            else if(incx != 1 && incy == 1)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device vector -> device buffer
-                hipLaunchKernelGGL((rocblas_copy_void_ptr_vector_kernel<NB_X>),
-                                   grid,
-                                   threads,
-                                   0,
-                                   0,
-                                   n_elem_max,
-                                   elem_size,
-                                   x_d_start,
-                                   incx,
-                                   t_d,
-                                   1);
-                // device buffer -> contiguous host vector
-                PRINT_IF_HIP_ERROR(hipMemcpy(y_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
-            }
-        }
+        // copy as a matrix with one row, whose leading dimensions are the increments
+        return rocblas_get_matrix_pipelined(1, n, elem_size_u64, x_d, incx, y_h, incy);
     }
     return rocblas_status_success;
 }
@@ -617,34 +1090,6 @@ catch(...) // catch all exceptions
     return exception_to_rocblas_status();
 }
 
-/*******************************************************************************
- *! \brief  Matrix copy on device. Matrices are void pointers with element
-     size elem_size
- ******************************************************************************/
-
-constexpr size_t      MAT_BUFF_MAX_BYTES = 1048576;
-constexpr rocblas_int MATRIX_DIM_X       = 128;
-constexpr rocblas_int MATRIX_DIM_Y       = 8;
-
-template <rocblas_int DIM_X, rocblas_int DIM_Y>
-ROCBLAS_KERNEL(DIM_X* DIM_Y)
-rocblas_copy_void_ptr_matrix_kernel(rocblas_int rows,
-                                    rocblas_int cols,
-                                    size_t      elem_size_u64,
-                                    const void* a,
-                                    rocblas_int lda,
-                                    void*       b,
-                                    rocblas_int ldb)
-{
-    rocblas_int tx = blockIdx.x * blockDim.x + threadIdx.x;
-    rocblas_int ty = blockIdx.y * blockDim.y + threadIdx.y;
-
-    if(tx < rows && ty < cols)
-        memcpy((char*)b + (tx + size_t(ldb) * ty) * elem_size_u64,
-               (const char*)a + (tx + size_t(lda) * ty) * elem_size_u64,
-               elem_size_u64);
-}
-
 /*******************************************************************************
  *! \brief   copies void* matrix a_h with leading dimentsion lda on host to
      void* matrix b_d with leading dimension ldb on device. Matrices have
@@ -676,7 +1121,7 @@ try
         PRINT_IF_HIP_ERROR(hipMemcpy(b_d, a_h, bytes_to_copy, hipMemcpyHostToDevice));
     }
     // matrix columns too large to fit in temp buffer, copy matrix col by col
-    else if(rows * elem_size_u64 > MAT_BUFF_MAX_BYTES)
+    else if(rows * elem_size_u64 > STAGING_BUFF_BYTES)
     {
         for(size_t i = 0; i < cols; i++)
         {
@@ -686,110 +1131,10 @@ try
                                          hipMemcpyHostToDevice));
         }
     }
-    // columns fit in temp buffer, pack columns in buffer, hipMemcpy host->device, unpack
-    // columns
+    // columns fit in staging buffers, pipeline packing and transfers of chunks of columns
     else
     {
-        size_t bytes_to_copy = elem_size_u64 * rows * cols;
-        size_t temp_byte_size
-            = bytes_to_copy < MAT_BUFF_MAX_BYTES ? bytes_to_copy : MAT_BUFF_MAX_BYTES;
-        int n_cols = temp_byte_size / (elem_size_u64 * rows); // number of columns in buffer
-        int n_copy = ((cols - 1) / n_cols) + 1; // number of times buffer is copied
-
-        rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
-        rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
-        dim3        grid(blocksX, blocksY);
-        dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
-
-        size_t lda_h_byte = elem_size_u64 * lda;
-        size_t ldb_d_byte = elem_size_u64 * ldb;
-        size_t ldt_h_byte = elem_size_u64 * rows;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            size_t      i_start     = i_copy * n_cols;
-            int         n_cols_max  = cols - i_start < n_cols ? cols - i_start : n_cols;
-            size_t      contig_size = elem_size_u64 * rows * n_cols_max;
-            void*       b_d_start   = (char*)b_d + i_start * ldb_d_byte;
-            const void* a_h_start   = (const char*)a_h + i_start * lda_h_byte;
-
-            if((lda != rows) && (ldb != rows))
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
-                // host buffer -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, t_h, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device matrix
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size_u64,
-                    t_d,
-                    rows,
-                    b_d_start,
-                    ldb);
-            }
-            else if(lda == rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // contiguous host matrix -> device buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_d, a_h_start, contig_size, hipMemcpyHostToDevice));
-                // device buffer -> non-contiguous device matrix
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size_u64,
-                    t_d,
-                    rows,
-                    b_d_start,
-                    ldb);
-            }
-            else if(lda != rows && ldb == rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // non-contiguous host matrix -> host buffer
-                for(size_t i_t = 0, i_a = i_start; i_t < n_cols_max; i_t++, i_a++)
-                {
-                    memcpy((char*)t_h + i_t * ldt_h_byte,
-                           (const char*)a_h + i_a * lda_h_byte,
-                           ldt_h_byte);
-                }
-                // host buffer -> contiguous device matrix
-                PRINT_IF_HIP_ERROR(hipMemcpy(b_d_start, t_h, contig_size, hipMemcpyHostToDevice));
-            }
-        }
+        return rocblas_set_matrix_pipelined(rows, cols, elem_size_u64, a_h, lda, b_d, ldb);
     }
     return rocblas_status_success;
 }
@@ -829,7 +1174,7 @@ try
         PRINT_IF_HIP_ERROR(hipMemcpy(b_h, a_d, bytes_to_copy, hipMemcpyDeviceToHost));
     }
     // columns too large for temp buffer, hipMemcpy column by column
-    else if(rows * elem_size_u64 > MAT_BUFF_MAX_BYTES)
+    else if(rows * elem_size_u64 > STAGING_BUFF_BYTES)
     {
         for(size_t i = 0; i < cols; i++)
         {
@@ -839,109 +1184,10 @@ try
                                          hipMemcpyDeviceToHost));
         }
     }
-    // columns fit in temp buffer, pack columns in buffer, hipMemcpy device->host, unpack
-    // columns
+    // columns fit in staging buffers, pipeline transfers and unpacking of chunks of columns
     else
     {
-        size_t bytes_to_copy = elem_size_u64 * rows * cols;
-        size_t temp_byte_size
-            = bytes_to_copy < MAT_BUFF_MAX_BYTES ? bytes_to_copy : MAT_BUFF_MAX_BYTES;
-        int n_cols = temp_byte_size / (elem_size_u64 * rows); // number of columns in buffer
-        int n_copy = ((cols - 1) / n_cols) + 1; // number times buffer copied
-
-        rocblas_int blocksX = ((rows - 1) / MATRIX_DIM_X) + 1; // parameters for device kernel
-        rocblas_int blocksY = ((n_cols - 1) / MATRIX_DIM_Y) + 1;
-        dim3        grid(blocksX, blocksY);
-        dim3        threads(MATRIX_DIM_X, MATRIX_DIM_Y);
-
-        size_t lda_d_byte = elem_size_u64 * lda;
-        size_t ldb_h_byte = elem_size_u64 * ldb;
-        size_t ldt_h_byte = elem_size_u64 * rows;
-
-        for(int i_copy = 0; i_copy < n_copy; i_copy++)
-        {
-            int         i_start     = i_copy * n_cols;
-            int         n_cols_max  = cols - i_start < n_cols ? cols - i_start : n_cols;
-            size_t      contig_size = elem_size_u64 * rows * n_cols_max;
-            const void* a_d_start   = (const char*)a_d + i_start * lda_d_byte;
-            void*       b_h_start   = (char*)b_h + i_start * ldb_h_byte;
-            if(lda != rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device matrix -> device buffer
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size_u64,
-                    a_d_start,
-                    lda,
-                    t_d,
-                    rows);
-                // device buffer -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, t_d, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
-            }
-            else if(lda == rows && ldb != rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_h_managed = rocblas_unique_ptr{malloc(temp_byte_size), free};
-                void* t_h         = t_h_managed.get();
-                if(!t_h)
-                    return rocblas_status_memory_error;
-                // congiguous device matrix -> host buffer
-                PRINT_IF_HIP_ERROR(hipMemcpy(t_h, a_d_start, contig_size, hipMemcpyDeviceToHost));
-                // host buffer -> non-contiguous host matrix
-                for(size_t i_t = 0, i_b = i_start; i_t < n_cols_max; i_t++, i_b++)
-                {
-                    memcpy((char*)b_h + i_b * ldb_h_byte,
-                           (const char*)t_h + i_t * ldt_h_byte,
-                           ldt_h_byte);
-                }
-            }
-            else if(lda != rows && ldb == rows)
-            {
-                // used unique_ptr to avoid memory leak
-                auto  t_d_managed = rocblas_unique_ptr{device_malloc(temp_byte_size), device_free};
-                void* t_d         = t_d_managed.get();
-                if(!t_d)
-                    return rocblas_status_memory_error;
-                // non-contiguous device matrix -> device buffer
-                hipLaunchKernelGGL(
-                    (rocblas_copy_void_ptr_matrix_kernel<MATRIX_DIM_X, MATRIX_DIM_Y>),
-                    grid,
-                    threads,
-                    0,
-                    0,
-                    rows,
-                    n_cols_max,
-                    elem_size_u64,
-                    a_d_start,
-                    lda,
-                    t_d,
-                    rows);
-                // device temp buffer -> contiguous host matrix
-                PRINT_IF_HIP_ERROR(hipMemcpy(b_h_start, t_d, contig_size, hipMemcpyDeviceToHost));
-            }
-        }
+        return rocblas_get_matrix_pipelined(rows, cols, elem_size_u64, a_d, lda, b_h, ldb);
     }
     return rocblas_status_success;
 }
@@ -1049,6 +1295,214 @@ catch(...) // catch all exceptions
     return exception_to_rocblas_status();
 }
 
+/*******************************************************************************
+ *! \brief   copies void* matrices a_h[i] with leading dimension lda on host to
+     void* matrices b_d[i] with leading dimension ldb on device, for i <
+     batch_count. The arrays of pointers are on the host.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_matrix_batched(rocblas_int       rows,
+                                                     rocblas_int       cols,
+                                                     rocblas_int       elem_size,
+                                                     const void* const a_h[],
+                                                     rocblas_int       lda,
+                                                     void* const       b_d[],
+                                                     rocblas_int       ldb,
+                                                     rocblas_int       batch_count)
+try
+{
+    if(rows == 0 || cols == 0 || batch_count == 0) // quick return
+        return rocblas_status_success;
+    if(rows < 0 || cols < 0 || lda <= 0 || ldb <= 0 || rows > lda || rows > ldb || elem_size <= 0
+       || batch_count < 0)
+        return rocblas_status_invalid_size;
+    if(!a_h || !b_d)
+        return rocblas_status_invalid_pointer;
+    for(rocblas_int i = 0; i < batch_count; i++)
+        if(!a_h[i] || !b_d[i])
+            return rocblas_status_invalid_pointer;
+
+    return rocblas_set_matrix_batched_staged(
+        rows, cols, elem_size, a_h, lda, b_d, ldb, batch_count);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   copies void* matrices a_d[i] with leading dimension lda on device
+     to void* matrices b_h[i] with leading dimension ldb on host, for i <
+     batch_count. The arrays of pointers are on the host.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_matrix_batched(rocblas_int       rows,
+                                                     rocblas_int       cols,
+                                                     rocblas_int       elem_size,
+                                                     const void* const a_d[],
+                                                     rocblas_int       lda,
+                                                     void* const       b_h[],
+                                                     rocblas_int       ldb,
+                                                     rocblas_int       batch_count)
+try
+{
+    if(rows == 0 || cols == 0 || batch_count == 0) // quick return
+        return rocblas_status_success;
+    if(rows < 0 || cols < 0 || lda <= 0 || ldb <= 0 || rows > lda || rows > ldb || elem_size <= 0
+       || batch_count < 0)
+        return rocblas_status_invalid_size;
+    if(!a_d || !b_h)
+        return rocblas_status_invalid_pointer;
+    for(rocblas_int i = 0; i < batch_count; i++)
+        if(!a_d[i] || !b_h[i])
+            return rocblas_status_invalid_pointer;
+
+    return rocblas_get_matrix_batched_staged(
+        rows, cols, elem_size, a_d, lda, b_h, ldb, batch_count);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   copies batch_count void* matrices a_h with leading dimension lda,
+     stride_a elements apart on host, to void* matrices b_d with leading
+     dimension ldb, stride_b elements apart on device.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_matrix_strided_batched(rocblas_int    rows,
+                                                             rocblas_int    cols,
+                                                             rocblas_int    elem_size,
+                                                             const void*    a_h,
+                                                             rocblas_int    lda,
+                                                             rocblas_stride stride_a,
+                                                             void*          b_d,
+                                                             rocblas_int    ldb,
+                                                             rocblas_stride stride_b,
+                                                             rocblas_int    batch_count)
+try
+{
+    if(rows == 0 || cols == 0 || batch_count == 0) // quick return
+        return rocblas_status_success;
+    if(rows < 0 || cols < 0 || lda <= 0 || ldb <= 0 || rows > lda || rows > ldb || elem_size <= 0
+       || batch_count < 0)
+        return rocblas_status_invalid_size;
+    if(!a_h || !b_d)
+        return rocblas_status_invalid_pointer;
+
+    // matrices which follow each other on both sides form one matrix of cols * batch_count columns
+    if(stride_a == rocblas_stride(lda) * cols && stride_b == rocblas_stride(ldb) * cols
+       && int64_t(cols) * batch_count <= std::numeric_limits<rocblas_int>::max())
+        return rocblas_set_matrix(rows, cols * batch_count, elem_size, a_h, lda, b_d, ldb);
+
+    std::vector<const void*> a_h_array(batch_count);
+    std::vector<void*>       b_d_array(batch_count);
+    for(rocblas_int i = 0; i < batch_count; i++)
+    {
+        a_h_array[i] = (const char*)a_h + i * stride_a * elem_size;
+        b_d_array[i] = (char*)b_d + i * stride_b * elem_size;
+    }
+    return rocblas_set_matrix_batched_staged(
+        rows, cols, elem_size, a_h_array.data(), lda, b_d_array.data(), ldb, batch_count);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ *! \brief   copies batch_count void* matrices a_d with leading dimension lda,
+     stride_a elements apart on device, to void* matrices b_h with leading
+     dimension ldb, stride_b elements apart on host.
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_matrix_strided_batched(rocblas_int    rows,
+                                                             rocblas_int    cols,
+                                                             rocblas_int    elem_size,
+                                                             const void*    a_d,
+                                                             rocblas_int    lda,
+                                                             rocblas_stride stride_a,
+                                                             void*          b_h,
+                                                             rocblas_int    ldb,
+                                                             rocblas_stride stride_b,
+                                                             rocblas_int    batch_count)
+try
+{
+    if(rows == 0 || cols == 0 || batch_count == 0) // quick return
+        return rocblas_status_success;
+    if(rows < 0 || cols < 0 || lda <= 0 || ldb <= 0 || rows > lda || rows > ldb || elem_size <= 0
+       || batch_count < 0)
+        return rocblas_status_invalid_size;
+    if(!a_d || !b_h)
+        return rocblas_status_invalid_pointer;
+
+    // matrices which follow each other on both sides form one matrix of cols * batch_count columns
+    if(stride_a == rocblas_stride(lda) * cols && stride_b == rocblas_stride(ldb) * cols
+       && int64_t(cols) * batch_count <= std::numeric_limits<rocblas_int>::max())
+        return rocblas_get_matrix(rows, cols * batch_count, elem_size, a_d, lda, b_h, ldb);
+
+    std::vector<const void*> a_d_array(batch_count);
+    std::vector<void*>       b_h_array(batch_count);
+    for(rocblas_int i = 0; i < batch_count; i++)
+    {
+        a_d_array[i] = (const char*)a_d + i * stride_a * elem_size;
+        b_h_array[i] = (char*)b_h + i * stride_b * elem_size;
+    }
+    return rocblas_get_matrix_batched_staged(
+        rows, cols, elem_size, a_d_array.data(), lda, b_h_array.data(), ldb, batch_count);
+}
+catch(...) // catch all exceptions
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Query the statistics of the staging buffer pools, totalled over all pools
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_get_staging_pool_stats(size_t* hits,
+                                                         size_t* misses,
+                                                         size_t* cached_bytes,
+                                                         size_t* peak_bytes)
+try
+{
+    if(!hits && !misses && !cached_bytes && !peak_bytes)
+        return rocblas_status_invalid_pointer;
+
+    rocblas_pinned_staging_pool::stats total;
+    rocblas_staging_pools::instance().for_each([&](auto& pool) {
+        auto stats = pool.get_stats();
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.cached_bytes += stats.cached_bytes;
+        total.peak_bytes += stats.peak_bytes;
+    });
+
+    if(hits)
+        *hits = total.hits;
+    if(misses)
+        *misses = total.misses;
+    if(cached_bytes)
+        *cached_bytes = total.cached_bytes;
+    if(peak_bytes)
+        *peak_bytes = total.peak_bytes;
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
+/*******************************************************************************
+ * Set the cap of each staging buffer pool
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_set_staging_pool_cap(size_t cap)
+try
+{
+    rocblas_staging_pools::instance().set_cap(cap);
+    return rocblas_status_success;
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
+
 // Convert rocblas_status to string
 extern "C" const char* rocblas_status_to_string(rocblas_status status)
 {
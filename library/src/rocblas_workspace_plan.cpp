@@ -0,0 +1,263 @@
+/* ************************************************************************
+ * Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+ * ies of the Software, and to permit persons to whom the Software is furnished
+ * to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+ * PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+ * CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ************************************************************************ */
+#include "handle.hpp"
+#include "workspace_plan.hpp"
+#include <string>
+
+namespace
+{
+    // Public functions used to plan each precision
+    template <typename T>
+    struct rocblas_plan_functions;
+
+#define PLAN_FUNCTIONS(T_, p_, dot_)                                                     \
+    template <>                                                                          \
+    struct rocblas_plan_functions<T_>                                                    \
+    {                                                                                    \
+        static constexpr auto gemm                 = rocblas_##p_##gemm;                 \
+        static constexpr auto gemm_strided_batched = rocblas_##p_##gemm_strided_batched; \
+        static constexpr auto trsm                 = rocblas_##p_##trsm;                 \
+        static constexpr auto trsm_strided_batched = rocblas_##p_##trsm_strided_batched; \
+        static constexpr auto syrk                 = rocblas_##p_##syrk;                 \
+        static constexpr auto gemv                 = rocblas_##p_##gemv;                 \
+        static constexpr auto symv                 = rocblas_##p_##symv;                 \
+        static constexpr auto trsv                 = rocblas_##p_##trsv;                 \
+        static constexpr auto dot                  = dot_;                               \
+    }
+
+    PLAN_FUNCTIONS(float, s, rocblas_sdot);
+    PLAN_FUNCTIONS(double, d, rocblas_ddot);
+    PLAN_FUNCTIONS(rocblas_float_complex, c, rocblas_cdotu);
+    PLAN_FUNCTIONS(rocblas_double_complex, z, rocblas_zdotu);
+
+#undef PLAN_FUNCTIONS
+
+    rocblas_operation plan_operation(char c)
+    {
+        switch(c)
+        {
+        case 'T':
+        case 't':
+            return rocblas_operation_transpose;
+        case 'C':
+        case 'c':
+            return rocblas_operation_conjugate_transpose;
+        default:
+            return rocblas_operation_none;
+        }
+    }
+
+    rocblas_fill plan_fill(char c)
+    {
+        return c == 'L' || c == 'l' ? rocblas_fill_lower : rocblas_fill_upper;
+    }
+
+    rocblas_side plan_side(char c)
+    {
+        return c == 'R' || c == 'r' ? rocblas_side_right : rocblas_side_left;
+    }
+
+    rocblas_diagonal plan_diagonal(char c)
+    {
+        return c == 'U' || c == 'u' ? rocblas_diagonal_unit : rocblas_diagonal_non_unit;
+    }
+
+    // Scalars are logged as --alpha re, followed by --alphai im if complex
+    template <typename T>
+    T plan_scalar(const rocblas_bench_call& call, const std::string& name, double default_value)
+    {
+        double re = call.get_double(name, default_value);
+        if constexpr(rocblas_is_complex<T>)
+            return T(re, call.get_double(name + "i", 0));
+        else
+            return T(re);
+    }
+
+    // Operands are never accessed in device memory size query mode, but they
+    // must not be nullptr to pass argument checking
+    template <typename T>
+    T* plan_operand()
+    {
+        static T placeholder;
+        return &placeholder;
+    }
+
+    // Make the call in the current device memory size query. Defaults are those of rocblas-bench.
+    template <typename T>
+    rocblas_status plan_call(rocblas_handle handle, const rocblas_bench_call& call)
+    {
+        using F = rocblas_plan_functions<T>;
+
+        const std::string& function    = call.function();
+        T*                 x           = plan_operand<T>();
+        T                  alpha       = plan_scalar<T>(call, "alpha", 1);
+        T                  beta        = plan_scalar<T>(call, "beta", 0);
+        rocblas_operation  trans_a     = plan_operation(call.get_char("transposeA", 'N'));
+        rocblas_operation  trans_b     = plan_operation(call.get_char("transposeB", 'N'));
+        rocblas_fill       uplo        = plan_fill(call.get_char("uplo", 'U'));
+        rocblas_side       side        = plan_side(call.get_char("side", 'L'));
+        rocblas_diagonal   diag        = plan_diagonal(call.get_char("diag", 'N'));
+        rocblas_int        m           = call.get_int("m", 128);
+        rocblas_int        n           = call.get_int("n", 128);
+        rocblas_int        k           = call.get_int("k", 128);
+        rocblas_int        lda         = call.get_int("lda", 128);
+        rocblas_int        ldb         = call.get_int("ldb", 128);
+        rocblas_int        ldc         = call.get_int("ldc", 128);
+        rocblas_int        incx        = call.get_int("incx", 1);
+        rocblas_int        incy        = call.get_int("incy", 1);
+        rocblas_int        batch_count = call.get_int("batch_count", 1);
+
+        if(function == "gemm")
+            return F::gemm(
+                handle, trans_a, trans_b, m, n, k, &alpha, x, lda, x, ldb, &beta, x, ldc);
+
+        if(function == "gemm_strided_batched")
+            return F::gemm_strided_batched(handle,
+                                           trans_a,
+                                           trans_b,
+                                           m,
+                                           n,
+                                           k,
+                                           &alpha,
+                                           x,
+                                           lda,
+                                           call.get_int("stride_a"),
+                                           x,
+                                           ldb,
+                                           call.get_int("stride_b"),
+                                           &beta,
+                                           x,
+                                           ldc,
+                                           call.get_int("stride_c"),
+                                           batch_count);
+
+        // trsm with alpha == 0 only zeroes B, without using device memory, and it
+        // does so before testing for a query, so it is not called
+        if((function == "trsm" || function == "trsm_strided_batched") && alpha == T(0))
+            return rocblas_status_success;
+
+        if(function == "trsm")
+            return F::trsm(handle, side, uplo, trans_a, diag, m, n, &alpha, x, lda, x, ldb);
+
+        if(function == "trsm_strided_batched")
+            return F::trsm_strided_batched(handle,
+                                           side,
+                                           uplo,
+                                           trans_a,
+                                           diag,
+                                           m,
+                                           n,
+                                           &alpha,
+                                           x,
+                                           lda,
+                                           call.get_int("stride_A"),
+                                           x,
+                                           ldb,
+                                           call.get_int("stride_B"),
+                                           batch_count);
+
+        if(function == "syrk")
+            return F::syrk(handle, uplo, trans_a, n, k, &alpha, x, lda, &beta, x, ldc);
+
+        if(function == "gemv")
+            return F::gemv(handle, trans_a, m, n, &alpha, x, lda, x, incx, &beta, x, incy);
+
+        if(function == "symv")
+            return F::symv(handle, uplo, n, &alpha, x, lda, x, incx, &beta, x, incy);
+
+        if(function == "trsv")
+            return F::trsv(handle, uplo, trans_a, diag, m, x, lda, x, incx);
+
+        if(function == "dot")
+            return F::dot(handle, n, x, incx, x, incy, x);
+
+        return rocblas_status_not_implemented;
+    }
+
+    rocblas_status plan_call_precision(rocblas_handle handle, const rocblas_bench_call& call)
+    {
+        const std::string& precision = call.precision();
+        if(precision == "f32_r" || precision == "s")
+            return plan_call<float>(handle, call);
+        if(precision == "f64_r" || precision == "d")
+            return plan_call<double>(handle, call);
+        if(precision == "f32_c" || precision == "c")
+            return plan_call<rocblas_float_complex>(handle, call);
+        if(precision == "f64_c" || precision == "z")
+            return plan_call<rocblas_double_complex>(handle, call);
+        return rocblas_status_not_implemented;
+    }
+
+    // Workspace of calls run in device memory size query mode on a handle
+    class handle_workspace_query : public rocblas_workspace_query
+    {
+        rocblas_handle m_handle;
+
+    public:
+        explicit handle_workspace_query(rocblas_handle handle)
+            : m_handle(handle)
+        {
+        }
+
+        rocblas_status workspace(const rocblas_bench_call& call, size_t& size) override
+        {
+            RETURN_IF_ROCBLAS_ERROR(rocblas_start_device_memory_size_query(m_handle));
+            rocblas_status status = plan_call_precision(m_handle, call);
+            RETURN_IF_ROCBLAS_ERROR(rocblas_stop_device_memory_size_query(m_handle, &size));
+
+            // Calls return whether they changed the size of the query, or success on quick return
+            return status == rocblas_status_size_increased
+                           || status == rocblas_status_size_unchanged
+                           || status == rocblas_status_success
+                       ? rocblas_status_success
+                       : status;
+        }
+    };
+}
+
+/*******************************************************************************
+ * Plan the device memory workspace of a sequence of calls
+ ******************************************************************************/
+extern "C" rocblas_status rocblas_plan_workspace(rocblas_handle     handle,
+                                                 size_t             count,
+                                                 const char* const* calls,
+                                                 size_t*            step_sizes,
+                                                 size_t*            peak)
+try
+{
+    if(!handle)
+        return rocblas_status_invalid_handle;
+    if(handle->is_device_memory_size_query())
+        return rocblas_status_size_query_mismatch;
+
+    // Planned calls are not logged or checked, and their scalars are on the host
+    auto saved_pointer_mode   = handle->push_pointer_mode(rocblas_pointer_mode_host);
+    auto saved_layer_mode     = handle->push_layer_mode(rocblas_layer_mode_none);
+    auto saved_check_numerics = handle->push_check_numerics(rocblas_check_numerics_mode_no_check);
+
+    handle_workspace_query query(handle);
+    return rocblas_plan_workspace_sequence(count, calls, query, step_sizes, peak);
+}
+catch(...)
+{
+    return exception_to_rocblas_status();
+}
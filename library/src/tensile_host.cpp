@@ -32,6 +32,8 @@ extern "C" void rocblas_shutdown();
  *****************************************************************************/
 
 #include "tensile_host.hpp"
+#include "gemm_coverage.hpp"
+#include "solution_cache_file.hpp"
 //#include <Tensile/AMDGPU.hpp>
 #include <Tensile/Contractions.hpp>
 #include <Tensile/EmbeddedLibrary.hpp>
@@ -44,12 +46,16 @@ extern "C" void rocblas_shutdown();
 #include <Tensile/hip/HipSolutionAdapter.hpp>
 #include <Tensile/hip/HipUtils.hpp>
 #include <atomic>
+#include <cmath>
 #include <complex>
 #include <exception>
 #include <future>
 #include <iomanip>
+#include <limits>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <regex>
 #include <string>
 #include <type_traits>
@@ -183,6 +189,18 @@ namespace
         }
     }
 
+    /*************************************************************************
+     * Size of GSU workspace which a Tensile solution may use.               *
+     * We set it to max size_t if this is a size query.                      *
+     *************************************************************************/
+    size_t tensile_workspace_size(rocblas_handle handle)
+    {
+        return handle->is_device_memory_size_query()
+                   ? ~size_t{0}
+                   : (handle->get_available_workspace() / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
+                         * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+    }
+
     /*************************************************************************
      * Class for converting alpha and beta between rocBLAS and Tensile types *
      * By default, alpha and beta are the same type as Tc compute_type       *
@@ -306,12 +324,8 @@ namespace
                                     {prob.row_stride_d, prob.col_stride_d, prob.batch_stride_d},
                                     prob.buffer_offset_d};
 
-        // Size of GSU workspace. We set it to max size_t if this is a size query.
-        size_t workspace_size
-            = prob.handle->is_device_memory_size_query()
-                  ? ~size_t{0}
-                  : (prob.handle->get_available_workspace() / HPA_GSU_WORKSPACE_SIZE_GRANULARITY)
-                        * HPA_GSU_WORKSPACE_SIZE_GRANULARITY;
+        // Size of GSU workspace
+        size_t workspace_size = tensile_workspace_size(prob.handle);
 
         // The ContractionProblem
         Tensile::ContractionProblem tensileProblem{a,
@@ -396,6 +410,58 @@ namespace
         return tensileProblem;
     }
 
+    /*****************************************************************
+     * Construct the solution cache key of a RocblasContractionProblem *
+     * It must capture every field which ConstructTensileProblem reads *
+     * from the problem, since cache hits reuse the Tensile problem.   *
+     *****************************************************************/
+    template <typename Ti, typename To, typename Tc>
+    rocblas_solution_cache_key
+        ConstructSolutionCacheKey(const RocblasContractionProblem<Ti, To, Tc>& prob)
+    {
+        rocblas_solution_cache_key key{};
+
+        key.a_type             = rocblas_datatype_from_type<Ti>;
+        key.c_type             = rocblas_datatype_from_type<To>;
+        key.compute_type       = rocblas_datatype_from_type<Tc>;
+        key.trans_a            = prob.trans_a;
+        key.trans_b            = prob.trans_b;
+        key.flags              = prob.flags;
+        key.atomics_mode       = prob.handle->atomics_mode;
+        key.performance_metric = prob.handle->performance_metric;
+
+        // alpha is only dereferenced when k != 0, as in ConstructTensileProblem
+        key.alpha_category = prob.k ? int32_t(value_category(*prob.alpha)) : 0;
+        key.beta_category  = int32_t(value_category(*prob.beta));
+        key.strided_batch  = prob.strided_batch;
+        key.c_equals_d     = prob.C == prob.D;
+
+        key.m              = prob.m;
+        key.n              = prob.n;
+        key.k              = key.alpha_category ? prob.k : 0;
+        key.batch_count    = prob.batch_count;
+        key.col_stride_a   = prob.col_stride_a;
+        key.batch_stride_a = prob.batch_stride_a;
+        key.col_stride_b   = prob.col_stride_b;
+        key.batch_stride_b = prob.batch_stride_b;
+        key.col_stride_c   = prob.col_stride_c;
+        key.batch_stride_c = prob.batch_stride_c;
+        key.col_stride_d   = prob.col_stride_d;
+        key.batch_stride_d = prob.batch_stride_d;
+        key.workspace_size = tensile_workspace_size(prob.handle);
+
+        key.row_stride_a    = prob.row_stride_a;
+        key.row_stride_b    = prob.row_stride_b;
+        key.row_stride_c    = prob.row_stride_c;
+        key.row_stride_d    = prob.row_stride_d;
+        key.buffer_offset_a = prob.buffer_offset_a;
+        key.buffer_offset_b = prob.buffer_offset_b;
+        key.buffer_offset_c = prob.buffer_offset_c;
+        key.buffer_offset_d = prob.buffer_offset_d;
+
+        return key;
+    }
+
     /***************************************************************
      * Construct the inputs to a Tensile ContractionProblem        *
      ***************************************************************/
@@ -450,6 +516,33 @@ namespace
         return inputs;
     }
 
+    /****************************************************************************
+     * Solution selections persisted across processes. This is enabled by      *
+     * setting ROCBLAS_TENSILE_SOLUTION_CACHE_PATH to a file name. Selections   *
+     * for each GPU architecture are kept in the file name followed by "." and *
+     * the architecture name, which is loaded when Tensile is initialized for  *
+     * the first device of that architecture. New selections are written when *
+     * a handle is destroyed, and by rocblas_shutdown.                         *
+     ****************************************************************************/
+    const char* persistent_solution_cache_path()
+    {
+        static const char* path = getenv("ROCBLAS_TENSILE_SOLUTION_CACHE_PATH");
+        return path;
+    }
+
+    struct persistent_solution_caches
+    {
+        std::mutex                                         mutex;
+        std::map<std::string, rocblas_solution_cache_file> files; // by architecture
+    };
+
+    // The caches are never destroyed, so that handles destroyed during exit can still save
+    persistent_solution_caches& get_persistent_solution_caches()
+    {
+        static auto* caches = new persistent_solution_caches;
+        return *caches;
+    }
+
     /**************************************************
      * The TensileHost struct interfaces with Tensile *
      **************************************************/
@@ -459,12 +552,16 @@ namespace
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> m_library;
         std::shared_ptr<hipDeviceProp_t>                                             m_deviceProp;
 
+        // Hash of the library file, identifying it for persisted solution selections
+        uint64_t m_library_hash = 0;
+
         // The adapter object. mutable is used to allow adapters to be modified
         // even when they are stored in a const vector which is immutable in size
         struct adapter_s
         {
             mutable std::atomic<Tensile::hip::SolutionAdapter*> adapter{nullptr};
             mutable std::mutex                                  mutex;
+            mutable rocblas_solution_cache_file*                solution_cache{nullptr};
         };
 
         // Each device contains an adapter
@@ -535,7 +632,10 @@ namespace
          * Initialize adapter and library according to environment variables *
          * and default paths based on librocblas.so location and GPU         *
          *********************************************************************/
-        void initialize(Tensile::hip::SolutionAdapter& adapter, rocblas_int deviceId)
+        // Initialize the adapter and possibly the library, returning the persisted
+        // solution selections for the device, or nullptr if they are not enabled
+        rocblas_solution_cache_file* initialize(Tensile::hip::SolutionAdapter& adapter,
+                                                rocblas_int                    deviceId)
         {
             std::string path;
             std::string tensileLibraryPath;
@@ -765,6 +865,9 @@ namespace
                     {
                         using MSL = Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>;
                         m_library = std::dynamic_pointer_cast<MSL>(lib);
+                        if(persistent_solution_cache_path())
+                            m_library_hash
+                                = rocblas_solution_cache_file::hash_file(tensileLibraryPath);
                     }
                     return 0;
                 }();
@@ -797,6 +900,25 @@ namespace
                         << overridePath << std::endl;
                 }
             }
+
+            // Persisted solution selections are only valid for this architecture, and for
+            // the library with the overrides applied to it
+            if(!persistent_solution_cache_path())
+                return nullptr;
+
+            uint64_t identity = m_library_hash;
+            if(overrideEnv)
+                identity = rocblas_solution_cache_file::hash_file(overrideEnv, identity);
+
+            auto&                       caches = get_persistent_solution_caches();
+            std::lock_guard<std::mutex> lock(caches.mutex);
+            auto                        inserted = caches.files.try_emplace(processor);
+            if(inserted.second)
+                inserted.first->second.load(
+                    std::string(persistent_solution_cache_path()) + "." + processor,
+                    identity,
+                    processor);
+            return &inserted.first->second;
         }
     };
 
@@ -804,8 +926,9 @@ namespace
     auto& get_library_and_adapter(
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>>* library
         = nullptr,
-        std::shared_ptr<hipDeviceProp_t>* deviceProp = nullptr,
-        int                               device     = -1)
+        std::shared_ptr<hipDeviceProp_t>* deviceProp     = nullptr,
+        int                               device         = -1,
+        rocblas_solution_cache_file**     solution_cache = nullptr)
     try
     {
         // TensileHost is initialized on the first call
@@ -831,7 +954,7 @@ namespace
                 adapter = new Tensile::hip::SolutionAdapter;
 
                 // Initialize the adapter and possibly the library
-                host.initialize(*adapter, device);
+                a.solution_cache = host.initialize(*adapter, device);
 
                 // Atomically change the adapter stored for this device ID
                 a.adapter.store(adapter, std::memory_order_release);
@@ -843,6 +966,8 @@ namespace
             *library = host.get_library();
         if(deviceProp)
             *deviceProp = host.get_device_property();
+        if(solution_cache)
+            *solution_cache = a.solution_cache;
 
         return *adapter;
     }
@@ -860,6 +985,47 @@ namespace
         rocblas_abort();
     }
 
+    /*****************************************************************************
+     * Entry of the handle's solution cache: the Tensile problem constructed for *
+     * a key, and the solution selected for it                                   *
+     *****************************************************************************/
+    struct solution_cache_entry
+    {
+        Tensile::ContractionProblem                   problem;
+        std::shared_ptr<Tensile::ContractionSolution> solution;
+    };
+
+    /*****************************************************************************
+     * Select the best solution for a problem. If the persistent solution cache  *
+     * of the device is given, a selection recorded by an earlier process is     *
+     * used when it can solve the problem, and new selections are recorded.     *
+     *****************************************************************************/
+    std::shared_ptr<Tensile::ContractionSolution>
+        SelectSolution(Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>& library,
+                       const Tensile::ContractionProblem&                           problem,
+                       const Tensile::Hardware&                                     hardware,
+                       const rocblas_solution_cache_key&                            key,
+                       rocblas_solution_cache_file*                                 persistent)
+    {
+        if(!persistent)
+            return library.findBestSolution(problem, hardware);
+
+        int32_t index = persistent->find(key);
+        if(index >= 0)
+        {
+            // With lazy loading, the solution is not available until its
+            // code object has been loaded by findBestSolution
+            auto solution = library.getSolutionByIndex(index);
+            if(solution && solution->canSolve(problem, hardware))
+                return solution;
+        }
+
+        auto solution = library.findBestSolution(problem, hardware);
+        if(solution && solution->index != index)
+            persistent->record(key, solution->index);
+        return solution;
+    }
+
     /**************************************************************************
     * We normally print error messages only once, to avoid excessive logging *
     **************************************************************************/
@@ -899,28 +1065,53 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
         std::shared_ptr<Tensile::MasterSolutionLibrary<Tensile::ContractionProblem>> library;
         std::shared_ptr<hipDeviceProp_t>                                             deviceProp;
         std::shared_ptr<Tensile::Hardware>                                           hardware;
+        rocblas_solution_cache_file*                                                 persistent;
 
-        auto& adapter = get_library_and_adapter(&library, &deviceProp, prob.handle->getDevice());
+        auto& adapter = get_library_and_adapter(
+            &library, &deviceProp, prob.handle->getDevice(), &persistent);
 
         hardware = Tensile::hip::GetDevice(*deviceProp);
 
-        auto  tensile_prob  = ConstructTensileProblem(prob);
         auto  handle        = prob.handle;
         auto* fitness_query = handle->get_solution_fitness_query();
 
+        // The Tensile problem is either constructed for this call, or taken from the cache
+        std::optional<Tensile::ContractionProblem>  constructed;
+        std::shared_ptr<const solution_cache_entry> cached;
+
         if(algo == rocblas_gemm_algo_solution_index && solution_index > 0)
         {
+            constructed.emplace(ConstructTensileProblem(prob));
             solution = library->getSolutionByIndex(solution_index - 1);
             // load solution if not already loaded
             if(!solution)
             {
-                library->findAllSolutions(tensile_prob, *hardware);
+                library->findAllSolutions(*constructed, *hardware);
                 solution = library->getSolutionByIndex(solution_index - 1);
             }
         }
+        else if(fitness_query)
+        {
+            constructed.emplace(ConstructTensileProblem(prob));
+            solution = library->findBestSolution(*constructed, *hardware, fitness_query);
+        }
         else
         {
-            solution = library->findBestSolution(tensile_prob, *hardware, fitness_query);
+            // Repeated problems skip constructing the Tensile problem and selecting the
+            // solution, using the handle's cache
+            auto key = ConstructSolutionCacheKey(prob);
+            cached   = std::static_pointer_cast<const solution_cache_entry>(
+                handle->solution_cache.find_or_insert(key, [&]() -> std::shared_ptr<void> {
+                    auto entry = std::make_shared<solution_cache_entry>(
+                        solution_cache_entry{ConstructTensileProblem(prob), nullptr});
+                    entry->solution
+                        = SelectSolution(*library, entry->problem, *hardware, key, persistent);
+                    if(!entry->solution)
+                        return nullptr;
+                    return entry;
+                }));
+            if(cached)
+                solution = cached->solution;
         }
 
         if(!solution)
@@ -938,6 +1129,8 @@ rocblas_status runContractionProblem(const RocblasContractionProblem<Ti, To, Tc>
         }
         else
         {
+            const auto& tensile_prob = cached ? cached->problem : *constructed;
+
             if(fitness_query)
                 status = rocblas_status_success;
             else if(handle->is_device_memory_size_query())
@@ -1013,6 +1206,17 @@ rocblas_status getAllSolutions(const RocblasContractionProblem<Ti, To, Tc>& prob
         {
             solutions = library->findAllSolutionsMatchingType(tensile_prob, *hardware);
         }
+        else if(option == COVERAGE)
+        {
+            if(list_array == nullptr || list_size == nullptr)
+                return rocblas_status_invalid_pointer;
+
+            double fitness  = rocblas_gemm_fitness_unset;
+            auto   solution = library->findBestSolution(tensile_prob, *hardware, &fitness);
+            list_array[0]   = rocblas_gemm_solution_coverage(solution != nullptr, fitness);
+            *list_size      = 1;
+            return rocblas_status_success;
+        }
         else
         {
             return rocblas_status_invalid_value;
@@ -1063,6 +1267,25 @@ extern "C" void rocblas_initialize()
     get_library_and_adapter();
 }
 
+/*******************************************************************************
+ * Write the solution selections made since they were last saved to the       *
+ * persistent solution cache files                                             *
+ *******************************************************************************/
+void rocblas_save_persistent_solution_caches()
+{
+    if(!persistent_solution_cache_path())
+        return;
+
+    auto&                       caches = get_persistent_solution_caches();
+    std::lock_guard<std::mutex> lock(caches.mutex);
+    for(auto& file : caches.files)
+    {
+        if(file.second.dirty() && !file.second.save())
+            rocblas_cerr << "\nrocBLAS warning: Could not write solution cache "
+                         << file.second.path() << std::endl;
+    }
+}
+
 /******************************************************************************
  * Intantiate the cases of runContractionProblem which are needed to satisfy  *
  * rocBLAS dependencies. This file's template functions are not defined in a  *
@@ -0,0 +1,349 @@
+#!/usr/bin/python
+
+"""Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+   ies of the Software, and to permit persons to whom the Software is furnished
+   to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+   PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+   COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+   CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+"""
+
+# Extracts the GEMM problems of real workloads from rocBLAS logs, and writes them as a Tensile
+# tuning config and as a rocblas-bench --yaml input, so that tuning follows the shapes which
+# are actually run.
+#
+# The inputs are bench logs (ROCBLAS_LAYER=2, written to ROCBLAS_LOG_BENCH_PATH) or profile
+# logs (ROCBLAS_LAYER=4, written to ROCBLAS_LOG_PROFILE_PATH), in any mix. Identical problems
+# are merged, counting one call per bench log line and call_count calls per profile entry.
+# Problems are weighted by their calls, their flops, or the GPU time recorded by profile
+# logging with ROCBLAS_LOG_PROFILE_LATENCY. For each Tensile problem type, the problems with
+# the largest weight are kept until --fraction of the weight of the type is covered.
+#
+# Example:
+#   extract-gemm-problemset.py --weight flops --fraction 0.95 --arch gfx90a \
+#       --tensile_config tune.yaml --bench_yaml bench.yaml bench_log_*.txt profile.yaml
+
+import argparse
+import copy
+import shlex
+import sys
+import yaml
+
+# Tensile data types of the rocBLAS datatypes
+tensileTypes = {'f16_r': 'h', 'bf16_r': 'b', 'f32_r': 's', 'f64_r': 'd',
+                'f32_c': 'c', 'f64_c': 'z', 'i8_r': 'I8', 'i32_r': 'I'}
+
+# Datatypes of the BLAS precision letters used by rocblas-bench and the gemm function names
+precisionTypes = {'h': 'f16_r', 's': 'f32_r', 'd': 'f64_r', 'c': 'f32_c', 'z': 'f64_c'}
+
+gemmFunctions = ['gemm', 'gemm_batched', 'gemm_strided_batched',
+                 'gemm_ex', 'gemm_batched_ex', 'gemm_strided_batched_ex']
+
+benchAliases = {'-f': 'function', '-r': 'precision', '-m': 'M', '-n': 'N', '-k': 'K',
+                '--sizem': 'M', '--sizen': 'N', '--sizek': 'K', '--batch': 'batch_count'}
+
+typeKeys = ['a_type', 'b_type', 'c_type', 'd_type', 'compute_type']
+
+def isOption(token):
+    if not token.startswith('-') or len(token) < 2:
+        return False
+    try:
+        float(token)
+        return False
+    except ValueError:
+        return True
+
+def parseBenchLine(line):
+    # Returns the options of a rocblas-bench command line, or None
+    try:
+        tokens = shlex.split(line)
+    except ValueError:
+        return None
+    options = {}
+    i = 0
+    while i < len(tokens):
+        if isOption(tokens[i]):
+            name = benchAliases.get(tokens[i], tokens[i].lstrip('-'))
+            if i + 1 < len(tokens) and not isOption(tokens[i + 1]):
+                options[name] = tokens[i + 1]
+                i += 1
+            else:
+                options[name] = ''
+        i += 1
+    return options if 'function' in options else None
+
+def parseProfileLine(line):
+    # Returns the entry of a profile log line, which is a YAML flow mapping, or None
+    line = line.strip()
+    if not line.startswith('- {'):
+        return None
+    try:
+        entry = yaml.safe_load(line[1:])
+    except yaml.YAMLError:
+        return None
+    if type(entry) is not dict or 'rocblas_function' not in entry:
+        return None
+
+    # rocblas_sgemm_batched is function gemm_batched of precision s
+    name = str(entry['rocblas_function'])
+    name = name[len('rocblas_'):] if name.startswith('rocblas_') else name
+    if name[1:5] == 'gemm' and name[0] in precisionTypes:
+        entry['precision'] = name[0]
+        name = name[1:]
+    entry['function'] = name
+    return entry
+
+def problemFromOptions(options):
+    # Returns the problem of a GEMM call, or None for other functions or malformed calls
+    function = options.get('function')
+    if function not in gemmFunctions:
+        return None
+    try:
+        ex = function.endswith('_ex')
+        precision = str(options.get('precision', 'f32_r'))
+        precision = precisionTypes.get(precision, precision)
+        p = {'function': function}
+        for key in typeKeys:
+            p[key] = str(options.get(key, precision)) if ex else precision
+            if p[key] not in tensileTypes:
+                return None
+        p['transA'] = str(options.get('transposeA', options.get('transA', 'N'))).upper()
+        p['transB'] = str(options.get('transposeB', options.get('transB', 'N'))).upper()
+        if p['transA'] not in 'NTC' or p['transB'] not in 'NTC':
+            return None
+        for key, default in (('M', 128), ('N', 128), ('K', 128), ('batch_count', 1)):
+            p[key] = int(options.get(key, default))
+        p['alpha'] = float(options.get('alpha', 1))
+        p['beta'] = float(options.get('beta', 0))
+
+        rowsA = p['M'] if p['transA'] == 'N' else p['K']
+        colsA = p['K'] if p['transA'] == 'N' else p['M']
+        rowsB = p['K'] if p['transB'] == 'N' else p['N']
+        colsB = p['N'] if p['transB'] == 'N' else p['K']
+        p['lda'] = int(options.get('lda', rowsA))
+        p['ldb'] = int(options.get('ldb', rowsB))
+        p['ldc'] = int(options.get('ldc', p['M']))
+        p['ldd'] = int(options.get('ldd', p['ldc'])) if ex else p['ldc']
+
+        # Batched calls have no strides; their matrices are handled as packed
+        packed = not function.endswith('strided_batched') and \
+                 not function.endswith('strided_batched_ex')
+        for key, ld, cols in (('stride_a', 'lda', colsA), ('stride_b', 'ldb', colsB),
+                              ('stride_c', 'ldc', p['N']), ('stride_d', 'ldd', p['N'])):
+            p[key] = p[ld] * cols if packed else int(options.get(key, p[ld] * cols))
+    except (TypeError, ValueError):
+        return None
+
+    if min(p['M'], p['N'], p['K'], p['batch_count']) < 0:
+        return None
+    return p
+
+def problemKey(p):
+    return tuple(p[key] for key in ['function'] + typeKeys +
+                 ['transA', 'transB', 'M', 'N', 'K', 'batch_count', 'alpha', 'beta',
+                  'lda', 'ldb', 'ldc', 'ldd', 'stride_a', 'stride_b', 'stride_c', 'stride_d'])
+
+def readLogs(filenames):
+    # Returns the distinct problems, with their calls and recorded GPU time
+    problems = {}
+    skipped = 0
+    for filename in filenames:
+        with open(filename, 'r') as f:
+            for line in f:
+                entry = parseProfileLine(line)
+                if entry is not None:
+                    calls = int(entry.get('call_count', 1))
+                    timeUs = entry.get('gpu_time_us_total')
+                    if timeUs is not None and entry.get('gpu_time_calls'):
+                        # Only some calls may be timed; scale their time to all calls
+                        timeUs = float(timeUs) * calls / int(entry['gpu_time_calls'])
+                    p = problemFromOptions(entry)
+                else:
+                    options = parseBenchLine(line)
+                    calls, timeUs = 1, None
+                    p = problemFromOptions(options) if options else None
+                if p is None:
+                    skipped += bool(line.strip())
+                    continue
+                merged = problems.setdefault(problemKey(p), dict(p, calls = 0, timeUs = None))
+                merged['calls'] += calls
+                if timeUs is not None:
+                    merged['timeUs'] = (merged['timeUs'] or 0) + timeUs
+    return list(problems.values()), skipped
+
+def weight(p, kind):
+    if kind == 'calls':
+        return p['calls']
+    if kind == 'time':
+        return p['timeUs'] or 0
+    flops = 2.0 * p['M'] * p['N'] * p['K'] * max(p['batch_count'], 1)
+    return p['calls'] * flops * (4 if p['a_type'].endswith('_c') else 1)
+
+def problemType(p):
+    dataType = tensileTypes[p['a_type']]
+    hpa = p['compute_type'] != p['a_type'] and dataType in ('h', 'b', 'I8')
+    return {'OperationType': 'GEMM',
+            'DataType': dataType,
+            'DestDataType': tensileTypes[p['d_type']],
+            'ComputeDataType': tensileTypes[p['compute_type']],
+            'HighPrecisionAccumulate': hpa,
+            'TransposeA': p['transA'] != 'N',
+            'TransposeB': p['transB'] != 'N',
+            'ComplexConjugateA': p['transA'] == 'C',
+            'ComplexConjugateB': p['transB'] == 'C',
+            'UseBeta': True,
+            'Batched': True}
+
+def selectProblems(problems, args):
+    # Groups the problems by Tensile problem type, and keeps the heaviest of each type
+    groups = {}
+    for p in problems:
+        key = yaml.safe_dump(problemType(p), sort_keys = True)
+        groups.setdefault(key, []).append(p)
+
+    selected = []
+    for key in sorted(groups):
+        group = sorted(groups[key], key = lambda p: weight(p, args.weight), reverse = True)
+        total = sum(weight(p, args.weight) for p in group)
+        kept, covered = [], 0
+        for p in group:
+            if kept and (covered >= args.fraction * total or len(kept) == args.max_sizes):
+                break
+            kept.append(p)
+            covered += weight(p, args.weight)
+        selected.append((problemType(group[0]), kept, covered, total))
+    return selected
+
+def exactSize(p):
+    # Tensile exact sizes of GEMM are [M, N, batch, K, ldd, ldc, lda, ldb]
+    return [p['M'], p['N'], p['batch_count'], p['K'], p['ldd'], p['ldc'], p['lda'], p['ldb']]
+
+def defaultTensileTemplate(arch):
+    return {'GlobalParameters': {'MinimumRequiredVersion': '4.33.0',
+                                 'PrintLevel': 1,
+                                 'NumElementsToValidate': 0,
+                                 'KernelTime': True,
+                                 'SleepPercent': 50,
+                                 'DataInitTypeBeta': 0,
+                                 'NumBenchmarks': 1,
+                                 'SyncsPerBenchmark': 1,
+                                 'EnqueuesPerSync': 10},
+            'BenchmarkProblemSizeGroup': {'InitialSolutionParameters': None,
+                                          'BenchmarkCommonParameters':
+                                              [{'KernelLanguage': ['Assembly']}],
+                                          'ForkParameters': [{'PrefetchGlobalRead': [2]}],
+                                          'BenchmarkForkParameters': None,
+                                          'JoinParameters': None,
+                                          'BenchmarkJoinParameters': None},
+            'LibraryLogic': {'ScheduleName': arch,
+                             'DeviceNames': ['Device 0000'],
+                             'ArchitectureName': arch}}
+
+def writeTensileConfig(filename, selected, args):
+    # The template names the tuning parameters; the problem types and sizes are filled in
+    if args.tensile_template:
+        with open(args.tensile_template, 'r') as f:
+            template = yaml.safe_load(f)
+    else:
+        template = defaultTensileTemplate(args.arch)
+
+    config = {'GlobalParameters': template['GlobalParameters'], 'BenchmarkProblems': []}
+    for (ptype, kept, covered, total) in selected:
+        # Problems which differ only in alpha, beta or strides have the same Tensile size
+        sizes = []
+        for p in kept:
+            if exactSize(p) not in sizes:
+                sizes.append(exactSize(p))
+        group = copy.deepcopy(template['BenchmarkProblemSizeGroup'])
+        group['BenchmarkFinalParameters'] = [{'ProblemSizes': [{'Exact': size}
+                                                               for size in sizes]}]
+        config['BenchmarkProblems'].append([ptype, group])
+    if 'LibraryLogic' in template:
+        config['LibraryLogic'] = template['LibraryLogic']
+
+    with open(filename, 'w') as f:
+        yaml.safe_dump(config, f, default_flow_style = None, sort_keys = False)
+
+def writeBenchYaml(filename, selected, args):
+    # Each problem is run as it was called; the weight is kept as a comment
+    with open(filename, 'w') as f:
+        for (ptype, kept, covered, total) in selected:
+            for p in kept:
+                entry = ['rocblas_function: "rocblas_{}"'.format(p['function'])]
+                if not p['function'].endswith('_ex'):
+                    entry[0] = 'rocblas_function: "rocblas_{}{}"'.format(
+                        [c for c in precisionTypes if precisionTypes[c] == p['a_type']][0],
+                        p['function'])
+                else:
+                    entry += ['{}: "{}"'.format(key, p[key]) for key in typeKeys]
+                entry += ['transA: "{}"'.format(p['transA']), 'transB: "{}"'.format(p['transB'])]
+                entry += ['{}: {}'.format(key, p[key]) for key in
+                          ['M', 'N', 'K', 'alpha', 'beta', 'lda', 'ldb', 'ldc', 'ldd']]
+                if p['function'] != 'gemm' and p['function'] != 'gemm_ex':
+                    entry.append('batch_count: {}'.format(p['batch_count']))
+                if 'strided' in p['function']:
+                    entry += ['{}: {}'.format(key, p[key]) for key in
+                              ['stride_a', 'stride_b', 'stride_c', 'stride_d']]
+                entry += ['cold_iters: {}'.format(args.cold_iters),
+                          'iters: {}'.format(args.iters)]
+                f.write('- {{ {} }} # calls: {}, weight: {:.4g}\n'.format(
+                        ', '.join(entry), p['calls'], weight(p, args.weight)))
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description = 'Extract GEMM tuning inputs from rocBLAS bench and profile logs')
+    parser.add_argument('logs', nargs = '+', help = 'bench or profile log files')
+    parser.add_argument('--weight', default = 'calls', choices = ['calls', 'flops', 'time'],
+                        help = 'weight of a problem; time needs profile logs with latency')
+    parser.add_argument('--fraction', default = 1.0, type = float,
+                        help = 'fraction of the weight of each problem type to cover')
+    parser.add_argument('--max_sizes', default = 0, type = int,
+                        help = 'maximum number of sizes per problem type, 0 for no limit')
+    parser.add_argument('--arch', default = 'gfx90a',
+                        help = 'architecture named in the default Tensile template')
+    parser.add_argument('--tensile_template',
+                        help = 'YAML file with GlobalParameters, BenchmarkProblemSizeGroup and '
+                               'LibraryLogic to use in the Tensile config')
+    parser.add_argument('--tensile_config', help = 'Tensile tuning config to write')
+    parser.add_argument('--bench_yaml', help = 'rocblas-bench --yaml input to write')
+    parser.add_argument('--iters', default = 10, type = int)
+    parser.add_argument('--cold_iters', default = 2, type = int)
+    args = parser.parse_args(argv)
+
+    if not 0 < args.fraction <= 1:
+        print('--fraction must be in (0, 1]')
+        return 1
+
+    problems, skipped = readLogs(args.logs)
+    if args.weight == 'time' and any(p['timeUs'] is None for p in problems):
+        print('Warning: problems without recorded GPU time have no weight')
+    selected = selectProblems(problems, args)
+
+    print('{} distinct GEMM problems, {} other lines skipped'.format(len(problems), skipped))
+    for (ptype, kept, covered, total) in selected:
+        print('{} {}{}: {} of {} sizes, {:.1f}% of the weight'.format(
+              ptype['DataType'] + ptype['DestDataType'] + ptype['ComputeDataType'],
+              'T' if ptype['TransposeA'] else 'N', 'T' if ptype['TransposeB'] else 'N',
+              len(kept), sum(1 for p in problems if problemType(p) == ptype),
+              100.0 * covered / total if total else 100.0))
+
+    if args.tensile_config:
+        writeTensileConfig(args.tensile_config, selected, args)
+    if args.bench_yaml:
+        writeBenchYaml(args.bench_yaml, selected, args)
+    return 0
+
+if __name__=="__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,187 @@
+#!/usr/bin/python
+
+"""Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+   ies of the Software, and to permit persons to whom the Software is furnished
+   to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+   PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+   COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+   CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+"""
+
+
+# Generates kernel variant rules of a level 2 function for the GPU in use, and appends them
+# to a data file which rocBLAS reads when ROCBLAS_LEVEL2_VARIANTS names it.
+#
+# rocblas-bench times the function at each size of a grid once per candidate variant. Each
+# run reads a rules file which selects that variant, falling back to the generic variant if
+# it cannot run the problem. A variant other than generic is kept only if it is faster than
+# the generic variant by more than the margin. Each size of the grid stands for the sizes
+# above the previous one, up to it; the last one stands for all larger sizes.
+#
+# Example, generating the gemv transpose rules of double precision:
+#   level2-variant-tune.py --bench ./rocblas-bench --arch gfx942 --op gemv_t --precision d \
+#       --m 1024 4096 16384 --n 1024 4096 16384 --output level2_variants.txt
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from tempfile import mkstemp
+
+FORMAT_VERSION = 1
+
+variants = {'gemv_n':     ['generic', 'sm_mn_batched', 'double_buffered', 'threads_512'],
+            'gemv_t':     ['generic', 'double_buffered', 'warp_reduce_256', 'shared_reduce_256'],
+            'gemv_c':     ['generic', 'double_buffered', 'shared_reduce_256'],
+            'symv_upper': ['generic', 'double_buffered'],
+            'symv_lower': ['generic', 'double_buffered'],
+            'ger':        ['generic', 'double_buffered']}
+
+def rule(args, mRange, nRange, variant):
+    return '{} {} {} {} {} {} {} {} {} - {}\n'.format(args.arch, args.op, args.precision,
+                                                   mRange[0], mRange[1], nRange[0], nRange[1],
+                                                   args.batch_range[0], args.batch_range[1],
+                                                   variant)
+
+def benchCommand(args, m, n):
+    function = args.op.split('_')[0]
+    if args.batch_count > 1:
+        function += '_strided_batched'
+    cmd = [args.bench, '-f', function, '-r', args.precision,
+           '--batch_count', str(args.batch_count),
+           '-i', str(args.iters), '-j', str(args.cold_iters)]
+
+    if args.op.startswith('gemv'):
+        cmd += ['--transposeA', {'gemv_n': 'N', 'gemv_t': 'T', 'gemv_c': 'C'}[args.op],
+                '-m', str(m), '-n', str(n), '--lda', str(m)]
+    elif args.op.startswith('symv'):
+        cmd += ['--uplo', 'U' if args.op == 'symv_upper' else 'L', '-n', str(n), '--lda', str(n)]
+    else:
+        cmd += ['-m', str(m), '-n', str(n), '--lda', str(m)]
+    return cmd
+
+def benchTime(args, m, n, variant):
+    (fd, rulesFile) = mkstemp(prefix = 'level2_variants_', suffix = '.txt')
+    os.close(fd)
+    try:
+        with open(rulesFile, 'w') as f:
+            f.write('rocblas_level2_variants {}\n'.format(FORMAT_VERSION))
+            f.write(rule(args, ['-', '-'], ['-', '-'], variant))
+            f.write(rule(args, ['-', '-'], ['-', '-'], 'generic'))
+
+        cmd = benchCommand(args, m, n)
+        env = dict(os.environ, ROCBLAS_LEVEL2_VARIANTS = rulesFile)
+        output = subprocess.run(cmd, env = env, stdout = subprocess.PIPE,
+                                universal_newlines = True).stdout
+    finally:
+        os.remove(rulesFile)
+
+    # The line following the csv header which contains the us column holds the timing
+    lines = output.splitlines()
+    for i in range(len(lines) - 1):
+        names = [name.strip() for name in lines[i].split(',')]
+        if 'us' in names:
+            return float(re.split(r',\s*(?![^()]*\))', lines[i + 1])[names.index('us')])
+
+    print('Failed to time: {}'.format(' '.join(cmd)))
+    return float('inf')
+
+def ranges(sizes):
+    # The range of sizes which each size of the grid stands for
+    lower = '-'
+    result = []
+    for i, size in enumerate(sizes):
+        upper = '-' if i == len(sizes) - 1 else size
+        result.append([lower, upper])
+        lower = size + 1
+    return result
+
+def main(argv):
+    parser = argparse.ArgumentParser(description = 'Generate level 2 kernel variant rules')
+    parser.add_argument('--bench', default = './rocblas-bench', help = 'path of rocblas-bench')
+    parser.add_argument('--arch', required = True,
+                        help = 'architecture of the GPU in use, such as gfx942')
+    parser.add_argument('--op', required = True, choices = sorted(variants.keys()))
+    parser.add_argument('--precision', default = 's', choices = ['s', 'd', 'c', 'z'])
+    parser.add_argument('--m', nargs = '+', type = int, default = [1024],
+                        help = 'ascending rows of the grid; not used by symv')
+    parser.add_argument('--n', nargs = '+', type = int, required = True,
+                        help = 'ascending columns of the grid')
+    parser.add_argument('--batch_count', default = 1, type = int)
+    parser.add_argument('--batch_range', nargs = 2, default = ['-', '-'],
+                        help = 'batch counts which the rules apply to, - for open bounds')
+    parser.add_argument('--candidates', nargs = '+',
+                        help = 'variants to try, all variants of the op by default')
+    parser.add_argument('--margin', default = 3.0, type = float,
+                        help = 'percentage by which a variant must beat the generic variant')
+    parser.add_argument('--iters', default = 10, type = int)
+    parser.add_argument('--cold_iters', default = 2, type = int)
+    parser.add_argument('--output', default = 'level2_variants.txt',
+                        help = 'data file which the rules are appended to')
+    args = parser.parse_args(argv)
+
+    candidates = args.candidates or variants[args.op]
+    unknown = [v for v in candidates if v not in variants[args.op]]
+    if unknown:
+        print('{} has no variants {}'.format(args.op, ' '.join(unknown)))
+        return 1
+    if 'generic' not in candidates:
+        candidates = ['generic'] + candidates
+
+    for sizes in (args.m, args.n):
+        if any(a >= b for a, b in zip(sizes, sizes[1:])):
+            print('Sizes must be ascending')
+            return 1
+
+    # symv has a single dimension
+    mSizes = args.n if args.op.startswith('symv') else args.m
+    mRanges = [['-', '-']] if args.op.startswith('symv') else ranges(args.m)
+
+    rules = []
+    for mIndex, mRange in enumerate(mRanges):
+        row = []
+        for n in args.n:
+            m = n if args.op.startswith('symv') else mSizes[mIndex]
+            times = {v: benchTime(args, m, n, v) for v in candidates}
+            best = min(times, key = times.get)
+            if times[best] * (1 + args.margin / 100) >= times['generic']:
+                best = 'generic'
+            print('{} {} m {} n {}: {} ({} us)'.format(args.op, args.precision, m, n, best,
+                                                      times[best]))
+            row.append(best)
+
+        # Merge the columns of the row which select the same variant
+        nRanges = ranges(args.n)
+        start = 0
+        for i in range(1, len(row) + 1):
+            if i == len(row) or row[i] != row[start]:
+                rules.append(rule(args, mRange, [nRanges[start][0], nRanges[i - 1][1]],
+                                  row[start]))
+                start = i
+
+    header = not os.path.exists(args.output) or os.path.getsize(args.output) == 0
+    with open(args.output, 'a') as f:
+        if header:
+            f.write('rocblas_level2_variants {}\n'.format(FORMAT_VERSION))
+        f.write('# {} {} {} batch_count {}\n'.format(args.arch, args.op, args.precision,
+                                                     args.batch_count))
+        f.writelines(rules)
+    print('Appended {} rules for {} {} to {}'.format(len(rules), args.arch, args.op,
+                                                     args.output))
+    return 0
+
+if __name__=="__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,150 @@
+#!/usr/bin/python
+
+"""Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+
+   Permission is hereby granted, free of charge, to any person obtaining a copy
+   of this software and associated documentation files (the "Software"), to deal
+   in the Software without restriction, including without limitation the rights
+   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell cop-
+   ies of the Software, and to permit persons to whom the Software is furnished
+   to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included in all
+   copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IM-
+   PLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+   COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+   IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNE-
+   CTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+"""
+
+# Tunes one trsm block size table for the GPU in use and appends it to a data file which
+# rocBLAS reads when ROCBLAS_TRSM_BLOCK_TABLES names it.
+#
+# For each cell of the table, given by an interval of the rows and one of the columns,
+# rocblas-bench runs a left sided trsm of a size within the cell once per candidate block
+# size. Each run reads a table with that block size only, and the fastest candidate is
+# written for the cell. A candidate of 0 disables the substitution method for the cell.
+#
+# Example, tuning the batched real table:
+#   trsm-block-tune.py --bench ./rocblas-bench --arch gfx90a --precision s --batched \
+#       --batch_count 64 --rows 20 28 40 56 --cols 6 10 16 24 32 --output trsm_tables.txt
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from tempfile import mkstemp
+
+FORMAT_VERSION = 1
+
+def tableKind(precision, batched):
+    kind = 'complex' if precision in ('c', 'z') else 'real'
+    return kind + '_batched' if batched else kind
+
+def cellSizes(bounds):
+    # A size in the middle of each interval; the last interval is open
+    sizes = []
+    lower = 1
+    for bound in bounds:
+        sizes.append((lower + bound) // 2)
+        lower = bound + 1
+    sizes.append(lower + lower // 2)
+    return sizes
+
+def writeTables(filename, arch, kind, rows, cols, blksizes, header = True):
+    with open(filename, 'a') as f:
+        if header:
+            f.write('rocblas_trsm_block_tables {}\n'.format(FORMAT_VERSION))
+        f.write('\narch {}\ntable {}\n'.format(arch, kind))
+        f.write('rows {}\n'.format(' '.join(str(r) for r in rows)))
+        f.write('cols {}\n'.format(' '.join(str(c) for c in cols)))
+        f.write('blksizes')
+        for row in blksizes:
+            f.write('\n' + ' '.join(str(b) for b in row))
+        f.write('\n')
+
+def benchTime(args, kind, m, n, blksize):
+    (fd, tableFile) = mkstemp(prefix = 'trsm_block_tables_', suffix = '.txt')
+    os.close(fd)
+    try:
+        writeTables(tableFile, args.arch, kind, [], [], [[blksize]])
+
+        # trsm_batched reads the batched tables, trsm and trsm_strided_batched the others
+        if args.batched:
+            function = 'trsm_batched'
+        else:
+            function = 'trsm_strided_batched' if args.batch_count > 1 else 'trsm'
+        cmd = [args.bench, '-f', function, '-r', args.precision,
+               '--side', 'L', '--uplo', args.uplo, '--transposeA', args.transposeA,
+               '--diag', 'N', '-m', str(m), '-n', str(n), '--lda', str(m), '--ldb', str(m),
+               '--batch_count', str(args.batch_count),
+               '-i', str(args.iters), '-j', str(args.cold_iters)]
+
+        env = dict(os.environ, ROCBLAS_TRSM_BLOCK_TABLES = tableFile)
+        output = subprocess.run(cmd, env = env, stdout = subprocess.PIPE,
+                                universal_newlines = True).stdout
+    finally:
+        os.remove(tableFile)
+
+    # The line following the csv header which contains the us column holds the timing
+    lines = output.splitlines()
+    for i in range(len(lines) - 1):
+        names = [name.strip() for name in lines[i].split(',')]
+        if 'us' in names:
+            return float(re.split(r',\s*(?![^()]*\))', lines[i + 1])[names.index('us')])
+
+    print('Failed to time: {}'.format(' '.join(cmd)))
+    return float('inf')
+
+def main(argv):
+    parser = argparse.ArgumentParser(description = 'Tune a trsm block size table')
+    parser.add_argument('--bench', default = './rocblas-bench', help = 'path of rocblas-bench')
+    parser.add_argument('--arch', required = True,
+                        help = 'architecture of the GPU in use, such as gfx90a')
+    parser.add_argument('--precision', default = 's', choices = ['s', 'd', 'c', 'z'])
+    parser.add_argument('--batched', action = 'store_true',
+                        help = 'tune the table of trsm_batched')
+    parser.add_argument('--batch_count', default = 1, type = int)
+    parser.add_argument('--rows', nargs = '+', type = int, required = True,
+                        help = 'ascending upper bounds of the row intervals')
+    parser.add_argument('--cols', nargs = '+', type = int, required = True,
+                        help = 'ascending upper bounds of the column intervals')
+    parser.add_argument('--candidates', nargs = '+', type = int,
+                        default = [1, 16, 24, 32, 48, 64, 0],
+                        help = 'block sizes to try; 1 selects min(m, 512), 0 disables')
+    parser.add_argument('--uplo', default = 'L', choices = ['L', 'U'])
+    parser.add_argument('--transposeA', default = 'N', choices = ['N', 'T', 'C'])
+    parser.add_argument('--iters', default = 10, type = int)
+    parser.add_argument('--cold_iters', default = 2, type = int)
+    parser.add_argument('--output', default = 'trsm_block_tables.txt',
+                        help = 'data file which the tuned table is appended to')
+    args = parser.parse_args(argv)
+
+    for bounds in (args.rows, args.cols):
+        if any(a >= b for a, b in zip(bounds, bounds[1:])):
+            print('Interval bounds must be ascending')
+            return 1
+
+    kind = tableKind(args.precision, args.batched)
+    blksizes = []
+    for m in cellSizes(args.rows):
+        row = []
+        for n in cellSizes(args.cols):
+            times = [benchTime(args, kind, m, n, blk) for blk in args.candidates]
+            best = times.index(min(times))
+            print('{} m {} n {}: block size {} ({} us)'.format(
+                  kind, m, n, args.candidates[best], times[best]))
+            row.append(args.candidates[best])
+        blksizes.append(row)
+
+    header = not os.path.exists(args.output) or os.path.getsize(args.output) == 0
+    writeTables(args.output, args.arch, kind, args.rows, args.cols, blksizes, header)
+    print('Appended table {} for {} to {}'.format(kind, args.arch, args.output))
+    return 0
+
+if __name__=="__main__":
+    sys.exit(main(sys.argv[1:]))